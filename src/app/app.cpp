@@ -37,9 +37,11 @@
 
 #include "common/system/system.h"
 
+#include "common/thread/job_system.h"
 #include "common/thread/thread.h"
 
 #include "graphics/core/nulldevice.h"
+#include "graphics/core/recordingdevice.h"
 
 #include "graphics/opengl/glutil.h"
 
@@ -52,6 +54,8 @@
     #include "sound/oalsound/alsound.h"
 #endif
 
+#include <algorithm>
+
 #include <boost/tokenizer.hpp>
 
 #include <SDL.h>
@@ -112,6 +116,7 @@ struct ApplicationPrivate
 CApplication::CApplication(CSystemUtils* systemUtils)
     : m_systemUtils(systemUtils),
       m_private(MakeUnique<ApplicationPrivate>()),
+      m_jobSystem(MakeUnique<CJobSystem>()),
       m_configFile(MakeUnique<CConfigFile>()),
       m_input(MakeUnique<CInput>()),
       m_pathManager(MakeUnique<CPathManager>(systemUtils)),
@@ -188,6 +193,8 @@ CApplication::~CApplication()
         m_device.reset();
     }
 
+    m_jobSystem.reset();
+
     if (m_private->joystick != nullptr)
     {
         SDL_JoystickClose(m_private->joystick);
@@ -227,6 +234,11 @@ CModManager* CApplication::GetModManager()
     return m_modManager.get();
 }
 
+CSystemUtils* CApplication::GetSystemUtils()
+{
+    return m_systemUtils;
+}
+
 void CApplication::LoadEnvironmentVariables()
 {
     auto dataDir = m_systemUtils->GetEnvVar("COLOBOT_DATA_DIR");
@@ -333,6 +345,7 @@ ParseArgsStatus CApplication::ParseArguments(int argc, char *argv[])
                 GetLogger()->Message("  -resolution WxH     set resolution\n");
                 GetLogger()->Message("  -headless           headless mode - disables graphics, sound and user interaction\n");
                 GetLogger()->Message("  -graphics           changes graphics device (one of: default, auto, opengl, gl14, gl21, gl33\n");
+                GetLogger()->Message("                      or record in headless mode)\n");
                 GetLogger()->Message("  -glversion          sets OpenGL context version to use (either default or version in format #.#)\n");
                 GetLogger()->Message("  -glprofile          sets OpenGL context profile to use (one of: default, core, compatibility, opengles)\n");
                 return PARSE_ARGS_HELP;
@@ -520,6 +533,19 @@ bool CApplication::Create()
         GetLogger()->Warn("Config could not be loaded. Default values will be used!\n");
     }
 
+    // Sizes in kilobytes, cache size 0 disables the resource cache
+    int cacheSize = 0, cacheFileSize = 0;
+    if (GetConfigFile().GetIntProperty("Resources", "CacheSize", cacheSize) &&
+        GetConfigFile().GetIntProperty("Resources", "CacheFileSize", cacheFileSize))
+    {
+        CResourceManager::SetCacheLimits(std::max(cacheSize, 0) * 1024, std::max(cacheFileSize, 0) * 1024);
+    }
+    int readBufferSize = 0;
+    if (GetConfigFile().GetIntProperty("Resources", "ReadBufferSize", readBufferSize) && readBufferSize > 0)
+    {
+        CResourceManager::SetReadBufferSize(readBufferSize * 1024);
+    }
+
     m_modManager->FindMods();
     m_modManager->SaveMods();
     m_modManager->MountAllMods();
@@ -679,6 +705,10 @@ bool CApplication::Create()
             m_device = Gfx::CreateDevice(m_deviceConfig, "opengl");
         }
     }
+    else if (m_graphicsOverride && m_graphics == "record")
+    {
+        m_device = MakeUnique<Gfx::CRecordingDevice>(m_deviceConfig);
+    }
     else
     {
         m_device = MakeUnique<Gfx::CNullDevice>();
@@ -1062,6 +1092,9 @@ int CApplication::Run()
     SystemTimeStamp *currentTimeStamp = m_systemUtils->CreateTimeStamp();
     SystemTimeStamp *interpolatedTimeStamp = m_systemUtils->CreateTimeStamp();
 
+    // Statistics of a recorded run are checked to include shadow rendering
+    bool recordShadows = m_headless && m_graphicsOverride && m_graphics == "record" && m_engine->GetShadowMapping();
+
     while (true)
     {
         if (m_active)
@@ -1199,6 +1232,12 @@ int CApplication::Run()
     }
 
 end:
+    if (recordShadows && !m_engine->GetShadowMapping())
+    {
+        GetLogger()->Error("Shadow mapping was disabled during the recorded run, rendering statistics are not valid\n");
+        m_exitCode = 7;
+    }
+
     m_systemUtils->DestroyTimeStamp(previousTimeStamp);
     m_systemUtils->DestroyTimeStamp(currentTimeStamp);
     m_systemUtils->DestroyTimeStamp(interpolatedTimeStamp);
@@ -45,6 +45,7 @@ class CInput;
 class CModManager;
 class CPathManager;
 class CConfigFile;
+class CJobSystem;
 class CSystemUtils;
 struct SystemTimeStamp;
 
@@ -165,6 +166,8 @@ public:
     CSoundInterface* GetSound();
     //! Returns the mod manager
     CModManager* GetModManager();
+    //! Returns the system utils
+    CSystemUtils* GetSystemUtils();
 
 public:
     //! Loads some data from environment variables
@@ -317,6 +320,8 @@ protected:
     CSystemUtils* m_systemUtils;
     //! Private (SDL-dependent data)
     std::unique_ptr<ApplicationPrivate> m_private;
+    //! Threads running background jobs
+    std::unique_ptr<CJobSystem> m_jobSystem;
     //! Global event queue
     std::unique_ptr<CEventQueue> m_eventQueue;
     //! Graphics engine
@@ -46,6 +46,8 @@ CModManager::CModManager(CApplication* app, CPathManager* pathManager)
 
 void CModManager::FindMods()
 {
+    CResourceManager::ClearCache();
+
     m_mods.clear();
     m_userChanges = false;
 
@@ -203,6 +205,8 @@ void CModManager::MountAllMods()
 
 void CModManager::ReloadResources()
 {
+    // Files of mods may have changed on disk, not only the mounted ones
+    CResourceManager::ClearCache();
     m_app->ReloadResources();
 }
 
@@ -0,0 +1,227 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "common/compression.h"
+
+#include "common/ioutils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+
+const int MIN_MATCH = 3;
+const int MAX_MATCH = MIN_MATCH + 255;
+const int MAX_OFFSET = 0xFFFF;
+//! Number of earlier positions tried when looking for a match
+const int MAX_CHAIN = 32;
+
+const int HEADER_SIZE = 10;
+const unsigned char PACK_VERSION = 1;
+const unsigned char PACK_STORED = 0;
+const unsigned char PACK_LZ77 = 1;
+
+const int HASH_BITS = 15;
+const int HASH_SIZE = 1 << HASH_BITS;
+
+int Hash(const unsigned char* p)
+{
+    unsigned int value = p[0] | (p[1] << 8) | (p[2] << 16);
+    return static_cast<int>((value * 2654435761u) >> (32 - HASH_BITS));
+}
+
+} // anonymous namespace
+
+
+namespace Compression
+{
+
+std::string CompressLZ77(const std::string& data)
+{
+    const unsigned char* input = reinterpret_cast<const unsigned char*>(data.data());
+    const int size = static_cast<int>(data.size());
+
+    std::string result;
+    result.reserve(size / 2 + 16);
+
+    // Last position with given hash and previous position with the same hash
+    std::vector<int> head(HASH_SIZE, -1);
+    std::vector<int> previous(size, -1);
+
+    auto insert = [&](int pos)
+    {
+        if (pos + MIN_MATCH > size) return;
+        int hash = Hash(input + pos);
+        previous[pos] = head[hash];
+        head[hash] = pos;
+    };
+
+    std::size_t flagPos = 0;
+    int item = 8;
+    int pos = 0;
+    while (pos < size)
+    {
+        if (item == 8)
+        {
+            flagPos = result.size();
+            result.push_back('\0');
+            item = 0;
+        }
+
+        int bestLength = 0;
+        int bestOffset = 0;
+        if (pos + MIN_MATCH <= size)
+        {
+            int maxLength = std::min(MAX_MATCH, size - pos);
+            int candidate = head[Hash(input + pos)];
+            for (int chain = 0; candidate >= 0 && chain < MAX_CHAIN; chain++)
+            {
+                if (pos - candidate > MAX_OFFSET) break;
+
+                int length = 0;
+                while (length < maxLength && input[candidate + length] == input[pos + length])
+                    length++;
+
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    bestOffset = pos - candidate;
+                    if (length == maxLength) break;
+                }
+
+                candidate = previous[candidate];
+            }
+        }
+
+        if (bestLength >= MIN_MATCH)
+        {
+            result[flagPos] = static_cast<char>(static_cast<unsigned char>(result[flagPos]) | (1 << item));
+            result.push_back(static_cast<char>(bestOffset & 0xFF));
+            result.push_back(static_cast<char>(bestOffset >> 8));
+            result.push_back(static_cast<char>(bestLength - MIN_MATCH));
+
+            for (int i = 0; i < bestLength; i++)
+                insert(pos + i);
+            pos += bestLength;
+        }
+        else
+        {
+            result.push_back(static_cast<char>(input[pos]));
+            insert(pos);
+            pos++;
+        }
+
+        item++;
+    }
+
+    return result;
+}
+
+bool DecompressLZ77(const std::string& data, std::size_t size, std::string& result)
+{
+    const unsigned char* input = reinterpret_cast<const unsigned char*>(data.data());
+    const std::size_t inputSize = data.size();
+
+    result.clear();
+
+    // Every match takes at least 3 bytes of input, so a bigger size comes from a corrupted header
+    // and must be rejected before allocating memory for it
+    if (size > (inputSize / 3 + 1) * MAX_MATCH)
+        return false;
+    result.reserve(size);
+
+    std::size_t pos = 0;
+    while (pos < inputSize)
+    {
+        unsigned char flags = input[pos++];
+        for (int item = 0; item < 8 && pos < inputSize; item++)
+        {
+            if ((flags & (1 << item)) == 0)
+            {
+                if (result.size() >= size) return false;
+                result.push_back(static_cast<char>(input[pos++]));
+                continue;
+            }
+
+            if (pos + 3 > inputSize) return false;
+            std::size_t offset = input[pos] | (input[pos+1] << 8);
+            std::size_t length = input[pos+2] + MIN_MATCH;
+            pos += 3;
+
+            if (offset == 0 || offset > result.size()) return false;
+            if (result.size() + length > size) return false;
+
+            // The match may overlap the bytes being written, so copy byte by byte
+            std::size_t from = result.size() - offset;
+            for (std::size_t i = 0; i < length; i++)
+                result.push_back(result[from + i]);
+        }
+    }
+
+    return result.size() == size;
+}
+
+std::string Pack(const std::string& data, const char* magic)
+{
+    std::string compressed = CompressLZ77(data);
+    bool stored = compressed.size() >= data.size();
+
+    std::ostringstream stream;
+    stream.write(magic, 4);
+    IOUtils::WriteBinary<1, unsigned char>(PACK_VERSION, stream);
+    IOUtils::WriteBinary<1, unsigned char>(stored ? PACK_STORED : PACK_LZ77, stream);
+    IOUtils::WriteBinary<4, unsigned int>(data.size(), stream);
+    const std::string& payload = stored ? data : compressed;
+    stream.write(payload.data(), payload.size());
+    return stream.str();
+}
+
+bool IsPacked(const std::string& data, const char* magic)
+{
+    return data.size() >= HEADER_SIZE && memcmp(data.data(), magic, 4) == 0;
+}
+
+bool Unpack(const std::string& data, const char* magic, std::string& result)
+{
+    if (!IsPacked(data, magic)) return false;
+
+    std::istringstream stream(data.substr(4, HEADER_SIZE - 4));
+    unsigned char version = IOUtils::ReadBinary<1, unsigned char>(stream);
+    unsigned char method = IOUtils::ReadBinary<1, unsigned char>(stream);
+    unsigned int size = IOUtils::ReadBinary<4, unsigned int>(stream);
+    if (version != PACK_VERSION) return false;
+
+    if (method == PACK_STORED)
+    {
+        if (data.size() - HEADER_SIZE != size) return false;
+        result = data.substr(HEADER_SIZE);
+        return true;
+    }
+    if (method == PACK_LZ77)
+        return DecompressLZ77(data.substr(HEADER_SIZE), size, result);
+
+    return false;
+}
+
+} // namespace Compression
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+/**
+ * \file common/compression.h
+ * \brief Simple LZ77 compression of memory buffers
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \namespace Compression
+ * \brief Byte-oriented LZ77 compression, used for saved games
+ *
+ * The compressed data is a sequence of groups, each made of a flag byte
+ * followed by up to 8 items. Bit i of the flag byte tells if item i is
+ * a literal byte (0) or a match (1). A match is 3 bytes: 16-bit little endian
+ * offset back into the output (1..65535) and length of the match minus 3.
+ *
+ * The LZ77 format doesn't store the size of the data, it has to be kept by the caller.
+ * Pack() and Unpack() add a small header with the size, a magic identifying
+ * the kind of data and the method of compression.
+ */
+namespace Compression
+{
+
+//! Compresses given data
+std::string CompressLZ77(const std::string& data);
+
+/**
+ * \brief Decompresses data compressed by CompressLZ77()
+ * \param data compressed data
+ * \param size size of the original data
+ * \param result receives the original data
+ * \return false if the data is corrupted or has a different size
+ */
+bool DecompressLZ77(const std::string& data, std::size_t size, std::string& result);
+
+//! Compresses data, adding a header starting with 4 bytes of \a magic
+std::string Pack(const std::string& data, const char* magic);
+//! Checks if data starts with the header of Pack() with given magic
+bool IsPacked(const std::string& data, const char* magic);
+//! Decompresses data made by Pack(), returns false if the data is corrupted
+bool Unpack(const std::string& data, const char* magic, std::string& result);
+
+} // namespace Compression
@@ -143,6 +143,7 @@ enum Error
     INFO_LOST             = 10041,    //! <  lost
     INFO_LOSTq            = 10042,    //! <  lost immediately
     INFO_WRITEOK          = 10043,    //! <  record done
+    INFO_WRITEFAILED      = 10044,    //! <  record failed
     INFO_DELETEMOTHER     = 10100,    //! <  insect killed
     INFO_DELETEANT        = 10101,    //! <  insect killed
     INFO_DELETEBEE        = 10102,    //! <  insect killed
@@ -24,9 +24,104 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <thread>
+#include <vector>
+
 namespace
 {
 const char* EVENT_TYPE_TEXT[EVENT_STD_MAX];
+
+//! Size of blocks of the event data pool, enough for all EventData subclasses
+const std::size_t EVENT_DATA_BLOCK_SIZE = 64;
+//! Number of blocks allocated at once when the pool is empty
+const int EVENT_DATA_BLOCKS_PER_CHUNK = 64;
+
+union EventDataBlock
+{
+    EventDataBlock* next;
+    alignas(std::max_align_t) unsigned char storage[EVENT_DATA_BLOCK_SIZE];
+};
+
+/**
+ * \class CEventDataPool
+ * \brief Free list of blocks for EventData, guarded by a spin lock
+ *
+ * Blocks are allocated in chunks and never given back to the heap.
+ */
+class CEventDataPool
+{
+public:
+    void* Allocate()
+    {
+        Lock();
+        if (m_free == nullptr)
+        {
+            m_chunks.emplace_back(new EventDataBlock[EVENT_DATA_BLOCKS_PER_CHUNK]);
+            EventDataBlock* chunk = m_chunks.back().get();
+            for (int i = 0; i < EVENT_DATA_BLOCKS_PER_CHUNK; i++)
+            {
+                chunk[i].next = m_free;
+                m_free = &chunk[i];
+            }
+        }
+
+        EventDataBlock* block = m_free;
+        m_free = block->next;
+        Unlock();
+        return block;
+    }
+
+    void Free(void* pointer)
+    {
+        EventDataBlock* block = static_cast<EventDataBlock*>(pointer);
+        Lock();
+        block->next = m_free;
+        m_free = block;
+        Unlock();
+    }
+
+private:
+    void Lock()
+    {
+        while (m_lock.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    void Unlock()
+    {
+        m_lock.clear(std::memory_order_release);
+    }
+
+    std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+    EventDataBlock* m_free = nullptr;
+    std::vector<std::unique_ptr<EventDataBlock[]>> m_chunks;
+};
+
+CEventDataPool& GetEventDataPool()
+{
+    // Never destroyed, as event data may outlive other static objects
+    static CEventDataPool* pool = new CEventDataPool();
+    return *pool;
+}
+
+} // anonymous namespace
+
+void* EventData::operator new(std::size_t size)
+{
+    if (size > EVENT_DATA_BLOCK_SIZE)
+        return ::operator new(size);
+
+    return GetEventDataPool().Allocate();
+}
+
+void EventData::operator delete(void* pointer, std::size_t size)
+{
+    if (pointer == nullptr) return;
+
+    if (size > EVENT_DATA_BLOCK_SIZE)
+        ::operator delete(pointer);
+    else
+        GetEventDataPool().Free(pointer);
 }
 
 EventType GetUniqueEventType()
@@ -605,75 +700,66 @@ std::string ParseEventType(EventType eventType)
 
 
 
+const int CEventQueue::INITIAL_EVENT_QUEUE;
+const int CEventQueue::MAX_EVENT_QUEUE;
+
 CEventQueue::CEventQueue()
-    : m_mutex{},
-      m_fifo(),
-      m_head{0},
-      m_tail{0},
-      m_total{0}
+    : m_queue(INITIAL_EVENT_QUEUE, MAX_EVENT_QUEUE),
+      m_count{0},
+      m_peakCount{0},
+      m_droppedCount{0}
 {}
 
 CEventQueue::~CEventQueue()
-{}
+{
+    GetLogger()->Debug("Event queue: peak %d events, %lld dropped\n", GetPeakCount(), GetDroppedCount());
+}
 
 bool CEventQueue::IsEmpty()
 {
-    return m_head == m_tail;
+    return m_queue.IsEmpty();
 }
 
 /** If the maximum size of queue has been reached, returns \c false.
     Else, adds the event to the queue and returns \c true. */
 bool CEventQueue::AddEvent(Event&& event)
 {
-    bool result{};
-
-    SDL_LockMutex(*m_mutex);
-
-    if (m_total >= MAX_EVENT_QUEUE)
+    // The place is reserved first, so that the queue never holds more than MAX_EVENT_QUEUE events
+    int count = m_count.fetch_add(1) + 1;
+    if (count > MAX_EVENT_QUEUE || !m_queue.Push(std::move(event)))
     {
-        GetLogger()->Warn("Event queue flood!\n");
-
-        result = false;
-    }
-    else
-    {
-        m_fifo[m_head++] = std::move(event);
-
-        if (m_head >= MAX_EVENT_QUEUE)
-            m_head = 0;
+        m_count.fetch_sub(1);
 
-        m_total++;
+        if (m_droppedCount.fetch_add(1) == 0)
+            GetLogger()->Warn("Event queue flood!\n");
 
-        result = true;
+        return false;
     }
 
-    SDL_UnlockMutex(*m_mutex);
+    int peak = m_peakCount.load();
+    while (count > peak && !m_peakCount.compare_exchange_weak(peak, count));
 
-    return result;
+    return true;
 }
 
 Event CEventQueue::GetEvent()
 {
     Event event;
 
-    SDL_LockMutex(*m_mutex);
-
-    if (m_head == m_tail)
-    {
-        event.type = EVENT_NULL;
-    }
+    if (m_queue.Pop(event))
+        m_count.fetch_sub(1);
     else
-    {
-        event = std::move(m_fifo[m_tail++]);
-
-        if (m_tail >= MAX_EVENT_QUEUE)
-            m_tail = 0;
-
-        m_total--;
+        event.type = EVENT_NULL;
 
-    }
+    return event;
+}
 
-    SDL_UnlockMutex(*m_mutex);
+long long CEventQueue::GetDroppedCount() const
+{
+    return m_droppedCount.load();
+}
 
-    return event;
+int CEventQueue::GetPeakCount() const
+{
+    return m_peakCount.load();
 }
@@ -27,11 +27,13 @@
 #include "common/key.h"
 #include "common/make_unique.h"
 
-#include "common/thread/sdl_mutex_wrapper.h"
+#include "common/thread/mpsc_queue.h"
 
 #include "math/point.h"
 #include "math/vector.h"
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 
 /**
@@ -648,6 +650,9 @@ enum EventType
 /**
  * \struct EventData
  * \brief Base class for additional event data
+ *
+ * Event data is small and created for most input events, so it is allocated
+ * from a pool of fixed size blocks instead of the general heap.
  */
 struct EventData
 {
@@ -655,6 +660,11 @@ struct EventData
     {}
 
     virtual std::unique_ptr<EventData> Clone() const = 0;
+
+    //! Allocates a block from the pool, or from the heap if \a size doesn't fit in a block
+    static void* operator new(std::size_t size);
+    //! Returns a block allocated by operator new
+    static void operator delete(void* pointer, std::size_t size);
 };
 
 /**
@@ -908,15 +918,18 @@ std::string ParseEventType(EventType eventType);
  * \brief Global event queue
  *
  * Provides an interface to a global FIFO queue with events (both system- and user-generated).
- * The queue has a fixed maximum size but it should not be a problem.
+ * The queue starts small and grows when needed, up to a maximum size;
+ * events added to a full queue are dropped and counted.
  *
- * This class is thread-safe
+ * Events may be added from any thread without locking, but only one thread may take them out.
  */
 class CEventQueue
 {
 public:
-    //! Constant maximum size of queue
-    static const int MAX_EVENT_QUEUE = 100;
+    //! Initial size of queue
+    static const int INITIAL_EVENT_QUEUE = 128;
+    //! Maximum size of queue
+    static const int MAX_EVENT_QUEUE = 4096;
 
 public:
     //! Object's constructor
@@ -931,10 +944,15 @@ public:
     //! Removes and returns an event from queue front; if queue is empty, returns event of type EVENT_NULL
     Event GetEvent();
 
+    //! Returns the number of events dropped because the queue was full
+    long long GetDroppedCount() const;
+    //! Returns the largest number of events waiting in the queue at once
+    int GetPeakCount() const;
+
 protected:
-    CSDLMutexWrapper m_mutex;
-    Event        m_fifo[MAX_EVENT_QUEUE];
-    int          m_head;
-    int          m_tail;
-    int          m_total;
+    CMPSCQueue<Event>   m_queue;
+    //! Number of events waiting, including places reserved by events being added right now
+    std::atomic<int>    m_count;
+    std::atomic<int>    m_peakCount;
+    std::atomic<long long> m_droppedCount;
 };
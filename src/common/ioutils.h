@@ -26,6 +26,7 @@
 
 
 #include <iostream>
+#include <string>
 
 #include <cstring>
 
@@ -62,7 +63,7 @@ T ReadBinary(std::istream &istr)
     {
         unsigned char byte = 0;
         istr.read(reinterpret_cast<char*>(&byte), 1);
-        value |= byte << (i*8);
+        value |= static_cast<T>(byte) << (i*8);
     }
     return value;
 }
@@ -127,6 +128,40 @@ inline float ReadBinaryFloat(std::istream &istr)
     return u.fValue;
 }
 
+//! Writes an array of binary 32-bit floats to output stream
+/**
+ * Same encoding as WriteBinaryFloat, written with a single call to the stream.
+ */
+inline void WriteBinaryFloats(const float* values, int count, std::ostream &ostr)
+{
+    std::string bytes(count * 4, '\0');
+    for (int i = 0; i < count; ++i)
+    {
+        unsigned int value = 0;
+        memcpy(&value, &values[i], 4);
+        for (int j = 0; j < 4; ++j)
+            bytes[i*4 + j] = static_cast<char>((value >> (j*8)) & 0xFF);
+    }
+    ostr.write(bytes.data(), bytes.size());
+}
+
+//! Reads an array of binary 32-bit floats from input stream
+/**
+ * Same encoding as ReadBinaryFloat, read with a single call to the stream.
+ */
+inline void ReadBinaryFloats(float* values, int count, std::istream &istr)
+{
+    std::string bytes(count * 4, '\0');
+    istr.read(&bytes[0], bytes.size());
+    for (int i = 0; i < count; ++i)
+    {
+        unsigned int value = 0;
+        for (int j = 0; j < 4; ++j)
+            value |= static_cast<unsigned int>(static_cast<unsigned char>(bytes[i*4 + j])) << (j*8);
+        memcpy(&values[i], &value, 4);
+    }
+}
+
 //! Writes a variable binary string to output stream
 /**
  * The string is written by first writing string length
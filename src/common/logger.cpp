@@ -44,6 +44,7 @@ void CLogger::Log(LogLevel type, const char* str, va_list args)
     if (type < m_logLevel)
         return;
 
+    m_mutex.Lock();
     for (FILE* out : m_outputs)
     {
         switch (type)
@@ -72,6 +73,7 @@ void CLogger::Log(LogLevel type, const char* str, va_list args)
         vfprintf(out, str, args2);
         va_end(args2);
     }
+    m_mutex.Unlock();
 }
 
 void CLogger::Trace(const char* str, ...)
@@ -27,6 +27,8 @@
 
 #include "common/singleton.h"
 
+#include "common/thread/sdl_mutex_wrapper.h"
+
 #include <string>
 #include <cstdarg>
 #include <cstdio>
@@ -54,6 +56,7 @@ enum LogLevel
 *
 * @brief Class for loggin information to file or console
 *
+* Messages can be written from any thread, each one is written as a whole.
 */
 class CLogger : public CSingleton<CLogger>
 {
@@ -127,6 +130,8 @@ public:
 private:
     std::vector<FILE*> m_outputs;
     LogLevel m_logLevel;
+    //! Keeps messages of different threads from mixing
+    CSDLMutexWrapper m_mutex;
     void Log(LogLevel type, const char* str, va_list args);
 };
 
@@ -26,6 +26,7 @@
 CSystemUtils* CProfiler::m_systemUtils = nullptr;
 long long CProfiler::m_performanceCounters[PCNT_MAX] = {0};
 long long CProfiler::m_prevPerformanceCounters[PCNT_MAX] = {0};
+std::atomic<long long> CProfiler::m_addedPerformanceCounters[PCNT_MAX];
 std::stack<SystemTimeStamp*> CProfiler::m_runningPerformanceCounters;
 std::stack<PerformanceCounter> CProfiler::m_runningPerformanceCountersType;
 
@@ -71,6 +72,11 @@ float CProfiler::GetPerformanceCounterFraction(PerformanceCounter counter)
     return static_cast<float>(m_prevPerformanceCounters[counter]) / static_cast<float>(m_prevPerformanceCounters[PCNT_ALL]);
 }
 
+void CProfiler::AddPerformanceCounterTime(PerformanceCounter counter, long long time)
+{
+    m_addedPerformanceCounters[counter] += time;
+}
+
 void CProfiler::ResetPerformanceCounters()
 {
     for (int i = 0; i < PCNT_MAX; ++i)
@@ -85,6 +91,7 @@ void CProfiler::SavePerformanceCounters()
 
     for (int i = 0; i < PCNT_MAX; ++i)
     {
+        m_performanceCounters[i] += m_addedPerformanceCounters[i].exchange(0);
         m_prevPerformanceCounters[i] = m_performanceCounters[i];
     }
 }
@@ -22,6 +22,7 @@
 class CSystemUtils;
 struct SystemTimeStamp;
 
+#include <atomic>
 #include <stack>
 
 /**
@@ -49,6 +50,8 @@ enum PerformanceCounter
 
     PCNT_SWAP_BUFFERS,          //! < swapping buffers and vsync
 
+    PCNT_JOBS,                  //! < jobs run by CJobSystem, summed over all threads
+
     PCNT_ALL,                   //! < all counters together
 
     PCNT_MAX
@@ -63,6 +66,8 @@ public:
     static void StopPerformanceCounter(PerformanceCounter counter);
     static long long GetPerformanceCounterTime(PerformanceCounter counter);
     static float GetPerformanceCounterFraction(PerformanceCounter counter);
+    //! Adds time measured by the caller to a counter; unlike other functions, may be called from any thread
+    static void AddPerformanceCounterTime(PerformanceCounter counter, long long time);
 
 private:
     static void ResetPerformanceCounters();
@@ -73,6 +78,8 @@ private:
 
     static long long m_performanceCounters[PCNT_MAX];
     static long long m_prevPerformanceCounters[PCNT_MAX];
+    //! Time added from other threads, moved to m_performanceCounters at the end of frame
+    static std::atomic<long long> m_addedPerformanceCounters[PCNT_MAX];
     static std::stack<SystemTimeStamp*> m_runningPerformanceCounters;
     static std::stack<PerformanceCounter> m_runningPerformanceCountersType;
 };
@@ -27,15 +27,15 @@
 #include <sstream>
 
 CInputStreamBuffer::CInputStreamBuffer(std::size_t bufferSize)
-  : m_bufferSize(bufferSize)
+  : m_bufferSize(bufferSize > 0 ? bufferSize : CResourceManager::GetReadBufferSize())
   , m_file(nullptr)
 {
-    if (bufferSize <= 0)
+    if (m_bufferSize <= 0)
     {
         throw std::runtime_error("File buffer must be larger than 0 bytes");
     }
 
-    m_buffer = MakeUniqueArray<char>(bufferSize);
+    m_buffer = MakeUniqueArray<char>(m_bufferSize);
 }
 
 
@@ -47,35 +47,83 @@ CInputStreamBuffer::~CInputStreamBuffer()
 
 void CInputStreamBuffer::open(const std::string &filename)
 {
-    if (PHYSFS_isInit())
-        m_file = PHYSFS_openRead(CResourceManager::CleanPath(filename).c_str());
+    if (!PHYSFS_isInit())
+        return;
+
+    std::string path = CResourceManager::CleanPath(filename);
+    CResourceCache* cache = CResourceManager::IsCacheablePath(path) ? CResourceManager::GetCache() : nullptr;
+    if (cache != nullptr)
+    {
+        std::shared_ptr<std::string> data = cache->GetFile(path);
+        if (data != nullptr)
+        {
+            SetData(data);
+            return;
+        }
+    }
+
+    m_file = PHYSFS_openRead(path.c_str());
+    if (m_file == nullptr || cache == nullptr)
+        return;
+
+    PHYSFS_sint64 length = PHYSFS_fileLength(m_file);
+    if (length < 0 || !cache->IsCacheable(length))
+        return;
+
+    // Read the whole file at once, the next time it's read from the cache
+    auto data = std::make_shared<std::string>(length, '\0');
+    PHYSFS_sint64 read = length > 0 ? PHYSFS_read(m_file, &(*data)[0], 1, length) : 0;
+    PHYSFS_close(m_file);
+    m_file = nullptr;
+    if (read != length)
+        return;
+
+    cache->AddFile(path, data);
+    SetData(data);
 }
 
 
 void CInputStreamBuffer::close()
 {
-    if (is_open())
+    if (m_file != nullptr)
         PHYSFS_close(m_file);
+    m_file = nullptr;
+    m_data.reset();
+    setg(nullptr, nullptr, nullptr);
 }
 
 
 bool CInputStreamBuffer::is_open()
 {
-    return m_file != nullptr;
+    return m_file != nullptr || m_data != nullptr;
 }
 
 
 std::size_t CInputStreamBuffer::size()
 {
+    if (m_data != nullptr)
+        return m_data->size();
+
     return PHYSFS_fileLength(m_file);
 }
 
 
+void CInputStreamBuffer::SetData(std::shared_ptr<std::string> data)
+{
+    m_data = data;
+    char* begin = &(*m_data)[0];
+    setg(begin, begin, begin + m_data->size());
+}
+
+
 std::streambuf::int_type CInputStreamBuffer::underflow()
 {
     if (gptr() < egptr())
         return traits_type::to_int_type(*gptr());
 
+    if (m_data != nullptr)
+        return traits_type::eof();
+
     if (PHYSFS_eof(m_file))
         return traits_type::eof();
 
@@ -106,6 +154,34 @@ std::streampos CInputStreamBuffer::seekoff(std::streamoff off, std::ios_base::se
 
     std::streamoff new_position{};
 
+    if (m_data != nullptr)
+    {
+        // The whole file is in the buffer
+        switch (way)
+        {
+            case std::ios_base::beg:
+                new_position = off;
+                break;
+
+            case std::ios_base::cur:
+                new_position = off + (gptr() - eback());
+                break;
+
+            case std::ios_base::end:
+                new_position = off + static_cast<off_type>(m_data->size());
+                break;
+
+            default:
+                break;
+        }
+
+        if (new_position < 0 || new_position > static_cast<off_type>(m_data->size()))
+            return pos_type(off_type(-1));
+
+        setg(eback(), eback() + new_position, egptr());
+        return pos_type(new_position);
+    }
+
     switch (way)
     {
         case std::ios_base::beg:
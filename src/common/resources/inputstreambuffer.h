@@ -26,10 +26,18 @@
 
 #include <physfs.h>
 
+/**
+ * \class CInputStreamBuffer
+ * \brief Stream buffer reading a file through PhysFS
+ *
+ * Small files are read whole and kept in the resource cache, see CResourceManager::GetCache();
+ * they are then read from memory when opened again.
+ */
 class CInputStreamBuffer : public std::streambuf
 {
 public:
-    CInputStreamBuffer(std::size_t bufferSize = 512);
+    //! Creates the buffer; size 0 means CResourceManager::GetReadBufferSize()
+    CInputStreamBuffer(std::size_t bufferSize = 0);
     virtual ~CInputStreamBuffer();
 
     CInputStreamBuffer(const CInputStreamBuffer &) = delete;
@@ -46,7 +54,12 @@ private:
     std::streampos seekpos(std::streampos sp, std::ios_base::openmode which) override;
     std::streampos seekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which) override;
 
+    //! Makes the whole content of the file available from memory
+    void SetData(std::shared_ptr<std::string> data);
+
     const std::size_t m_bufferSize;
     PHYSFS_File *m_file;
     std::unique_ptr<char[]> m_buffer;
+    //! Content of the file if it is read from memory
+    std::shared_ptr<std::string> m_data;
 };
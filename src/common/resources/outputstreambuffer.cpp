@@ -49,17 +49,26 @@ void COutputStreamBuffer::open(const std::string &filename, std::ios_base::openm
 {
     if (PHYSFS_isInit())
     {
-        if ( mode == std::ios_base::out ) m_file = PHYSFS_openWrite(CResourceManager::CleanPath(filename).c_str());
-        else if ( mode == std::ios_base::app ) m_file = PHYSFS_openAppend(CResourceManager::CleanPath(filename).c_str());
+        m_filename = CResourceManager::CleanPath(filename);
+        CResourceManager::InvalidateCachedFile(m_filename);
+
+        if ( mode == std::ios_base::out ) m_file = PHYSFS_openWrite(m_filename.c_str());
+        else if ( mode == std::ios_base::app ) m_file = PHYSFS_openAppend(m_filename.c_str());
     }
 }
 
 
 void COutputStreamBuffer::close()
 {
+    if (!is_open())
+        return;
+
     sync();
-    if (is_open())
-        PHYSFS_close(m_file);
+    PHYSFS_close(m_file);
+    m_file = nullptr;
+
+    // The file may have been read while it was written
+    CResourceManager::InvalidateCachedFile(m_filename);
 }
 
 
@@ -51,4 +51,6 @@ private:
 
     PHYSFS_File *m_file;
     std::unique_ptr<char[]> m_buffer;
+    //! Path of the open file, for dropping it from the resource cache
+    std::string m_filename;
 };
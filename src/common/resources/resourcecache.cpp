@@ -0,0 +1,209 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/resources/resourcecache.h"
+
+
+CResourceCache::CResourceCache()
+    : m_maxSize(0),
+      m_maxFileSize(0),
+      m_size(0)
+{
+}
+
+CResourceCache::~CResourceCache()
+{
+}
+
+void CResourceCache::SetLimits(std::size_t maxSize, std::size_t maxFileSize)
+{
+    m_mutex.Lock();
+    m_maxSize = maxSize;
+    m_maxFileSize = maxFileSize;
+    Trim();
+    if (m_maxSize == 0)
+    {
+        m_lists.clear();
+        m_exists.clear();
+    }
+    m_mutex.Unlock();
+}
+
+bool CResourceCache::IsEnabled()
+{
+    m_mutex.Lock();
+    bool enabled = m_maxSize > 0;
+    m_mutex.Unlock();
+    return enabled;
+}
+
+bool CResourceCache::IsCacheable(std::size_t fileSize)
+{
+    m_mutex.Lock();
+    bool cacheable = fileSize <= m_maxFileSize && fileSize <= m_maxSize;
+    m_mutex.Unlock();
+    return cacheable;
+}
+
+std::shared_ptr<std::string> CResourceCache::GetFile(const std::string& path)
+{
+    std::shared_ptr<std::string> data;
+
+    m_mutex.Lock();
+    auto it = m_files.find(path);
+    if (it != m_files.end())
+    {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+        data = it->second.data;
+        m_counters.fileHits++;
+    }
+    else
+    {
+        m_counters.fileMisses++;
+    }
+    m_mutex.Unlock();
+
+    return data;
+}
+
+void CResourceCache::AddFile(const std::string& path, std::shared_ptr<std::string> data)
+{
+    m_mutex.Lock();
+    if (data->size() <= m_maxFileSize && data->size() <= m_maxSize)
+    {
+        auto it = m_files.find(path);
+        if (it != m_files.end())
+        {
+            m_size -= it->second.data->size();
+            m_lru.erase(it->second.lruIt);
+            m_files.erase(it);
+        }
+
+        m_lru.push_front(path);
+        m_files[path] = FileEntry{ data, m_lru.begin() };
+        m_size += data->size();
+        Trim();
+    }
+    m_mutex.Unlock();
+}
+
+bool CResourceCache::GetList(const std::string& key, std::vector<std::string>& list)
+{
+    m_mutex.Lock();
+    auto it = m_lists.find(key);
+    bool found = it != m_lists.end();
+    if (found)
+    {
+        list = it->second;
+        m_counters.listHits++;
+    }
+    else
+    {
+        m_counters.listMisses++;
+    }
+    m_mutex.Unlock();
+    return found;
+}
+
+void CResourceCache::AddList(const std::string& key, const std::vector<std::string>& list)
+{
+    m_mutex.Lock();
+    if (m_maxSize > 0)
+        m_lists[key] = list;
+    m_mutex.Unlock();
+}
+
+bool CResourceCache::GetExists(const std::string& path, bool& exists)
+{
+    m_mutex.Lock();
+    auto it = m_exists.find(path);
+    bool found = it != m_exists.end();
+    if (found)
+    {
+        exists = it->second;
+        m_counters.listHits++;
+    }
+    else
+    {
+        m_counters.listMisses++;
+    }
+    m_mutex.Unlock();
+    return found;
+}
+
+void CResourceCache::AddExists(const std::string& path, bool exists)
+{
+    m_mutex.Lock();
+    if (m_maxSize > 0)
+        m_exists[path] = exists;
+    m_mutex.Unlock();
+}
+
+void CResourceCache::InvalidateFile(const std::string& path)
+{
+    m_mutex.Lock();
+    auto it = m_files.find(path);
+    if (it != m_files.end())
+    {
+        m_size -= it->second.data->size();
+        m_lru.erase(it->second.lruIt);
+        m_files.erase(it);
+    }
+    m_lists.clear();
+    m_exists.clear();
+    m_mutex.Unlock();
+}
+
+void CResourceCache::Clear()
+{
+    m_mutex.Lock();
+    m_files.clear();
+    m_lru.clear();
+    m_size = 0;
+    m_lists.clear();
+    m_exists.clear();
+    m_mutex.Unlock();
+}
+
+ResourceCacheCounters CResourceCache::GetCounters()
+{
+    m_mutex.Lock();
+    ResourceCacheCounters counters = m_counters;
+    m_mutex.Unlock();
+    return counters;
+}
+
+std::size_t CResourceCache::GetSize()
+{
+    m_mutex.Lock();
+    std::size_t size = m_size;
+    m_mutex.Unlock();
+    return size;
+}
+
+void CResourceCache::Trim()
+{
+    while (m_size > m_maxSize && !m_lru.empty())
+    {
+        auto it = m_files.find(m_lru.back());
+        m_size -= it->second.data->size();
+        m_files.erase(it);
+        m_lru.pop_back();
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/resources/resourcecache.h
+ * \brief In-memory cache of files and directory listings - CResourceCache class
+ */
+
+#pragma once
+
+#include "common/thread/sdl_mutex_wrapper.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \struct ResourceCacheCounters
+ * \brief Numbers of lookups in CResourceCache
+ */
+struct ResourceCacheCounters
+{
+    long long fileHits = 0;
+    long long fileMisses = 0;
+    long long listHits = 0;
+    long long listMisses = 0;
+};
+
+/**
+ * \class CResourceCache
+ * \brief Cache in front of PhysFS with contents of small files and results of directory queries
+ *
+ * Files are kept up to a total size, the least recently used ones are dropped
+ * first. Directory listings and results of Exists() have no limit, as they are
+ * small; they are all dropped whenever a file is written or removed. A cache
+ * with size 0 is disabled and keeps nothing.
+ *
+ * Only paths from read-only locations should be added, see CResourceManager::IsCacheablePath().
+ *
+ * All methods can be called from any thread.
+ */
+class CResourceCache
+{
+public:
+    CResourceCache();
+    ~CResourceCache();
+
+    CResourceCache(const CResourceCache&) = delete;
+    CResourceCache& operator=(const CResourceCache&) = delete;
+
+    //! Sets total size of cached files and size of the largest file which is cached, in bytes
+    void        SetLimits(std::size_t maxSize, std::size_t maxFileSize);
+    //! Returns false if the cache was disabled by setting its size to 0
+    bool        IsEnabled();
+    //! Returns true if a file of given size should be cached
+    bool        IsCacheable(std::size_t fileSize);
+
+    //! Returns cached content of a file or nullptr; the content must not be modified
+    std::shared_ptr<std::string> GetFile(const std::string& path);
+    //! Adds content of a file, dropping least recently used files over the limit
+    void        AddFile(const std::string& path, std::shared_ptr<std::string> data);
+
+    //! Finds a cached directory listing or result of Exists(), returns false if there is none
+    bool        GetList(const std::string& key, std::vector<std::string>& list);
+    void        AddList(const std::string& key, const std::vector<std::string>& list);
+    bool        GetExists(const std::string& path, bool& exists);
+    void        AddExists(const std::string& path, bool exists);
+
+    //! Drops given file and all directory queries, after the file was written or removed
+    void        InvalidateFile(const std::string& path);
+    //! Drops everything, after the search path has changed
+    void        Clear();
+
+    ResourceCacheCounters GetCounters();
+    //! Returns total size of cached files in bytes
+    std::size_t GetSize();
+
+private:
+    //! Removes least recently used files until the size is within the limit; called with the mutex locked
+    void        Trim();
+
+private:
+    struct FileEntry
+    {
+        std::shared_ptr<std::string> data;
+        std::list<std::string>::iterator lruIt;
+    };
+
+    CSDLMutexWrapper m_mutex;
+    std::size_t m_maxSize;
+    std::size_t m_maxFileSize;
+    std::size_t m_size;
+    std::unordered_map<std::string, FileEntry> m_files;
+    //! Paths of cached files, most recently used first
+    std::list<std::string> m_lru;
+    std::unordered_map<std::string, std::vector<std::string>> m_lists;
+    std::unordered_map<std::string, bool> m_exists;
+    ResourceCacheCounters m_counters;
+};
@@ -29,11 +29,28 @@
 #include "common/logger.h"
 #include "common/make_unique.h"
 
+#include <algorithm>
+
 #include <physfs.h>
 
+#include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
 
 
+namespace
+{
+
+//! Default limits of the cache, enough for help files and level lists
+const std::size_t DEFAULT_CACHE_SIZE = 16 * 1024 * 1024;
+const std::size_t DEFAULT_CACHE_FILE_SIZE = 256 * 1024;
+
+} // anonymous namespace
+
+
+std::unique_ptr<CResourceCache> CResourceManager::m_cache;
+std::size_t CResourceManager::m_readBufferSize = 512;
+
+
 CResourceManager::CResourceManager(const char *argv0)
 {
     if (!PHYSFS_init(argv0))
@@ -42,11 +59,19 @@ CResourceManager::CResourceManager(const char *argv0)
         assert(false);
     }
     PHYSFS_permitSymbolicLinks(1);
+
+    m_cache = MakeUnique<CResourceCache>();
+    m_cache->SetLimits(DEFAULT_CACHE_SIZE, DEFAULT_CACHE_FILE_SIZE);
 }
 
 
 CResourceManager::~CResourceManager()
 {
+    ResourceCacheCounters counters = GetCacheCounters();
+    GetLogger()->Debug("Resource cache: %lld file hits, %lld file misses, %lld directory hits, %lld directory misses\n",
+                       counters.fileHits, counters.fileMisses, counters.listHits, counters.listMisses);
+    m_cache.reset();
+
     if (PHYSFS_isInit())
     {
         if (!PHYSFS_deinit())
@@ -70,6 +95,7 @@ bool CResourceManager::AddLocation(const std::string &location, bool prepend, co
         return false;
     }
 
+    ClearCache();
     return true;
 }
 
@@ -82,6 +108,7 @@ bool CResourceManager::RemoveLocation(const std::string &location)
         return false;
     }
 
+    ClearCache();
     return true;
 }
 
@@ -110,6 +137,7 @@ bool CResourceManager::SetSaveLocation(const std::string &location)
         return false;
     }
 
+    ClearCache();
     return true;
 }
 
@@ -142,7 +170,16 @@ bool CResourceManager::Exists(const std::string &filename)
 {
     if (PHYSFS_isInit())
     {
-        return PHYSFS_exists(CleanPath(filename).c_str());
+        std::string path = CleanPath(filename);
+        bool exists = false;
+        bool cacheable = IsCacheablePath(path);
+        if (cacheable && m_cache->GetExists(path, exists))
+            return exists;
+
+        exists = PHYSFS_exists(path.c_str());
+        if (cacheable)
+            m_cache->AddExists(path, exists);
+        return exists;
     }
     return false;
 }
@@ -160,6 +197,7 @@ bool CResourceManager::CreateDirectory(const std::string& directory)
 {
     if (PHYSFS_isInit())
     {
+        InvalidateCachedFile(directory);
         return PHYSFS_mkdir(CleanPath(directory).c_str());
     }
     return false;
@@ -172,9 +210,11 @@ bool CResourceManager::RemoveDirectory(const std::string& directory)
         std::string path = CleanPath(directory);
         for (auto file : ListFiles(path))
         {
+            InvalidateCachedFile(path + "/" + file);
             if (PHYSFS_delete((path + "/" + file).c_str()) == 0)
                 return false;
         }
+        InvalidateCachedFile(path);
         return PHYSFS_delete(path.c_str()) != 0;
     }
     return false;
@@ -186,6 +226,11 @@ std::vector<std::string> CResourceManager::ListFiles(const std::string &director
 
     if (PHYSFS_isInit())
     {
+        std::string key = (excludeDirs ? "files:" : "all:") + CleanPath(directory);
+        bool cacheable = IsCacheablePath(CleanPath(directory));
+        if (cacheable && m_cache->GetList(key, result))
+            return result;
+
         char **files = PHYSFS_enumerateFiles(CleanPath(directory).c_str());
 
         for (char **i = files; *i != nullptr; i++)
@@ -199,6 +244,9 @@ std::vector<std::string> CResourceManager::ListFiles(const std::string &director
         }
 
         PHYSFS_freeList(files);
+
+        if (cacheable)
+            m_cache->AddList(key, result);
     }
 
     return result;
@@ -210,6 +258,11 @@ std::vector<std::string> CResourceManager::ListDirectories(const std::string &di
 
     if (PHYSFS_isInit())
     {
+        std::string key = "dirs:" + CleanPath(directory);
+        bool cacheable = IsCacheablePath(CleanPath(directory));
+        if (cacheable && m_cache->GetList(key, result))
+            return result;
+
         char **files = PHYSFS_enumerateFiles(CleanPath(directory).c_str());
 
         for (char **i = files; *i != nullptr; i++)
@@ -222,6 +275,9 @@ std::vector<std::string> CResourceManager::ListDirectories(const std::string &di
         }
 
         PHYSFS_freeList(files);
+
+        if (cacheable)
+            m_cache->AddList(key, result);
     }
 
     return result;
@@ -253,7 +309,62 @@ bool CResourceManager::Remove(const std::string& filename)
 {
     if (PHYSFS_isInit())
     {
+        InvalidateCachedFile(filename);
         return PHYSFS_delete(filename.c_str()) != 0;
     }
     return false;
 }
+
+void CResourceManager::SetCacheLimits(std::size_t maxSize, std::size_t maxFileSize)
+{
+    if (m_cache != nullptr)
+        m_cache->SetLimits(maxSize, maxFileSize);
+}
+
+CResourceCache* CResourceManager::GetCache()
+{
+    return m_cache.get();
+}
+
+bool CResourceManager::IsCacheablePath(const std::string& path)
+{
+    if (m_cache == nullptr || !m_cache->IsEnabled())
+        return false;
+
+    const char* writeDir = PHYSFS_getWriteDir();
+    if (writeDir == nullptr)
+        return true;
+
+    boost::system::error_code error;
+    return !boost::filesystem::exists(boost::filesystem::path(writeDir) / path, error);
+}
+
+void CResourceManager::ClearCache()
+{
+    if (m_cache != nullptr)
+        m_cache->Clear();
+}
+
+void CResourceManager::InvalidateCachedFile(const std::string& filename)
+{
+    if (m_cache != nullptr)
+        m_cache->InvalidateFile(CleanPath(filename));
+}
+
+ResourceCacheCounters CResourceManager::GetCacheCounters()
+{
+    if (m_cache == nullptr)
+        return ResourceCacheCounters();
+
+    return m_cache->GetCounters();
+}
+
+void CResourceManager::SetReadBufferSize(std::size_t size)
+{
+    m_readBufferSize = std::max<std::size_t>(size, 1);
+}
+
+std::size_t CResourceManager::GetReadBufferSize()
+{
+    return m_readBufferSize;
+}
@@ -19,10 +19,12 @@
 
 #pragma once
 
+#include "common/resources/resourcecache.h"
 #include "common/resources/sdl_file_wrapper.h"
 #include "common/resources/sdl_memory_wrapper.h"
 #include "common/resources/sndfile_wrapper.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -74,4 +76,31 @@ public:
 
     //! Remove file
     static bool Remove(const std::string& filename);
+
+    //! Sets total size of files kept in memory and size of the largest file kept, in bytes; 0 disables the cache
+    static void SetCacheLimits(std::size_t maxSize, std::size_t maxFileSize);
+    //! Returns the cache of files and directory listings, nullptr if there is no resource manager
+    static CResourceCache* GetCache();
+    /**
+     * \brief Returns true if results for the path can be cached
+     *
+     * The cache must be enabled and the path can't exist in the save directory,
+     * as it can be changed outside of the game. Other locations are read-only.
+     * This is checked again before each use of cached results.
+     */
+    static bool IsCacheablePath(const std::string& path);
+    //! Drops all cached files and directory listings, after files could change outside of the game
+    static void ClearCache();
+    //! Drops cached content of a file and all directory listings, after the file was written
+    static void InvalidateCachedFile(const std::string& filename);
+    //! Returns numbers of cache hits and misses
+    static ResourceCacheCounters GetCacheCounters();
+
+    //! Sets size of buffers used to read files which are not cached
+    static void SetReadBufferSize(std::size_t size);
+    static std::size_t GetReadBufferSize();
+
+private:
+    static std::unique_ptr<CResourceCache> m_cache;
+    static std::size_t m_readBufferSize;
 };
@@ -38,6 +38,8 @@ public:
     bool IsOpen();
     std::string &GetLastError();
     sf_count_t Read(short int *ptr, sf_count_t items);
+    //! Goes to given frame, returns false if the file can't seek
+    bool Seek(sf_count_t frame);
 
 private:
     static sf_count_t SNDLength(void *data);
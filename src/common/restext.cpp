@@ -724,6 +724,7 @@ void InitializeRestext()
     stringsErr[INFO_LOST]           = TR("<<< Sorry; mission failed >>>");
     stringsErr[INFO_LOSTq]          = TR("<<< Sorry; mission failed >>>");
     stringsErr[INFO_WRITEOK]        = TR("Current mission saved");
+    stringsErr[INFO_WRITEFAILED]    = TR("Saving the mission failed");
     stringsErr[INFO_DELETEMOTHER]   = TR("Alien Queen killed");
     stringsErr[INFO_DELETEANT]      = TR("Ant fatally wounded");
     stringsErr[INFO_DELETEBEE]      = TR("Wasp fatally wounded");
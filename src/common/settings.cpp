@@ -87,11 +87,13 @@ void CSettings::SaveSettings()
     GetConfigFile().SetBoolProperty("Setup", "Autosave", main->GetAutosave());
     GetConfigFile().SetIntProperty("Setup", "AutosaveInterval", main->GetAutosaveInterval());
     GetConfigFile().SetIntProperty("Setup", "AutosaveSlots", main->GetAutosaveSlots());
+    GetConfigFile().SetBoolProperty("Setup", "TextSaves", main->GetTextSaves());
     GetConfigFile().SetBoolProperty("Setup", "ObjectDirty", engine->GetDirty());
     GetConfigFile().SetBoolProperty("Setup", "FogMode", engine->GetFog());
     GetConfigFile().SetBoolProperty("Setup", "LightMode", engine->GetLightMode());
     GetConfigFile().SetIntProperty("Setup", "JoystickIndex", app->GetJoystickEnabled() ? app->GetJoystick().index : -1);
     GetConfigFile().SetFloatProperty("Setup", "ParticleDensity", engine->GetParticleDensity());
+    GetConfigFile().SetIntProperty("Setup", "ParticleBudget", engine->GetParticleBudget());
     GetConfigFile().SetFloatProperty("Setup", "ClippingDistance", engine->GetClippingDistance());
     GetConfigFile().SetBoolProperty("Setup", "EditIndentMode", engine->GetEditIndentMode());
     GetConfigFile().SetIntProperty("Setup", "EditIndentValue", engine->GetEditIndentValue());
@@ -113,6 +115,7 @@ void CSettings::SaveSettings()
 
     // Experimental settings
     GetConfigFile().SetBoolProperty("Experimental", "TerrainShadows", engine->GetTerrainShadows());
+    GetConfigFile().SetBoolProperty("Experimental", "ShadowMappingCache", engine->GetShadowMappingCache());
     GetConfigFile().SetIntProperty("Setup", "VSync", engine->GetVSync());
 
     CInput::GetInstancePointer()->SaveKeyBindings();
@@ -194,6 +197,9 @@ void CSettings::LoadSettings()
     if (GetConfigFile().GetIntProperty("Setup", "AutosaveSlots", iValue))
         main->SetAutosaveSlots(iValue);
 
+    if (GetConfigFile().GetBoolProperty("Setup", "TextSaves", bValue))
+        main->SetTextSaves(bValue);
+
     if (GetConfigFile().GetBoolProperty("Setup", "ObjectDirty", bValue))
         engine->SetDirty(bValue);
 
@@ -229,6 +235,9 @@ void CSettings::LoadSettings()
     if (GetConfigFile().GetFloatProperty("Setup", "ParticleDensity", fValue))
         engine->SetParticleDensity(fValue);
 
+    if (GetConfigFile().GetIntProperty("Setup", "ParticleBudget", iValue))
+        engine->SetParticleBudget(iValue);
+
     if (GetConfigFile().GetFloatProperty("Setup", "ClippingDistance", fValue))
         engine->SetClippingDistance(fValue);
 
@@ -287,6 +296,8 @@ void CSettings::LoadSettings()
 
     if (GetConfigFile().GetBoolProperty("Experimental", "TerrainShadows", bValue))
         engine->SetTerrainShadows(bValue);
+    if (GetConfigFile().GetBoolProperty("Experimental", "ShadowMappingCache", bValue))
+        engine->SetShadowMappingCache(bValue);
     if (GetConfigFile().GetIntProperty("Setup", "VSync", iValue))
     {
         engine->SetVSync(iValue);
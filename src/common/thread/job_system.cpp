@@ -0,0 +1,287 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/thread/job_system.h"
+
+#include "common/make_unique.h"
+#include "common/profiler.h"
+#include "common/stringutils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+
+namespace
+{
+
+//! Job system the current thread works for, if any
+thread_local CJobSystem* t_jobSystem = nullptr;
+//! Index of queue of the current worker thread
+thread_local int t_queueIndex = 0;
+
+} // anonymous namespace
+
+
+CJob::CJob(std::function<void()> func)
+    : m_func(std::move(func)),
+      m_pendingDependencies{1},
+      m_done{false}
+{
+}
+
+bool CJob::IsDone() const
+{
+    return m_done.load();
+}
+
+
+CJobSystem::CJobSystem(int workerCount)
+    : m_queuedJobs{0},
+      m_waitingThreads{0},
+      m_running(true)
+{
+    if (workerCount <= 0)
+        workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+
+    for (int i = 0; i <= workerCount; i++)
+        m_queues.push_back(MakeUnique<JobQueue>());
+
+    for (int i = 1; i <= workerCount; i++)
+    {
+        m_threads.push_back(MakeUnique<CThread>(std::bind(&CJobSystem::Run, this, i),
+                                                StrUtils::Format("Job thread %d", i)));
+        m_threads.back()->Start();
+    }
+}
+
+CJobSystem::~CJobSystem()
+{
+    m_sleepMutex.Lock();
+    m_running = false;
+    m_workCond.Broadcast();
+    m_sleepMutex.Unlock();
+
+    for (auto& thread : m_threads)
+        thread->Join();
+
+    // Continuations queued by the last jobs
+    while (JobHandle job = TakeJob(0))
+        RunJob(job);
+}
+
+int CJobSystem::GetWorkerCount() const
+{
+    return m_threads.size();
+}
+
+JobHandle CJobSystem::Schedule(JobFunction func, const std::vector<JobHandle>& dependencies)
+{
+    JobHandle job(new CJob(std::move(func)));
+
+    for (const JobHandle& dependency : dependencies)
+    {
+        if (dependency == nullptr) continue;
+
+        dependency->m_mutex.Lock();
+        if (!dependency->m_done)
+        {
+            job->m_pendingDependencies++;
+            dependency->m_continuations.push_back(job);
+        }
+        dependency->m_mutex.Unlock();
+    }
+
+    if (job->m_pendingDependencies.fetch_sub(1) == 1)
+        Enqueue(job);
+
+    return job;
+}
+
+JobHandle CJobSystem::Then(const JobHandle& job, JobFunction func)
+{
+    return Schedule(std::move(func), { job });
+}
+
+void CJobSystem::Wait(const JobHandle& job)
+{
+    if (job == nullptr) return;
+
+    int index = GetCurrentIndex();
+    while (!job->IsDone())
+    {
+        if (JobHandle other = TakeJob(index))
+        {
+            RunJob(other);
+            continue;
+        }
+
+        m_sleepMutex.Lock();
+        m_waitingThreads++;
+        while (!job->IsDone() && m_queuedJobs.load() <= 0)
+            m_waitCond.Wait(*m_sleepMutex);
+        m_waitingThreads--;
+        m_sleepMutex.Unlock();
+    }
+}
+
+void CJobSystem::ParallelFor(int count, int chunkSize, const RangeFunction& func)
+{
+    if (count <= 0) return;
+
+    int chunkCount = (count + chunkSize - 1) / chunkSize;
+    if (chunkCount == 1)
+    {
+        func(0, count);
+        return;
+    }
+
+    std::atomic<int> nextFirst{0};
+    auto runChunks = [&]()
+    {
+        int first;
+        while ((first = nextFirst.fetch_add(chunkSize)) < count)
+            func(first, std::min(first + chunkSize, count));
+    };
+
+    std::vector<JobHandle> jobs;
+    int helperCount = std::min(chunkCount - 1, GetWorkerCount());
+    for (int i = 0; i < helperCount; i++)
+        jobs.push_back(Schedule(runChunks));
+
+    runChunks();
+
+    for (const JobHandle& job : jobs)
+        Wait(job);
+}
+
+void CJobSystem::Run(int index)
+{
+    t_jobSystem = this;
+    t_queueIndex = index;
+
+    while (true)
+    {
+        if (JobHandle job = TakeJob(index))
+        {
+            RunJob(job);
+            continue;
+        }
+
+        m_sleepMutex.Lock();
+        while (m_running && m_queuedJobs.load() <= 0)
+            m_workCond.Wait(*m_sleepMutex);
+        bool running = m_running || m_queuedJobs.load() > 0;
+        m_sleepMutex.Unlock();
+
+        if (!running) break;
+    }
+
+    t_jobSystem = nullptr;
+}
+
+void CJobSystem::Enqueue(const JobHandle& job)
+{
+    JobQueue& queue = *m_queues[GetCurrentIndex()];
+    queue.mutex.Lock();
+    queue.jobs.push_back(job);
+    queue.mutex.Unlock();
+
+    m_sleepMutex.Lock();
+    m_queuedJobs++;
+    m_workCond.Signal();
+    if (m_waitingThreads.load() > 0)
+        m_waitCond.Broadcast();
+    m_sleepMutex.Unlock();
+}
+
+JobHandle CJobSystem::TakeJob(int index)
+{
+    JobHandle job;
+    int queueCount = m_queues.size();
+
+    // Own queue first, newest job, as its data is most likely in the cache
+    if (index != 0)
+    {
+        JobQueue& queue = *m_queues[index];
+        queue.mutex.Lock();
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        }
+        queue.mutex.Unlock();
+    }
+
+    // Then the shared queue and other workers, oldest job
+    for (int i = 0; i < queueCount && job == nullptr; i++)
+    {
+        int other = (index + i) % queueCount;
+        if (other == index && index != 0) continue;
+
+        JobQueue& queue = *m_queues[other];
+        queue.mutex.Lock();
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+        queue.mutex.Unlock();
+    }
+
+    if (job != nullptr)
+        m_queuedJobs--;
+
+    return job;
+}
+
+void CJobSystem::RunJob(const JobHandle& job)
+{
+    auto start = std::chrono::steady_clock::now();
+    job->m_func();
+    auto end = std::chrono::steady_clock::now();
+    CProfiler::AddPerformanceCounterTime(PCNT_JOBS, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+    // Release captured data as soon as possible
+    job->m_func = nullptr;
+
+    std::vector<JobHandle> continuations;
+    job->m_mutex.Lock();
+    job->m_done = true;
+    continuations.swap(job->m_continuations);
+    job->m_mutex.Unlock();
+
+    for (const JobHandle& continuation : continuations)
+    {
+        if (continuation->m_pendingDependencies.fetch_sub(1) == 1)
+            Enqueue(continuation);
+    }
+
+    if (m_waitingThreads.load() > 0)
+    {
+        m_sleepMutex.Lock();
+        m_waitCond.Broadcast();
+        m_sleepMutex.Unlock();
+    }
+}
+
+int CJobSystem::GetCurrentIndex() const
+{
+    return t_jobSystem == this ? t_queueIndex : 0;
+}
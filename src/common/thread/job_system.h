@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/thread/job_system.h
+ * \brief Threads running jobs with dependencies - CJobSystem class
+ */
+
+#pragma once
+
+#include "common/singleton.h"
+
+#include "common/thread/sdl_cond_wrapper.h"
+#include "common/thread/sdl_mutex_wrapper.h"
+#include "common/thread/thread.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CJob;
+using JobHandle = std::shared_ptr<CJob>;
+
+/**
+ * \class CJob
+ * \brief Function scheduled in CJobSystem, see CJobSystem::Schedule()
+ */
+class CJob
+{
+public:
+    //! Checks if the function has finished
+    bool IsDone() const;
+
+    CJob(const CJob&) = delete;
+    CJob& operator=(const CJob&) = delete;
+
+private:
+    friend class CJobSystem;
+
+    explicit CJob(std::function<void()> func);
+
+    std::function<void()> m_func;
+    //! Unfinished dependencies, plus one while the job is being scheduled
+    std::atomic<int> m_pendingDependencies;
+    std::atomic<bool> m_done;
+    //! Guards m_continuations and setting m_done
+    CSDLMutexWrapper m_mutex;
+    //! Jobs depending on this one
+    std::vector<JobHandle> m_continuations;
+};
+
+/**
+ * \class CJobSystem
+ * \brief Threads which run small jobs, sized to the number of processors
+ *
+ * Every worker thread has its own queue of jobs. A worker takes the newest job
+ * from its own queue and, when it is empty, steals the oldest job of another worker.
+ * Jobs scheduled from other threads go to a shared queue.
+ *
+ * A job may depend on other jobs; it is queued when all of them have finished.
+ * Threads waiting for a job run other jobs in the meantime.
+ *
+ * Time spent in jobs is added to the PCNT_JOBS performance counter.
+ */
+class CJobSystem : public CSingleton<CJobSystem>
+{
+public:
+    using JobFunction = std::function<void()>;
+    using RangeFunction = std::function<void(int first, int last)>;
+
+public:
+    //! Creates \a workerCount worker threads; 0 means one less than the number of processors, but at least one
+    explicit CJobSystem(int workerCount = 0);
+    //! Runs all scheduled jobs and stops the workers
+    ~CJobSystem();
+
+    //! Returns the number of worker threads
+    int         GetWorkerCount() const;
+
+    //! Schedules \a func to run on any thread after all \a dependencies have finished
+    JobHandle   Schedule(JobFunction func, const std::vector<JobHandle>& dependencies = {});
+    //! Schedules \a func to run after \a job has finished
+    JobHandle   Then(const JobHandle& job, JobFunction func);
+
+    //! Waits until \a job has finished, running other jobs meanwhile
+    void        Wait(const JobHandle& job);
+
+    /**
+     * \brief Calls \a func for chunks of range 0 .. \a count-1 and waits until all are done
+     *
+     * Chunks run on the calling thread and on the workers,
+     * so \a func must not touch anything shared with other chunks.
+     */
+    void        ParallelFor(int count, int chunkSize, const RangeFunction& func);
+
+    CJobSystem(const CJobSystem&) = delete;
+    CJobSystem& operator=(const CJobSystem&) = delete;
+
+private:
+    //! Jobs of one worker or the shared queue, index 0
+    struct JobQueue
+    {
+        CSDLMutexWrapper mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    //! Main loop of worker with queue \a index
+    void        Run(int index);
+    //! Adds a job whose dependencies are done to the queue of the current thread
+    void        Enqueue(const JobHandle& job);
+    //! Takes a job for the thread with queue \a index, stealing from other queues if needed
+    JobHandle   TakeJob(int index);
+    //! Runs a job and queues its continuations
+    void        RunJob(const JobHandle& job);
+    //! Returns the queue index of the calling thread, 0 for threads other than workers
+    int         GetCurrentIndex() const;
+
+private:
+    std::vector<std::unique_ptr<JobQueue>> m_queues;
+    std::vector<std::unique_ptr<CThread>> m_threads;
+
+    //! Number of jobs in all queues
+    std::atomic<int> m_queuedJobs;
+    //! Number of threads sleeping in Wait()
+    std::atomic<int> m_waitingThreads;
+    bool m_running;
+
+    CSDLMutexWrapper m_sleepMutex;
+    //! Signalled when a job is queued
+    CSDLCondWrapper m_workCond;
+    //! Broadcast when a job is queued or finished while threads sleep in Wait()
+    CSDLCondWrapper m_waitCond;
+};
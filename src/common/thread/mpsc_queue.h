@@ -0,0 +1,256 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file common/thread/mpsc_queue.h
+ * \brief Lock-free queue with many producers and one consumer - CMPSCQueue class
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <thread>
+
+/**
+ * \class CMPSCQueue
+ * \brief FIFO queue which any thread can push to and one thread pops from
+ *
+ * Values are kept in a chain of rings of growing size. Producers claim slots
+ * of the newest ring with atomic operations only; when it is full, the first
+ * of them to notice adds a ring twice as large, until \a maxCapacity is reached.
+ * The consumer drains older rings before moving on to newer ones, so values
+ * pushed by one thread are popped in the same order.
+ *
+ * Rings left behind by the consumer are not reused, but they are kept until
+ * the queue is destroyed, as producers may still be looking at them.
+ * All of them together take at most twice the maximum capacity.
+ */
+template<typename T>
+class CMPSCQueue
+{
+public:
+    //! Creates a queue; capacities are rounded up to powers of two
+    CMPSCQueue(std::size_t initialCapacity, std::size_t maxCapacity)
+        : m_maxCapacity(RoundUpToPowerOfTwo(maxCapacity))
+    {
+        m_firstSegment = new Segment(std::min(RoundUpToPowerOfTwo(initialCapacity), m_maxCapacity));
+        m_producerSegment.store(m_firstSegment);
+        m_consumerSegment = m_firstSegment;
+    }
+
+    ~CMPSCQueue()
+    {
+        Segment* segment = m_firstSegment;
+        while (segment != nullptr)
+        {
+            Segment* next = segment->next.load();
+            delete segment;
+            segment = next;
+        }
+    }
+
+    CMPSCQueue(const CMPSCQueue&) = delete;
+    CMPSCQueue& operator=(const CMPSCQueue&) = delete;
+
+    /**
+     * \brief Adds a value to the queue; may be called from any thread
+     * \return false if the queue is full at its maximum capacity, \a value is left untouched then
+     */
+    bool Push(T&& value)
+    {
+        Segment* segment = m_producerSegment.load(std::memory_order_acquire);
+        while (true)
+        {
+            if (segment->TryPush(value))
+                return true;
+
+            Segment* next = segment->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+            {
+                std::size_t capacity = segment->mask + 1;
+                if (capacity >= m_maxCapacity)
+                    return false;
+
+                Segment* newSegment = new Segment(capacity * 2);
+                if (segment->next.compare_exchange_strong(next, newSegment, std::memory_order_acq_rel))
+                    next = newSegment;
+                else
+                    delete newSegment;  // another producer was faster, next is its ring
+            }
+
+            Segment* expected = segment;
+            m_producerSegment.compare_exchange_strong(expected, next, std::memory_order_acq_rel);
+            segment = next;
+        }
+    }
+
+    /**
+     * \brief Removes the value at the front of the queue; may be called only from the consumer thread
+     * \return false if there is no value ready
+     */
+    bool Pop(T& value)
+    {
+        while (true)
+        {
+            Segment* segment = m_consumerSegment;
+            if (segment->TryPop(value))
+                return true;
+
+            Segment* next = segment->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return false;
+
+            // Producers moved on; close the ring, then wait for values whose slots were already claimed
+            if (!segment->closed)
+            {
+                segment->closedEnd = segment->enqueuePos.fetch_or(CLOSED, std::memory_order_acq_rel);
+                segment->closed = true;
+            }
+            if (segment->dequeuePos != segment->closedEnd)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            m_consumerSegment = next;
+        }
+    }
+
+    //! Checks if there is no value ready to pop; may be called only from the consumer thread
+    bool IsEmpty() const
+    {
+        for (Segment* segment = m_consumerSegment; segment != nullptr; segment = segment->next.load(std::memory_order_acquire))
+        {
+            if (segment->IsReadable())
+                return false;
+        }
+        return true;
+    }
+
+    //! Returns the capacity of the ring producers currently write to
+    std::size_t GetCapacity() const
+    {
+        return m_producerSegment.load(std::memory_order_acquire)->mask + 1;
+    }
+
+private:
+    //! Bit of Segment::enqueuePos set when the consumer closed the ring
+    static const std::size_t CLOSED = ~(std::numeric_limits<std::size_t>::max() >> 1);
+
+    struct Cell
+    {
+        //! Position the cell is ready to be written at, or that position + 1 when it holds a value
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    //! Bounded ring of cells with sequence numbers
+    struct Segment
+    {
+        explicit Segment(std::size_t capacity)
+            : cells(new Cell[capacity]),
+              mask(capacity - 1)
+        {
+            for (std::size_t i = 0; i < capacity; i++)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        bool TryPush(T& value)
+        {
+            std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            while ((pos & CLOSED) == 0)
+            {
+                Cell& cell = cells[pos & mask];
+                std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                if (sequence == pos)
+                {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = std::move(value);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (sequence < pos)
+                {
+                    return false;  // full
+                }
+                else
+                {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            return false;
+        }
+
+        bool TryPop(T& value)
+        {
+            if (!IsReadable())
+                return false;
+
+            Cell& cell = cells[dequeuePos & mask];
+            value = std::move(cell.value);
+            cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+            dequeuePos++;
+            return true;
+        }
+
+        bool IsReadable() const
+        {
+            return cells[dequeuePos & mask].sequence.load(std::memory_order_acquire) == dequeuePos + 1;
+        }
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t mask;
+        //! Next position to write, shared by producers
+        std::atomic<std::size_t> enqueuePos{0};
+        //! Newer ring, set once by the producer which added it
+        std::atomic<Segment*> next{nullptr};
+
+        //! Next position to read, used only by the consumer
+        std::size_t dequeuePos = 0;
+        //! Set by the consumer when it stops producers from writing to this ring
+        bool closed = false;
+        //! Position after the last value written before closing
+        std::size_t closedEnd = 0;
+    };
+
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result *= 2;
+        return result;
+    }
+
+    const std::size_t m_maxCapacity;
+    //! Oldest ring, owning the chain
+    Segment* m_firstSegment;
+    //! Newest ring known to producers
+    std::atomic<Segment*> m_producerSegment;
+    //! Ring the consumer reads from
+    Segment* m_consumerSegment;
+};
+
+template<typename T>
+const std::size_t CMPSCQueue<T>::CLOSED;
@@ -52,6 +52,11 @@ public:
         SDL_CondSignal(m_cond);
     }
 
+    void Broadcast()
+    {
+        SDL_CondBroadcast(m_cond);
+    }
+
     void Wait(SDL_mutex* mutex)
     {
         SDL_CondWait(m_cond, mutex);
@@ -50,6 +50,12 @@ public:
         SDL_LockMutex(m_mutex);
     }
 
+    //! Locks the mutex if it isn't locked by another thread, returns true if locked
+    bool TryLock()
+    {
+        return SDL_TryLockMutex(m_mutex) == 0;
+    }
+
     void Unlock()
     {
         SDL_UnlockMutex(m_mutex);
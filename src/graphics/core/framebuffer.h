@@ -109,6 +109,9 @@ public:
 
     //! Copies content of color buffer to screen
     virtual void CopyToScreen(int fromX, int fromY, int fromWidth, int fromHeight, int toX, int toY, int toWidth, int toHeight) = 0;
+
+    //! Copies content of depth buffer to another framebuffer with the same depth format
+    virtual void CopyDepthTo(CFramebuffer* target) = 0;
 };
 
 
@@ -161,6 +164,9 @@ public:
 
     //! Copies content of color buffer to screen
     void CopyToScreen(int fromX, int fromY, int fromWidth, int fromHeight, int toX, int toY, int toWidth, int toHeight) override;
+
+    //! Copies content of depth buffer to another framebuffer with the same depth format
+    void CopyDepthTo(CFramebuffer* target) override;
 };
 
 } // end of Gfx
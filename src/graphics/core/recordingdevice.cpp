@@ -0,0 +1,683 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "graphics/core/recordingdevice.h"
+
+#include "common/image.h"
+#include "common/logger.h"
+#include "common/make_unique.h"
+
+#include "graphics/core/framebuffer.h"
+
+#include <SDL.h>
+
+#include <cstring>
+#include <sstream>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+namespace
+{
+
+/**
+ * \class CRecordingFramebuffer
+ * \brief Offscreen framebuffer of CRecordingDevice; only counts binds
+ *
+ * Texture attachments get texture IDs like textures of the device, so that
+ * the engine can use them as it would with a real device.
+ */
+class CRecordingFramebuffer : public CFramebuffer
+{
+public:
+    CRecordingFramebuffer(CRecordingDevice* device, const std::string& name, const FramebufferParams& params,
+                          int colorTexture, int depthTexture)
+        : m_device(device), m_name(name), m_params(params),
+          m_colorTexture(colorTexture), m_depthTexture(depthTexture)
+    {}
+
+    bool Create() override { return true; }
+    void Destroy() override {}
+    bool IsDefault() override { return false; }
+    int GetWidth() override { return m_params.width; }
+    int GetHeight() override { return m_params.height; }
+    int GetDepth() override { return m_params.depth; }
+    int GetSamples() override { return m_params.samples; }
+    int GetColorTexture() override { return m_colorTexture; }
+    int GetDepthTexture() override { return m_depthTexture; }
+
+    void Bind() override
+    {
+        m_device->RecordFramebufferBind(m_name);
+    }
+
+    void Unbind() override
+    {
+        m_device->RecordFramebufferBind("default");
+    }
+
+    void CopyToScreen(int fromX, int fromY, int fromWidth, int fromHeight, int toX, int toY, int toWidth, int toHeight) override {}
+    void CopyDepthTo(CFramebuffer* target) override {}
+
+private:
+    CRecordingDevice* m_device;
+    std::string m_name;
+    FramebufferParams m_params;
+    int m_colorTexture;
+    int m_depthTexture;
+};
+
+/**
+ * \class CRecordingFrameBufferPixels
+ * \brief Zero-filled pixel buffer returned by CRecordingDevice
+ */
+class CRecordingFrameBufferPixels : public CFrameBufferPixels
+{
+public:
+    explicit CRecordingFrameBufferPixels(std::size_t size)
+        : m_pixels(MakeUniqueArray<unsigned char>(size))
+    {
+        memset(m_pixels.get(), 0, size);
+    }
+
+    void* GetPixelsData() override
+    {
+        return static_cast<void*>(m_pixels.get());
+    }
+
+private:
+    std::unique_ptr<unsigned char[]> m_pixels;
+};
+
+bool SphereInPlane(const Math::Vector& normal, float originPlane, const Math::Vector& center, float radius)
+{
+    float distance = originPlane + Math::DotProduct(normal, center);
+    return distance >= -radius;
+}
+
+} // anonymous namespace
+
+
+void RecordingDeviceStats::Add(const RecordingDeviceStats& other)
+{
+    frames += other.frames;
+    drawCalls += other.drawCalls;
+    vertices += other.vertices;
+    stateChanges += other.stateChanges;
+    redundantStateChanges += other.redundantStateChanges;
+    textureBinds += other.textureBinds;
+    textureUploads += other.textureUploads;
+    bufferUploads += other.bufferUploads;
+    bufferUploadVertices += other.bufferUploadVertices;
+    framebufferBinds += other.framebufferBinds;
+}
+
+std::string RecordingDeviceStats::ToString() const
+{
+    std::stringstream str;
+    str << "frames: " << frames
+        << ", draw calls: " << drawCalls
+        << ", vertices: " << vertices
+        << ", state changes: " << stateChanges
+        << " (" << redundantStateChanges << " redundant)"
+        << ", texture binds: " << textureBinds
+        << ", texture uploads: " << textureUploads
+        << ", buffer uploads: " << bufferUploads
+        << " (" << bufferUploadVertices << " vertices)"
+        << ", framebuffer binds: " << framebufferBinds;
+    return str.str();
+}
+
+
+CRecordingDevice::CRecordingDevice(const DeviceConfig &config)
+    : m_config(config)
+{
+}
+
+CRecordingDevice::~CRecordingDevice()
+{
+}
+
+const RecordingDeviceStats& CRecordingDevice::GetFrameStats() const
+{
+    return m_frameStats;
+}
+
+const RecordingDeviceStats& CRecordingDevice::GetTotalStats() const
+{
+    return m_totalStats;
+}
+
+void CRecordingDevice::RecordDraw(const char* what, PrimitiveType type, int vertexCount)
+{
+    m_currentStats.drawCalls++;
+    m_currentStats.vertices += vertexCount;
+    GetLogger()->Trace("%s: primitive %d, %d vertices\n", what, static_cast<int>(type), vertexCount);
+}
+
+void CRecordingDevice::RecordState(const char* what)
+{
+    m_currentStats.stateChanges++;
+    GetLogger()->Trace("%s\n", what);
+}
+
+unsigned int CRecordingDevice::RecordBufferUpload(unsigned int bufferId, PrimitiveType type, int vertexCount)
+{
+    if (bufferId == 0)
+        bufferId = m_nextBufferId++;
+
+    m_staticBuffers[bufferId] = vertexCount;
+    m_currentStats.bufferUploads++;
+    m_currentStats.bufferUploadVertices += vertexCount;
+    GetLogger()->Trace("Static buffer %u upload: primitive %d, %d vertices\n", bufferId, static_cast<int>(type), vertexCount);
+    return bufferId;
+}
+
+void CRecordingDevice::RecordFramebufferBind(const std::string& name)
+{
+    m_currentStats.framebufferBinds++;
+    GetLogger()->Trace("Bind framebuffer '%s'\n", name.c_str());
+}
+
+void CRecordingDevice::DebugHook()
+{
+}
+
+void CRecordingDevice::DebugLights()
+{
+}
+
+std::string CRecordingDevice::GetName()
+{
+    return std::string("Recording Device");
+}
+
+bool CRecordingDevice::Create()
+{
+    GetLogger()->Info("Creating recording device\n");
+
+    FramebufferParams params;
+    params.width = m_config.size.x;
+    params.height = m_config.size.y;
+    params.depth = m_config.depthSize;
+    m_framebuffers["default"] = MakeUnique<CDefaultFramebuffer>(params);
+
+    return true;
+}
+
+void CRecordingDevice::Destroy()
+{
+    m_totalStats.Add(m_currentStats);
+    m_currentStats = RecordingDeviceStats();
+    m_framebuffers.clear();
+    m_staticBuffers.clear();
+
+    GetLogger()->Info("Recording device totals: %s\n", m_totalStats.ToString().c_str());
+}
+
+void CRecordingDevice::ConfigChanged(const DeviceConfig &newConfig)
+{
+    m_config = newConfig;
+
+    FramebufferParams params;
+    params.width = m_config.size.x;
+    params.height = m_config.size.y;
+    params.depth = m_config.depthSize;
+    m_framebuffers["default"] = MakeUnique<CDefaultFramebuffer>(params);
+}
+
+void CRecordingDevice::BeginScene()
+{
+    // Work done between frames (e.g. loading) only counts towards totals
+    m_totalStats.Add(m_currentStats);
+    m_currentStats = RecordingDeviceStats();
+}
+
+void CRecordingDevice::EndScene()
+{
+    m_currentStats.frames = 1;
+    m_frameStats = m_currentStats;
+    m_totalStats.Add(m_currentStats);
+    m_currentStats = RecordingDeviceStats();
+
+    GetLogger()->Debug("Recorded frame %d: %s\n", m_totalStats.frames, m_frameStats.ToString().c_str());
+}
+
+void CRecordingDevice::Clear()
+{
+    RecordState("Clear");
+}
+
+void CRecordingDevice::SetRenderMode(RenderMode mode)
+{
+    RecordState("SetRenderMode");
+}
+
+void CRecordingDevice::SetTransform(TransformType type, const Math::Matrix &matrix)
+{
+    if (type == TRANSFORM_WORLD)
+    {
+        m_worldMat = matrix;
+    }
+    else if (type == TRANSFORM_VIEW)
+    {
+        // Same z flip as in OpenGL devices
+        Math::Matrix scale;
+        scale.Set(3, 3, -1.0f);
+        m_viewMat = Math::MultiplyMatrices(scale, matrix);
+    }
+    else if (type == TRANSFORM_PROJECTION)
+    {
+        m_projectionMat = matrix;
+    }
+
+    m_combinedMatrix = Math::MultiplyMatrices(m_projectionMat, Math::MultiplyMatrices(m_viewMat, m_worldMat));
+
+    RecordState("SetTransform");
+}
+
+void CRecordingDevice::SetMaterial(const Material &material)
+{
+    RecordState("SetMaterial");
+}
+
+int CRecordingDevice::GetMaxLightCount()
+{
+    return 8;
+}
+
+void CRecordingDevice::SetLight(int index, const Light &light)
+{
+    RecordState("SetLight");
+}
+
+void CRecordingDevice::SetLightEnabled(int index, bool enabled)
+{
+    RecordState("SetLightEnabled");
+}
+
+Texture CRecordingDevice::CreateTexture(CImage *image, const TextureCreateParams &params)
+{
+    ImageData* data = image->GetData();
+    if (data == nullptr)
+        return Texture();
+
+    return CreateTexture(data, params);
+}
+
+Texture CRecordingDevice::CreateTexture(ImageData *data, const TextureCreateParams &params)
+{
+    Texture result;
+    if (data == nullptr || data->surface == nullptr)
+        return result;
+
+    result.id = m_nextTextureId++;
+    result.size.x = data->surface->w;
+    result.size.y = data->surface->h;
+    result.originalSize = result.size;
+    result.alpha = data->surface->format->BytesPerPixel == 4;
+
+    m_currentStats.textureUploads++;
+    GetLogger()->Trace("Create texture %u: %dx%d\n", result.id, result.size.x, result.size.y);
+
+    return result;
+}
+
+Texture CRecordingDevice::CreateDepthTexture(int width, int height, int depth)
+{
+    Texture result;
+    result.id = m_nextTextureId++;
+    result.size.x = width;
+    result.size.y = height;
+    result.originalSize = result.size;
+
+    m_currentStats.textureUploads++;
+    GetLogger()->Trace("Create depth texture %u: %dx%d\n", result.id, width, height);
+
+    return result;
+}
+
+void CRecordingDevice::UpdateTexture(const Texture& texture, Math::IntPoint offset, ImageData* data, TexImgFormat format)
+{
+    m_currentStats.textureUploads++;
+    GetLogger()->Trace("Update texture %u\n", texture.id);
+}
+
+void CRecordingDevice::DestroyTexture(const Texture &texture)
+{
+}
+
+void CRecordingDevice::DestroyAllTextures()
+{
+}
+
+int CRecordingDevice::GetMaxTextureStageCount()
+{
+    return 3;
+}
+
+void CRecordingDevice::SetTexture(int index, const Texture &texture)
+{
+    SetTexture(index, texture.id);
+}
+
+void CRecordingDevice::SetTexture(int index, unsigned int textureId)
+{
+    m_currentStats.textureBinds++;
+    GetLogger()->Trace("Bind texture %u to stage %d\n", textureId, index);
+}
+
+void CRecordingDevice::SetTextureEnabled(int index, bool enabled)
+{
+    RecordState("SetTextureEnabled");
+}
+
+void CRecordingDevice::SetTextureStageParams(int index, const TextureStageParams &params)
+{
+    RecordState("SetTextureStageParams");
+}
+
+void CRecordingDevice::SetTextureStageWrap(int index, Gfx::TexWrapMode wrapS, Gfx::TexWrapMode wrapT)
+{
+    RecordState("SetTextureStageWrap");
+}
+
+void CRecordingDevice::DrawPrimitive(PrimitiveType type, const Vertex* vertices, int vertexCount, Color color)
+{
+    RecordDraw("DrawPrimitive", type, vertexCount);
+}
+
+void CRecordingDevice::DrawPrimitive(PrimitiveType type, const VertexTex2* vertices, int vertexCount, Color color)
+{
+    RecordDraw("DrawPrimitive", type, vertexCount);
+}
+
+void CRecordingDevice::DrawPrimitive(PrimitiveType type, const VertexCol* vertices, int vertexCount)
+{
+    RecordDraw("DrawPrimitive", type, vertexCount);
+}
+
+void CRecordingDevice::DrawPrimitives(PrimitiveType type, const Vertex *vertices,
+    int first[], int count[], int drawCount, Color color)
+{
+    for (int i = 0; i < drawCount; ++i)
+        RecordDraw("DrawPrimitives", type, count[i]);
+}
+
+void CRecordingDevice::DrawPrimitives(PrimitiveType type, const VertexTex2 *vertices,
+    int first[], int count[], int drawCount, Color color)
+{
+    for (int i = 0; i < drawCount; ++i)
+        RecordDraw("DrawPrimitives", type, count[i]);
+}
+
+void CRecordingDevice::DrawPrimitives(PrimitiveType type, const VertexCol *vertices,
+    int first[], int count[], int drawCount)
+{
+    for (int i = 0; i < drawCount; ++i)
+        RecordDraw("DrawPrimitives", type, count[i]);
+}
+
+unsigned int CRecordingDevice::CreateStaticBuffer(PrimitiveType primitiveType, const Vertex* vertices, int vertexCount)
+{
+    return RecordBufferUpload(0, primitiveType, vertexCount);
+}
+
+unsigned int CRecordingDevice::CreateStaticBuffer(PrimitiveType primitiveType, const VertexTex2* vertices, int vertexCount)
+{
+    return RecordBufferUpload(0, primitiveType, vertexCount);
+}
+
+unsigned int CRecordingDevice::CreateStaticBuffer(PrimitiveType primitiveType, const VertexCol* vertices, int vertexCount)
+{
+    return RecordBufferUpload(0, primitiveType, vertexCount);
+}
+
+void CRecordingDevice::UpdateStaticBuffer(unsigned int bufferId, PrimitiveType primitiveType, const Vertex* vertices, int vertexCount)
+{
+    RecordBufferUpload(bufferId, primitiveType, vertexCount);
+}
+
+void CRecordingDevice::UpdateStaticBuffer(unsigned int bufferId, PrimitiveType primitiveType, const VertexTex2* vertices, int vertexCount)
+{
+    RecordBufferUpload(bufferId, primitiveType, vertexCount);
+}
+
+void CRecordingDevice::UpdateStaticBuffer(unsigned int bufferId, PrimitiveType primitiveType, const VertexCol* vertices, int vertexCount)
+{
+    RecordBufferUpload(bufferId, primitiveType, vertexCount);
+}
+
+void CRecordingDevice::DrawStaticBuffer(unsigned int bufferId)
+{
+    auto it = m_staticBuffers.find(bufferId);
+    if (it == m_staticBuffers.end())
+        return;
+
+    m_currentStats.drawCalls++;
+    m_currentStats.vertices += it->second;
+    GetLogger()->Trace("DrawStaticBuffer: buffer %u, %d vertices\n", bufferId, it->second);
+}
+
+void CRecordingDevice::DestroyStaticBuffer(unsigned int bufferId)
+{
+    m_staticBuffers.erase(bufferId);
+}
+
+int CRecordingDevice::ComputeSphereVisibility(const Math::Vector &center, float radius)
+{
+    // Frustum planes extracted in the same way as in OpenGL devices
+    Math::Matrix &m = m_combinedMatrix;
+
+    const int planeRows[6] = { 1, 1, 2, 2, 3, 3 };
+    const float planeSigns[6] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+    const int planeFlags[6] =
+    {
+        FRUSTUM_PLANE_LEFT, FRUSTUM_PLANE_RIGHT,
+        FRUSTUM_PLANE_BOTTOM, FRUSTUM_PLANE_TOP,
+        FRUSTUM_PLANE_FRONT, FRUSTUM_PLANE_BACK
+    };
+
+    int result = 0;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        int row = planeRows[i];
+        float sign = planeSigns[i];
+
+        Math::Vector normal;
+        normal.x = m.Get(4, 1) + sign * m.Get(row, 1);
+        normal.y = m.Get(4, 2) + sign * m.Get(row, 2);
+        normal.z = m.Get(4, 3) + sign * m.Get(row, 3);
+        float length = normal.Length();
+        if (length == 0.0f)
+        {
+            result |= planeFlags[i];
+            continue;
+        }
+        normal.Normalize();
+        float originPlane = (m.Get(4, 4) + sign * m.Get(row, 4)) / length;
+
+        if (SphereInPlane(normal, originPlane, center, radius))
+            result |= planeFlags[i];
+    }
+
+    return result;
+}
+
+void CRecordingDevice::SetViewport(int x, int y, int width, int height)
+{
+    RecordState("SetViewport");
+}
+
+void CRecordingDevice::SetRenderState(RenderState state, bool enabled)
+{
+    auto it = m_renderStates.find(state);
+    if (it != m_renderStates.end() && it->second == enabled)
+        m_currentStats.redundantStateChanges++;
+
+    m_renderStates[state] = enabled;
+
+    RecordState("SetRenderState");
+}
+
+void CRecordingDevice::SetColorMask(bool red, bool green, bool blue, bool alpha)
+{
+    RecordState("SetColorMask");
+}
+
+void CRecordingDevice::SetDepthTestFunc(CompFunc func)
+{
+    RecordState("SetDepthTestFunc");
+}
+
+void CRecordingDevice::SetDepthBias(float factor, float units)
+{
+    RecordState("SetDepthBias");
+}
+
+void CRecordingDevice::SetAlphaTestFunc(CompFunc func, float refValue)
+{
+    RecordState("SetAlphaTestFunc");
+}
+
+void CRecordingDevice::SetBlendFunc(BlendFunc srcBlend, BlendFunc dstBlend)
+{
+    RecordState("SetBlendFunc");
+}
+
+void CRecordingDevice::SetClearColor(const Color &color)
+{
+    RecordState("SetClearColor");
+}
+
+void CRecordingDevice::SetGlobalAmbient(const Color &color)
+{
+    RecordState("SetGlobalAmbient");
+}
+
+void CRecordingDevice::SetFogParams(FogMode mode, const Color &color, float start, float end, float density)
+{
+    RecordState("SetFogParams");
+}
+
+void CRecordingDevice::SetCullMode(CullMode mode)
+{
+    RecordState("SetCullMode");
+}
+
+void CRecordingDevice::SetShadeModel(ShadeModel model)
+{
+    RecordState("SetShadeModel");
+}
+
+void CRecordingDevice::SetShadowColor(float value)
+{
+    RecordState("SetShadowColor");
+}
+
+void CRecordingDevice::SetFillMode(FillMode mode)
+{
+    RecordState("SetFillMode");
+}
+
+void CRecordingDevice::CopyFramebufferToTexture(Texture& texture, int xOffset, int yOffset, int x, int y, int width, int height)
+{
+    m_currentStats.textureUploads++;
+    GetLogger()->Trace("Copy framebuffer to texture %u\n", texture.id);
+}
+
+std::unique_ptr<CFrameBufferPixels> CRecordingDevice::GetFrameBufferPixels() const
+{
+    std::size_t size = static_cast<std::size_t>(m_config.size.x) * m_config.size.y * 4;
+    return MakeUnique<CRecordingFrameBufferPixels>(size);
+}
+
+CFramebuffer* CRecordingDevice::GetFramebuffer(std::string name)
+{
+    auto it = m_framebuffers.find(name);
+    if (it == m_framebuffers.end())
+        return nullptr;
+
+    return it->second.get();
+}
+
+CFramebuffer* CRecordingDevice::CreateFramebuffer(std::string name, const FramebufferParams& params)
+{
+    // existing framebuffer was found
+    if (m_framebuffers.find(name) != m_framebuffers.end())
+        return nullptr;
+
+    int colorTexture = 0;
+    if (params.colorAttachment == FramebufferParams::AttachmentType::Texture)
+        colorTexture = m_nextTextureId++;
+
+    int depthTexture = 0;
+    if (params.depthAttachment == FramebufferParams::AttachmentType::Texture)
+        depthTexture = m_nextTextureId++;
+
+    auto framebuffer = MakeUnique<CRecordingFramebuffer>(this, name, params, colorTexture, depthTexture);
+    CFramebuffer* result = framebuffer.get();
+    m_framebuffers[name] = std::move(framebuffer);
+    return result;
+}
+
+void CRecordingDevice::DeleteFramebuffer(std::string name)
+{
+    // can't delete default framebuffer
+    if (name == "default") return;
+
+    m_framebuffers.erase(name);
+}
+
+bool CRecordingDevice::IsAnisotropySupported()
+{
+    return false;
+}
+
+int CRecordingDevice::GetMaxAnisotropyLevel()
+{
+    return 1;
+}
+
+int CRecordingDevice::GetMaxSamples()
+{
+    return 1;
+}
+
+bool CRecordingDevice::IsShadowMappingSupported()
+{
+    return true;
+}
+
+int CRecordingDevice::GetMaxTextureSize()
+{
+    return 8192;
+}
+
+bool CRecordingDevice::IsFramebufferSupported()
+{
+    return true;
+}
+
+
+} // namespace Gfx
@@ -0,0 +1,255 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/core/recordingdevice.h
+ * \brief Recording device - CRecordingDevice class
+ */
+
+#pragma once
+
+#include "graphics/core/device.h"
+
+#include "math/matrix.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+class CFramebuffer;
+
+/**
+ * \struct RecordingDeviceStats
+ * \brief Counters of calls made to CRecordingDevice
+ */
+struct RecordingDeviceStats
+{
+    //! Number of rendered frames
+    int         frames = 0;
+    //! Number of draw calls, including static buffer draws
+    int         drawCalls = 0;
+    //! Number of vertices submitted by draw calls
+    long long   vertices = 0;
+    //! Number of state changes (render states, transforms, materials, lights, ...)
+    int         stateChanges = 0;
+    //! Number of render state changes which did not change the state
+    int         redundantStateChanges = 0;
+    //! Number of texture binds
+    int         textureBinds = 0;
+    //! Number of texture creations and updates
+    int         textureUploads = 0;
+    //! Number of static buffer creations and updates
+    int         bufferUploads = 0;
+    //! Number of vertices uploaded into static buffers
+    long long   bufferUploadVertices = 0;
+    //! Number of framebuffer binds
+    int         framebufferBinds = 0;
+
+    //! Adds counters from \a other
+    void Add(const RecordingDeviceStats& other);
+    //! Formats the counters for logging
+    std::string ToString() const;
+};
+
+/**
+ * \class CRecordingDevice
+ * \brief Device implementation that doesn't render anything, but records what would be rendered
+ *
+ * Every call is counted in RecordingDeviceStats, per frame and in total, which makes
+ * it possible to benchmark and regression-test the CPU side of rendering on machines without GPU.
+ * Resources (textures, static buffers and framebuffers) get valid IDs and frustum culling
+ * is computed like in OpenGL devices, so the engine takes the same paths as with a real device.
+ *
+ * Each call is logged at trace level and each frame summary at debug level.
+ * Selected with -graphics record in headless mode.
+ */
+class CRecordingDevice : public CDevice
+{
+public:
+    explicit CRecordingDevice(const DeviceConfig &config);
+    virtual ~CRecordingDevice();
+
+    //! Returns counters of the last completed frame
+    const RecordingDeviceStats& GetFrameStats() const;
+    //! Returns counters accumulated since the device was created
+    const RecordingDeviceStats& GetTotalStats() const;
+
+    void DebugHook() override;
+    void DebugLights() override;
+
+    std::string GetName() override;
+
+    bool Create() override;
+    void Destroy() override;
+
+    void ConfigChanged(const DeviceConfig &newConfig) override;
+
+    void BeginScene() override;
+    void EndScene() override;
+
+    void Clear() override;
+
+    void SetRenderMode(RenderMode mode) override;
+
+    void SetTransform(TransformType type, const Math::Matrix &matrix) override;
+
+    void SetMaterial(const Material &material) override;
+
+    int GetMaxLightCount() override;
+    void SetLight(int index, const Light &light) override;
+    void SetLightEnabled(int index, bool enabled) override;
+
+    Texture CreateTexture(CImage *image, const TextureCreateParams &params) override;
+    Texture CreateTexture(ImageData *data, const TextureCreateParams &params) override;
+    Texture CreateDepthTexture(int width, int height, int depth) override;
+    void UpdateTexture(const Texture& texture, Math::IntPoint offset, ImageData* data, TexImgFormat format) override;
+    void DestroyTexture(const Texture &texture) override;
+    void DestroyAllTextures() override;
+
+    int GetMaxTextureStageCount() override;
+    void SetTexture(int index, const Texture &texture) override;
+    void SetTexture(int index, unsigned int textureId) override;
+    void SetTextureEnabled(int index, bool enabled) override;
+
+    void SetTextureStageParams(int index, const TextureStageParams &params) override;
+
+    void SetTextureStageWrap(int index, Gfx::TexWrapMode wrapS, Gfx::TexWrapMode wrapT) override;
+
+    void DrawPrimitive(PrimitiveType type, const Vertex* vertices, int vertexCount, Color color = Color(1.0f, 1.0f, 1.0f, 1.0f)) override;
+    void DrawPrimitive(PrimitiveType type, const VertexTex2* vertices, int vertexCount, Color color = Color(1.0f, 1.0f, 1.0f, 1.0f)) override;
+    void DrawPrimitive(PrimitiveType type, const VertexCol *vertices, int vertexCount) override;
+
+    void DrawPrimitives(PrimitiveType type, const Vertex *vertices,
+        int first[], int count[], int drawCount,
+        Color color = Color(1.0f, 1.0f, 1.0f, 1.0f)) override;
+    void DrawPrimitives(PrimitiveType type, const VertexTex2 *vertices,
+        int first[], int count[], int drawCount,
+        Color color = Color(1.0f, 1.0f, 1.0f, 1.0f)) override;
+    void DrawPrimitives(PrimitiveType type, const VertexCol *vertices,
+        int first[], int count[], int drawCount) override;
+
+    unsigned int CreateStaticBuffer(PrimitiveType primitiveType, const Vertex* vertices, int vertexCount) override;
+    unsigned int CreateStaticBuffer(PrimitiveType primitiveType, const VertexTex2* vertices, int vertexCount) override;
+    unsigned int CreateStaticBuffer(PrimitiveType primitiveType, const VertexCol* vertices, int vertexCount) override;
+    void UpdateStaticBuffer(unsigned int bufferId, PrimitiveType primitiveType, const Vertex* vertices, int vertexCount) override;
+    void UpdateStaticBuffer(unsigned int bufferId, PrimitiveType primitiveType, const VertexTex2* vertices, int vertexCount) override;
+    void UpdateStaticBuffer(unsigned int bufferId, PrimitiveType primitiveType, const VertexCol* vertices, int vertexCount) override;
+    void DrawStaticBuffer(unsigned int bufferId) override;
+    void DestroyStaticBuffer(unsigned int bufferId) override;
+
+    int ComputeSphereVisibility(const Math::Vector &center, float radius) override;
+
+    void SetViewport(int x, int y, int width, int height) override;
+
+    void SetRenderState(RenderState state, bool enabled) override;
+
+    void SetColorMask(bool red, bool green, bool blue, bool alpha) override;
+
+    void SetDepthTestFunc(CompFunc func) override;
+
+    void SetDepthBias(float factor, float units) override;
+
+    void SetAlphaTestFunc(CompFunc func, float refValue) override;
+
+    void SetBlendFunc(BlendFunc srcBlend, BlendFunc dstBlend) override;
+
+    void SetClearColor(const Color &color) override;
+
+    void SetGlobalAmbient(const Color &color) override;
+
+    void SetFogParams(FogMode mode, const Color &color, float start, float end, float density) override;
+
+    void SetCullMode(CullMode mode) override;
+
+    void SetShadeModel(ShadeModel model) override;
+
+    void SetShadowColor(float value) override;
+
+    void SetFillMode(FillMode mode) override;
+
+    void CopyFramebufferToTexture(Texture& texture, int xOffset, int yOffset, int x, int y, int width, int height) override;
+
+    std::unique_ptr<CFrameBufferPixels> GetFrameBufferPixels() const override;
+
+    CFramebuffer* GetFramebuffer(std::string name) override;
+
+    CFramebuffer* CreateFramebuffer(std::string name, const FramebufferParams& params) override;
+
+    void DeleteFramebuffer(std::string name) override;
+
+    bool IsAnisotropySupported() override;
+    int GetMaxAnisotropyLevel() override;
+
+    int GetMaxSamples() override;
+
+    bool IsShadowMappingSupported() override;
+
+    int GetMaxTextureSize() override;
+
+    bool IsFramebufferSupported() override;
+
+    //! Counts a framebuffer bind; called by framebuffers of this device
+    void        RecordFramebufferBind(const std::string& name);
+
+private:
+    //! Counts a draw call of given number of vertices
+    void        RecordDraw(const char* what, PrimitiveType type, int vertexCount);
+    //! Counts a state change
+    void        RecordState(const char* what);
+    //! Counts a static buffer upload
+    unsigned int RecordBufferUpload(unsigned int bufferId, PrimitiveType type, int vertexCount);
+
+private:
+    //! Current configuration
+    DeviceConfig m_config;
+
+    //! Counters of the frame being rendered
+    RecordingDeviceStats m_currentStats;
+    //! Counters of the last completed frame
+    RecordingDeviceStats m_frameStats;
+    //! Counters since creation
+    RecordingDeviceStats m_totalStats;
+
+    //! Last set values of render states, for detecting redundant changes
+    std::map<RenderState, bool> m_renderStates;
+
+    //! Current world, view and projection matrices
+    Math::Matrix m_worldMat;
+    Math::Matrix m_viewMat;
+    Math::Matrix m_projectionMat;
+    //! Combined world-view-projection matrix, used for frustum culling
+    Math::Matrix m_combinedMatrix;
+
+    //! Next free texture ID
+    unsigned int m_nextTextureId = 1;
+    //! Static buffers, as number of vertices by ID
+    std::map<unsigned int, int> m_staticBuffers;
+    //! Next free static buffer ID
+    unsigned int m_nextBufferId = 1;
+    //! Framebuffers by name
+    std::map<std::string, std::unique_ptr<CFramebuffer>> m_framebuffers;
+};
+
+
+} // namespace Gfx
@@ -32,7 +32,7 @@
 
 #include "common/system/system.h"
 
-#include "common/thread/resource_owning_thread.h"
+#include "common/thread/job_system.h"
 
 #include "graphics/core/device.h"
 #include "graphics/core/framebuffer.h"
@@ -45,8 +45,10 @@
 #include "graphics/engine/particle.h"
 #include "graphics/engine/planet.h"
 #include "graphics/engine/pyro_manager.h"
+#include "graphics/engine/ray_query.h"
 #include "graphics/engine/terrain.h"
 #include "graphics/engine/text.h"
+#include "graphics/engine/texture_recolor.h"
 #include "graphics/engine/water.h"
 
 #include "graphics/model/model_mesh.h"
@@ -60,6 +62,8 @@
 
 #include "ui/controls/interface.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <SDL_surface.h>
 #include <SDL_thread.h>
@@ -102,6 +106,12 @@ struct EngineMouse
     {}
 };
 
+//! Fraction of the shadow range the light may move before the cached static shadow map is re-rendered
+const float SHADOW_CACHE_MOVE_THRESHOLD = 0.1f;
+
+//! Size of each of the 16 ground spot textures
+const int GROUND_SPOT_TEXTURE_SIZE = 256;
+
 const Math::IntPoint MOUSE_SIZE(32, 32);
 const std::map<EngineMouseType, EngineMouse> MOUSE_TYPES = {
     {{ENG_MOUSE_NORM},    {EngineMouse( 0,  1, 32, ENG_RSTATE_TTEXTURE_WHITE, ENG_RSTATE_TTEXTURE_BLACK, Math::IntPoint( 1,  1))}},
@@ -143,6 +153,8 @@ CEngine::CEngine(CApplication *app, CSystemUtils* systemUtils)
     m_sound      = nullptr;
     m_terrain    = nullptr;
 
+    m_rayQuery = MakeUnique<CRayQuery>(this);
+
     m_showStats = false;
 
     m_focus = 0.75f;
@@ -186,6 +198,7 @@ CEngine::CEngine(CApplication *app, CSystemUtils* systemUtils)
     m_drawWorld = true;
     m_drawFront = false;
     m_particleDensity = 1.0f;
+    m_particleBudget = 4000;
     m_clippingDistance = 1.0f;
     m_terrainVision = 1000.0f;
     m_textureMipmapLevel = 1;
@@ -195,6 +208,7 @@ CEngine::CEngine(CApplication *app, CSystemUtils* systemUtils)
     m_offscreenShadowRenderingResolution = 1024;
     m_qualityShadows = true;
     m_terrainShadows = false;
+    m_shadowMapCache = false;
     m_shadowRange = 0.0f;
     m_multisample = 2;
     m_vsync = 0;
@@ -207,9 +221,6 @@ CEngine::CEngine(CApplication *app, CSystemUtils* systemUtils)
     m_pauseBlurEnabled = true;
 
 
-    m_updateGeometry = false;
-    m_updateStaticBuffers = false;
-
     m_interfaceMode = false;
 
     m_debugLights = false;
@@ -235,8 +246,18 @@ CEngine::CEngine(CApplication *app, CSystemUtils* systemUtils)
     Math::LoadTranslationMatrix(temp2, Math::Vector(1.0f, 1.0f, 1.0f));
     m_shadowBias = Math::MultiplyMatrices(temp1, temp2);
 
+    m_shadowStaticValid = false;
+    m_shadowStaticDirty = false;
+    m_shadowStaticDist = 0.0f;
+    m_shadowCacheHits = 0;
+    m_shadowCacheMisses = 0;
+    m_shadowRerenderFrustum = 0;
+    m_shadowRerenderGeometry = 0;
+
     m_lastState = -1;
     m_statisticTriangle = 0;
+    m_geometryVertexScan = 0;
+    m_statisticVertexScan = 0;
     m_fps = 0.0f;
     m_firstGroundSpot = false;
 }
@@ -309,6 +330,11 @@ CCloud* CEngine::GetCloud()
     return m_cloud.get();
 }
 
+CRayQuery* CEngine::GetRayQuery()
+{
+    return m_rayQuery.get();
+}
+
 void CEngine::SetTerrain(CTerrain* terrain)
 {
     m_terrain = terrain;
@@ -384,6 +410,9 @@ void CEngine::Destroy()
         m_shadowMap = Texture();
     }
 
+    m_device->DeleteFramebuffer("shadow_static");
+    m_shadowStaticValid = false;
+
     m_lightMan.reset();
     m_text.reset();
     m_particle.reset();
@@ -492,33 +521,15 @@ void CEngine::FrameUpdate()
     }
 }
 
-void CEngine::WriteScreenShot(const std::string& fileName)
+std::unique_ptr<CImage> CEngine::CaptureScreenShot()
 {
-    auto data = MakeUnique<WriteScreenShotData>();
-    data->img = MakeUnique<CImage>(Math::IntPoint(m_size.x, m_size.y));
+    auto img = MakeUnique<CImage>(Math::IntPoint(m_size.x, m_size.y));
 
     auto pixels = m_device->GetFrameBufferPixels();
-    data->img->SetDataPixels(pixels->GetPixelsData());
-    data->img->FlipVertically();
-
-    data->fileName = fileName;
-
-    CResourceOwningThread<WriteScreenShotData> thread(CEngine::WriteScreenShotThread, std::move(data), "WriteScreenShot thread");
-    thread.Start();
-}
-
-void CEngine::WriteScreenShotThread(std::unique_ptr<WriteScreenShotData> data)
-{
-    if ( data->img->SavePNG(data->fileName.c_str()) )
-    {
-       GetLogger()->Debug("Save screenshot saved successfully\n");
-    }
-    else
-    {
-       GetLogger()->Error("%s!\n", data->img->GetError().c_str());
-    }
+    img->SetDataPixels(pixels->GetPixelsData());
+    img->FlipVertically();
 
-    CApplication::GetInstancePointer()->GetEventQueue()->AddEvent(Event(EVENT_WRITE_SCENE_FINISHED));
+    return img;
 }
 
 void CEngine::SetPause(bool pause)
@@ -666,6 +677,8 @@ int CEngine::CreateBaseObject()
 
     m_baseObjects[baseObjRank].used = true;
 
+    m_rayQuery->InvalidateBaseObject(baseObjRank);
+
     return baseObjRank;
 }
 
@@ -693,6 +706,12 @@ void CEngine::DeleteBaseObject(int baseObjRank)
     p1.next.clear();
 
     p1.used = false;
+
+    m_updateGeometryRanks.erase(baseObjRank);
+    m_updateStaticBufferRanks.erase(baseObjRank);
+
+    m_rayQuery->InvalidateBaseObject(baseObjRank);
+    InvalidateStaticShadowMap();
 }
 
 void CEngine::DeleteAllBaseObjects()
@@ -717,6 +736,12 @@ void CEngine::DeleteAllBaseObjects()
     }
 
     m_baseObjects.clear();
+
+    m_updateGeometryRanks.clear();
+    m_updateStaticBufferRanks.clear();
+
+    m_rayQuery->InvalidateAll();
+    InvalidateStaticShadowMap();
 }
 
 void CEngine::CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank)
@@ -726,6 +751,9 @@ void CEngine::CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank)
 
     m_baseObjects[destBaseObjRank] = m_baseObjects[sourceBaseObjRank];
 
+    m_rayQuery->InvalidateBaseObject(destBaseObjRank);
+    InvalidateStaticShadowMap();
+
     EngineBaseObject& p1 = m_baseObjects[destBaseObjRank];
 
     if (! p1.used)
@@ -756,19 +784,12 @@ void CEngine::AddBaseObjTriangles(int baseObjRank, const std::vector<VertexTex2>
     p3.vertices.insert(p3.vertices.end(), vertices.begin(), vertices.end());
 
     p3.updateStaticBuffer = true;
-    m_updateStaticBuffers = true;
+    m_updateStaticBufferRanks.insert(baseObjRank);
 
-    for (int i = 0; i < static_cast<int>( vertices.size() ); i++)
-    {
-        p1.bboxMin.x = Math::Min(vertices[i].coord.x, p1.bboxMin.x);
-        p1.bboxMin.y = Math::Min(vertices[i].coord.y, p1.bboxMin.y);
-        p1.bboxMin.z = Math::Min(vertices[i].coord.z, p1.bboxMin.z);
-        p1.bboxMax.x = Math::Max(vertices[i].coord.x, p1.bboxMax.x);
-        p1.bboxMax.y = Math::Max(vertices[i].coord.y, p1.bboxMax.y);
-        p1.bboxMax.z = Math::Max(vertices[i].coord.z, p1.bboxMax.z);
-    }
+    ExtendBaseObjBBox(p1, vertices);
 
-    p1.boundingSphere = Math::BoundingSphereForBox(p1.bboxMin, p1.bboxMax);
+    m_rayQuery->InvalidateBaseObject(baseObjRank);
+    InvalidateStaticShadowMap();
 
     p1.totalTriangles += vertices.size() / 3;
 }
@@ -788,24 +809,15 @@ void CEngine::AddBaseObjQuick(int baseObjRank, const EngineBaseObjDataTier& buff
 
     UpdateStaticBuffer(p3);
 
+    // With global update, the bounding box is recomputed once for the whole
+    // base object in UpdateGeometry() instead of after every added buffer
     if (globalUpdate)
-    {
-        m_updateGeometry = true;
-    }
+        m_updateGeometryRanks.insert(baseObjRank);
     else
-    {
-        for (int i = 0; i < static_cast<int>( p3.vertices.size() ); i++)
-        {
-            p1.bboxMin.x = Math::Min(p3.vertices[i].coord.x, p1.bboxMin.x);
-            p1.bboxMin.y = Math::Min(p3.vertices[i].coord.y, p1.bboxMin.y);
-            p1.bboxMin.z = Math::Min(p3.vertices[i].coord.z, p1.bboxMin.z);
-            p1.bboxMax.x = Math::Max(p3.vertices[i].coord.x, p1.bboxMax.x);
-            p1.bboxMax.y = Math::Max(p3.vertices[i].coord.y, p1.bboxMax.y);
-            p1.bboxMax.z = Math::Max(p3.vertices[i].coord.z, p1.bboxMax.z);
-        }
+        ExtendBaseObjBBox(p1, p3.vertices);
 
-        p1.boundingSphere = Math::BoundingSphereForBox(p1.bboxMin, p1.bboxMax);
-    }
+    m_rayQuery->InvalidateBaseObject(baseObjRank);
+    InvalidateStaticShadowMap();
 
     if (p3.type == ENG_TRIANGLE_TYPE_TRIANGLES)
         p1.totalTriangles += p3.vertices.size() / 3;
@@ -909,6 +921,8 @@ int CEngine::CreateObject()
     m_objects[objRank].baseObjRank = -1;
     m_objects[objRank].shadowRank = -1;
 
+    m_rayQuery->InvalidateObjects();
+
     return objRank;
 }
 
@@ -917,6 +931,14 @@ void CEngine::DeleteAllObjects()
     m_objects.clear();
     m_shadowSpots.clear();
 
+    m_rayQuery->InvalidateObjects();
+
+    InvalidateStaticShadowMap();
+    m_shadowCacheHits = 0;
+    m_shadowCacheMisses = 0;
+    m_shadowRerenderFrustum = 0;
+    m_shadowRerenderGeometry = 0;
+
     DeleteAllGroundSpots();
 }
 
@@ -924,9 +946,14 @@ void CEngine::DeleteObject(int objRank)
 {
     assert(objRank >= 0 && objRank < static_cast<int>( m_objects.size() ));
 
+    if (m_objects[objRank].shadowCached)
+        InvalidateStaticShadowMap();
+
     // Mark object as deleted
     m_objects[objRank].used = false;
 
+    m_rayQuery->InvalidateObjects();
+
     // Delete associated shadows
     DeleteShadowSpot(objRank);
 }
@@ -936,6 +963,11 @@ void CEngine::SetObjectBaseRank(int objRank, int baseObjRank)
     assert(objRank == -1 || (objRank >= 0 && objRank < static_cast<int>( m_objects.size() )));
 
     m_objects[objRank].baseObjRank = baseObjRank;
+
+    m_rayQuery->InvalidateObjects();
+
+    if (IsStaticShadowCaster(objRank) || m_objects[objRank].shadowCached)
+        InvalidateStaticShadowMap();
 }
 
 int CEngine::GetObjectBaseRank(int objRank)
@@ -950,6 +982,11 @@ void CEngine::SetObjectType(int objRank, EngineObjectType type)
     assert(objRank >= 0 && objRank < static_cast<int>( m_objects.size() ));
 
     m_objects[objRank].type = type;
+
+    m_rayQuery->InvalidateObjects();
+
+    if (IsStaticShadowCaster(objRank) || m_objects[objRank].shadowCached)
+        InvalidateStaticShadowMap();
 }
 
 EngineObjectType CEngine::GetObjectType(int objRank)
@@ -964,7 +1001,25 @@ void CEngine::SetObjectTransform(int objRank, const Math::Matrix& transform)
 {
     assert(objRank >= 0 && objRank < static_cast<int>( m_objects.size() ));
 
-    m_objects[objRank].transform = transform;
+    EngineObject& object = m_objects[objRank];
+
+    // Exact comparison, objects are often given the same transform every frame
+    if (std::equal(transform.m, transform.m + 16, object.transform.m))
+        return;
+
+    if (object.shadowCached || IsStaticShadowCaster(objRank))
+    {
+        // Static objects which move after being cached are animated, so they are
+        // drawn with dynamic casters from now on instead of invalidating the cache every frame
+        if (object.shadowCached)
+            object.shadowDynamic = true;
+
+        InvalidateStaticShadowMap();
+    }
+
+    object.transform = transform;
+
+    m_rayQuery->InvalidateObjectTransform(objRank);
 }
 
 void CEngine::GetObjectTransform(int objRank, Math::Matrix& transform)
@@ -1572,6 +1627,8 @@ void CEngine::DeleteGroundSpot(int rank)
 
     m_groundSpots[rank].used = false;
     m_groundSpots[rank].pos = Math::Vector(0.0f, 0.0f, 0.0f);
+
+    InvalidateGroundSpot(rank);
 }
 
 void CEngine::SetObjectGroundSpotPos(int rank, const Math::Vector& pos)
@@ -1579,6 +1636,8 @@ void CEngine::SetObjectGroundSpotPos(int rank, const Math::Vector& pos)
     assert(rank >= 0 && rank < static_cast<int>( m_groundSpots.size() ));
 
     m_groundSpots[rank].pos = pos;
+
+    InvalidateGroundSpot(rank);
 }
 
 void CEngine::SetObjectGroundSpotRadius(int rank, float radius)
@@ -1586,6 +1645,8 @@ void CEngine::SetObjectGroundSpotRadius(int rank, float radius)
     assert(rank >= 0 && rank < static_cast<int>( m_groundSpots.size() ));
 
     m_groundSpots[rank].radius = radius;
+
+    InvalidateGroundSpot(rank);
 }
 
 void CEngine::SetObjectGroundSpotColor(int rank, const Color& color)
@@ -1593,14 +1654,20 @@ void CEngine::SetObjectGroundSpotColor(int rank, const Color& color)
     assert(rank >= 0 && rank < static_cast<int>( m_groundSpots.size() ));
 
     m_groundSpots[rank].color = color;
+
+    InvalidateGroundSpot(rank);
 }
 
 void CEngine::SetObjectGroundSpotMinMax(int rank, float min, float max)
 {
     assert(rank >= 0 && rank < static_cast<int>( m_groundSpots.size() ));
 
+    InvalidateGroundSpot(rank);
+
     m_groundSpots[rank].min = min;
     m_groundSpots[rank].max = max;
+
+    InvalidateGroundSpot(rank);
 }
 
 void CEngine::SetObjectGroundSpotSmooth(int rank, float smooth)
@@ -1608,12 +1675,18 @@ void CEngine::SetObjectGroundSpotSmooth(int rank, float smooth)
     assert(rank >= 0 && rank < static_cast<int>( m_groundSpots.size() ));
 
     m_groundSpots[rank].smooth = smooth;
+
+    InvalidateGroundSpot(rank);
 }
 
 void CEngine::CreateGroundMark(Math::Vector pos, float radius,
                                    float delay1, float delay2, float delay3,
                                    int dx, int dy, char* table)
 {
+    // Erase the previous mark, its draw state is reset below
+    if (m_groundMark.drawRadius != 0.0f)
+        AddGroundSpotDirtyArea(m_groundMark.drawPos, m_groundMark.drawRadius);
+
     m_groundMark.LoadDefault();
 
     m_groundMark.draw      = true;
@@ -1631,6 +1704,9 @@ void CEngine::CreateGroundMark(Math::Vector pos, float radius,
 
 void CEngine::DeleteGroundMark(int rank)
 {
+    if (m_groundMark.drawRadius != 0.0f)
+        AddGroundSpotDirtyArea(m_groundMark.drawPos, m_groundMark.drawRadius);
+
     m_groundMark.LoadDefault();
 }
 
@@ -1649,13 +1725,29 @@ void CEngine::ComputeDistance()
     }
 }
 
-void CEngine::UpdateGeometry()
+void CEngine::ExtendBaseObjBBox(EngineBaseObject& p1, const std::vector<VertexTex2>& vertices)
 {
-    if (! m_updateGeometry)
-        return;
+    for (int i = 0; i < static_cast<int>( vertices.size() ); i++)
+    {
+        p1.bboxMin.x = Math::Min(vertices[i].coord.x, p1.bboxMin.x);
+        p1.bboxMin.y = Math::Min(vertices[i].coord.y, p1.bboxMin.y);
+        p1.bboxMin.z = Math::Min(vertices[i].coord.z, p1.bboxMin.z);
+        p1.bboxMax.x = Math::Max(vertices[i].coord.x, p1.bboxMax.x);
+        p1.bboxMax.y = Math::Max(vertices[i].coord.y, p1.bboxMax.y);
+        p1.bboxMax.z = Math::Max(vertices[i].coord.z, p1.bboxMax.z);
+    }
 
-    for (int baseObjRank = 0; baseObjRank < static_cast<int>( m_baseObjects.size() ); baseObjRank++)
+    m_geometryVertexScan += vertices.size();
+
+    p1.boundingSphere = Math::BoundingSphereForBox(p1.bboxMin, p1.bboxMax);
+}
+
+void CEngine::UpdateGeometry()
+{
+    for (int baseObjRank : m_updateGeometryRanks)
     {
+        assert(baseObjRank >= 0 && baseObjRank < static_cast<int>( m_baseObjects.size() ));
+
         EngineBaseObject &p1 = m_baseObjects[baseObjRank];
         if (! p1.used)
             continue;
@@ -1668,25 +1760,13 @@ void CEngine::UpdateGeometry()
             EngineBaseObjTexTier& p2 = p1.next[l2];
 
             for (int l3 = 0; l3 < static_cast<int>( p2.next.size() ); l3++)
-            {
-                EngineBaseObjDataTier& p3 = p2.next[l3];
-
-                for (int i = 0; i < static_cast<int>( p3.vertices.size() ); i++)
-                {
-                        p1.bboxMin.x = Math::Min(p3.vertices[i].coord.x, p1.bboxMin.x);
-                        p1.bboxMin.y = Math::Min(p3.vertices[i].coord.y, p1.bboxMin.y);
-                        p1.bboxMin.z = Math::Min(p3.vertices[i].coord.z, p1.bboxMin.z);
-                        p1.bboxMax.x = Math::Max(p3.vertices[i].coord.x, p1.bboxMax.x);
-                        p1.bboxMax.y = Math::Max(p3.vertices[i].coord.y, p1.bboxMax.y);
-                        p1.bboxMax.z = Math::Max(p3.vertices[i].coord.z, p1.bboxMax.z);
-                }
-            }
+                ExtendBaseObjBBox(p1, p2.next[l3].vertices);
         }
 
         p1.boundingSphere = Math::BoundingSphereForBox(p1.bboxMin, p1.bboxMax);
     }
 
-    m_updateGeometry = false;
+    m_updateGeometryRanks.clear();
 }
 
 void CEngine::UpdateStaticBuffer(EngineBaseObjDataTier& p4)
@@ -1707,13 +1787,10 @@ void CEngine::UpdateStaticBuffer(EngineBaseObjDataTier& p4)
 
 void CEngine::UpdateStaticBuffers()
 {
-    if (!m_updateStaticBuffers)
-        return;
-
-    m_updateStaticBuffers = false;
-
-    for (int baseObjRank = 0; baseObjRank < static_cast<int>( m_baseObjects.size() ); baseObjRank++)
+    for (int baseObjRank : m_updateStaticBufferRanks)
     {
+        assert(baseObjRank >= 0 && baseObjRank < static_cast<int>( m_baseObjects.size() ));
+
         EngineBaseObject& p1 = m_baseObjects[baseObjRank];
         if (! p1.used)
             continue;
@@ -1733,6 +1810,8 @@ void CEngine::UpdateStaticBuffers()
             }
         }
     }
+
+    m_updateStaticBufferRanks.clear();
 }
 
 void CEngine::Update()
@@ -1742,178 +1821,31 @@ void CEngine::Update()
     UpdateStaticBuffers();
 }
 
-bool CEngine::DetectBBox(int objRank, Math::Point mouse)
-{
-    assert(objRank >= 0 && objRank < static_cast<int>(m_objects.size()));
-
-    int baseObjRank = m_objects[objRank].baseObjRank;
-    if (baseObjRank == -1)
-        return false;
-
-    assert(baseObjRank >= 0 && baseObjRank < static_cast<int>(m_baseObjects.size()));
-
-    EngineBaseObject& p1 = m_baseObjects[baseObjRank];
-
-    Math::Point min, max;
-    min.x =  1000000.0f;
-    min.y =  1000000.0f;
-    max.x = -1000000.0f;
-    max.y = -1000000.0f;
-
-    for (int i = 0; i < 8; i++)
-    {
-        Math::Vector p;
-
-        if ( i & (1<<0) )  p.x = p1.bboxMin.x;
-        else               p.x = p1.bboxMax.x;
-        if ( i & (1<<1) )  p.y = p1.bboxMin.y;
-        else               p.y = p1.bboxMax.y;
-        if ( i & (1<<2) )  p.z = p1.bboxMin.z;
-        else               p.z = p1.bboxMax.z;
-
-        Math::Vector pp;
-        if ( TransformPoint(pp, objRank, p) )
-        {
-            if (pp.x < min.x) min.x = pp.x;
-            if (pp.x > max.x) max.x = pp.x;
-            if (pp.y < min.y) min.y = pp.y;
-            if (pp.y > max.y) max.y = pp.y;
-        }
-    }
-
-    return ( mouse.x >= min.x &&
-             mouse.x <= max.x &&
-             mouse.y >= min.y &&
-             mouse.y <= max.y );
-}
-
 int CEngine::DetectObject(Math::Point mouse, Math::Vector& targetPos, bool terrain)
 {
-    float min = 1000000.0f;
-    int nearest = -1;
-    Math::Vector pos;
-
-    for (int objRank = 0; objRank < static_cast<int>( m_objects.size() ); objRank++)
-    {
-        if (! m_objects[objRank].used)
-            continue;
-
-        if (m_objects[objRank].type == ENG_OBJTYPE_TERRAIN && !terrain)
-            continue;
-
-        if (! DetectBBox(objRank, mouse))
-            continue;
-
-        int baseObjRank = m_objects[objRank].baseObjRank;
-        if (baseObjRank == -1)
-            continue;
-
-        assert(baseObjRank >= 0 && baseObjRank < static_cast<int>(m_baseObjects.size()));
-
-        EngineBaseObject& p1 = m_baseObjects[baseObjRank];
-        if (! p1.used)
-            continue;
-
-        for (int l2 = 0; l2 < static_cast<int>( p1.next.size() ); l2++)
-        {
-            EngineBaseObjTexTier& p2 = p1.next[l2];
-
-            for (int l3 = 0; l3 < static_cast<int>( p2.next.size() ); l3++)
-            {
-                EngineBaseObjDataTier& p3 = p2.next[l3];
+    Math::Vector origin, dir;
+    GetMouseRay(mouse, origin, dir);
 
-                if (p3.type == ENG_TRIANGLE_TYPE_TRIANGLES)
-                {
-                    for (int i = 0; i < static_cast<int>( p3.vertices.size() ); i += 3)
-                    {
-                        float dist = 0.0f;
-                        if (DetectTriangle(mouse, &p3.vertices[i], objRank, dist, pos) && dist < min)
-                        {
-                            min = dist;
-                            nearest = objRank;
-                            targetPos = pos;
-                        }
-                    }
-                }
-                else if (p3.type == ENG_TRIANGLE_TYPE_SURFACE)
-                {
-                    for (int i = 0; i < static_cast<int>( p3.vertices.size() ) - 2; i += 1)
-                    {
-                        float dist = 0.0f;
-                        if (DetectTriangle(mouse, &p3.vertices[i], objRank, dist, pos) && dist < min)
-                        {
-                            min = dist;
-                            nearest = objRank;
-                            targetPos = pos;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    RayHit hit;
+    if (! m_rayQuery->CastRay(origin, dir, 1000000.0f, terrain, hit))
+        return -1;
 
-    return nearest;
+    targetPos = hit.pos;
+    return hit.objRank;
 }
 
-bool CEngine::DetectTriangle(Math::Point mouse, VertexTex2* triangle, int objRank, float& dist, Math::Vector& pos)
+void CEngine::GetMouseRay(Math::Point mouse, Math::Vector& origin, Math::Vector& dir)
 {
-    assert(objRank >= 0 && objRank < static_cast<int>(m_objects.size()));
-
-    Math::Vector p2D[3], p3D;
+    Math::Matrix viewInverse = m_matView.Inverse();
 
-    for (int i = 0; i < 3; i++)
-    {
-        p3D.x = triangle[i].coord.x;
-        p3D.y = triangle[i].coord.y;
-        p3D.z = triangle[i].coord.z;
-
-        if (! TransformPoint(p2D[i], objRank, p3D))
-            return false;
-    }
-
-    if (mouse.x < p2D[0].x &&
-        mouse.x < p2D[1].x &&
-        mouse.x < p2D[2].x)
-        return false;
-
-    if (mouse.x > p2D[0].x &&
-        mouse.x > p2D[1].x &&
-        mouse.x > p2D[2].x)
-        return false;
+    // Point on the mouse ray at unit depth in view space
+    Math::Vector p;
+    p.x = (mouse.x*2.0f-1.0f) / m_matProj.Get(1,1);
+    p.y = (mouse.y*2.0f-1.0f) / m_matProj.Get(2,2);
+    p.z = 1.0f;
 
-    if (mouse.y < p2D[0].y &&
-        mouse.y < p2D[1].y &&
-        mouse.y < p2D[2].y)
-        return false;
-
-    if (mouse.y > p2D[0].y &&
-        mouse.y > p2D[1].y &&
-        mouse.y > p2D[2].y)
-        return false;
-
-    Math::Point a, b, c;
-    a.x = p2D[0].x;
-    a.y = p2D[0].y;
-    b.x = p2D[1].x;
-    b.y = p2D[1].y;
-    c.x = p2D[2].x;
-    c.y = p2D[2].y;
-
-    if (! Math::IsInsideTriangle(a, b, c, mouse))
-        return false;
-
-    Math::Vector a2 = Math::Transform(m_objects[objRank].transform, triangle[0].coord);
-    Math::Vector b2 = Math::Transform(m_objects[objRank].transform, triangle[1].coord);
-    Math::Vector c2 = Math::Transform(m_objects[objRank].transform, triangle[2].coord);
-    Math::Vector e  = Math::Transform(m_matView.Inverse(), Math::Vector(0.0f, 0.0f, -1.0f));
-    Math::Vector f  = Math::Transform(m_matView.Inverse(), Math::Vector(
-        (mouse.x*2.0f-1.0f)*m_matProj.Inverse().Get(1,1),
-        (mouse.y*2.0f-1.0f)*m_matProj.Inverse().Get(2,2),
-        0.0f));
-    Math::Intersect(a2, b2, c2, e, f, pos);
-
-    dist = (p2D[0].z + p2D[1].z + p2D[2].z) / 3.0f;
-    return true;
+    origin = Math::Transform(viewInverse, Math::Vector(0.0f, 0.0f, 0.0f));
+    dir = Math::Normalize(Math::Transform(viewInverse, p) - origin);
 }
 
 //! Use only after world transform already set
@@ -2305,8 +2237,146 @@ Texture CEngine::LoadTexture(const std::string& name, const TextureCreateParams&
     return CreateTexture(name, params);
 }
 
+void CEngine::PreloadTextures(const std::vector<std::pair<std::string, TextureCreateParams>>& textures)
+{
+    std::vector<std::pair<std::string, TextureCreateParams>> missing;
+    std::set<std::string> names;
+    for (const auto& texture : textures)
+    {
+        const std::string& name = texture.first;
+        if (name.empty()) continue;
+        if (m_texNameMap.find(name) != m_texNameMap.end()) continue;
+        if (m_texBlacklist.find(name) != m_texBlacklist.end()) continue;
+        if (!names.insert(name).second) continue;  // first params are used, as by LoadTexture()
+
+        missing.push_back(texture);
+    }
+
+    if (missing.empty())
+        return;
+
+    SystemTimeStamp* start = m_systemUtils->CreateTimeStamp();
+    SystemTimeStamp* decoded = m_systemUtils->CreateTimeStamp();
+    SystemTimeStamp* end = m_systemUtils->CreateTimeStamp();
+    m_systemUtils->GetCurrentTimeStamp(start);
+
+    // Decoding uses only the image and PhysFS, which are safe to use from several threads
+    int count = missing.size();
+    std::vector<std::unique_ptr<CImage>> images(count);
+    std::vector<char> loaded(count, false);
+    auto decode = [&](int first, int last)
+    {
+        for (int i = first; i < last; i++)
+        {
+            images[i] = MakeUnique<CImage>();
+            loaded[i] = images[i]->Load(missing[i].first);
+        }
+    };
+    if (CJobSystem::IsCreated())
+        CJobSystem::GetInstancePointer()->ParallelFor(count, 1, decode);
+    else
+        decode(0, count);
+
+    m_systemUtils->GetCurrentTimeStamp(decoded);
+
+    // Textures are uploaded from the main thread, which owns the context of the device
+    for (int i = 0; i < count; i++)
+    {
+        const std::string& name = missing[i].first;
+        if (!loaded[i])
+        {
+            std::string error = images[i]->GetError();
+            GetLogger()->Error("Couldn't load texture '%s': %s, blacklisting\n", name.c_str(), error.c_str());
+            m_texBlacklist.insert(name);
+            continue;
+        }
+
+        CreateTexture(name, missing[i].second, images[i].get());
+        images[i].reset();
+    }
+
+    m_systemUtils->GetCurrentTimeStamp(end);
+
+    m_textureLoadCount += count;
+    m_textureDecodeTime += m_systemUtils->TimeStampDiff(start, decoded, STU_SEC);
+    m_textureUploadTime += m_systemUtils->TimeStampDiff(decoded, end, STU_SEC);
+
+    m_systemUtils->DestroyTimeStamp(start);
+    m_systemUtils->DestroyTimeStamp(decoded);
+    m_systemUtils->DestroyTimeStamp(end);
+}
+
+void CEngine::BeginTextureBatch()
+{
+    m_textureBatch = true;
+    m_textureLoadCount = 0;
+    m_textureDecodeTime = 0.0f;
+    m_textureUploadTime = 0.0f;
+}
+
+void CEngine::EndTextureBatch()
+{
+    if (!m_textureBatch) return;
+
+    m_textureBatch = false;
+    LoadAllTextures();
+
+    if (m_textureLoadCount > 0)
+    {
+        int threadCount = CJobSystem::IsCreated() ? CJobSystem::GetInstancePointer()->GetWorkerCount() + 1 : 1;
+        GetLogger()->Info("Loaded %d textures: decoding %.3f s on %d threads, upload %.3f s\n",
+                          m_textureLoadCount, m_textureDecodeTime, threadCount, m_textureUploadTime);
+    }
+}
+
 bool CEngine::LoadAllTextures()
 {
+    if (m_textureBatch)
+        return true;
+
+    // Collects textures of all objects first, to decode them together
+    std::vector<std::pair<std::string, TextureCreateParams>> textures;
+    textures.emplace_back("textures/interface/mouse.png", m_defaultTexParams);
+    textures.emplace_back("textures/interface/button1.png", m_defaultTexParams);
+    textures.emplace_back("textures/interface/button2.png", m_defaultTexParams);
+    textures.emplace_back("textures/interface/button3.png", m_defaultTexParams);
+    textures.emplace_back("textures/interface/button4.png", m_defaultTexParams);
+    textures.emplace_back("textures/effect00.png", m_defaultTexParams);
+    textures.emplace_back("textures/effect01.png", m_defaultTexParams);
+    textures.emplace_back("textures/effect02.png", m_defaultTexParams);
+    textures.emplace_back("textures/effect03.png", m_defaultTexParams);
+
+    if (! m_backgroundName.empty())
+    {
+        TextureCreateParams params = m_defaultTexParams;
+        params.padToNearestPowerOfTwo = true;
+        textures.emplace_back(m_backgroundName, params);
+    }
+
+    if (! m_foregroundName.empty())
+        textures.emplace_back(m_foregroundName, m_defaultTexParams);
+
+    for (const EngineObject& object : m_objects)
+    {
+        if (! object.used || object.baseObjRank == -1)
+            continue;
+
+        const EngineBaseObject& p1 = m_baseObjects[object.baseObjRank];
+        if (! p1.used)
+            continue;
+
+        const TextureCreateParams& params = object.type == ENG_OBJTYPE_TERRAIN ? m_terrainTexParams : m_defaultTexParams;
+        for (const EngineBaseObjTexTier& p2 : p1.next)
+        {
+            if (! p2.tex1Name.empty())
+                textures.emplace_back("textures/"+p2.tex1Name, params);
+            if (! p2.tex2Name.empty())
+                textures.emplace_back("textures/"+p2.tex2Name, params);
+        }
+    }
+
+    PreloadTextures(textures);
+
     m_miceTexture = LoadTexture("textures/interface/mouse.png");
     LoadTexture("textures/interface/button1.png");
     LoadTexture("textures/interface/button2.png");
@@ -2385,25 +2455,6 @@ bool CEngine::LoadAllTextures()
     return ok;
 }
 
-static bool IsExcludeColor(Math::Point *exclude, int x, int y)
-{
-    int i = 0;
-    while ( exclude[i+0].x != 0.0f || exclude[i+0].y != 0.0f ||
-            exclude[i+1].y != 0.0f || exclude[i+1].y != 0.0f )
-    {
-        if ( x >= static_cast<int>(exclude[i+0].x*256.0f) &&
-             x <  static_cast<int>(exclude[i+1].x*256.0f) &&
-             y >= static_cast<int>(exclude[i+0].y*256.0f) &&
-             y <  static_cast<int>(exclude[i+1].y*256.0f) )
-            return true;  // exclude
-
-        i += 2;
-    }
-
-    return false;  // point to include
-}
-
-
 bool CEngine::ChangeTextureColor(const std::string& texName,
                                  const std::string& srcName,
                                  Color colorRef1, Color colorNew1,
@@ -2412,6 +2463,39 @@ bool CEngine::ChangeTextureColor(const std::string& texName,
                                  Math::Point ts, Math::Point ti,
                                  Math::Point *exclude, float shift, bool hsv)
 {
+    RecolorParams params;
+    params.colorRef1 = colorRef1;
+    params.colorNew1 = colorNew1;
+    params.colorRef2 = colorRef2;
+    params.colorNew2 = colorNew2;
+    params.tolerance1 = tolerance1;
+    params.tolerance2 = tolerance2;
+    params.ts = ts;
+    params.ti = ti;
+    params.shift = shift;
+    params.hsv = hsv;
+
+    if (exclude != nullptr)
+    {
+        int i = 0;
+        while ( exclude[i+0].x != 0.0f || exclude[i+0].y != 0.0f ||
+                exclude[i+1].y != 0.0f || exclude[i+1].y != 0.0f )
+        {
+            params.exclude.push_back(exclude[i+0]);
+            params.exclude.push_back(exclude[i+1]);
+            i += 2;
+        }
+    }
+
+    // The texture may already have these colors, when the same level is loaded again
+    std::string key = srcName + '\0' + params.GetKey();
+    auto keyIt = m_textureColorKeys.find(texName);
+    if (keyIt != m_textureColorKeys.end() && keyIt->second == key &&
+        m_texNameMap.find(texName) != m_texNameMap.end())
+    {
+        return true;
+    }
+
     CImage img;
     if (!img.Load(srcName))
     {
@@ -2433,91 +2517,32 @@ bool CEngine::ChangeTextureColor(const std::string& texName,
         changeColorsNeeded = false;
     }
 
-
-    int dx = img.GetSize().x;
-    int dy = img.GetSize().y;
-
-    int sx = static_cast<int>(Math::Max(ts.x*dx, 0));
-    int sy = static_cast<int>(Math::Max(ts.y*dy, 0));
-
-    int ex = static_cast<int>(Math::Min(ti.x*dx, dx));
-    int ey = static_cast<int>(Math::Min(ti.y*dy, dy));
-
-
-    ColorHSV cr1 = RGB2HSV(colorRef1);
-    ColorHSV cn1 = RGB2HSV(colorNew1);
-    ColorHSV cr2 = RGB2HSV(colorRef2);
-    ColorHSV cn2 = RGB2HSV(colorNew2);
-
     if (changeColorsNeeded)
     {
-        for (int y = sy; y < ey; y++)
+        SDL_Surface* surface = img.GetData()->surface;
+        bool alpha = surface->format->Amask != 0;
+        if (surface->format->BytesPerPixel != 4)
         {
-            for (int x = sx; x < ex; x++)
-            {
-                if (exclude != nullptr && IsExcludeColor(exclude, x,y) )
-                    continue;
+            img.ConvertToRGBA();
+            surface = img.GetData()->surface;
+        }
 
-                Color color = img.GetPixel(Math::IntPoint(x, y));
+        RecolorImage image;
+        image.pixels = static_cast<std::uint32_t*>(surface->pixels);
+        image.width  = surface->w;
+        image.height = surface->h;
+        image.pitch  = surface->pitch / 4;
+        image.rShift = surface->format->Rshift;
+        image.gShift = surface->format->Gshift;
+        image.bShift = surface->format->Bshift;
+        image.aShift = surface->format->Ashift;
+        image.alpha  = alpha;
 
-                if (hsv)
-                {
-                    ColorHSV c = RGB2HSV(color);
-                    if (c.s > 0.01f && fabs(c.h - cr1.h) < tolerance1)
-                    {
-                        c.h += cn1.h - cr1.h;
-                        c.s += cn1.s - cr1.s;
-                        c.v += cn1.v - cr1.v;
-                        if (c.h < 0.0f) c.h -= 1.0f;
-                        if (c.h > 1.0f) c.h += 1.0f;
-                        color = HSV2RGB(c);
-                        color.r = Math::Norm(color.r + shift);
-                        color.g = Math::Norm(color.g + shift);
-                        color.b = Math::Norm(color.b + shift);
-                        img.SetPixel(Math::IntPoint(x, y), color);
-                    }
-                    else if (tolerance2 != -1.0f &&
-                            c.s > 0.01f && fabs(c.h - cr2.h) < tolerance2)
-                    {
-                        c.h += cn2.h - cr2.h;
-                        c.s += cn2.s - cr2.s;
-                        c.v += cn2.v - cr2.v;
-                        if (c.h < 0.0f) c.h -= 1.0f;
-                        if (c.h > 1.0f) c.h += 1.0f;
-                        color = HSV2RGB(c);
-                        color.r = Math::Norm(color.r + shift);
-                        color.g = Math::Norm(color.g + shift);
-                        color.b = Math::Norm(color.b + shift);
-                        img.SetPixel(Math::IntPoint(x, y), color);
-                    }
-                }
-                else
-                {
-                    if ( fabs(color.r - colorRef1.r) +
-                        fabs(color.g - colorRef1.g) +
-                        fabs(color.b - colorRef1.b) < tolerance1 * 3.0f)
-                    {
-                        color.r = Math::Norm(colorNew1.r + color.r - colorRef1.r + shift);
-                        color.g = Math::Norm(colorNew1.g + color.g - colorRef1.g + shift);
-                        color.b = Math::Norm(colorNew1.b + color.b - colorRef1.b + shift);
-                        img.SetPixel(Math::IntPoint(x, y), color);
-                    }
-                    else if (tolerance2 != -1 &&
-                            fabs(color.r - colorRef2.r) +
-                            fabs(color.g - colorRef2.g) +
-                            fabs(color.b - colorRef2.b) < tolerance2 * 3.0f)
-                    {
-                        color.r = Math::Norm(colorNew2.r + color.r - colorRef2.r + shift);
-                        color.g = Math::Norm(colorNew2.g + color.g - colorRef2.g + shift);
-                        color.b = Math::Norm(colorNew2.b + color.b - colorRef2.b + shift);
-                        img.SetPixel(Math::IntPoint(x, y), color);
-                    }
-                }
-            }
-        }
+        RecolorPixels(image, params);
     }
 
     CreateOrUpdateTexture(texName, &img);
+    m_textureColorKeys[texName] = key;
 
     return true;
 }
@@ -2542,6 +2567,7 @@ void CEngine::DeleteTexture(const std::string& texName)
 
     m_device->DestroyTexture((*it).second);
 
+    m_textureColorKeys.erase(texName);
     m_revTexNameMap.erase(revIt);
     m_texNameMap.erase(it);
 }
@@ -2557,6 +2583,7 @@ void CEngine::DeleteTexture(const Texture& tex)
 
     m_device->DestroyTexture(tex);
 
+    m_textureColorKeys.erase((*revIt).second);
     auto it = m_texNameMap.find((*revIt).second);
 
     m_revTexNameMap.erase(revIt);
@@ -2565,6 +2592,8 @@ void CEngine::DeleteTexture(const Texture& tex)
 
 void CEngine::CreateOrUpdateTexture(const std::string& texName, CImage* img)
 {
+    m_textureColorKeys.erase(texName);
+
     auto it = m_texNameMap.find(texName);
     if (it == m_texNameMap.end())
     {
@@ -2586,6 +2615,7 @@ void CEngine::FlushTextureCache()
     m_texNameMap.clear();
     m_revTexNameMap.clear();
     m_texBlacklist.clear();
+    m_textureColorKeys.clear();
 
     m_firstGroundSpot = true;
 }
@@ -2877,6 +2907,19 @@ float CEngine::GetParticleDensity()
     return m_particleDensity;
 }
 
+void CEngine::SetParticleBudget(int value)
+{
+    // Particle channels can address at most 65536 particles
+    if (value < 500) value = 500;
+    if (value > 60000) value = 60000;
+    m_particleBudget = value;
+}
+
+int CEngine::GetParticleBudget()
+{
+    return m_particleBudget;
+}
+
 float CEngine::ParticleAdapt(float factor)
 {
     if (m_particleDensity == 0.0f)
@@ -2955,8 +2998,10 @@ void CEngine::SetShadowMapping(bool value)
     if(!value)
     {
         m_device->DeleteFramebuffer("shadow");
+        m_device->DeleteFramebuffer("shadow_static");
         m_device->DestroyTexture(m_shadowMap);
         m_shadowMap.id = 0;
+        m_shadowStaticValid = false;
     }
 }
 
@@ -2978,7 +3023,9 @@ void CEngine::SetShadowMappingOffscreen(bool value)
     else
     {
         m_device->DeleteFramebuffer("shadow");
+        m_device->DeleteFramebuffer("shadow_static");
         m_shadowMap.id = 0;
+        m_shadowStaticValid = false;
     }
 }
 
@@ -2993,7 +3040,9 @@ void CEngine::SetShadowMappingOffscreenResolution(int resolution)
     if(resolution == m_offscreenShadowRenderingResolution) return;
     m_offscreenShadowRenderingResolution = resolution;
     m_device->DeleteFramebuffer("shadow");
+    m_device->DeleteFramebuffer("shadow_static");
     m_shadowMap.id = 0;
+    m_shadowStaticValid = false;
 }
 
 int CEngine::GetShadowMappingOffscreenResolution()
@@ -3019,6 +3068,9 @@ bool CEngine::GetShadowMappingQuality()
 
 void CEngine::SetTerrainShadows(bool value)
 {
+    if (value != m_terrainShadows)
+        InvalidateStaticShadowMap();
+
     m_terrainShadows = value;
 }
 
@@ -3027,6 +3079,20 @@ bool CEngine::GetTerrainShadows()
     return m_terrainShadows;
 }
 
+void CEngine::SetShadowMappingCache(bool value)
+{
+    if (value == m_shadowMapCache) return;
+    m_shadowMapCache = value;
+    if (!value)
+        m_device->DeleteFramebuffer("shadow_static");
+    m_shadowStaticValid = false;
+}
+
+bool CEngine::GetShadowMappingCache()
+{
+    return m_shadowMapCache;
+}
+
 void CEngine::SetVSync(int value)
 {
     if (value < -1) value = -1;
@@ -3189,6 +3255,8 @@ void CEngine::Render()
         return;
 
     m_statisticTriangle = 0;
+    m_statisticVertexScan = m_geometryVertexScan;
+    m_geometryVertexScan = 0;
     m_lastState = -1;
     m_lastColor = Color(-1.0f);
     m_lastMaterial = Material();
@@ -3818,7 +3886,18 @@ void CEngine::RenderShadowMap()
             }
 
             m_shadowMap.id = framebuffer->GetDepthTexture();
+            if (m_shadowMap.id == 0)
+            {
+                GetLogger()->Error("Shadow mapping framebuffer has no depth texture, disabling dynamic shadows\n");
+                m_device->DeleteFramebuffer("shadow");
+                m_shadowMapping = false;
+                m_offscreenShadowRendering = false;
+                m_qualityShadows = false;
+                CProfiler::StopPerformanceCounter(PCNT_RENDER_SHADOW_MAP);
+                return;
+            }
             m_shadowMap.size = Math::IntPoint(width, height);
+            m_shadowStaticValid = false;
         }
         else
         {
@@ -3839,13 +3918,28 @@ void CEngine::RenderShadowMap()
         GetLogger()->Info("Created shadow map texture: %dx%d, depth %d\n", width, height, depth);
     }
 
-    if (m_offscreenShadowRendering)
+    // Static casters can be cached in a separate depth map only with offscreen rendering
+    bool useCache = m_shadowMapCache && m_offscreenShadowRendering;
+
+    if (useCache && m_device->GetFramebuffer("shadow_static") == nullptr)
     {
-        m_device->GetFramebuffer("shadow")->Bind();
+        FramebufferParams params;
+        params.width = params.height = m_shadowMap.size.x;
+        params.depth = 32;
+        params.colorAttachment = FramebufferParams::AttachmentType::None;
+        params.depthAttachment = FramebufferParams::AttachmentType::Texture;
+
+        if (m_device->CreateFramebuffer("shadow_static", params) == nullptr)
+        {
+            GetLogger()->Error("Could not create static shadow map framebuffer, disabling shadow map cache\n");
+            m_shadowMapCache = false;
+            useCache = false;
+        }
+
+        m_shadowStaticValid = false;
     }
 
     m_device->SetRenderMode(RENDER_MODE_SHADOW);
-    m_device->Clear();
 
     // change state to rendering shadow maps
     m_device->SetColorMask(false, false, false, false);
@@ -3897,19 +3991,52 @@ void CEngine::RenderShadowMap()
         pos = Math::MatrixVectorMultiply(lightRotation.Inverse(), pos);
     }
 
-    Math::Vector lookAt = pos - lightDir;
+    // With the cache, the light frustum stays where the static map was rendered
+    // until the camera moves far enough or static casters change
+    bool renderStatic = false;
+    if (useCache)
+    {
+        if (!m_shadowStaticValid)
+        {
+            renderStatic = true;
+        }
+        else if (m_shadowStaticDirty)
+        {
+            renderStatic = true;
+            m_shadowRerenderGeometry++;
+        }
+        else if (dist != m_shadowStaticDist ||
+                 Math::DistanceProjected(pos, m_shadowStaticPos) > SHADOW_CACHE_MOVE_THRESHOLD * dist)
+        {
+            renderStatic = true;
+            m_shadowRerenderFrustum++;
+        }
+
+        if (renderStatic)
+            m_shadowCacheMisses++;
+        else
+            m_shadowCacheHits++;
+    }
+
+    if (!useCache || renderStatic)
+    {
+        Math::Vector lookAt = pos - lightDir;
 
-    Math::LoadOrthoProjectionMatrix(m_shadowProjMat, -dist, dist, -dist, dist, -depth, depth);
-    Math::LoadViewMatrix(m_shadowViewMat, pos, lookAt, worldUp);
+        Math::LoadOrthoProjectionMatrix(m_shadowProjMat, -dist, dist, -dist, dist, -depth, depth);
+        Math::LoadViewMatrix(m_shadowViewMat, pos, lookAt, worldUp);
 
-    Math::Matrix scaleMat;
-    Math::LoadScaleMatrix(scaleMat, Math::Vector(1.0f, 1.0f, -1.0f));
-    m_shadowViewMat = Math::MultiplyMatrices(scaleMat, m_shadowViewMat);
+        Math::Matrix scaleMat;
+        Math::LoadScaleMatrix(scaleMat, Math::Vector(1.0f, 1.0f, -1.0f));
+        m_shadowViewMat = Math::MultiplyMatrices(scaleMat, m_shadowViewMat);
 
-    Math::Matrix temporary = Math::MultiplyMatrices(m_shadowProjMat, m_shadowViewMat);
-    m_shadowTextureMat = Math::MultiplyMatrices(m_shadowBias, temporary);
+        Math::Matrix temporary = Math::MultiplyMatrices(m_shadowProjMat, m_shadowViewMat);
+        m_shadowTextureMat = Math::MultiplyMatrices(m_shadowBias, temporary);
 
-    m_shadowViewMat = Math::MultiplyMatrices(scaleMat, m_shadowViewMat);
+        m_shadowViewMat = Math::MultiplyMatrices(scaleMat, m_shadowViewMat);
+
+        m_shadowStaticPos = pos;
+        m_shadowStaticDist = dist;
+    }
 
     m_device->SetTransform(TRANSFORM_PROJECTION, m_shadowProjMat);
     m_device->SetTransform(TRANSFORM_VIEW, m_shadowViewMat);
@@ -3918,12 +4045,83 @@ void CEngine::RenderShadowMap()
     m_device->SetTexture(1, 0);
     m_device->SetTexture(2, 0);
 
-    // render objects into shadow map
+    if (useCache)
+    {
+        CFramebuffer* staticFramebuffer = m_device->GetFramebuffer("shadow_static");
+        CFramebuffer* framebuffer = m_device->GetFramebuffer("shadow");
+
+        if (renderStatic)
+        {
+            staticFramebuffer->Bind();
+            m_device->Clear();
+
+            DrawShadowCasters(true, false);
+
+            staticFramebuffer->Unbind();
+
+            m_shadowStaticValid = true;
+            m_shadowStaticDirty = false;
+        }
+
+        // start from the cached static casters and composite dynamic ones on top
+        staticFramebuffer->CopyDepthTo(framebuffer);
+
+        framebuffer->Bind();
+        DrawShadowCasters(false, true);
+    }
+    else
+    {
+        if (m_offscreenShadowRendering)
+        {
+            m_device->GetFramebuffer("shadow")->Bind();
+        }
+
+        m_device->Clear();
+
+        DrawShadowCasters(true, true);
+    }
+
+    m_device->SetRenderState(RENDER_STATE_DEPTH_BIAS, false);
+    m_device->SetDepthBias(0.0f, 0.0f);
+    m_device->SetRenderState(RENDER_STATE_ALPHA_TEST, false);
+    m_device->SetRenderState(RENDER_STATE_CULLING, false);
+    m_device->SetCullMode(CULL_CW);
+
+    if (m_offscreenShadowRendering)     // shadow map texture already have depth information, just unbind it
+    {
+        m_device->GetFramebuffer("shadow")->Unbind();
+    }
+    else    // copy depth buffer to shadow map
+    {
+        m_device->CopyFramebufferToTexture(m_shadowMap, 0, 0, 0, 0, m_shadowMap.size.x, m_shadowMap.size.y);
+    }
+
+    // restore default state
+    m_device->SetViewport(0, 0, m_size.x, m_size.y);
+
+    m_device->SetColorMask(true, true, true, true);
+    m_device->Clear();
+
+    CProfiler::StopPerformanceCounter(PCNT_RENDER_SHADOW_MAP);
+
+    m_device->SetRenderMode(RENDER_MODE_NORMAL);
+    m_device->SetRenderState(RENDER_STATE_DEPTH_TEST, false);
+}
+
+void CEngine::DrawShadowCasters(bool staticCasters, bool dynamicCasters)
+{
     for (int objRank = 0; objRank < static_cast<int>(m_objects.size()); objRank++)
     {
         if (!m_objects[objRank].used)
             continue;
 
+        bool isStatic = IsStaticShadowCaster(objRank);
+        if (staticCasters && !dynamicCasters)
+            m_objects[objRank].shadowCached = isStatic;
+
+        if (isStatic ? !staticCasters : !dynamicCasters)
+            continue;
+
         bool terrain = (m_objects[objRank].type == ENG_OBJTYPE_TERRAIN);
 
         if (terrain)
@@ -3972,32 +4170,24 @@ void CEngine::RenderShadowMap()
             }
         }
     }
+}
 
-    m_device->SetRenderState(RENDER_STATE_DEPTH_BIAS, false);
-    m_device->SetDepthBias(0.0f, 0.0f);
-    m_device->SetRenderState(RENDER_STATE_ALPHA_TEST, false);
-    m_device->SetRenderState(RENDER_STATE_CULLING, false);
-    m_device->SetCullMode(CULL_CW);
-
-    if (m_offscreenShadowRendering)     // shadow map texture already have depth information, just unbind it
-    {
-        m_device->GetFramebuffer("shadow")->Unbind();
-    }
-    else    // copy depth buffer to shadow map
-    {
-        m_device->CopyFramebufferToTexture(m_shadowMap, 0, 0, 0, 0, m_shadowMap.size.x, m_shadowMap.size.y);
-    }
-
-    // restore default state
-    m_device->SetViewport(0, 0, m_size.x, m_size.y);
+bool CEngine::IsStaticShadowCaster(int objRank)
+{
+    const EngineObject& object = m_objects[objRank];
 
-    m_device->SetColorMask(true, true, true, true);
-    m_device->Clear();
+    if (object.shadowDynamic)
+        return false;
 
-    CProfiler::StopPerformanceCounter(PCNT_RENDER_SHADOW_MAP);
+    return object.type == ENG_OBJTYPE_TERRAIN ||
+           object.type == ENG_OBJTYPE_FIX     ||
+           object.type == ENG_OBJTYPE_QUARTZ  ||
+           object.type == ENG_OBJTYPE_METAL;
+}
 
-    m_device->SetRenderMode(RENDER_MODE_NORMAL);
-    m_device->SetRenderState(RENDER_STATE_DEPTH_TEST, false);
+void CEngine::InvalidateStaticShadowMap()
+{
+    m_shadowStaticDirty = true;
 }
 
 void CEngine::UseShadowMapping(bool enable)
@@ -4233,310 +4423,360 @@ void CEngine::DrawInterface()
     m_device->SetRenderMode(RENDER_MODE_NORMAL);
 }
 
-void CEngine::UpdateGroundSpotTextures()
+//! Computes center, pixel and half size of a ground spot or ground mark in ground spot texture space
+static void GetGroundSpotPixel(const Math::Vector& pos, float radius,
+                               Math::Point& center, Math::IntPoint& pixel, int& dot)
 {
-    if (!m_firstGroundSpot                                   &&
-        m_groundMark.drawPos.x     == m_groundMark.pos.x     &&
-        m_groundMark.drawPos.z     == m_groundMark.pos.z     &&
-        m_groundMark.drawRadius    == m_groundMark.radius    &&
-        m_groundMark.drawIntensity == m_groundMark.intensity)
-        return;
+    dot = static_cast<int>(radius/2.0f);
 
-    for (int s = 0; s < 16; s++)
+    float tu = (pos.x+1600.0f)/3200.0f;
+    float tv = (pos.z+1600.0f)/3200.0f;  // 0..1
+
+    center.x = (tu*254.0f*4.0f)-0.5f;
+    center.y = (tv*254.0f*4.0f)-0.5f;
+
+    if (dot == 0)
     {
-        Math::Point min, max;
-        min.x = (s%4) * 254.0f - 1.0f;  // 1 pixel cover
-        min.y = (s/4) * 254.0f - 1.0f;
-        max.x = min.x + 254.0f + 2.0f;
-        max.y = min.y + 254.0f + 2.0f;
+        center.x += 0.5f;
+        center.y += 0.5f;
+    }
 
-        bool clear = false;
-        bool set   = false;
+    // multiple of 1
+    pixel.x = static_cast<int>(center.x-Math::Mod(center.x, 1.0f));
+    pixel.y = static_cast<int>(center.y-Math::Mod(center.y, 1.0f));
+}
 
-        // Calculate the area to be erased.
-        int dot = static_cast<int>(m_groundMark.drawRadius/2.0f);
+//! Returns the position of ground spot texture \a s in ground spot texture space
+static Math::IntPoint GetGroundSpotTextureOrigin(int s)
+{
+    return Math::IntPoint((s%4) * 254 - 1, (s/4) * 254 - 1);  // 1 pixel cover
+}
 
-        float tu, tv;
-        float cx, cy;
+void CEngine::AddGroundSpotDirtyArea(const Math::Vector& pos, float radius)
+{
+    Math::Point center;
+    Math::IntPoint pixel;
+    int dot = 0;
+    GetGroundSpotPixel(pos, radius, center, pixel, dot);
+
+    for (int s = 0; s < 16; s++)
+    {
+        Math::IntPoint origin = GetGroundSpotTextureOrigin(s);
 
-        tu = (m_groundMark.drawPos.x+1600.0f)/3200.0f;
-        tv = (m_groundMark.drawPos.z+1600.0f)/3200.0f;  // 0..1
+        Math::IntPoint min(Math::Max(pixel.x - dot - origin.x, 0),
+                           Math::Max(pixel.y - dot - origin.y, 0));
+        Math::IntPoint max(Math::Min(pixel.x + dot + 1 - origin.x, GROUND_SPOT_TEXTURE_SIZE),
+                           Math::Min(pixel.y + dot + 1 - origin.y, GROUND_SPOT_TEXTURE_SIZE));
 
-        cx = (tu*254.0f*4.0f)-0.5f;
-        cy = (tv*254.0f*4.0f)-0.5f;
+        if (min.x >= max.x || min.y >= max.y)
+            continue;
 
-        if (dot == 0)
+        Math::IntPoint& dirtyMin = m_groundSpotDirtyMin[s];
+        Math::IntPoint& dirtyMax = m_groundSpotDirtyMax[s];
+        if (dirtyMin.x >= dirtyMax.x || dirtyMin.y >= dirtyMax.y)
         {
-            cx += 0.5f;
-            cy += 0.5f;
+            dirtyMin = min;
+            dirtyMax = max;
         }
-
-        float px = cx-Math::Mod(cx, 1.0f);
-        float py = cy-Math::Mod(cy, 1.0f);  // multiple of 1
-
-        if (m_firstGroundSpot ||
-            (m_groundMark.drawRadius != 0.0f    &&
-             px+dot >= min.x && py+dot >= min.y &&
-             px-dot <= max.x && py-dot <= max.y))
+        else
         {
-            clear = true;
+            dirtyMin = Math::IntPoint(Math::Min(dirtyMin.x, min.x), Math::Min(dirtyMin.y, min.y));
+            dirtyMax = Math::IntPoint(Math::Max(dirtyMax.x, max.x), Math::Max(dirtyMax.y, max.y));
         }
+    }
+}
+
+void CEngine::AddGroundSpotDirtyAll()
+{
+    for (int s = 0; s < 16; s++)
+    {
+        m_groundSpotDirtyMin[s] = Math::IntPoint(0, 0);
+        m_groundSpotDirtyMax[s] = Math::IntPoint(GROUND_SPOT_TEXTURE_SIZE, GROUND_SPOT_TEXTURE_SIZE);
+    }
+}
 
-        // Calculate the area to draw.
-        dot = static_cast<int>(m_groundMark.radius/2.0f);
+void CEngine::InvalidateGroundSpot(int rank)
+{
+    const EngineGroundSpot& spot = m_groundSpots[rank];
 
-        tu = (m_groundMark.pos.x+1600.0f)/3200.0f;
-        tv = (m_groundMark.pos.z+1600.0f)/3200.0f;  // 0..1
+    // Spots limited by altitude can cover any part of the ground
+    if (spot.min != 0.0f || spot.max != 0.0f)
+    {
+        AddGroundSpotDirtyAll();
+        return;
+    }
 
-        cx = (tu*254.0f*4.0f)-0.5f;
-        cy = (tv*254.0f*4.0f)-0.5f;
+    if (spot.drawRadius != 0.0f)
+        AddGroundSpotDirtyArea(spot.drawPos, spot.drawRadius);
+
+    if (spot.used && spot.radius != 0.0f)
+        AddGroundSpotDirtyArea(spot.pos, spot.radius);
+}
 
-        if ( dot == 0 )
+void CEngine::UpdateGroundSpotTextures()
+{
+    if (m_firstGroundSpot)
+    {
+        AddGroundSpotDirtyAll();
+    }
+    else if (m_groundMark.drawPos.x     != m_groundMark.pos.x     ||
+             m_groundMark.drawPos.z     != m_groundMark.pos.z     ||
+             m_groundMark.drawRadius    != m_groundMark.radius    ||
+             m_groundMark.drawIntensity != m_groundMark.intensity)
+    {
+        // Erase the previous mark and draw the new one
+        if (m_groundMark.drawRadius != 0.0f)
+            AddGroundSpotDirtyArea(m_groundMark.drawPos, m_groundMark.drawRadius);
+
+        if (m_groundMark.draw)
+            AddGroundSpotDirtyArea(m_groundMark.pos, m_groundMark.radius);
+    }
+
+    for (int s = 0; s < 16; s++)
+    {
+        std::stringstream str;
+        str << "textures/shadow" << std::setfill('0') << std::setw(2) << s << ".png";
+        std::string texName = str.str();
+
+        auto it = m_texNameMap.find(texName);
+        if (it == m_texNameMap.end())
         {
-            cx += 0.5f;
-            cy += 0.5f;
+            m_groundSpotDirtyMin[s] = Math::IntPoint(0, 0);
+            m_groundSpotDirtyMax[s] = Math::IntPoint(GROUND_SPOT_TEXTURE_SIZE, GROUND_SPOT_TEXTURE_SIZE);
         }
 
-        px = cx - Math::Mod(cx, 1.0f);
-        py = cy - Math::Mod(cy, 1.0f);  // multiple of 1
+        Math::IntPoint min = m_groundSpotDirtyMin[s];
+        Math::IntPoint max = m_groundSpotDirtyMax[s];
+        if (min.x >= max.x || min.y >= max.y)
+            continue;
 
-        if (m_groundMark.draw &&
-            px+dot >= min.x && py+dot >= min.y &&
-            px-dot <= max.x && py-dot <= max.y)
+        m_groundSpotDirtyMin[s] = m_groundSpotDirtyMax[s] = Math::IntPoint(0, 0);
+
+        CImage shadowImg(Math::IntPoint(max.x - min.x, max.y - min.y));
+        RenderGroundSpotRect(s, min, max, shadowImg);
+
+        // Upload only the changed part of the texture
+        if (it == m_texNameMap.end())
+            LoadTexture(texName, &shadowImg);
+        else
+            m_device->UpdateTexture((*it).second, min, shadowImg.GetData(), m_defaultTexParams.format);
+    }
+
+    for (int i = 0; i < static_cast<int>( m_groundSpots.size() ); i++)
+    {
+        if (m_groundSpots[i].used == false ||
+            m_groundSpots[i].radius == 0.0f)
         {
-            set = true;
+            m_groundSpots[i].drawRadius = 0.0f;
         }
-
-        if (clear || set || m_debugResources || m_displayGotoImage != nullptr)
+        else
         {
-            CImage shadowImg(Math::IntPoint(256, 256));
-            shadowImg.Fill(Gfx::IntColor(255, 255, 255, 255));
+            m_groundSpots[i].drawPos    = m_groundSpots[i].pos;
+            m_groundSpots[i].drawRadius = m_groundSpots[i].radius;
+        }
+    }
 
-            // Draw the new shadows.
-            for (int i = 0; i < static_cast<int>( m_groundSpots.size() ); i++)
-            {
-                if (m_groundSpots[i].used == false ||
-                    m_groundSpots[i].radius == 0.0f)
-                    continue;
+    m_groundMark.drawPos       = m_groundMark.pos;
+    m_groundMark.drawRadius    = m_groundMark.radius;
+    m_groundMark.drawIntensity = m_groundMark.intensity;
 
-                if (m_groundSpots[i].min == 0.0f &&
-                    m_groundSpots[i].max == 0.0f)
-                {
-                    dot = static_cast<int>(m_groundSpots[i].radius/2.0f);
+    m_firstGroundSpot = false;
+}
 
-                    tu = (m_groundSpots[i].pos.x+1600.0f)/3200.0f;
-                    tv = (m_groundSpots[i].pos.z+1600.0f)/3200.0f;  // 0..1
+void CEngine::RenderGroundSpotRect(int s, Math::IntPoint rectMin, Math::IntPoint rectMax, CImage& image)
+{
+    Math::IntPoint origin = GetGroundSpotTextureOrigin(s);
 
-                    cx = (tu*254.0f*4.0f) - 0.5f;
-                    cy = (tv*254.0f*4.0f) - 0.5f;
+    int width  = rectMax.x - rectMin.x;
+    int height = rectMax.y - rectMin.y;
 
-                    if (dot == 0)
-                    {
-                        cx += 0.5f;
-                        cy += 0.5f;
-                    }
+    // Color channels are kept in separate planes, so that the loops below can be vectorized
+    // (std::sqrt needs -fno-math-errno for that, see CMakeLists.txt)
+    std::vector<float> red(width * height, 1.0f);
+    std::vector<float> green(width * height, 1.0f);
+    std::vector<float> blue(width * height, 1.0f);
 
-                    px = cx-Math::Mod(cx, 1.0f);
-                    py = cy-Math::Mod(cy, 1.0f);  // multiple of 1
+    Math::Point center;
+    Math::IntPoint pixel;
+    int dot = 0;
 
-                    if (px+dot < min.x || py+dot < min.y ||
-                        px-dot > max.x || py-dot > max.y)
-                        continue;
+    // Draw the shadows.
+    for (int i = 0; i < static_cast<int>( m_groundSpots.size() ); i++)
+    {
+        const EngineGroundSpot& spot = m_groundSpots[i];
 
-                    for (int iy = -dot; iy <= dot; iy++)
-                    {
-                        for (int ix =- dot; ix <= dot; ix++)
-                        {
-                            float ppx = px+ix;
-                            float ppy = py+iy;
-
-                            if (ppx <  min.x || ppy <  min.y ||
-                                ppx >= max.x || ppy >= max.y)
-                                continue;
-
-                            float intensity;
-                            if (dot == 0)
-                                intensity = 0.0f;
-                            else
-                                intensity = Math::Point(ppx-cx, ppy-cy).Length()/dot;
-
-                            ppx -= min.x;  // on the texture
-                            ppy -= min.y;
-                            Math::IntPoint pp(ppx, ppy);
-
-                            Gfx::Color color = shadowImg.GetPixel(pp);
-                            color.r *= Math::Norm(m_groundSpots[i].color.r+intensity);
-                            color.g *= Math::Norm(m_groundSpots[i].color.g+intensity);
-                            color.b *= Math::Norm(m_groundSpots[i].color.b+intensity);
-                            shadowImg.SetPixel(pp, color);
-                        }
-                    }
-                }
-                else
+        if (spot.used == false || spot.radius == 0.0f)
+            continue;
+
+        if (spot.min == 0.0f && spot.max == 0.0f)
+        {
+            GetGroundSpotPixel(spot.pos, spot.radius, center, pixel, dot);
+
+            // Spot area clipped to the rectangle, in texture pixels
+            int x0 = Math::Max(pixel.x - dot - origin.x, rectMin.x);
+            int y0 = Math::Max(pixel.y - dot - origin.y, rectMin.y);
+            int x1 = Math::Min(pixel.x + dot + 1 - origin.x, rectMax.x);
+            int y1 = Math::Min(pixel.y + dot + 1 - origin.y, rectMax.y);
+            if (x0 >= x1 || y0 >= y1)
+                continue;
+
+            float invDot = (dot == 0) ? 0.0f : 1.0f / dot;
+            float cx = center.x - origin.x;
+
+            for (int y = y0; y < y1; y++)
+            {
+                float dy = y + origin.y - center.y;
+                float dy2 = dy * dy;
+
+                int row = (y - rectMin.y) * width + (x0 - rectMin.x);
+                float* r = &red[row];
+                float* g = &green[row];
+                float* b = &blue[row];
+                float dx0 = x0 - cx;
+
+                for (int k = 0; k < x1 - x0; k++)
                 {
-                    for (int iy = 0; iy < 256; iy++)
-                    {
-                        for (int ix = 0; ix < 256; ix++)
-                        {
-                            Math::Vector pos;
-                            pos.x = (256.0f * (s%4) + ix) * 3200.0f/1024.0f - 1600.0f;
-                            pos.z = (256.0f * (s/4) + iy) * 3200.0f/1024.0f - 1600.0f;
-                            pos.y = 0.0f;
-
-                            float level = m_terrain->GetFloorLevel(pos, true);
-                            if (level < m_groundSpots[i].min ||
-                                level > m_groundSpots[i].max)
-                                continue;
-
-                            float intensity;
-                            if (level > (m_groundSpots[i].max+m_groundSpots[i].min)/2.0f)
-                                intensity = 1.0f - (m_groundSpots[i].max-level) / m_groundSpots[i].smooth;
-                            else
-                                intensity = 1.0f - (level-m_groundSpots[i].min) / m_groundSpots[i].smooth;
-
-                            if (intensity < 0.0f) intensity = 0.0f;
-
-                            Math::IntPoint pp(ix, iy);
-
-                            Gfx::Color color = shadowImg.GetPixel(pp);
-                            color.r *= Math::Norm(m_groundSpots[i].color.r+intensity);
-                            color.g *= Math::Norm(m_groundSpots[i].color.g+intensity);
-                            color.b *= Math::Norm(m_groundSpots[i].color.b+intensity);
-                            shadowImg.SetPixel(pp, color);
-                        }
-                    }
+                    float dx = dx0 + k;
+                    float intensity = std::sqrt(dx*dx + dy2) * invDot;
+
+                    r[k] *= std::min(std::max(spot.color.r + intensity, 0.0f), 1.0f);
+                    g[k] *= std::min(std::max(spot.color.g + intensity, 0.0f), 1.0f);
+                    b[k] *= std::min(std::max(spot.color.b + intensity, 0.0f), 1.0f);
                 }
             }
-
-            if (set)
+        }
+        else
+        {
+            for (int y = rectMin.y; y < rectMax.y; y++)
             {
-                dot = static_cast<int>(m_groundMark.radius/2.0f);
+                int row = (y - rectMin.y) * width - rectMin.x;
 
-                tu = (m_groundMark.pos.x + 1600.0f) / 3200.0f;
-                tv = (m_groundMark.pos.z + 1600.0f) / 3200.0f;  // 0..1
+                for (int x = rectMin.x; x < rectMax.x; x++)
+                {
+                    Math::Vector pos;
+                    pos.x = (256.0f * (s%4) + x) * 3200.0f/1024.0f - 1600.0f;
+                    pos.z = (256.0f * (s/4) + y) * 3200.0f/1024.0f - 1600.0f;
+                    pos.y = 0.0f;
 
-                cx = (tu*254.0f*4.0f)-0.5f;
-                cy = (tv*254.0f*4.0f)-0.5f;
+                    float level = m_terrain->GetFloorLevel(pos, true);
+                    if (level < spot.min || level > spot.max)
+                        continue;
 
-                if (dot == 0)
-                {
-                    cx += 0.5f;
-                    cy += 0.5f;
-                }
+                    float intensity;
+                    if (level > (spot.max+spot.min)/2.0f)
+                        intensity = 1.0f - (spot.max-level) / spot.smooth;
+                    else
+                        intensity = 1.0f - (level-spot.min) / spot.smooth;
 
-                px = cx-Math::Mod(cx, 1.0f);
-                py = cy-Math::Mod(cy, 1.0f);  // multiple of 1
+                    if (intensity < 0.0f) intensity = 0.0f;
 
-                for (int iy = -dot; iy <= dot; iy++)
-                {
-                    for (int ix = -dot; ix <= dot; ix++)
-                    {
-                        float ppx = px+ix;
-                        float ppy = py+iy;
-
-                        if (ppx <  min.x || ppy <  min.y ||
-                            ppx >= max.x || ppy >= max.y)
-                            continue;
-
-                        ppx -= min.x;  // on the texture
-                        ppy -= min.y;
-
-                        float intensity = 1.0f - Math::Point(ix, iy).Length() / dot;
-                        if (intensity <= 0.0f)
-                            continue;
-
-                        intensity *= m_groundMark.intensity;
-
-                        int j = (ix+dot) + (iy+dot) * m_groundMark.dx;
-                        if (m_groundMark.table[j] == 1)  // green ?
-                        {
-                            Math::IntPoint pp(ppx, ppy);
-                            Gfx::Color color = shadowImg.GetPixel(pp);
-                            color.r *= Math::Norm(1.0f-intensity);
-                            color.g *= 1.0f;
-                            color.b *= Math::Norm(1.0f-intensity);
-                            shadowImg.SetPixel(pp, color);
-                        }
-                        if (m_groundMark.table[j] == 2)  // red ?
-                        {
-                            Math::IntPoint pp(ppx, ppy);
-                            Gfx::Color color = shadowImg.GetPixel(pp);
-                            color.r *= 1.0f;
-                            color.g *= Math::Norm(1.0f-intensity);
-                            color.b *= Math::Norm(1.0f-intensity);
-                            shadowImg.SetPixel(pp, color);
-                        }
-                    }
+                    red[row + x]   *= Math::Norm(spot.color.r+intensity);
+                    green[row + x] *= Math::Norm(spot.color.g+intensity);
+                    blue[row + x]  *= Math::Norm(spot.color.b+intensity);
                 }
             }
+        }
+    }
 
-            if (m_debugResources)
+    // Draw the ground mark.
+    GetGroundSpotPixel(m_groundMark.pos, m_groundMark.radius, center, pixel, dot);
+
+    if (m_groundMark.draw && dot != 0)
+    {
+        int x0 = Math::Max(pixel.x - dot - origin.x, rectMin.x);
+        int y0 = Math::Max(pixel.y - dot - origin.y, rectMin.y);
+        int x1 = Math::Min(pixel.x + dot + 1 - origin.x, rectMax.x);
+        int y1 = Math::Min(pixel.y + dot + 1 - origin.y, rectMax.y);
+
+        for (int y = y0; y < y1; y++)
+        {
+            int iy = y + origin.y - pixel.y;
+            int row = (y - rectMin.y) * width - rectMin.x;
+
+            for (int x = x0; x < x1; x++)
             {
-                for (float x = min.x; x < max.x; x += 1.0f)
+                int ix = x + origin.x - pixel.x;
+
+                float intensity = 1.0f - Math::Point(ix, iy).Length() / dot;
+                if (intensity <= 0.0f)
+                    continue;
+
+                intensity *= m_groundMark.intensity;
+
+                int j = (ix+dot) + (iy+dot) * m_groundMark.dx;
+                if (m_groundMark.table[j] == 1)  // green ?
                 {
-                    for (float y = min.y; y < max.y; y += 1.0f)
-                    {
-                        Math::Vector pos(
-                            x / 4.0f / 254.0f * 3200.0f - 1600.0f,
-                            0.0f,
-                            y / 4.0f / 254.0f * 3200.0f - 1600.0f
-                        );
-                        TerrainRes res = m_terrain->GetResource(pos);
-                        Math::IntPoint p(x-min.x, y-min.y);
-                        if (res == TR_NULL)
-                        {
-                            shadowImg.SetPixel(p, Gfx::Color(0.5f, 0.5f, 0.5f));
-                            continue;
-                        }
-                        shadowImg.SetPixelInt(p, ResourceToColor(res));
-                    }
+                    red[row + x]  *= Math::Norm(1.0f-intensity);
+                    blue[row + x] *= Math::Norm(1.0f-intensity);
                 }
-            }
-
-            if (m_displayGotoImage != nullptr)
-            {
-                Math::IntPoint size = m_displayGotoImage->GetSize();
-                for (float x = min.x; x < max.x; x += 1.0f)
+                if (m_groundMark.table[j] == 2)  // red ?
                 {
-                    for (float y = min.y; y < max.y; y += 1.0f)
-                    {
-                        int px = x / 4.0f / 254.0f * size.x;
-                        int py = y / 4.0f / 254.0f * size.y;
-                        // This can happen because the shadow??.png textures have a 1 pixel margin around them
-                        if (px < 0 || px >= size.x || py < 0 || py >= size.y)
-                            continue;
-                        shadowImg.SetPixelInt(Math::IntPoint(x-min.x, y-min.y), m_displayGotoImage->GetPixelInt(Math::IntPoint(px, py)));
-                    }
+                    green[row + x] *= Math::Norm(1.0f-intensity);
+                    blue[row + x]  *= Math::Norm(1.0f-intensity);
                 }
             }
+        }
+    }
+
+    SDL_Surface* surface = image.GetData()->surface;
+    SDL_PixelFormat* format = surface->format;
+    assert(format->BytesPerPixel == 4);
 
-            std::stringstream str;
-            str << "textures/shadow" << std::setfill('0') << std::setw(2) << s << ".png";
-            std::string texName = str.str();
+    for (int y = 0; y < height; y++)
+    {
+        Uint32* dest = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+        const float* r = &red[y * width];
+        const float* g = &green[y * width];
+        const float* b = &blue[y * width];
 
-            CreateOrUpdateTexture(texName, &shadowImg);
+        for (int x = 0; x < width; x++)
+        {
+            dest[x] = (static_cast<Uint32>(r[x] * 255.0f) << format->Rshift) |
+                      (static_cast<Uint32>(g[x] * 255.0f) << format->Gshift) |
+                      (static_cast<Uint32>(b[x] * 255.0f) << format->Bshift) |
+                      format->Amask;
         }
     }
 
-    for (int i = 0; i < static_cast<int>( m_groundSpots.size() ); i++)
+    if (m_debugResources)
     {
-        if (m_groundSpots[i].used == false ||
-            m_groundSpots[i].radius == 0.0f)
+        for (int x = rectMin.x; x < rectMax.x; x++)
         {
-            m_groundSpots[i].drawRadius = 0.0f;
+            for (int y = rectMin.y; y < rectMax.y; y++)
+            {
+                Math::Vector pos(
+                    (x + origin.x) / 4.0f / 254.0f * 3200.0f - 1600.0f,
+                    0.0f,
+                    (y + origin.y) / 4.0f / 254.0f * 3200.0f - 1600.0f
+                );
+                TerrainRes res = m_terrain->GetResource(pos);
+                Math::IntPoint p(x-rectMin.x, y-rectMin.y);
+                if (res == TR_NULL)
+                {
+                    image.SetPixel(p, Gfx::Color(0.5f, 0.5f, 0.5f));
+                    continue;
+                }
+                image.SetPixelInt(p, ResourceToColor(res));
+            }
         }
-        else
+    }
+
+    if (m_displayGotoImage != nullptr)
+    {
+        Math::IntPoint size = m_displayGotoImage->GetSize();
+        for (int x = rectMin.x; x < rectMax.x; x++)
         {
-            m_groundSpots[i].drawPos    = m_groundSpots[i].pos;
-            m_groundSpots[i].drawRadius = m_groundSpots[i].radius;
+            for (int y = rectMin.y; y < rectMax.y; y++)
+            {
+                int px = (x + origin.x) / 4.0f / 254.0f * size.x;
+                int py = (y + origin.y) / 4.0f / 254.0f * size.y;
+                // This can happen because the shadow??.png textures have a 1 pixel margin around them
+                if (px < 0 || px >= size.x || py < 0 || py >= size.y)
+                    continue;
+                image.SetPixelInt(Math::IntPoint(x-rectMin.x, y-rectMin.y), m_displayGotoImage->GetPixelInt(Math::IntPoint(px, py)));
+            }
         }
     }
-
-    m_groundMark.drawPos       = m_groundMark.pos;
-    m_groundMark.drawRadius    = m_groundMark.radius;
-    m_groundMark.drawIntensity = m_groundMark.intensity;
-
-    m_firstGroundSpot = false;
 }
 
 void CEngine::DrawShadowSpots()
@@ -5140,7 +5380,7 @@ void CEngine::DrawStats()
 
     float height = m_text->GetAscent(FONT_COMMON, 13.0f);
     float width = 0.4f;
-    const int TOTAL_LINES = 22;
+    const int TOTAL_LINES = 27;
 
     Math::Point pos(0.05f * m_size.x/m_size.y, 0.05f + TOTAL_LINES * height);
 
@@ -5226,8 +5466,20 @@ void CEngine::DrawStats()
     drawStatsCounter("    Shadow map render", PCNT_RENDER_SHADOW_MAP);
     drawStatsValue(  "    Other render",      otherRender);
     drawStatsCounter("Swap buffers & VSync",  PCNT_SWAP_BUFFERS);
+    drawStatsCounter("Jobs (all threads)",    PCNT_JOBS);
     drawStatsLine(   "", "", "");
     drawStatsLine(   "Triangles",         StrUtils::ToString<int>(m_statisticTriangle), "");
+    drawStatsLine(   "Vertices scanned",  StrUtils::ToString<int>(m_statisticVertexScan), "");
+    drawStatsLine(   "Particles",
+                     StrUtils::Format("%d/%d", m_particle->GetParticleCount(), m_particleBudget),
+                     StrUtils::Format("peak %d, culled %d", m_particle->GetParticlePeak(), m_particle->GetParticleCulled()));
+    int shadowFrames = m_shadowCacheHits + m_shadowCacheMisses;
+    drawStatsLine(   "Shadow cache hits",
+                     shadowFrames > 0 ? StrUtils::Format("%.1f%%", 100.0f * m_shadowCacheHits / shadowFrames) : "off",
+                     StrUtils::Format("%d/%d", m_shadowCacheHits, shadowFrames));
+    drawStatsLine(   "Shadow re-renders",
+                     StrUtils::Format("frustum %d", m_shadowRerenderFrustum),
+                     StrUtils::Format("geometry %d", m_shadowRerenderGeometry));
     drawStatsLine(   "FPS",               StrUtils::Format("%.3f", m_fps), "");
     drawStatsLine(   "", "", "");
     std::stringstream str;
@@ -70,6 +70,7 @@ class CLightning;
 class CPlanet;
 class CTerrain;
 class CPyroManager;
+class CRayQuery;
 class CModelMesh;
 struct ModelShadowSpot;
 struct ModelTriangle;
@@ -283,6 +284,10 @@ struct EngineObject
     int                    shadowRank = -1;
     //! Transparency of the object [0, 1]
     float                  transparency = 0.0f;
+    //! If true, the object is drawn into the cached static shadow map
+    bool                   shadowCached = false;
+    //! If true, the object moved after being cached and is drawn as a dynamic shadow caster
+    bool                   shadowDynamic = false;
 
     //! Loads default values
     inline void LoadDefault()
@@ -584,6 +589,8 @@ enum EngineMouseType
  */
 class CEngine : public CSingleton<CEngine>
 {
+    friend class CRayQuery;
+
 public:
     CEngine(CApplication* app, CSystemUtils* systemUtils);
     ~CEngine();
@@ -611,6 +618,8 @@ public:
     CPlanet*        GetPlanet();
     //! Returns the fog manager
     CCloud*         GetCloud();
+    //! Returns the ray query service
+    CRayQuery*      GetRayQuery();
 
     //! Sets the terrain object
     void            SetTerrain(CTerrain* terrain);
@@ -633,8 +642,8 @@ public:
     void            FrameUpdate();
 
 
-    //! Writes a screenshot containing the current frame
-    void            WriteScreenShot(const std::string& fileName);
+    //! Returns an image of the current frame
+    std::unique_ptr<CImage> CaptureScreenShot();
 
 
     //@{
@@ -808,6 +817,8 @@ public:
     //! Detects the target object that is selected with the mouse
     /** Returns the rank of the object or -1. */
     int             DetectObject(Math::Point mouse, Math::Vector& targetPos, bool terrain = false);
+    //! Computes the world space ray going through the given mouse position
+    void            GetMouseRay(Math::Point mouse, Math::Vector& origin, Math::Vector& dir);
 
     //! Creates a shadow for the given object
     void            CreateShadowSpot(int objRank);
@@ -880,6 +891,10 @@ public:
     Texture         LoadTexture(const std::string& name, const TextureCreateParams& params);
     //! Loads all necessary textures
     bool            LoadAllTextures();
+    //! Defers LoadAllTextures() until EndTextureBatch(), so that textures of a whole scene are loaded together
+    void            BeginTextureBatch();
+    //! Loads textures deferred since BeginTextureBatch() and logs the time spent loading textures
+    void            EndTextureBatch();
 
     //! Changes colors in a texture
     //@{
@@ -1024,6 +1039,13 @@ public:
     float           GetParticleDensity();
     //@}
 
+    //@{
+    //! Management of the maximum number of live particles
+    // NOTE: This is an user configuration setting
+    void            SetParticleBudget(int value);
+    int             GetParticleBudget();
+    //@}
+
     //! Adapts particle factor according to particle density
     float           ParticleAdapt(float factor);
 
@@ -1070,6 +1092,8 @@ public:
     bool            GetShadowMappingQuality();
     void            SetTerrainShadows(bool value);
     bool            GetTerrainShadows();
+    void            SetShadowMappingCache(bool value);
+    bool            GetShadowMappingCache();
     //@}
 
     //@{
@@ -1206,6 +1230,12 @@ protected:
     void        DrawCaptured3DScene();
     //! Renders shadow map
     void        RenderShadowMap();
+    //! Draws shadow casters into the bound shadow map, selecting static and/or dynamic ones
+    void        DrawShadowCasters(bool staticCasters, bool dynamicCasters);
+    //! Returns true if the object is drawn into the cached static shadow map
+    bool        IsStaticShadowCaster(int objRank);
+    //! Marks the cached static shadow map for re-rendering
+    void        InvalidateStaticShadowMap();
     //! Enables or disables shadow mapping
     void        UseShadowMapping(bool enable);
     //! Enables or disables MSAA
@@ -1215,6 +1245,15 @@ protected:
     //! Draws the user interface over the scene
     void        DrawInterface();
 
+    //! Marks the area of a ground spot or ground mark for regeneration of ground spot textures
+    void        AddGroundSpotDirtyArea(const Math::Vector& pos, float radius);
+    //! Marks all ground spot textures for regeneration
+    void        AddGroundSpotDirtyAll();
+    //! Marks the areas where given ground spot was and will be drawn for regeneration
+    void        InvalidateGroundSpot(int rank);
+    //! Generates part of ground spot texture \a s into \a image
+    void        RenderGroundSpotRect(int s, Math::IntPoint rectMin, Math::IntPoint rectMax, CImage& image);
+
     //! Draws old-style shadow spots
     void        DrawShadowSpots();
     //! Draws the gradient background
@@ -1249,19 +1288,15 @@ protected:
 
     //! Create texture and add it to cache
     Texture CreateTexture(const std::string &texName, const TextureCreateParams &params, CImage* image = nullptr);
+    //! Creates textures not present yet, decoding their images in parallel
+    void    PreloadTextures(const std::vector<std::pair<std::string, TextureCreateParams>>& textures);
 
     //! Tests whether the given object is visible
     bool        IsVisible(int objRank);
 
-    //! Detects whether an object is affected by the mouse
-    bool        DetectBBox(int objRank, Math::Point mouse);
-
     //! Compute and return the 2D box on screen of any object
     bool        GetBBox2D(int objRank, Math::Point& min, Math::Point& max);
 
-    //! Detects whether the mouse is in a triangle.
-    bool        DetectTriangle(Math::Point mouse, VertexTex2* triangle, int objRank, float& dist, Math::Vector& pos);
-
     //! Transforms a 3D point (x, y, z) in 2D space (x, y, -) of the window
     /** The coordinated p2D.z gives the distance. */
     bool        TransformPoint(Math::Vector& p2D, int objRank, Math::Vector p3D);
@@ -1269,8 +1304,10 @@ protected:
     //! Calculates the distances between the viewpoint and the origin of different objects
     void        ComputeDistance();
 
-    //! Updates geometric parameters of objects (bounding box and radius)
+    //! Updates geometric parameters of changed objects (bounding box and radius)
     void        UpdateGeometry();
+    //! Extends the bounding box of base object to include the given vertices
+    void        ExtendBaseObjBBox(EngineBaseObject& p1, const std::vector<VertexTex2>& vertices);
 
     //! Updates a given static buffer
     void        UpdateStaticBuffer(EngineBaseObjDataTier& p4);
@@ -1284,13 +1321,6 @@ protected:
 
     int GetEngineState(const ModelTriangle& triangle);
 
-    struct WriteScreenShotData
-    {
-        std::unique_ptr<CImage> img;
-        std::string fileName;
-    };
-    static void WriteScreenShotThread(std::unique_ptr<WriteScreenShotData> data);
-
 protected:
     CApplication*     m_app;
     CSystemUtils*     m_systemUtils;
@@ -1306,6 +1336,7 @@ protected:
     std::unique_ptr<CLightning>       m_lightning;
     std::unique_ptr<CPlanet>          m_planet;
     std::unique_ptr<CPyroManager> m_pyroManager;
+    std::unique_ptr<CRayQuery>    m_rayQuery;
 
     //! Last encountered error
     std::string     m_error;
@@ -1343,6 +1374,23 @@ protected:
     //! Texture bias for sampling shadow maps
     Math::Matrix    m_shadowBias;
 
+    //! true if the cached static shadow map holds valid data
+    bool            m_shadowStaticValid;
+    //! true if static shadow casters changed since the cached map was rendered
+    bool            m_shadowStaticDirty;
+    //! Light position the cached static shadow map was rendered for
+    Math::Vector    m_shadowStaticPos;
+    //! Light range the cached static shadow map was rendered for
+    float           m_shadowStaticDist;
+    //! Frames which reused the cached static shadow map
+    int             m_shadowCacheHits;
+    //! Frames which had to re-render the cached static shadow map
+    int             m_shadowCacheMisses;
+    //! Re-renders caused by the light frustum moving too far
+    int             m_shadowRerenderFrustum;
+    //! Re-renders caused by changes of static shadow casters
+    int             m_shadowRerenderGeometry;
+
     //! Vertical synchronization controll
     int m_vsync;
 
@@ -1381,10 +1429,19 @@ protected:
     float           m_fogStart[2];
     Color           m_waterAddColor;
     int             m_statisticTriangle;
+    //! Number of vertices scanned for bounding boxes since the last rendered frame
+    int             m_geometryVertexScan;
+    //! Number of vertices scanned for bounding boxes in the last frame (displayed in stats)
+    int             m_statisticVertexScan;
     Math::Vector    m_statisticPos;
-    bool            m_updateGeometry;
-    bool            m_updateStaticBuffers;
+    //! Ranks of base objects whose bounding box and sphere need to be recomputed
+    std::set<int>   m_updateGeometryRanks;
+    //! Ranks of base objects which have static buffers waiting for upload
+    std::set<int>   m_updateStaticBufferRanks;
     bool            m_firstGroundSpot;
+    //! Parts of ground spot textures to regenerate, in texture pixels (max is exclusive)
+    Math::IntPoint  m_groundSpotDirtyMin[16];
+    Math::IntPoint  m_groundSpotDirtyMax[16];
     std::string     m_secondTex;
     bool            m_backgroundFull;
     bool            m_backgroundScale;
@@ -1409,6 +1466,7 @@ protected:
     bool            m_dirty;
     bool            m_fog;
     float           m_particleDensity;
+    int             m_particleBudget;
     float           m_clippingDistance;
     bool            m_lightMode;
     bool            m_editIndentMode;
@@ -1454,6 +1512,8 @@ protected:
     bool m_qualityShadows;
     //! true enables casting shadows by terrain
     bool m_terrainShadows;
+    //! true enables caching of static shadow casters
+    bool m_shadowMapCache;
     //! Shadow color
     float m_shadowColor;
     //! Shadow range
@@ -1469,6 +1529,16 @@ protected:
     /** Textures on this list were not successful in first loading,
      *  so are disabled for subsequent load calls. */
     std::set<std::string> m_texBlacklist;
+    //! Parameters of ChangeTextureColor() which gave their content to textures, by name
+    std::map<std::string, std::string> m_textureColorKeys;
+
+    //! Whether LoadAllTextures() is deferred, see BeginTextureBatch()
+    bool            m_textureBatch = false;
+    //! Number of textures loaded by PreloadTextures() since BeginTextureBatch()
+    int             m_textureLoadCount = 0;
+    //! Time spent decoding images and uploading textures since BeginTextureBatch(), in seconds
+    float           m_textureDecodeTime = 0.0f;
+    float           m_textureUploadTime = 0.0f;
 
     //! Texture with mouse cursors
     Texture         m_miceTexture;
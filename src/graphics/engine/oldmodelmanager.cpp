@@ -22,16 +22,22 @@
 #include "app/app.h"
 
 #include "common/logger.h"
+#include "common/make_unique.h"
 #include "common/stringutils.h"
 
 #include "common/resources/inputstream.h"
 
+#include "common/thread/job_system.h"
+
 #include "graphics/engine/engine.h"
 
 #include "graphics/model/model_input.h"
 #include "graphics/model/model_io_exception.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <limits>
+
 
 namespace Gfx
 {
@@ -45,10 +51,8 @@ COldModelManager::~COldModelManager()
 {
 }
 
-bool COldModelManager::LoadModel(const std::string& fileName, bool mirrored, int variant)
+bool COldModelManager::ReadModel(const std::string& fileName, std::vector<ModelTriangle>& triangles)
 {
-    GetLogger()->Debug("Loading model '%s'\n", fileName.c_str());
-
     CModel model;
     try
     {
@@ -79,9 +83,30 @@ bool COldModelManager::LoadModel(const std::string& fileName, bool mirrored, int
     CModelMesh* mesh = model.GetMesh("main");
     assert(mesh != nullptr);
 
+    triangles = mesh->GetTriangles();
+    return true;
+}
+
+bool COldModelManager::LoadModel(const std::string& fileName, bool mirrored, int variant)
+{
+    RecordUsedFile(fileName);
+
     ModelInfo modelInfo;
+
+    auto it = m_preloaded.find(fileName);
+    if (it != m_preloaded.end())
+    {
+        GetLogger()->Debug("Loading preloaded model '%s'\n", fileName.c_str());
+        modelInfo.triangles = it->second;  // other variants may still need it
+    }
+    else
+    {
+        GetLogger()->Debug("Loading model '%s'\n", fileName.c_str());
+        if (!ReadModel(fileName, modelInfo.triangles))
+            return false;
+    }
+
     modelInfo.baseObjRank = m_engine->CreateBaseObject();
-    modelInfo.triangles = mesh->GetTriangles();
 
     if (mirrored)
         Mirror(modelInfo.triangles);
@@ -99,6 +124,8 @@ bool COldModelManager::LoadModel(const std::string& fileName, bool mirrored, int
 
 bool COldModelManager::AddModelReference(const std::string& fileName, bool mirrored, int objRank, int variant)
 {
+    RecordUsedFile(fileName);
+
     auto it = m_models.find(FileInfo(fileName, mirrored, variant));
     if (it == m_models.end())
     {
@@ -115,6 +142,8 @@ bool COldModelManager::AddModelReference(const std::string& fileName, bool mirro
 
 bool COldModelManager::AddModelCopy(const std::string& fileName, bool mirrored, int objRank, int variant)
 {
+    RecordUsedFile(fileName);
+
     auto it = m_models.find(FileInfo(fileName, mirrored, variant));
     if (it == m_models.end())
     {
@@ -176,6 +205,81 @@ void COldModelManager::UnloadAllModels()
     m_models.clear();
 }
 
+int COldModelManager::PreloadModels(const std::vector<std::string>& fileNames)
+{
+    std::vector<std::string> missing;
+    for (const std::string& fileName : fileNames)
+    {
+        if (m_preloaded.find(fileName) != m_preloaded.end()) continue;
+        if (std::find(missing.begin(), missing.end(), fileName) != missing.end()) continue;
+
+        // Models are sorted by file name first, so any loaded variant is found here
+        auto it = m_models.lower_bound(FileInfo(fileName, false, std::numeric_limits<int>::min()));
+        if (it != m_models.end() && it->first.fileName == fileName) continue;
+
+        missing.push_back(fileName);
+    }
+
+    if (missing.empty())
+        return 0;
+
+    // Reading uses only PhysFS and the model parser, creating base objects is left to the main thread
+    int count = missing.size();
+    std::vector<std::vector<ModelTriangle>> triangles(count);
+    std::vector<char> loaded(count, false);
+    auto read = [&](int first, int last)
+    {
+        for (int i = first; i < last; i++)
+            loaded[i] = ReadModel(missing[i], triangles[i]);
+    };
+    if (CJobSystem::IsCreated())
+        CJobSystem::GetInstancePointer()->ParallelFor(count, 1, read);
+    else
+        read(0, count);
+
+    int preloaded = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!loaded[i]) continue;
+
+        m_preloaded[missing[i]] = std::move(triangles[i]);
+        preloaded++;
+    }
+    return preloaded;
+}
+
+void COldModelManager::ClearPreloadedModels()
+{
+    m_preloaded.clear();
+}
+
+int COldModelManager::GetPreloadThreadCount()
+{
+    return CJobSystem::IsCreated() ? CJobSystem::GetInstancePointer()->GetWorkerCount() + 1 : 1;
+}
+
+void COldModelManager::BeginRecordUsedFiles()
+{
+    m_recordUsedFiles = true;
+    m_usedFiles.clear();
+}
+
+std::vector<std::string> COldModelManager::EndRecordUsedFiles()
+{
+    m_recordUsedFiles = false;
+    std::vector<std::string> usedFiles;
+    usedFiles.swap(m_usedFiles);
+    return usedFiles;
+}
+
+void COldModelManager::RecordUsedFile(const std::string& fileName)
+{
+    if (!m_recordUsedFiles) return;
+
+    if (std::find(m_usedFiles.begin(), m_usedFiles.end(), fileName) == m_usedFiles.end())
+        m_usedFiles.push_back(fileName);
+}
+
 void COldModelManager::Mirror(std::vector<ModelTriangle>& triangles)
 {
     for (int i = 0; i < static_cast<int>( triangles.size() ); i++)
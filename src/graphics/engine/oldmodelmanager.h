@@ -80,11 +80,30 @@ public:
     //! Unloads all models
     void UnloadAllModels();
 
+    /**
+     * \brief Reads given model files on worker threads, so that loading them later only creates base objects
+     * \return number of files read
+     */
+    int PreloadModels(const std::vector<std::string>& fileNames);
+    //! Frees models read by PreloadModels() which weren't used
+    void ClearPreloadedModels();
+    //! Returns the number of threads used by PreloadModels()
+    int GetPreloadThreadCount();
+
+    //! Starts recording the files of models added to objects
+    void BeginRecordUsedFiles();
+    //! Stops recording and returns the files of models added to objects since BeginRecordUsedFiles()
+    std::vector<std::string> EndRecordUsedFiles();
+
 protected:
     //! Mirrors the model along the Z axis
     void Mirror(std::vector<ModelTriangle>& triangles);
     //! Changes variant
     void ChangeVariant(std::vector<ModelTriangle>& triangles, int variant);
+    //! Reads triangles of the main mesh of a model file, may be called from any thread
+    static bool ReadModel(const std::string& fileName, std::vector<ModelTriangle>& triangles);
+    //! Records a file for EndRecordUsedFiles()
+    void RecordUsedFile(const std::string& fileName);
 
 private:
     struct ModelInfo
@@ -121,6 +140,11 @@ private:
     std::map<FileInfo, ModelInfo> m_models;
     std::vector<int> m_copiesBaseRanks;
     CEngine* m_engine;
+
+    //! Triangles read by PreloadModels(), by file name
+    std::map<std::string, std::vector<ModelTriangle>> m_preloaded;
+    bool m_recordUsedFiles = false;
+    std::vector<std::string> m_usedFiles;
 };
 
 } // namespace Gfx
@@ -36,6 +36,7 @@
 #include "math/geometry.h"
 
 #include "object/object.h"
+#include "object/object_grid.h"
 #include "object/object_manager.h"
 
 #include "object/interface/damageable_object.h"
@@ -44,6 +45,7 @@
 
 #include "sound/sound.h"
 
+#include <algorithm>
 #include <cstring>
 
 
@@ -56,21 +58,6 @@ const float FOG_HSUP    = 10.0f;
 const float FOG_HINF    = 100.0f;
 
 
-//! Check if an object is a destroyable enemy
-static bool IsAlien(ObjectType type)
-{
-    return ( type == OBJECT_ANT      ||
-             type == OBJECT_SPIDER   ||
-             type == OBJECT_BEE      ||
-             type == OBJECT_WORM     ||
-             type == OBJECT_MOTHER   ||
-             type == OBJECT_NEST     ||
-             type == OBJECT_BULLET   ||
-             type == OBJECT_EGG      ||
-             type == OBJECT_TEEN28   ||
-             type == OBJECT_TEEN31   );
-}
-
 CParticle::CParticle(CEngine* engine)
     : m_engine(engine)
 {
@@ -88,8 +75,8 @@ void CParticle::SetDevice(CDevice* device)
 
 void CParticle::FlushParticle()
 {
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
-        m_particle[i].used = false;
+    for (int i = 0; i < m_particle.GetCount(); i++)
+        m_particle.used[i] = false;
 
     for (int i = 0; i < MAXPARTITYPE; i++)
     {
@@ -99,10 +86,10 @@ void CParticle::FlushParticle()
         }
     }
 
-    for (int i = 0; i < MAXTRACK; i++)
-        m_track[i].used = false;
+    m_track.clear();
+    m_freeTracks.clear();
 
-    m_wheelTraceTotal = 0;
+    m_wheelTrace.clear();
     m_wheelTraceIndex = 0;
 
     for (int i = 0; i < SH_MAX; i++)
@@ -110,27 +97,27 @@ void CParticle::FlushParticle()
 
     m_fogTotal = 0;
     m_exploGunCounter = 0;
+    m_particlePeak = 0;
+    m_particleCulled = 0;
+    m_cullExhausted = false;
 }
 
 void CParticle::FlushParticle(int sheet)
 {
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
+    for (int i = 0; i < m_particle.GetCount(); i++)
     {
-        if (!m_particle[i].used) continue;
-        if (m_particle[i].sheet != sheet) continue;
+        if (!m_particle.used[i]) continue;
+        if (m_particle.sheet[i] != sheet) continue;
 
-        m_particle[i].used = false;
+        DeleteRank(i);
     }
 
     for (int i = 0; i < MAXPARTITYPE; i++)
         m_totalInterface[i][sheet] = 0;
 
-    for (int i = 0; i < MAXTRACK; i++)
-        m_track[i].used = false;
-
     if (sheet == SH_WORLD)
     {
-        m_wheelTraceTotal = 0;
+        m_wheelTrace.clear();
         m_wheelTraceIndex = 0;
     }
 }
@@ -287,71 +274,64 @@ int CParticle::CreateParticle(Math::Vector pos, Math::Vector speed, Math::Point
     if (t >= MAXPARTITYPE) return -1;
     if (t == -1) return -1;
 
-    for (int j = 0; j < MAXPARTICULE; j++)
+    int i = AllocParticle(type, sheet, pos);
+    if (i == -1) return -1;
+
+    m_particle.used[i]      = true;
+    m_particle.partiType[i] = t;
+    m_particle.ray[i]       = false;
+    m_particle.uniqueStamp[i] = m_uniqueStamp++;
+    m_particle.sheet[i]     = sheet;
+    m_particle.mass[i]      = mass;
+    m_particle.duration[i]  = duration;
+    m_particle.pos[i]       = pos;
+    m_particle.goal[i]      = pos;
+    m_particle.speed[i]     = speed;
+    m_particle.windSensitivity[i] = windSensitivity;
+    m_particle.dim[i]       = dim;
+    m_particle.zoom[i]      = 1.0f;
+    m_particle.angle[i]     = 0.0f;
+    m_particle.intensity[i] = 1.0f;
+    m_particle.type[i]      = type;
+    m_particle.phase[i]     = PARPHSTART;
+    m_particle.texSup[i].x  = 0.0f;
+    m_particle.texSup[i].y  = 0.0f;
+    m_particle.texInf[i].x  = 0.0f;
+    m_particle.texInf[i].y  = 0.0f;
+    m_particle.time[i]      = 0.0f;
+    m_particle.phaseTime[i] = 0.0f;
+    m_particle.testTime[i]  = 0.0f;
+    m_particle.objLink[i]   = nullptr;
+    m_particle.objFather[i] = nullptr;
+    m_particle.trackRank[i] = -1;
+
+    m_totalInterface[t][sheet] ++;
+
+    if ( type == PARTIEXPLOT ||
+         type == PARTIEXPLOO )
     {
-        int i = MAXPARTICULE*t+j;
-
-        if (! m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = false;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = mass;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = pos;
-            m_particle[i].speed     = speed;
-            m_particle[i].windSensitivity = windSensitivity;
-            m_particle[i].dim       = dim;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].objLink   = nullptr;
-            m_particle[i].objFather = nullptr;
-            m_particle[i].trackRank = -1;
-
-            m_totalInterface[t][sheet] ++;
-
-            if ( type == PARTIEXPLOT ||
-                 type == PARTIEXPLOO )
-            {
-                m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
-            }
-
-            if ( type == PARTIGUN1 ||
-                 type == PARTIGUN4 )
-            {
-                m_particle[i].testTime = 1.0f;  // impact immediately
-            }
+        m_particle.angle[i] = Math::Rand()*Math::PI*2.0f;
+    }
 
-            if ( type == PARTIVIRUS )
-            {
-                m_particle[i].text = RandomLetter();
-            }
+    if ( type == PARTIGUN1 ||
+         type == PARTIGUN4 )
+    {
+        m_particle.testTime[i] = 1.0f;  // impact immediately
+    }
 
-            if ( type >= PARTIFOG0 &&
-                 type <= PARTIFOG7 )
-            {
-                if (m_fogTotal < MAXPARTIFOG)
-                m_fog[m_fogTotal++] = i;
-            }
+    if ( type == PARTIVIRUS )
+    {
+        m_particle.text[i] = RandomLetter();
+    }
 
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
+    if ( type >= PARTIFOG0 &&
+         type <= PARTIFOG7 )
+    {
+        if (m_fogTotal < MAXPARTIFOG)
+        m_fog[m_fogTotal++] = m_particle.handle[i] | ((m_particle.uniqueStamp[i]&0xffff)<<16);
     }
 
-    return -1;
+    return m_particle.handle[i] | ((m_particle.uniqueStamp[i]&0xffff)<<16);
 }
 
 /** Returns the channel of the particle created or -1 on error */
@@ -362,100 +342,93 @@ int CParticle::CreateFrag(Math::Vector pos, Math::Vector speed,
                           float windSensitivity, int sheet)
 {
     int t = 0;
-    for (int j = 0; j < MAXPARTICULE; j++)
-    {
-        int i = MAXPARTICULE*t+j;
-
-        if (!m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = false;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = mass;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = pos;
-            m_particle[i].speed     = speed;
-            m_particle[i].windSensitivity = windSensitivity;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].objLink   = nullptr;
-            m_particle[i].objFather = nullptr;
-            m_particle[i].trackRank = -1;
-            m_triangle[i] = *triangle;
-
-            m_totalInterface[t][sheet] ++;
-
-            Math::Vector    p1;
-            p1.x = m_triangle[i].triangle[0].coord.x;
-            p1.y = m_triangle[i].triangle[0].coord.y;
-            p1.z = m_triangle[i].triangle[0].coord.z;
-
-            Math::Vector p2;
-            p2.x = m_triangle[i].triangle[1].coord.x;
-            p2.y = m_triangle[i].triangle[1].coord.y;
-            p2.z = m_triangle[i].triangle[1].coord.z;
-
-            Math::Vector p3;
-            p3.x = m_triangle[i].triangle[2].coord.x;
-            p3.y = m_triangle[i].triangle[2].coord.y;
-            p3.z = m_triangle[i].triangle[2].coord.z;
-
-            float l1 = Math::Distance(p1, p2);
-            float l2 = Math::Distance(p2, p3);
-            float l3 = Math::Distance(p3, p1);
-            float dx = fabs(Math::Min(l1, l2, l3))*0.5f;
-            float dy = fabs(Math::Max(l1, l2, l3))*0.5f;
-            p1 = Math::Vector(-dx,  dy, 0.0f);
-            p2 = Math::Vector( dx,  dy, 0.0f);
-            p3 = Math::Vector(-dx, -dy, 0.0f);
-
-            m_triangle[i].triangle[0].coord.x = p1.x;
-            m_triangle[i].triangle[0].coord.y = p1.y;
-            m_triangle[i].triangle[0].coord.z = p1.z;
-
-            m_triangle[i].triangle[1].coord.x = p2.x;
-            m_triangle[i].triangle[1].coord.y = p2.y;
-            m_triangle[i].triangle[1].coord.z = p2.z;
-
-            m_triangle[i].triangle[2].coord.x = p3.x;
-            m_triangle[i].triangle[2].coord.y = p3.y;
-            m_triangle[i].triangle[2].coord.z = p3.z;
-
-            Math::Vector n(0.0f, 0.0f, -1.0f);
-
-            m_triangle[i].triangle[0].normal.x = n.x;
-            m_triangle[i].triangle[0].normal.y = n.y;
-            m_triangle[i].triangle[0].normal.z = n.z;
-
-            m_triangle[i].triangle[1].normal.x = n.x;
-            m_triangle[i].triangle[1].normal.y = n.y;
-            m_triangle[i].triangle[1].normal.z = n.z;
-
-            m_triangle[i].triangle[2].normal.x = n.x;
-            m_triangle[i].triangle[2].normal.y = n.y;
-            m_triangle[i].triangle[2].normal.z = n.z;
-
-            if (type == PARTIFRAG)
-                m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
-
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
-    }
-
-    return -1;
+    int i = AllocParticle(type, sheet, pos);
+    if (i == -1) return -1;
+
+    m_particle.used[i]      = true;
+    m_particle.partiType[i] = t;
+    m_particle.ray[i]       = false;
+    m_particle.uniqueStamp[i] = m_uniqueStamp++;
+    m_particle.sheet[i]     = sheet;
+    m_particle.mass[i]      = mass;
+    m_particle.duration[i]  = duration;
+    m_particle.pos[i]       = pos;
+    m_particle.goal[i]      = pos;
+    m_particle.speed[i]     = speed;
+    m_particle.windSensitivity[i] = windSensitivity;
+    m_particle.zoom[i]      = 1.0f;
+    m_particle.angle[i]     = 0.0f;
+    m_particle.intensity[i] = 1.0f;
+    m_particle.type[i]      = type;
+    m_particle.phase[i]     = PARPHSTART;
+    m_particle.texSup[i].x  = 0.0f;
+    m_particle.texSup[i].y  = 0.0f;
+    m_particle.texInf[i].x  = 0.0f;
+    m_particle.texInf[i].y  = 0.0f;
+    m_particle.time[i]      = 0.0f;
+    m_particle.phaseTime[i] = 0.0f;
+    m_particle.testTime[i]  = 0.0f;
+    m_particle.objLink[i]   = nullptr;
+    m_particle.objFather[i] = nullptr;
+    m_particle.trackRank[i] = -1;
+    m_particle.triangle[i] = *triangle;
+
+    m_totalInterface[t][sheet] ++;
+
+    Math::Vector    p1;
+    p1.x = m_particle.triangle[i].triangle[0].coord.x;
+    p1.y = m_particle.triangle[i].triangle[0].coord.y;
+    p1.z = m_particle.triangle[i].triangle[0].coord.z;
+
+    Math::Vector p2;
+    p2.x = m_particle.triangle[i].triangle[1].coord.x;
+    p2.y = m_particle.triangle[i].triangle[1].coord.y;
+    p2.z = m_particle.triangle[i].triangle[1].coord.z;
+
+    Math::Vector p3;
+    p3.x = m_particle.triangle[i].triangle[2].coord.x;
+    p3.y = m_particle.triangle[i].triangle[2].coord.y;
+    p3.z = m_particle.triangle[i].triangle[2].coord.z;
+
+    float l1 = Math::Distance(p1, p2);
+    float l2 = Math::Distance(p2, p3);
+    float l3 = Math::Distance(p3, p1);
+    float dx = fabs(Math::Min(l1, l2, l3))*0.5f;
+    float dy = fabs(Math::Max(l1, l2, l3))*0.5f;
+    p1 = Math::Vector(-dx,  dy, 0.0f);
+    p2 = Math::Vector( dx,  dy, 0.0f);
+    p3 = Math::Vector(-dx, -dy, 0.0f);
+
+    m_particle.triangle[i].triangle[0].coord.x = p1.x;
+    m_particle.triangle[i].triangle[0].coord.y = p1.y;
+    m_particle.triangle[i].triangle[0].coord.z = p1.z;
+
+    m_particle.triangle[i].triangle[1].coord.x = p2.x;
+    m_particle.triangle[i].triangle[1].coord.y = p2.y;
+    m_particle.triangle[i].triangle[1].coord.z = p2.z;
+
+    m_particle.triangle[i].triangle[2].coord.x = p3.x;
+    m_particle.triangle[i].triangle[2].coord.y = p3.y;
+    m_particle.triangle[i].triangle[2].coord.z = p3.z;
+
+    Math::Vector n(0.0f, 0.0f, -1.0f);
+
+    m_particle.triangle[i].triangle[0].normal.x = n.x;
+    m_particle.triangle[i].triangle[0].normal.y = n.y;
+    m_particle.triangle[i].triangle[0].normal.z = n.z;
+
+    m_particle.triangle[i].triangle[1].normal.x = n.x;
+    m_particle.triangle[i].triangle[1].normal.y = n.y;
+    m_particle.triangle[i].triangle[1].normal.z = n.z;
+
+    m_particle.triangle[i].triangle[2].normal.x = n.x;
+    m_particle.triangle[i].triangle[2].normal.y = n.y;
+    m_particle.triangle[i].triangle[2].normal.z = n.z;
+
+    if (type == PARTIFRAG)
+        m_particle.angle[i] = Math::Rand()*Math::PI*2.0f;
+
+    return m_particle.handle[i] | ((m_particle.uniqueStamp[i]&0xffff)<<16);
 }
 
 
@@ -466,45 +439,38 @@ int CParticle::CreatePart(Math::Vector pos, Math::Vector speed,
                           float windSensitivity, int sheet)
 {
     int t = 0;
-    for (int j = 0; j < MAXPARTICULE; j++)
-    {
-        int i = MAXPARTICULE*t+j;
-
-        if (!m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = false;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = mass;
-            m_particle[i].weight    = weight;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = pos;
-            m_particle[i].speed     = speed;
-            m_particle[i].windSensitivity = windSensitivity;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].trackRank = -1;
-
-            m_totalInterface[t][sheet] ++;
-
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
-    }
-
-    return -1;
+    int i = AllocParticle(type, sheet, pos);
+    if (i == -1) return -1;
+
+    m_particle.used[i]      = true;
+    m_particle.partiType[i] = t;
+    m_particle.ray[i]       = false;
+    m_particle.uniqueStamp[i] = m_uniqueStamp++;
+    m_particle.sheet[i]     = sheet;
+    m_particle.mass[i]      = mass;
+    m_particle.weight[i]    = weight;
+    m_particle.duration[i]  = duration;
+    m_particle.pos[i]       = pos;
+    m_particle.goal[i]      = pos;
+    m_particle.speed[i]     = speed;
+    m_particle.windSensitivity[i] = windSensitivity;
+    m_particle.zoom[i]      = 1.0f;
+    m_particle.angle[i]     = 0.0f;
+    m_particle.intensity[i] = 1.0f;
+    m_particle.type[i]      = type;
+    m_particle.phase[i]     = PARPHSTART;
+    m_particle.texSup[i].x  = 0.0f;
+    m_particle.texSup[i].y  = 0.0f;
+    m_particle.texInf[i].x  = 0.0f;
+    m_particle.texInf[i].y  = 0.0f;
+    m_particle.time[i]      = 0.0f;
+    m_particle.phaseTime[i] = 0.0f;
+    m_particle.testTime[i]  = 0.0f;
+    m_particle.trackRank[i] = -1;
+
+    m_totalInterface[t][sheet] ++;
+
+    return m_particle.handle[i] | ((m_particle.uniqueStamp[i]&0xffff)<<16);
 }
 
 /** Returns the channel of the particle created or -1 on error */
@@ -522,47 +488,40 @@ int CParticle::CreateRay(Math::Vector pos, Math::Vector goal,
     if (t >= MAXPARTITYPE) return -1;
     if (t == -1) return -1;
 
-    for (int j = 0; j < MAXPARTICULE; j++)
-    {
-        int i = MAXPARTICULE*t+j;
-
-        if (!m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = true;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = 0.0f;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = goal;
-            m_particle[i].speed     = Math::Vector(0.0f, 0.0f, 0.0f);
-            m_particle[i].windSensitivity = 0.0f;
-            m_particle[i].dim       = dim;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].objLink   = nullptr;
-            m_particle[i].objFather = nullptr;
-            m_particle[i].trackRank = -1;
-
-            m_totalInterface[t][sheet] ++;
-
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
-    }
-
-    return -1;
+    int i = AllocParticle(type, sheet, pos);
+    if (i == -1) return -1;
+
+    m_particle.used[i]      = true;
+    m_particle.partiType[i] = t;
+    m_particle.ray[i]       = true;
+    m_particle.uniqueStamp[i] = m_uniqueStamp++;
+    m_particle.sheet[i]     = sheet;
+    m_particle.mass[i]      = 0.0f;
+    m_particle.duration[i]  = duration;
+    m_particle.pos[i]       = pos;
+    m_particle.goal[i]      = goal;
+    m_particle.speed[i]     = Math::Vector(0.0f, 0.0f, 0.0f);
+    m_particle.windSensitivity[i] = 0.0f;
+    m_particle.dim[i]       = dim;
+    m_particle.zoom[i]      = 1.0f;
+    m_particle.angle[i]     = 0.0f;
+    m_particle.intensity[i] = 1.0f;
+    m_particle.type[i]      = type;
+    m_particle.phase[i]     = PARPHSTART;
+    m_particle.texSup[i].x  = 0.0f;
+    m_particle.texSup[i].y  = 0.0f;
+    m_particle.texInf[i].x  = 0.0f;
+    m_particle.texInf[i].y  = 0.0f;
+    m_particle.time[i]      = 0.0f;
+    m_particle.phaseTime[i] = 0.0f;
+    m_particle.testTime[i]  = 0.0f;
+    m_particle.objLink[i]   = nullptr;
+    m_particle.objFather[i] = nullptr;
+    m_particle.trackRank[i] = -1;
+
+    m_totalInterface[t][sheet] ++;
+
+    return m_particle.handle[i] | ((m_particle.uniqueStamp[i]&0xffff)<<16);
 }
 
 /** "length" is the length of the tail of drag (in seconds)! */
@@ -574,27 +533,33 @@ int CParticle::CreateTrack(Math::Vector pos, Math::Vector speed, Math::Point dim
     int channel = CreateParticle(pos, speed, dim, type, duration, mass, 0.0f, 0);
     if (channel == -1) return -1;
 
-    // Seeks a streak free.
-    for (int i = 0; i < MAXTRACK; i++)
-    {
-        if (!m_track[i].used)  // free?
-        {
-            int rank = channel;
-            if (!CheckChannel(rank)) return -1;
-            m_particle[rank].trackRank = i;
+    int rank = channel;
+    if (!CheckChannel(rank)) return -1;
 
-            m_track[i].used = true;
-            m_track[i].step = (length/duration) / MAXTRACKLEN;
-            m_track[i].last = 0.0f;
-            m_track[i].intensity = 1.0f;
-            m_track[i].width = width;
-            m_track[i].posUsed = 1;
-            m_track[i].head = 0;
-            m_track[i].pos[0] = pos;
-            break;
-        }
+    // Takes a free streak.
+    int i;
+    if (!m_freeTracks.empty())
+    {
+        i = m_freeTracks.back();
+        m_freeTracks.pop_back();
+    }
+    else
+    {
+        i = m_track.size();
+        m_track.push_back(Track());
     }
 
+    m_particle.trackRank[rank] = i;
+
+    m_track[i].used = true;
+    m_track[i].step = (length/duration) / MAXTRACKLEN;
+    m_track[i].last = 0.0f;
+    m_track[i].intensity = 1.0f;
+    m_track[i].width = width;
+    m_track[i].posUsed = 1;
+    m_track[i].head = 0;
+    m_track[i].pos[0] = pos;
+
     return channel;
 }
 
@@ -602,9 +567,15 @@ void CParticle::CreateWheelTrace(const Math::Vector &p1, const Math::Vector &p2,
                                  const Math::Vector &p3, const Math::Vector &p4,
                                  TraceColor color)
 {
-    int max = MAXWHEELTRACE;
+    // Tire marks get a quarter of the particle budget
+    int max = std::max(m_engine->GetParticleBudget()/4, 100);
+    if (static_cast<int>(m_wheelTrace.size()) > max)
+        m_wheelTrace.resize(max);
+
+    if (m_wheelTraceIndex >= max)  m_wheelTraceIndex = 0;
     int i = m_wheelTraceIndex++;
-    if (m_wheelTraceIndex > max)  m_wheelTraceIndex = 0;
+    if (i == static_cast<int>(m_wheelTrace.size()))
+        m_wheelTrace.push_back(WheelTrace());
 
     m_wheelTrace[i].color = color;
     m_wheelTrace[i].pos[0] = p1;  // ul
@@ -626,57 +597,165 @@ void CParticle::CreateWheelTrace(const Math::Vector &p1, const Math::Vector &p2,
 
     m_terrain->AdjustToFloor(m_wheelTrace[i].pos[3]);
     m_wheelTrace[i].pos[3].y += 0.2f;  // just above the ground
-
-    if (m_wheelTraceTotal < max)
-        m_wheelTraceTotal++;
-    else
-        m_wheelTraceTotal = max;
 }
 
 
 
-/** Adapts the channel so it can be used as an offset in m_particle */
+/** Adapts the channel so it can be used as an index in m_particle */
 bool CParticle::CheckChannel(int &channel)
 {
     int uniqueStamp = (channel>>16)&0xffff;
-    channel &= 0xffff;
+    int handle = channel&0xffff;
 
+    channel = m_particle.GetIndex(handle);
     if (channel < 0)  return false;
-    if (channel >= MAXPARTICULE*MAXPARTITYPE) return false;
 
-    if (!m_particle[channel].used)
+    if (!m_particle.used[channel])
     {
-        GetLogger()->Trace("Particle %d:%d doesn't exist anymore (used=false)\n", channel, uniqueStamp);
+        GetLogger()->Trace("Particle %d:%d doesn't exist anymore (used=false)\n", handle, uniqueStamp);
         return false;
     }
 
-    if (m_particle[channel].uniqueStamp != uniqueStamp)
+    if (m_particle.uniqueStamp[channel] != uniqueStamp)
     {
-        GetLogger()->Trace("Particle %d:%d doesn't exist anymore (uniqueStamp changed)\n", channel, uniqueStamp);
+        GetLogger()->Trace("Particle %d:%d doesn't exist anymore (uniqueStamp changed)\n", handle, uniqueStamp);
         return false;
     }
 
     return true;
 }
 
+int CParticle::GetParticleCount()
+{
+    int total = 0;
+    for (int t = 0; t < MAXPARTITYPE; t++)
+    {
+        for (int sheet = 0; sheet < SH_MAX; sheet++)
+            total += m_totalInterface[t][sheet];
+    }
+
+    return total;
+}
+
+int CParticle::GetParticlePeak()
+{
+    return m_particlePeak;
+}
+
+int CParticle::GetParticleCulled()
+{
+    return m_particleCulled;
+}
+
+int CParticle::AllocParticle(ParticleType type, int sheet, const Math::Vector& pos)
+{
+    if (GetParticleCount() >= m_engine->GetParticleBudget())
+    {
+        // Distant particles are culled first
+        float score = -1.0f;
+        if (!IsParticleEssential(type, sheet))
+            score = Math::Distance(m_engine->GetEyePt(), pos);
+
+        if (!CullParticles(score)) return -1;
+    }
+    else if (!IsParticleEssential(type, sheet))
+    {
+        m_cullExhausted = false;
+    }
+
+    int i = m_particle.Add();
+    if (i == -1) return -1;
+
+    m_particlePeak = std::max(m_particlePeak, GetParticleCount()+1);
+    return i;
+}
+
+bool CParticle::IsParticleEssential(ParticleType type, int sheet)
+{
+    if (sheet != SH_WORLD) return true;
+
+    return type == PARTIGUN1    ||
+           type == PARTIGUN2    ||
+           type == PARTIGUN3    ||
+           type == PARTIGUN4    ||
+           type == PARTITRACK11 ||
+           type == PARTIRAY1    ||
+           type == PARTIRAY2    ||
+           type == PARTIRAY3    ||
+           type == PARTIQUARTZ  ||
+           type == PARTISELY    ||
+           type == PARTISELR    ||
+           (type >= PARTIFOG0 && type <= PARTIFOG7);
+}
+
+bool CParticle::CullParticles(float score)
+{
+    // Nothing new could be culled since the last search found nothing
+    if (m_cullExhausted)
+        return score < 0.0f;
+
+    Math::Vector eye = m_engine->GetEyePt();
+
+    // Particles bound to objects or drags are still referenced, they are not culled
+    m_cullCandidates.clear();
+    for (int i = 0; i < m_particle.GetCount(); i++)
+    {
+        if (!m_particle.used[i]) continue;
+        if (m_particle.objLink[i] != nullptr) continue;
+        if (m_particle.trackRank[i] != -1) continue;
+        if (IsParticleEssential(m_particle.type[i], m_particle.sheet[i])) continue;
+
+        // Older particles have less to show
+        float progress = Math::Norm(m_particle.time[i]/m_particle.duration[i]);
+        float candidateScore = Math::Distance(eye, m_particle.pos[i])*(1.0f+progress);
+        m_cullCandidates.push_back(std::make_pair(candidateScore, i));
+    }
+
+    // Culls an eighth of the budget at once, so the search is done rarely
+    int total = std::min(std::max(m_engine->GetParticleBudget()/8, 1),
+                         static_cast<int>(m_cullCandidates.size()));
+    if (total == 0)
+    {
+        m_cullExhausted = true;
+        return score < 0.0f;  // only essential particles may exceed the budget
+    }
+
+    std::nth_element(m_cullCandidates.begin(), m_cullCandidates.begin()+total-1, m_cullCandidates.end(),
+                     [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+    float threshold = m_cullCandidates[total-1].first;
+
+    for (int i = 0; i < total; i++)
+        DeleteRank(m_cullCandidates[i].second);
+
+    m_particleCulled += total;
+
+    return score < threshold;
+}
+
 void CParticle::DeleteRank(int rank)
 {
-    if (m_totalInterface[rank/MAXPARTICULE][m_particle[rank].sheet] > 0)
-        m_totalInterface[rank/MAXPARTICULE][m_particle[rank].sheet]--;
+    if (!m_particle.used[rank]) return;
+
+    if (m_totalInterface[m_particle.partiType[rank]][m_particle.sheet[rank]] > 0)
+        m_totalInterface[m_particle.partiType[rank]][m_particle.sheet[rank]]--;
 
-    int i = m_particle[rank].trackRank;
+    int i = m_particle.trackRank[rank];
     if (i != -1)  // drag associated?
+    {
         m_track[i].used = false;  // frees the drag
+        m_freeTracks.push_back(i);
+        m_particle.trackRank[rank] = -1;
+    }
 
-    m_particle[rank].used = false;
+    m_particle.used[rank] = false;
 }
 
 void CParticle::DeleteParticle(ParticleType type)
 {
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
+    for (int i = 0; i < m_particle.GetCount(); i++)
     {
-        if (!m_particle[i].used) continue;
-        if (m_particle[i].type != type) continue;
+        if (!m_particle.used[i]) continue;
+        if (m_particle.type[i] != type) continue;
 
         DeleteRank(i);
     }
@@ -686,81 +765,76 @@ void CParticle::DeleteParticle(int channel)
 {
     if (!CheckChannel(channel)) return;
 
-    if (m_totalInterface[channel/MAXPARTICULE][m_particle[channel].sheet] > 0 )
-        m_totalInterface[channel/MAXPARTICULE][m_particle[channel].sheet]--;
-
-    int i = m_particle[channel].trackRank;
-    if (i != -1)  // drag associated?
-        m_track[i].used = false;  // frees the drag
-
-    m_particle[channel].used = false;
+    DeleteRank(channel);
 }
 
 void CParticle::SetObjectLink(int channel, CObject *object)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].objLink = object;
+    m_particle.objLink[channel] = object;
+    if (object == nullptr)
+        m_cullExhausted = false;  // the particle may be culled now
 }
 
 void CParticle::SetObjectFather(int channel, CObject *object)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].objFather = object;
+    m_particle.objFather[channel] = object;
 }
 
 void CParticle::SetPosition(int channel, Math::Vector pos)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].pos = pos;
+    m_particle.pos[channel] = pos;
 }
 
 void CParticle::SetDimension(int channel, Math::Point dim)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].dim = dim;
+    m_particle.dim[channel] = dim;
 }
 
 void CParticle::SetZoom(int channel, float zoom)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].zoom = zoom;
+    m_particle.zoom[channel] = zoom;
 }
 
 void CParticle::SetAngle(int channel, float angle)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].angle = angle;
+    m_particle.angle[channel] = angle;
 }
 
 void CParticle::SetIntensity(int channel, float intensity)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].intensity = intensity;
+    m_particle.intensity[channel] = intensity;
 }
 
 void CParticle::SetParam(int channel, Math::Vector pos, Math::Point dim, float zoom,
                           float angle, float intensity)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].pos       = pos;
-    m_particle[channel].dim       = dim;
-    m_particle[channel].zoom      = zoom;
-    m_particle[channel].angle     = angle;
-    m_particle[channel].intensity = intensity;
+    m_particle.pos[channel]       = pos;
+    m_particle.dim[channel]       = dim;
+    m_particle.zoom[channel]      = zoom;
+    m_particle.angle[channel]     = angle;
+    m_particle.intensity[channel] = intensity;
 }
 
 void CParticle::SetPhase(int channel, ParticlePhase phase, float duration)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].phase = phase;
-    m_particle[channel].duration = duration;
-    m_particle[channel].phaseTime = m_particle[channel].time;
+    m_particle.phase[channel] = phase;
+    m_particle.duration[channel] = duration;
+    m_particle.phaseTime[channel] = m_particle.time[channel];
 }
 
 bool CParticle::GetPosition(int channel, Math::Vector &pos)
 {
     if (!CheckChannel(channel))  return false;
-    pos = m_particle[channel].pos;
+    pos = m_particle.pos[channel];
     return true;
 }
 
@@ -794,67 +868,86 @@ void CParticle::FrameParticle(float rTime)
     Math::Point ts, ti;
     Math::Vector pos;
 
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
+    // Objects have moved since the last frame
+    CObjectManager::GetInstancePointer()->InvalidateObjectGrid();
+
+    m_particle.Compact();
+
+    // Particles created during the update are first updated in the next frame
+    int count = m_particle.GetCount();
+
+    // Selects the particles updated in this frame
+    for (int i = 0; i < count; i++)
     {
-        if (!m_particle[i].used) continue;
-        if (!m_frameUpdate[m_particle[i].sheet]) continue;
+        bool update = m_particle.used[i] && m_frameUpdate[m_particle.sheet[i]];
 
-        if (m_particle[i].type != PARTISHOW)
+        if (m_particle.type[i] != PARTISHOW)
         {
-            if (pause && m_particle[i].sheet != SH_INTERFACE) continue;
+            if (pause && m_particle.sheet[i] != SH_INTERFACE) update = false;
         }
 
-        if (m_particle[i].type != PARTIQUARTZ)
-            m_particle[i].pos += m_particle[i].speed*rTime;
+        m_particle.ageStep[i] = update ? rTime : 0.0f;
+        m_particle.moveStep[i] = (update && m_particle.type[i] != PARTIQUARTZ) ? rTime : 0.0f;
+
+        if (update && m_particle.sheet[i] == SH_WORLD)
+            m_particle.windStep[i] = rTime*m_particle.windSensitivity[i]*Math::Rand()*2.0f;
+        else
+            m_particle.windStep[i] = 0.0f;
+    }
 
-        if (m_particle[i].sheet == SH_WORLD)
+    // Common movement and gravity of all particles
+    m_particle.Integrate(wind, 0, count);
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!m_particle.used[i]) continue;
+        if (!m_frameUpdate[m_particle.sheet[i]]) continue;
+
+        if (m_particle.type[i] != PARTISHOW)
         {
-            float h = rTime*m_particle[i].windSensitivity*Math::Rand()*2.0f;
-            m_particle[i].pos += wind*h;
+            if (pause && m_particle.sheet[i] != SH_INTERFACE) continue;
         }
 
-        float progress = (m_particle[i].time-m_particle[i].phaseTime)/m_particle[i].duration;
+        float progress = (m_particle.time[i]-m_particle.phaseTime[i])/m_particle.duration[i];
 
         // Manages the particles with mass that bounce.
-        if ( m_particle[i].mass != 0.0f        &&
-             m_particle[i].type != PARTIQUARTZ )
+        if ( m_particle.mass[i] != 0.0f        &&
+             m_particle.type[i] != PARTIQUARTZ )
         {
-            m_particle[i].speed.y -= m_particle[i].mass*rTime;
-
             float h;
-            if (m_particle[i].sheet == SH_INTERFACE)
+            if (m_particle.sheet[i] == SH_INTERFACE)
                 h = 0.0f;
             else
-                h = m_terrain->GetFloorLevel(m_particle[i].pos, true);
+                h = m_terrain->GetFloorLevel(m_particle.pos[i], true);
 
-            h += m_particle[i].dim.y*0.75f;
-            if (m_particle[i].pos.y < h)  // impact with the ground?
+            h += m_particle.dim[i].y*0.75f;
+            if (m_particle.pos[i].y < h)  // impact with the ground?
             {
-                if ( m_particle[i].type == PARTIPART &&
-                     m_particle[i].weight > 3.0f &&  // heavy enough?
-                     m_particle[i].bounce < 3 )
+                if ( m_particle.type[i] == PARTIPART &&
+                     m_particle.weight[i] > 3.0f &&  // heavy enough?
+                     m_particle.bounce[i] < 3 )
                 {
-                    float amplitude = m_particle[i].weight*0.1f;
-                    amplitude *= 1.0f-0.3f*m_particle[i].bounce;
+                    float amplitude = m_particle.weight[i]*0.1f;
+                    amplitude *= 1.0f-0.3f*m_particle.bounce[i];
                     if (amplitude > 1.0f)  amplitude = 1.0f;
                     if (amplitude > 0.0f)
                     {
-                        Play(SOUND_BOUM, m_particle[i].pos, amplitude);
+                        Play(SOUND_BOUM, m_particle.pos[i], amplitude);
                     }
                 }
 
-                if (m_particle[i].bounce < 3)
+                if (m_particle.bounce[i] < 3)
                 {
-                    m_particle[i].pos.y = h;
-                    m_particle[i].speed.y *= -0.4f;
-                    m_particle[i].speed.x *=  0.4f;
-                    m_particle[i].speed.z *=  0.4f;
-                    m_particle[i].bounce ++;  // more impact
+                    m_particle.pos[i].y = h;
+                    m_particle.speed[i].y *= -0.4f;
+                    m_particle.speed[i].x *=  0.4f;
+                    m_particle.speed[i].z *=  0.4f;
+                    m_particle.bounce[i] ++;  // more impact
                 }
                 else    // disappears after 3 bounces?
                 {
-                    if ( m_particle[i].pos.y < h-10.0f ||
-                         m_particle[i].time >= 20.0f   )
+                    if ( m_particle.pos[i].y < h-10.0f ||
+                         m_particle.time[i] >= 20.0f   )
                     {
                         DeleteRank(i);
                         continue;
@@ -864,10 +957,10 @@ void CParticle::FrameParticle(float rTime)
         }
 
         // Manages drag associated.
-        int r = m_particle[i].trackRank;
+        int r = m_particle.trackRank[i];
         if (r != -1)  // drag exists?
         {
-            if (TrackMove(r, m_particle[i].pos, progress))
+            if (TrackMove(r, m_particle.pos[i], progress))
             {
                 DeleteRank(i);
                 continue;
@@ -876,9 +969,9 @@ void CParticle::FrameParticle(float rTime)
             m_track[r].drawParticle = (progress < 1.0f);
         }
 
-        if (m_particle[i].type == PARTITRACK1)  // technical explosion?
+        if (m_particle.type[i] == PARTITRACK1)  // technical explosion?
         {
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.375f;
             ts.y = 0.000f;
@@ -886,9 +979,9 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTITRACK2)  // spray blue?
+        if (m_particle.type[i] == PARTITRACK2)  // spray blue?
         {
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.500f;
             ts.y = 0.000f;
@@ -896,9 +989,9 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTITRACK3)  // spider?
+        if (m_particle.type[i] == PARTITRACK3)  // spider?
         {
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.500f;
             ts.y = 0.750f;
@@ -906,9 +999,9 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTITRACK4)  // insect explosion?
+        if (m_particle.type[i] == PARTITRACK4)  // insect explosion?
         {
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.625f;
             ts.y = 0.000f;
@@ -916,9 +1009,9 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTITRACK5)  // derrick?
+        if (m_particle.type[i] == PARTITRACK5)  // derrick?
         {
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.750f;
             ts.y = 0.000f;
@@ -926,7 +1019,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTITRACK6)  // reset in/out?
+        if (m_particle.type[i] == PARTITRACK6)  // reset in/out?
         {
             ts.x = 0.0f;
             ts.y = 0.0f;
@@ -934,29 +1027,29 @@ void CParticle::FrameParticle(float rTime)
             ti.y = 0.0f;
         }
 
-        if ( m_particle[i].type == PARTITRACK7  ||  // win-1 ?
-             m_particle[i].type == PARTITRACK8  ||  // win-2 ?
-             m_particle[i].type == PARTITRACK9  ||  // win-3 ?
-             m_particle[i].type == PARTITRACK10 )   // win-4 ?
+        if ( m_particle.type[i] == PARTITRACK7  ||  // win-1 ?
+             m_particle.type[i] == PARTITRACK8  ||  // win-2 ?
+             m_particle.type[i] == PARTITRACK9  ||  // win-3 ?
+             m_particle.type[i] == PARTITRACK10 )   // win-4 ?
         {
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
-            ts.x = 0.25f*(m_particle[i].type-PARTITRACK7);
+            ts.x = 0.25f*(m_particle.type[i]-PARTITRACK7);
             ts.y = 0.25f;
             ti.x = ts.x+0.25f;
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTITRACK11)  // phazer shot?
+        if (m_particle.type[i] == PARTITRACK11)  // phazer shot?
         {
-            CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-            m_particle[i].goal = m_particle[i].pos;
+            CObject* object = SearchObjectGun(m_particle.goal[i], m_particle.pos[i], m_particle.type[i], m_particle.objFather[i]);
+            m_particle.goal[i] = m_particle.pos[i];
             if (object != nullptr && object->Implements(ObjectInterfaceType::Damageable))
             {
-                dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Phazer, 0.002f, m_particle[i].objFather);
+                dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Phazer, 0.002f, m_particle.objFather[i]);
             }
 
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.375f;
             ts.y = 0.000f;
@@ -964,9 +1057,9 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTITRACK12)  // drag reactor?
+        if (m_particle.type[i] == PARTITRACK12)  // drag reactor?
         {
-            m_particle[i].zoom = 1.0f;
+            m_particle.zoom[i] = 1.0f;
 
             ts.x = 0.375f;
             ts.y = 0.000f;
@@ -974,7 +1067,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIMOTOR)
+        if (m_particle.type[i] == PARTIMOTOR)
         {
             if (progress >= 1.0f)
             {
@@ -982,8 +1075,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.000f;
             ts.y = 0.750f;
@@ -991,7 +1084,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIBLITZ)
+        if (m_particle.type[i] == PARTIBLITZ)
         {
             if (progress >= 1.0f)
             {
@@ -999,8 +1092,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress;
-            m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
+            m_particle.zoom[i] = 1.0f-progress;
+            m_particle.angle[i] = Math::Rand()*Math::PI*2.0f;
 
             ts.x = 0.125f;
             ts.y = 0.750f;
@@ -1008,7 +1101,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTICRASH)
+        if (m_particle.type[i] == PARTICRASH)
         {
             if (progress >= 1.0f)
             {
@@ -1017,9 +1110,9 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress < 0.25f)
-                m_particle[i].zoom = progress/0.25f;
+                m_particle.zoom[i] = progress/0.25f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.25f)/0.75f;
+                m_particle.intensity[i] = 1.0f-(progress-0.25f)/0.75f;
 
             ts.x = 0.000f;
             ts.y = 0.750f;
@@ -1027,7 +1120,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIVAPOR)
+        if (m_particle.type[i] == PARTIVAPOR)
         {
             if (progress >= 1.0f)
             {
@@ -1035,8 +1128,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].intensity = 1.0f-progress;
-            m_particle[i].zoom = 1.0f+progress*3.0f;
+            m_particle.intensity[i] = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f+progress*3.0f;
 
             ts.x = 0.000f;
             ts.y = 0.750f;
@@ -1044,7 +1137,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIGAS)
+        if (m_particle.type[i] == PARTIGAS)
         {
             if (progress >= 1.0f)
             {
@@ -1052,7 +1145,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress;
 
             ts.x = 0.375f;
             ts.y = 0.750f;
@@ -1060,7 +1153,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIBASE)
+        if (m_particle.type[i] == PARTIBASE)
         {
             if (progress >= 1.0f)
             {
@@ -1068,8 +1161,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f+progress*7.0f;
-            m_particle[i].intensity = powf(1.0f-progress, 3.0f);
+            m_particle.zoom[i] = 1.0f+progress*7.0f;
+            m_particle.intensity[i] = powf(1.0f-progress, 3.0f);
 
             ts.x = 0.375f;
             ts.y = 0.750f;
@@ -1077,8 +1170,8 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if ( m_particle[i].type == PARTIFIRE  ||
-             m_particle[i].type == PARTIFIREZ )
+        if ( m_particle.type[i] == PARTIFIRE  ||
+             m_particle.type[i] == PARTIFIREZ )
         {
             if (progress >= 1.0f)
             {
@@ -1086,10 +1179,10 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            if (m_particle[i].type == PARTIFIRE)
-                m_particle[i].zoom = 1.0f-progress;
+            if (m_particle.type[i] == PARTIFIRE)
+                m_particle.zoom[i] = 1.0f-progress;
             else
-                m_particle[i].zoom = progress;
+                m_particle.zoom[i] = progress;
 
             ts.x = 0.500f;
             ts.y = 0.750f;
@@ -1097,7 +1190,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIGUN1)  // fireball shot?
+        if (m_particle.type[i] == PARTIGUN1)  // fireball shot?
         {
             if (progress >= 1.0f)
             {
@@ -1105,17 +1198,17 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            if (m_particle[i].testTime >= 0.05f)
+            if (m_particle.testTime[i] >= 0.05f)
             {
-                m_particle[i].testTime = 0.0f;
+                m_particle.testTime[i] = 0.0f;
 
-                if (m_terrain->GetHeightToFloor(m_particle[i].pos, true) < -2.0f)
+                if (m_terrain->GetHeightToFloor(m_particle.pos[i], true) < -2.0f)
                 {
                     m_exploGunCounter++;
 
                     if (m_exploGunCounter % 2 == 0)
                     {
-                        pos = m_particle[i].goal;
+                        pos = m_particle.goal[i];
                         m_terrain->AdjustToFloor(pos, true);
                         Math::Vector speed;
                         speed.x = 0.0f;
@@ -1150,20 +1243,20 @@ void CParticle::FrameParticle(float rTime)
                     continue;
                 }
 
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                CObject* object = SearchObjectGun(m_particle.goal[i], m_particle.pos[i], m_particle.type[i], m_particle.objFather[i]);
+                m_particle.goal[i] = m_particle.pos[i];
                 if (object != nullptr)
                 {
                     if (object->Implements(ObjectInterfaceType::Damageable))
                     {
-                        dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Fire, 0.001f, m_particle[i].objFather);
+                        dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Fire, 0.001f, m_particle.objFather[i]);
                     }
 
                     m_exploGunCounter++;
 
                     if (m_exploGunCounter % 2 == 0)
                     {
-                        pos = m_particle[i].pos;
+                        pos = m_particle.pos[i];
                         Math::Vector speed;
                         speed.x = 0.0f;
                         speed.z = 0.0f;
@@ -1198,8 +1291,8 @@ void CParticle::FrameParticle(float rTime)
                 }
             }
 
-            m_particle[i].angle -= rTime*Math::PI*8.0f;
-            m_particle[i].zoom = 1.0f-progress;
+            m_particle.angle[i] -= rTime*Math::PI*8.0f;
+            m_particle.zoom[i] = 1.0f-progress;
 
             ts.x = 0.00f;
             ts.y = 0.50f;
@@ -1207,7 +1300,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIGUN2)  // ant shot?
+        if (m_particle.type[i] == PARTIGUN2)  // ant shot?
         {
             if (progress >= 1.0f)
             {
@@ -1215,20 +1308,20 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            if (m_particle[i].testTime >= 0.1f)
+            if (m_particle.testTime[i] >= 0.1f)
             {
-                m_particle[i].testTime = 0.0f;
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                m_particle.testTime[i] = 0.0f;
+                CObject* object = SearchObjectGun(m_particle.goal[i], m_particle.pos[i], m_particle.type[i], m_particle.objFather[i]);
+                m_particle.goal[i] = m_particle.pos[i];
                 if (object != nullptr)
                 {
                     if (object->GetType() == OBJECT_MOBILErs && dynamic_cast<CShielder&>(*object).GetActiveShieldRadius() > 0.0f)  // protected by shield?
                     {
-                        CreateParticle(m_particle[i].pos, Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
+                        CreateParticle(m_particle.pos[i], Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
                         if (m_lastTimeGunDel > 0.2f)
                         {
                             m_lastTimeGunDel = 0.0f;
-                            Play(SOUND_GUNDEL, m_particle[i].pos, 1.0f);
+                            Play(SOUND_GUNDEL, m_particle.pos[i], 1.0f);
                         }
                         DeleteRank(i);
                         continue;
@@ -1236,18 +1329,18 @@ void CParticle::FrameParticle(float rTime)
                     else
                     {
                         if (object->GetType() != OBJECT_HUMAN)
-                            Play(SOUND_TOUCH, m_particle[i].pos, 1.0f);
+                            Play(SOUND_TOUCH, m_particle.pos[i], 1.0f);
 
                         if (object->Implements(ObjectInterfaceType::Damageable))
                         {
-                            dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Organic, 0.1f, m_particle[i].objFather);  // starts explosion
+                            dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Organic, 0.1f, m_particle.objFather[i]);  // starts explosion
                         }
                     }
                 }
             }
 
-            m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
-            m_particle[i].zoom = 1.0f-progress;
+            m_particle.angle[i] = Math::Rand()*Math::PI*2.0f;
+            m_particle.zoom[i] = 1.0f-progress;
 
             ts.x = 0.125f;
             ts.y = 0.875f;
@@ -1255,7 +1348,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIGUN3)  // spider suicides?
+        if (m_particle.type[i] == PARTIGUN3)  // spider suicides?
         {
             if (progress >= 1.0f)
             {
@@ -1263,20 +1356,20 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            if (m_particle[i].testTime >= 0.1f)
+            if (m_particle.testTime[i] >= 0.1f)
             {
-                m_particle[i].testTime = 0.0f;
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                m_particle.testTime[i] = 0.0f;
+                CObject* object = SearchObjectGun(m_particle.goal[i], m_particle.pos[i], m_particle.type[i], m_particle.objFather[i]);
+                m_particle.goal[i] = m_particle.pos[i];
                 if (object != nullptr)
                 {
                     if (object->GetType() == OBJECT_MOBILErs && dynamic_cast<CShielder&>(*object).GetActiveShieldRadius() > 0.0f)
                     {
-                        CreateParticle(m_particle[i].pos, Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
+                        CreateParticle(m_particle.pos[i], Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
                         if (m_lastTimeGunDel > 0.2f)
                         {
                             m_lastTimeGunDel = 0.0f;
-                            Play(SOUND_GUNDEL, m_particle[i].pos, 1.0f);
+                            Play(SOUND_GUNDEL, m_particle.pos[i], 1.0f);
                         }
                         DeleteRank(i);
                         continue;
@@ -1285,7 +1378,7 @@ void CParticle::FrameParticle(float rTime)
                     {
                         if (object->Implements(ObjectInterfaceType::Damageable))
                         {
-                            dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Fire, std::numeric_limits<float>::infinity(), m_particle[i].objFather);  // starts explosion
+                            dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Fire, std::numeric_limits<float>::infinity(), m_particle.objFather[i]);  // starts explosion
                         }
                     }
                 }
@@ -1297,7 +1390,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIGUN4)  // orgaball shot?
+        if (m_particle.type[i] == PARTIGUN4)  // orgaball shot?
         {
             if (progress >= 1.0f)
             {
@@ -1305,17 +1398,17 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            if (m_particle[i].testTime >= 0.05f)
+            if (m_particle.testTime[i] >= 0.05f)
             {
-                m_particle[i].testTime = 0.0f;
+                m_particle.testTime[i] = 0.0f;
 
-                if (m_terrain->GetHeightToFloor(m_particle[i].pos, true) < -2.0f)
+                if (m_terrain->GetHeightToFloor(m_particle.pos[i], true) < -2.0f)
                 {
                     m_exploGunCounter ++;
 
                     if (m_exploGunCounter % 2 == 0)
                     {
-                        pos = m_particle[i].goal;
+                        pos = m_particle.goal[i];
                         m_terrain->AdjustToFloor(pos, true);
                         Math::Vector speed;
                         speed.x = 0.0f;
@@ -1338,20 +1431,20 @@ void CParticle::FrameParticle(float rTime)
                     continue;
                 }
 
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                CObject* object = SearchObjectGun(m_particle.goal[i], m_particle.pos[i], m_particle.type[i], m_particle.objFather[i]);
+                m_particle.goal[i] = m_particle.pos[i];
                 if (object != nullptr)
                 {
                     if (object->Implements(ObjectInterfaceType::Damageable))
                     {
-                        dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Organic, 0.001f, m_particle[i].objFather);
+                        dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Organic, 0.001f, m_particle.objFather[i]);
                     }
 
                     m_exploGunCounter ++;
 
                     if (m_exploGunCounter % 2 == 0)
                     {
-                        pos = m_particle[i].pos;
+                        pos = m_particle.pos[i];
                         Math::Vector speed;
                         speed.x = 0.0f;
                         speed.z = 0.0f;
@@ -1372,8 +1465,8 @@ void CParticle::FrameParticle(float rTime)
                 }
             }
 
-            m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
-            m_particle[i].zoom = 1.0f-progress;
+            m_particle.angle[i] = Math::Rand()*Math::PI*2.0f;
+            m_particle.zoom[i] = 1.0f-progress;
 
             ts.x = 0.125f;
             ts.y = 0.875f;
@@ -1381,7 +1474,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIFLIC)
+        if (m_particle.type[i] == PARTIFLIC)
         {
             if (progress >= 1.0f)
             {
@@ -1389,8 +1482,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 0.1f+progress;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = 0.1f+progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.00f;
             ts.y = 0.75f;
@@ -1398,7 +1491,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTISHOW)
+        if (m_particle.type[i] == PARTISHOW)
         {
             if (progress >= 1.0f)
             {
@@ -1406,10 +1499,10 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            if (progress < 0.5f) m_particle[i].intensity = progress/0.5f;
-            else                 m_particle[i].intensity = 2.0f-progress/0.5f;
-            m_particle[i].zoom = 1.0f-progress*0.8f;
-            m_particle[i].angle -= rTime*Math::PI*0.5f;
+            if (progress < 0.5f) m_particle.intensity[i] = progress/0.5f;
+            else                 m_particle.intensity[i] = 2.0f-progress/0.5f;
+            m_particle.zoom[i] = 1.0f-progress*0.8f;
+            m_particle.angle[i] -= rTime*Math::PI*0.5f;
 
             ts.x = 0.50f;
             ts.y = 0.00f;
@@ -1417,7 +1510,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTICHOC)
+        if (m_particle.type[i] == PARTICHOC)
         {
             if (progress >= 1.0f)
             {
@@ -1425,8 +1518,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 0.1f+progress;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = 0.1f+progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.50f;
             ts.y = 0.50f;
@@ -1434,7 +1527,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIGFLAT)
+        if (m_particle.type[i] == PARTIGFLAT)
         {
             if (progress >= 1.0f)
             {
@@ -1442,9 +1535,9 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 0.1f+progress;
-            m_particle[i].intensity = 1.0f-progress;
-            m_particle[i].angle -= rTime*Math::PI*2.0f;
+            m_particle.zoom[i] = 0.1f+progress;
+            m_particle.intensity[i] = 1.0f-progress;
+            m_particle.angle[i] -= rTime*Math::PI*2.0f;
 
             ts.x = 0.00f;
             ts.y = 0.50f;
@@ -1452,7 +1545,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTILIMIT1)
+        if (m_particle.type[i] == PARTILIMIT1)
         {
             if (progress >= 1.0f)
             {
@@ -1460,15 +1553,15 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f;
-            m_particle[i].intensity = 1.0f;
+            m_particle.zoom[i] = 1.0f;
+            m_particle.intensity[i] = 1.0f;
 
             ts.x = 0.000f;
             ts.y = 0.125f;
             ti.x = ts.x+0.125f;
             ti.y = ts.y+0.125f;
         }
-        if (m_particle[i].type == PARTILIMIT2)
+        if (m_particle.type[i] == PARTILIMIT2)
         {
             if (progress >= 1.0f)
             {
@@ -1476,15 +1569,15 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f;
-            m_particle[i].intensity = 1.0f;
+            m_particle.zoom[i] = 1.0f;
+            m_particle.intensity[i] = 1.0f;
 
             ts.x = 0.375f;
             ts.y = 0.125f;
             ti.x = ts.x+0.125f;
             ti.y = ts.y+0.125f;
         }
-        if (m_particle[i].type == PARTILIMIT3)
+        if (m_particle.type[i] == PARTILIMIT3)
         {
             if (progress >= 1.0f)
             {
@@ -1492,8 +1585,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f;
-            m_particle[i].intensity = 1.0f;
+            m_particle.zoom[i] = 1.0f;
+            m_particle.intensity[i] = 1.0f;
 
             ts.x = 0.500f;
             ts.y = 0.125f;
@@ -1501,22 +1594,22 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIFOG0)
+        if (m_particle.type[i] == PARTIFOG0)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.3f+sinf(progress)*0.15f;
-            m_particle[i].angle += rTime*0.05f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.3f+sinf(progress)*0.15f;
+            m_particle.angle[i] += rTime*0.05f;
 
             ts.x = 0.25f;
             ts.y = 0.75f;
             ti.x = ts.x+0.25f;
             ti.y = ts.y+0.25f;
         }
-        if (m_particle[i].type == PARTIFOG1)
+        if (m_particle.type[i] == PARTIFOG1)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.3f+sinf(progress)*0.15f;
-            m_particle[i].angle -= rTime*0.07f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.3f+sinf(progress)*0.15f;
+            m_particle.angle[i] -= rTime*0.07f;
 
             ts.x = 0.25f;
             ts.y = 0.75f;
@@ -1524,22 +1617,22 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIFOG2)
+        if (m_particle.type[i] == PARTIFOG2)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.6f+sinf(progress)*0.15f;
-            m_particle[i].angle += rTime*0.05f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.6f+sinf(progress)*0.15f;
+            m_particle.angle[i] += rTime*0.05f;
 
             ts.x = 0.75f;
             ts.y = 0.75f;
             ti.x = ts.x+0.25f;
             ti.y = ts.y+0.25f;
         }
-        if (m_particle[i].type == PARTIFOG3)
+        if (m_particle.type[i] == PARTIFOG3)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.6f+sinf(progress)*0.15f;
-            m_particle[i].angle -= rTime*0.07f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.6f+sinf(progress)*0.15f;
+            m_particle.angle[i] -= rTime*0.07f;
 
             ts.x = 0.75f;
             ts.y = 0.75f;
@@ -1547,22 +1640,22 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIFOG4)
+        if (m_particle.type[i] == PARTIFOG4)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.5f+sinf(progress)*0.2f;
-            m_particle[i].angle += rTime*0.05f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.5f+sinf(progress)*0.2f;
+            m_particle.angle[i] += rTime*0.05f;
 
             ts.x = 0.00f;
             ts.y = 0.25f;
             ti.x = ts.x+0.25f;
             ti.y = ts.y+0.25f;
         }
-        if (m_particle[i].type == PARTIFOG5)
+        if (m_particle.type[i] == PARTIFOG5)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.5f+sinf(progress)*0.2f;
-            m_particle[i].angle -= rTime*0.07f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.5f+sinf(progress)*0.2f;
+            m_particle.angle[i] -= rTime*0.07f;
 
             ts.x = 0.00f;
             ts.y = 0.25f;
@@ -1570,22 +1663,22 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIFOG6)
+        if (m_particle.type[i] == PARTIFOG6)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.5f+sinf(progress)*0.2f;
-            m_particle[i].angle += rTime*0.05f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.5f+sinf(progress)*0.2f;
+            m_particle.angle[i] += rTime*0.05f;
 
             ts.x = 0.50f;
             ts.y = 0.25f;
             ti.x = ts.x+0.25f;
             ti.y = ts.y+0.25f;
         }
-        if (m_particle[i].type == PARTIFOG7)
+        if (m_particle.type[i] == PARTIFOG7)
         {
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 0.5f+sinf(progress)*0.2f;
-            m_particle[i].angle -= rTime*0.07f;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 0.5f+sinf(progress)*0.2f;
+            m_particle.angle[i] -= rTime*0.07f;
 
             ts.x = 0.50f;
             ts.y = 0.25f;
@@ -1595,25 +1688,25 @@ void CParticle::FrameParticle(float rTime)
 
         // Decreases the intensity if the camera
         // is almost at the same height (fog was eye level).
-        if ( m_particle[i].type >= PARTIFOG0 &&
-             m_particle[i].type <= PARTIFOG7 )
+        if ( m_particle.type[i] >= PARTIFOG0 &&
+             m_particle.type[i] <= PARTIFOG7 )
         {
             float h = 10.0f;
 
-            if ( m_particle[i].pos.y >= eye.y   &&
-                 m_particle[i].pos.y <  eye.y+h )
+            if ( m_particle.pos[i].y >= eye.y   &&
+                 m_particle.pos[i].y <  eye.y+h )
             {
-                m_particle[i].intensity *= (m_particle[i].pos.y-eye.y)/h;
+                m_particle.intensity[i] *= (m_particle.pos[i].y-eye.y)/h;
             }
-            if ( m_particle[i].pos.y >  eye.y-h &&
-                 m_particle[i].pos.y <  eye.y   )
+            if ( m_particle.pos[i].y >  eye.y-h &&
+                 m_particle.pos[i].y <  eye.y   )
             {
-                m_particle[i].intensity *= (eye.y-m_particle[i].pos.y)/h;
+                m_particle.intensity[i] *= (eye.y-m_particle.pos[i].y)/h;
             }
         }
 
-        if ( m_particle[i].type == PARTIEXPLOT ||
-             m_particle[i].type == PARTIEXPLOO )
+        if ( m_particle.type[i] == PARTIEXPLOT ||
+             m_particle.type[i] == PARTIEXPLOO )
         {
             if (progress >= 1.0f)
             {
@@ -1621,17 +1714,17 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress/2.0f;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress/2.0f;
+            m_particle.intensity[i] = 1.0f-progress;
 
-            if (m_particle[i].type == PARTIEXPLOT)  ts.x = 0.750f;
+            if (m_particle.type[i] == PARTIEXPLOT)  ts.x = 0.750f;
             else                                    ts.x = 0.875f;
             ts.y = 0.750f;
             ti.x = ts.x+0.125f;
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIEXPLOG1)
+        if (m_particle.type[i] == PARTIEXPLOG1)
         {
             if (progress >= 1.0f)
             {
@@ -1639,14 +1732,14 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.375f;
             ts.y = 0.000f;
             ti.x = ts.x+0.125f;
             ti.y = ts.y+0.125f;
         }
-        if (m_particle[i].type == PARTIEXPLOG2)
+        if (m_particle.type[i] == PARTIEXPLOG2)
         {
             if (progress >= 1.0f)
             {
@@ -1654,7 +1747,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.625f;
             ts.y = 0.000f;
@@ -1662,7 +1755,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIFLAME)
+        if (m_particle.type[i] == PARTIFLAME)
         {
             if (progress >= 1.0f)
             {
@@ -1670,14 +1763,14 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress/2.0f;
+            m_particle.zoom[i] = 1.0f-progress/2.0f;
             if (progress < 0.5f)
             {
-                m_particle[i].intensity = progress/0.5f;
+                m_particle.intensity[i] = progress/0.5f;
             }
             else
             {
-                m_particle[i].intensity = 2.0f-progress/0.5f;
+                m_particle.intensity[i] = 2.0f-progress/0.5f;
             }
 
             ts.x = 0.750f;
@@ -1686,17 +1779,17 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIBUBBLE)
+        if (m_particle.type[i] == PARTIBUBBLE)
         {
             if ( progress >= 1.0f ||
-                 m_particle[i].pos.y >= m_water->GetLevel() )
+                 m_particle.pos[i].y >= m_water->GetLevel() )
             {
                 DeleteRank(i);
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress/2.0f;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress/2.0f;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.250f;
             ts.y = 0.875f;
@@ -1704,9 +1797,9 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if ( m_particle[i].type == PARTISMOKE1 ||
-             m_particle[i].type == PARTISMOKE2 ||
-             m_particle[i].type == PARTISMOKE3 )
+        if ( m_particle.type[i] == PARTISMOKE1 ||
+             m_particle.type[i] == PARTISMOKE2 ||
+             m_particle.type[i] == PARTISMOKE3 )
         {
             if (progress >= 1.0f)
             {
@@ -1716,20 +1809,20 @@ void CParticle::FrameParticle(float rTime)
 
             if (progress < 0.25f)
             {
-                m_particle[i].zoom = progress/0.25f;
+                m_particle.zoom[i] = progress/0.25f;
             }
             else
             {
-                m_particle[i].intensity = 1.0f-(progress-0.25f)/0.75f;
+                m_particle.intensity[i] = 1.0f-(progress-0.25f)/0.75f;
             }
 
-            ts.x = 0.500f+0.125f*(m_particle[i].type-PARTISMOKE1);
+            ts.x = 0.500f+0.125f*(m_particle.type[i]-PARTISMOKE1);
             ts.y = 0.750f;
             ti.x = ts.x+0.125f;
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIBLOOD)
+        if (m_particle.type[i] == PARTIBLOOD)
         {
             if (progress >= 1.0f)
             {
@@ -1737,7 +1830,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.750f+(rand()%2)*0.125f;
             ts.y = 0.875f;
@@ -1745,7 +1838,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIBLOODM)
+        if (m_particle.type[i] == PARTIBLOODM)
         {
             if (progress >= 1.0f)
             {
@@ -1753,7 +1846,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.875f;
             ts.y = 0.750f;
@@ -1761,7 +1854,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if ( m_particle[i].type == PARTIVIRUS )
+        if ( m_particle.type[i] == PARTIVIRUS )
         {
             if (progress >= 1.0f)
             {
@@ -1770,14 +1863,14 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress < 0.25f)
-                m_particle[i].zoom = progress/0.25f;
+                m_particle.zoom[i] = progress/0.25f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.25f)/0.75f;
+                m_particle.intensity[i] = 1.0f-(progress-0.25f)/0.75f;
 
-            m_particle[i].angle += rTime*Math::PI*1.0f;
+            m_particle.angle[i] += rTime*Math::PI*1.0f;
         }
 
-        if (m_particle[i].type == PARTIBLUE)
+        if (m_particle.type[i] == PARTIBLUE)
         {
             if (progress >= 1.0f)
             {
@@ -1785,7 +1878,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress;
 
             ts.x = 0.625f;
             ts.y = 0.750f;
@@ -1793,7 +1886,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIROOT)
+        if (m_particle.type[i] == PARTIROOT)
         {
             if (progress >= 1.0f)
             {
@@ -1803,11 +1896,11 @@ void CParticle::FrameParticle(float rTime)
 
             if (progress < 0.25f)
             {
-                m_particle[i].zoom = progress/0.25f;
+                m_particle.zoom[i] = progress/0.25f;
             }
             else
             {
-                m_particle[i].intensity = 1.0f-(progress-0.25f)/0.75f;
+                m_particle.intensity[i] = 1.0f-(progress-0.25f)/0.75f;
             }
 
             ts.x = 0.000f;
@@ -1816,7 +1909,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIRECOVER)
+        if (m_particle.type[i] == PARTIRECOVER)
         {
             if (progress >= 1.0f)
             {
@@ -1826,11 +1919,11 @@ void CParticle::FrameParticle(float rTime)
 
             if (progress < 0.25f)
             {
-                m_particle[i].zoom = progress/0.25f;
+                m_particle.zoom[i] = progress/0.25f;
             }
             else
             {
-                m_particle[i].intensity = 1.0f-(progress-0.25f)/0.75f;
+                m_particle.intensity[i] = 1.0f-(progress-0.25f)/0.75f;
             }
 
             ts.x = 0.875f;
@@ -1839,7 +1932,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIEJECT)
+        if (m_particle.type[i] == PARTIEJECT)
         {
             if (progress >= 1.0f)
             {
@@ -1847,8 +1940,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f+powf(progress, 2.0f)*5.0f;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f+powf(progress, 2.0f)*5.0f;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.625f;
             ts.y = 0.875f;
@@ -1856,7 +1949,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTISCRAPS)
+        if (m_particle.type[i] == PARTISCRAPS)
         {
             if (progress >= 1.0f)
             {
@@ -1864,7 +1957,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress;
 
             ts.x = 0.625f;
             ts.y = 0.875f;
@@ -1872,9 +1965,9 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIFRAG)
+        if (m_particle.type[i] == PARTIFRAG)
         {
-            m_particle[i].angle += rTime*Math::PI*0.5f;
+            m_particle.angle[i] += rTime*Math::PI*0.5f;
 
             ts.x = 0.0f;
             ts.y = 0.0f;
@@ -1882,7 +1975,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = 0.0f;
         }
 
-        if (m_particle[i].type == PARTIPART)
+        if (m_particle.type[i] == PARTIPART)
         {
             ts.x = 0.0f;
             ts.y = 0.0f;
@@ -1890,13 +1983,13 @@ void CParticle::FrameParticle(float rTime)
             ti.y = 0.0f;
         }
 
-        if (m_particle[i].type == PARTIQUEUE)
+        if (m_particle.type[i] == PARTIQUEUE)
         {
-            if (m_particle[i].testTime >= 0.05f)
+            if (m_particle.testTime[i] >= 0.05f)
             {
-                m_particle[i].testTime = 0.0f;
+                m_particle.testTime[i] = 0.0f;
 
-                pos = m_particle[i].pos;
+                pos = m_particle.pos[i];
                 Math::Vector speed = Math::Vector(0.0f, 0.0f, 0.0f);
                 Math::Point dim;
                 dim.x = 1.0f*(Math::Rand()*0.8f+0.6f);
@@ -1910,18 +2003,18 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIORGANIC1)
+        if (m_particle.type[i] == PARTIORGANIC1)
         {
             if (progress >= 1.0f)
             {
                 DeleteRank(i);
 
-                pos = m_particle[i].pos;
+                pos = m_particle.pos[i];
                 Math::Point dim;
-                dim.x    = m_particle[i].dim.x/4.0f;
+                dim.x    = m_particle.dim[i].x/4.0f;
                 dim.y    = dim.x;
-                float duration = m_particle[i].duration;
-                float mass     = m_particle[i].mass;
+                float duration = m_particle.duration[i];
+                float mass     = m_particle.mass[i];
                 int total = static_cast<int>((10.0f*m_engine->GetParticleDensity()));
                 for (int j = 0; j < total; j++)
                 {
@@ -1944,7 +2037,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = (m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = (m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.125f;
             ts.y = 0.875f;
@@ -1952,7 +2045,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIORGANIC2)
+        if (m_particle.type[i] == PARTIORGANIC2)
         {
             if (progress >= 1.0f)
             {
@@ -1960,7 +2053,7 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration);
+            m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]);
 
             ts.x = 0.125f;
             ts.y = 0.875f;
@@ -1968,7 +2061,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIGLINT)
+        if (m_particle.type[i] == PARTIGLINT)
         {
             if (progress >= 1.0f)
             {
@@ -1977,9 +2070,9 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress > 0.5f)
-                m_particle[i].zoom = 1.0f-(progress-0.5f)*2.0f;
+                m_particle.zoom[i] = 1.0f-(progress-0.5f)*2.0f;
 
-            m_particle[i].angle = m_particle[i].time*Math::PI;
+            m_particle.angle[i] = m_particle.time[i]*Math::PI;
 
             ts.x = 0.75f;
             ts.y = 0.25f;
@@ -1987,7 +2080,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIGLINTb)
+        if (m_particle.type[i] == PARTIGLINTb)
         {
             if (progress >= 1.0f)
             {
@@ -1996,9 +2089,9 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress > 0.5f)
-                m_particle[i].zoom = 1.0f-(progress-0.5f)*2.0f;
+                m_particle.zoom[i] = 1.0f-(progress-0.5f)*2.0f;
 
-            m_particle[i].angle = m_particle[i].time*Math::PI;
+            m_particle.angle[i] = m_particle.time[i]*Math::PI;
 
             ts.x = 0.75f;
             ts.y = 0.50f;
@@ -2006,7 +2099,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIGLINTr)
+        if (m_particle.type[i] == PARTIGLINTr)
         {
             if (progress >= 1.0f)
             {
@@ -2015,9 +2108,9 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress > 0.5f)
-                m_particle[i].zoom = 1.0f-(progress-0.5f)*2.0f;
+                m_particle.zoom[i] = 1.0f-(progress-0.5f)*2.0f;
 
-            m_particle[i].angle = m_particle[i].time*Math::PI;
+            m_particle.angle[i] = m_particle.time[i]*Math::PI;
 
             ts.x = 0.75f;
             ts.y = 0.00f;
@@ -2025,8 +2118,8 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if ( m_particle[i].type >= PARTILENS1 &&
-             m_particle[i].type <= PARTILENS4 )
+        if ( m_particle.type[i] >= PARTILENS1 &&
+             m_particle.type[i] <= PARTILENS4 )
         {
             if (progress >= 1.0f)
             {
@@ -2035,17 +2128,17 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress < 0.5f)
-                m_particle[i].zoom = progress*2.0f;
+                m_particle.zoom[i] = progress*2.0f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.5f)*2.0f;
+                m_particle.intensity[i] = 1.0f-(progress-0.5f)*2.0f;
 
-            ts.x = 0.25f*(m_particle[i].type-PARTILENS1);
+            ts.x = 0.25f*(m_particle.type[i]-PARTILENS1);
             ts.y = 0.25f;
             ti.x = ts.x+0.25f;
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTICONTROL)
+        if (m_particle.type[i] == PARTICONTROL)
         {
             if (progress >= 1.0f)
             {
@@ -2055,12 +2148,12 @@ void CParticle::FrameParticle(float rTime)
 
             if (progress < 0.3f)
             {
-                m_particle[i].zoom = progress/0.3f;
+                m_particle.zoom[i] = progress/0.3f;
             }
             else
             {
-                m_particle[i].zoom = 1.0f;
-                m_particle[i].intensity = 1.0f-(progress-0.3f)/0.7f;
+                m_particle.zoom[i] = 1.0f;
+                m_particle.intensity[i] = 1.0f-(progress-0.3f)/0.7f;
             }
 
             ts.x = 0.00f;
@@ -2069,7 +2162,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIGUNDEL)
+        if (m_particle.type[i] == PARTIGUNDEL)
         {
             if (progress >= 1.0f)
             {
@@ -2078,9 +2171,9 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress > 0.5f)
-                m_particle[i].zoom = 1.0f-(m_particle[i].time-m_particle[i].duration/2.0f);
+                m_particle.zoom[i] = 1.0f-(m_particle.time[i]-m_particle.duration[i]/2.0f);
 
-            m_particle[i].angle = m_particle[i].time*Math::PI;
+            m_particle.angle[i] = m_particle.time[i]*Math::PI;
 
             ts.x = 0.75f;
             ts.y = 0.50f;
@@ -2088,29 +2181,29 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIQUARTZ)
+        if (m_particle.type[i] == PARTIQUARTZ)
         {
             if (progress >= 1.0f)
             {
-                m_particle[i].time = 0.0f;
-                m_particle[i].duration = 0.5f+Math::Rand()*2.0f;
-                m_particle[i].pos.x = m_particle[i].speed.x + (Math::Rand()-0.5f)*m_particle[i].mass;
-                m_particle[i].pos.y = m_particle[i].speed.y + (Math::Rand()-0.5f)*m_particle[i].mass;
-                m_particle[i].pos.z = m_particle[i].speed.z + (Math::Rand()-0.5f)*m_particle[i].mass;
-                m_particle[i].dim.x = 0.5f+Math::Rand()*1.5f;
-                m_particle[i].dim.y = m_particle[i].dim.x;
+                m_particle.time[i] = 0.0f;
+                m_particle.duration[i] = 0.5f+Math::Rand()*2.0f;
+                m_particle.pos[i].x = m_particle.speed[i].x + (Math::Rand()-0.5f)*m_particle.mass[i];
+                m_particle.pos[i].y = m_particle.speed[i].y + (Math::Rand()-0.5f)*m_particle.mass[i];
+                m_particle.pos[i].z = m_particle.speed[i].z + (Math::Rand()-0.5f)*m_particle.mass[i];
+                m_particle.dim[i].x = 0.5f+Math::Rand()*1.5f;
+                m_particle.dim[i].y = m_particle.dim[i].x;
                 progress = 0.0f;
             }
 
             if (progress < 0.2f)
             {
-                m_particle[i].zoom = progress/0.2f;
-                m_particle[i].intensity = 1.0f;
+                m_particle.zoom[i] = progress/0.2f;
+                m_particle.intensity[i] = 1.0f;
             }
             else
             {
-                m_particle[i].zoom = 1.0f;
-                m_particle[i].intensity = 1.0f-(progress-0.2f)/0.8f;
+                m_particle.zoom[i] = 1.0f;
+                m_particle.intensity[i] = 1.0f-(progress-0.2f)/0.8f;
             }
 
             ts.x = 0.25f;
@@ -2119,7 +2212,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTITOTO)
+        if (m_particle.type[i] == PARTITOTO)
         {
             if (progress >= 1.0f)
             {
@@ -2127,13 +2220,13 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress;
             if (progress < 0.15f)
-                m_particle[i].intensity = progress/0.15f;
+                m_particle.intensity[i] = progress/0.15f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.15f)/0.85f;
+                m_particle.intensity[i] = 1.0f-(progress-0.15f)/0.85f;
 
-            m_particle[i].intensity *= 0.5f;
+            m_particle.intensity[i] *= 0.5f;
 
             ts.x = 0.25f;
             ts.y = 0.50f;
@@ -2141,7 +2234,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIERROR)
+        if (m_particle.type[i] == PARTIERROR)
         {
             if (progress >= 1.0f)
             {
@@ -2149,8 +2242,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = progress*1.0f;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = progress*1.0f;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.500f;
             ts.y = 0.875f;
@@ -2158,7 +2251,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIWARNING)
+        if (m_particle.type[i] == PARTIWARNING)
         {
             if (progress >= 1.0f)
             {
@@ -2166,8 +2259,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = progress*1.0f;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = progress*1.0f;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.875f;
             ts.y = 0.875f;
@@ -2175,7 +2268,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIINFO)
+        if (m_particle.type[i] == PARTIINFO)
         {
             if (progress >= 1.0f)
             {
@@ -2183,8 +2276,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = progress*1.0f;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = progress*1.0f;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.750f;
             ts.y = 0.875f;
@@ -2192,14 +2285,14 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTISELY)
+        if (m_particle.type[i] == PARTISELY)
         {
             ts.x = 0.75f;
             ts.y = 0.25f;
             ti.x = ts.x+0.25f;
             ti.y = ts.y+0.25f;
         }
-        if (m_particle[i].type == PARTISELR)
+        if (m_particle.type[i] == PARTISELR)
         {
             ts.x = 0.75f;
             ts.y = 0.00f;
@@ -2207,7 +2300,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTISPHERE0)
+        if (m_particle.type[i] == PARTISPHERE0)
         {
             if (progress >= 1.0f)
             {
@@ -2215,14 +2308,14 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = progress*m_particle[i].dim.x;
+            m_particle.zoom[i] = progress*m_particle.dim[i].x;
 
             if (progress < 0.65f)
-                m_particle[i].intensity = progress/0.65f;
+                m_particle.intensity[i] = progress/0.65f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.65f)/0.35f;
+                m_particle.intensity[i] = 1.0f-(progress-0.65f)/0.35f;
 
-            m_particle[i].intensity *= 0.5f;
+            m_particle.intensity[i] *= 0.5f;
 
             ts.x = 0.50f;
             ts.y = 0.75f;
@@ -2230,7 +2323,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTISPHERE1)
+        if (m_particle.type[i] == PARTISPHERE1)
         {
             if (progress >= 1.0f)
             {
@@ -2239,12 +2332,12 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress < 0.30f)
-                m_particle[i].intensity = progress/0.30f;
+                m_particle.intensity[i] = progress/0.30f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.30f)/0.70f;
+                m_particle.intensity[i] = 1.0f-(progress-0.30f)/0.70f;
 
-            m_particle[i].zoom = progress*m_particle[i].dim.x;
-            m_particle[i].angle = m_particle[i].time*Math::PI*2.0f;
+            m_particle.zoom[i] = progress*m_particle.dim[i].x;
+            m_particle.angle[i] = m_particle.time[i]*Math::PI*2.0f;
 
             ts.x = 0.000f;
             ts.y = 0.000f;
@@ -2252,7 +2345,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTISPHERE2)
+        if (m_particle.type[i] == PARTISPHERE2)
         {
             if (progress >= 1.0f)
             {
@@ -2261,12 +2354,12 @@ void CParticle::FrameParticle(float rTime)
             }
 
             if (progress < 0.20f)
-                m_particle[i].intensity = 1.0f;
+                m_particle.intensity[i] = 1.0f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.20f)/0.80f;
+                m_particle.intensity[i] = 1.0f-(progress-0.20f)/0.80f;
 
-            m_particle[i].zoom = progress*m_particle[i].dim.x;
-            m_particle[i].angle = m_particle[i].time*Math::PI*2.0f;
+            m_particle.zoom[i] = progress*m_particle.dim[i].x;
+            m_particle.angle[i] = m_particle.time[i]*Math::PI*2.0f;
 
             ts.x = 0.125f;
             ts.y = 0.000f;
@@ -2274,27 +2367,27 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTISPHERE3)
+        if (m_particle.type[i] == PARTISPHERE3)
         {
-            if (m_particle[i].phase == PARPHEND &&
+            if (m_particle.phase[i] == PARPHEND &&
                 progress >= 1.0f)
             {
                 DeleteRank(i);
                 continue;
             }
 
-            if (m_particle[i].phase == PARPHSTART)
+            if (m_particle.phase[i] == PARPHSTART)
             {
-                m_particle[i].intensity = progress;
-                if (m_particle[i].intensity > 1.0f)
-                    m_particle[i].intensity = 1.0f;
+                m_particle.intensity[i] = progress;
+                if (m_particle.intensity[i] > 1.0f)
+                    m_particle.intensity[i] = 1.0f;
             }
 
-            if (m_particle[i].phase == PARPHEND)
-                m_particle[i].intensity = 1.0f-progress;
+            if (m_particle.phase[i] == PARPHEND)
+                m_particle.intensity[i] = 1.0f-progress;
 
-            m_particle[i].zoom = m_particle[i].dim.x;
-            m_particle[i].angle = m_particle[i].time*Math::PI*0.2f;
+            m_particle.zoom[i] = m_particle.dim[i].x;
+            m_particle.angle[i] = m_particle.time[i]*Math::PI*0.2f;
 
             ts.x = 0.25f;
             ts.y = 0.75f;
@@ -2302,7 +2395,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTISPHERE4)
+        if (m_particle.type[i] == PARTISPHERE4)
         {
             if (progress >= 1.0f)
             {
@@ -2310,14 +2403,14 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = progress*m_particle[i].dim.x;
+            m_particle.zoom[i] = progress*m_particle.dim[i].x;
 
             if (progress < 0.65 )
-                m_particle[i].intensity = progress/0.65f;
+                m_particle.intensity[i] = progress/0.65f;
             else
-                m_particle[i].intensity = 1.0f-(progress-0.65f)/0.35f;
+                m_particle.intensity[i] = 1.0f-(progress-0.65f)/0.35f;
 
-            m_particle[i].intensity *= 0.5f;
+            m_particle.intensity[i] *= 0.5f;
 
             ts.x = 0.125f;
             ts.y = 0.000f;
@@ -2325,11 +2418,11 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTISPHERE5)
+        if (m_particle.type[i] == PARTISPHERE5)
         {
-            m_particle[i].intensity = 0.7f+sinf(progress)*0.3f;
-            m_particle[i].zoom = m_particle[i].dim.x*(1.0f+sinf(progress*0.7f)*0.01f);
-            m_particle[i].angle = m_particle[i].time*Math::PI*0.2f;
+            m_particle.intensity[i] = 0.7f+sinf(progress)*0.3f;
+            m_particle.zoom[i] = m_particle.dim[i].x*(1.0f+sinf(progress*0.7f)*0.01f);
+            m_particle.angle[i] = m_particle.time[i]*Math::PI*0.2f;
 
             ts.x = 0.25f;
             ts.y = 0.50f;
@@ -2337,7 +2430,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTISPHERE6)
+        if (m_particle.type[i] == PARTISPHERE6)
         {
             if (progress >= 1.0f)
             {
@@ -2345,8 +2438,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = (1.0f-progress)*m_particle[i].dim.x;
-            m_particle[i].intensity = progress*0.5f;
+            m_particle.zoom[i] = (1.0f-progress)*m_particle.dim[i].x;
+            m_particle.intensity[i] = progress*0.5f;
 
             ts.x = 0.125f;
             ts.y = 0.000f;
@@ -2354,7 +2447,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIPLOUF0)
+        if (m_particle.type[i] == PARTIPLOUF0)
         {
             if (progress >= 1.0f)
             {
@@ -2362,8 +2455,8 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            m_particle[i].zoom = progress;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.50f;
             ts.y = 0.50f;
@@ -2371,17 +2464,17 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIDROP)
+        if (m_particle.type[i] == PARTIDROP)
         {
             if (progress >= 1.0f ||
-                m_particle[i].pos.y < m_water->GetLevel())
+                m_particle.pos[i].y < m_water->GetLevel())
             {
                 DeleteRank(i);
                 continue;
             }
 
-            m_particle[i].zoom = 1.0f-progress;
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.zoom[i] = 1.0f-progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.750f;
             ts.y = 0.500f;
@@ -2389,16 +2482,16 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIWATER)
+        if (m_particle.type[i] == PARTIWATER)
         {
             if (progress >= 1.0f ||
-                m_particle[i].pos.y < m_water->GetLevel())
+                m_particle.pos[i].y < m_water->GetLevel())
             {
                 DeleteRank(i);
                 continue;
             }
 
-            m_particle[i].intensity = 1.0f-progress;
+            m_particle.intensity[i] = 1.0f-progress;
 
             ts.x = 0.125f;
             ts.y = 0.125f;
@@ -2406,7 +2499,7 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.125f;
         }
 
-        if (m_particle[i].type == PARTIRAY1)  // tower ray ?
+        if (m_particle.type[i] == PARTIRAY1)  // tower ray ?
         {
             if (progress >= 1.0f)
             {
@@ -2414,15 +2507,15 @@ void CParticle::FrameParticle(float rTime)
                 continue;
             }
 
-            if (m_particle[i].testTime >= 0.2f)
+            if (m_particle.testTime[i] >= 0.2f)
             {
-                m_particle[i].testTime = 0.0f;
-                CObject* object = SearchObjectRay(m_particle[i].pos, m_particle[i].goal,
-                                         m_particle[i].type, m_particle[i].objFather);
+                m_particle.testTime[i] = 0.0f;
+                CObject* object = SearchObjectRay(m_particle.pos[i], m_particle.goal[i],
+                                         m_particle.type[i], m_particle.objFather[i]);
                 if (object != nullptr)
                 {
                     assert(object->Implements(ObjectInterfaceType::Damageable));
-                    dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Tower, std::numeric_limits<float>::infinity(), m_particle[i].objFather);
+                    dynamic_cast<CDamageableObject&>(*object).DamageObject(DamageType::Tower, std::numeric_limits<float>::infinity(), m_particle.objFather[i]);
                 }
             }
 
@@ -2432,8 +2525,8 @@ void CParticle::FrameParticle(float rTime)
             ti.y = ts.y+0.25f;
         }
 
-        if (m_particle[i].type == PARTIRAY2 ||
-            m_particle[i].type == PARTIRAY3)
+        if (m_particle.type[i] == PARTIRAY2 ||
+            m_particle.type[i] == PARTIRAY3)
         {
             if (progress >= 1.0f)
             {
@@ -2448,18 +2541,19 @@ void CParticle::FrameParticle(float rTime)
         }
 
         float dp = (1.0f/256.0f)/2.0f;
-        m_particle[i].texSup.x = ts.x+dp;
-        m_particle[i].texSup.y = ts.y+dp;
-        m_particle[i].texInf.x = ti.x-dp;
-        m_particle[i].texInf.y = ti.y-dp;
-        m_particle[i].time     += rTime;
-        m_particle[i].testTime += rTime;
+        m_particle.texSup[i].x = ts.x+dp;
+        m_particle.texSup[i].y = ts.y+dp;
+        m_particle.texInf[i].x = ti.x-dp;
+        m_particle.texInf[i].y = ti.y-dp;
     }
+
+    // Ageing of all particles updated in this frame
+    m_particle.Age(0, count);
 }
 
 bool CParticle::TrackMove(int i, Math::Vector pos, float progress)
 {
-    if (i < 0 || i >= MAXTRACK)  return true;
+    if (i < 0 || i >= static_cast<int>(m_track.size()))  return true;
     if (! m_track[i].used) return true;
 
     if (progress < 1.0f)  // particle exists?
@@ -2672,21 +2766,119 @@ void CParticle::TrackDraw(int i, ParticleType type)
     }
 }
 
+void CParticle::SetBatching(bool batching)
+{
+    m_batching = batching;
+}
+
+bool CParticle::GetBatching()
+{
+    return m_batching;
+}
+
+bool CParticle::IsParticleBatched(int i)
+{
+    if (!m_batching) return false;
+    if (m_particle.partiType[i] == 5) return false;  // text has its own texture and state
+    if (m_particle.ray[i]) return true;
+
+    if ( m_particle.type[i] >= PARTISPHERE0 &&
+         m_particle.type[i] <= PARTISPHERE6 )  return false;
+    if ( m_particle.type[i] == PARTIPLOUF0 )  return false;
+
+    return true;
+}
+
+void CParticle::DrawParticleQuad(int i, const Vertex vertex[4], const Math::Matrix* mat, const Color& color)
+{
+    if (!IsParticleBatched(i))
+    {
+        if (mat != nullptr)
+            m_device->SetTransform(TRANSFORM_WORLD, *mat);
+
+        m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, 4, color);
+        return;
+    }
+
+    // Rounded, so that particles of similar intensity share a draw call
+    ParticleBatchQuad quad;
+    quad.intensity = static_cast<int>(Math::Norm(m_particle.intensity[i])*PARTICLE_BATCH_LEVELS + 0.5f);
+    quad.color = color;
+    quad.first = m_batchVertices.size();
+    m_batchQuads.push_back(quad);
+
+    // The strip is split into two triangles with the same winding
+    const int order[6] = { 0, 1, 2, 2, 1, 3 };
+    for (int j = 0; j < 6; j++)
+    {
+        Vertex v = vertex[order[j]];
+        if (mat != nullptr)
+            v.coord = Math::Transform(*mat, v.coord);  // normals don't matter, lighting is off
+
+        m_batchVertices.push_back(v);
+    }
+}
+
+void CParticle::DrawParticleBatch(int state)
+{
+    if (m_batchQuads.empty()) return;
+
+    // Both blending modes of particles are commutative, so the quads can be reordered
+    std::stable_sort(m_batchQuads.begin(), m_batchQuads.end(),
+                     [](const ParticleBatchQuad& a, const ParticleBatchQuad& b)
+                     {
+                         if (a.intensity != b.intensity) return a.intensity < b.intensity;
+                         if (a.color.r != b.color.r) return a.color.r < b.color.r;
+                         if (a.color.g != b.color.g) return a.color.g < b.color.g;
+                         if (a.color.b != b.color.b) return a.color.b < b.color.b;
+                         return a.color.a < b.color.a;
+                     });
+
+    Math::Matrix matrix;
+    matrix.LoadIdentity();
+    m_device->SetTransform(TRANSFORM_WORLD, matrix);
+
+    std::size_t first = 0;
+    while (first < m_batchQuads.size())
+    {
+        const ParticleBatchQuad& quad = m_batchQuads[first];
+
+        m_batchSorted.clear();
+        std::size_t last = first;
+        while ( last < m_batchQuads.size() &&
+                m_batchQuads[last].intensity == quad.intensity &&
+                m_batchQuads[last].color == quad.color )
+        {
+            const Vertex* vertex = &m_batchVertices[m_batchQuads[last].first];
+            m_batchSorted.insert(m_batchSorted.end(), vertex, vertex+6);
+            last++;
+        }
+
+        m_engine->SetState(state, IntensityToColor(static_cast<float>(quad.intensity)/PARTICLE_BATCH_LEVELS));
+        m_device->DrawPrimitive(PRIMITIVE_TRIANGLES, m_batchSorted.data(), m_batchSorted.size(), quad.color);
+
+        first = last;
+    }
+
+    m_batchQuads.clear();
+    m_batchVertices.clear();
+}
+
 void CParticle::DrawParticleTriangle(int i)
 {
-    if (m_particle[i].zoom == 0.0f)  return;
+    if (m_particle.zoom[i] == 0.0f)  return;
 
     Math::Vector eye = m_engine->GetEyePt();
-    Math::Vector pos = m_particle[i].pos;
+    Math::Vector pos = m_particle.pos[i];
 
-    CObject* object = m_particle[i].objLink;
+    CObject* object = m_particle.objLink[i];
     if (object != nullptr)
         pos += object->GetPosition();
 
     Math::Vector angle;
     angle.x = -Math::RotateAngle(Math::DistanceProjected(pos, eye), pos.y-eye.y);
     angle.y = Math::RotateAngle(pos.z-eye.z, pos.x-eye.x);
-    angle.z = m_particle[i].angle;
+    angle.z = m_particle.angle[i];
 
     Math::Matrix mat;
     Math::LoadRotationXZYMatrix(mat, angle);
@@ -2695,30 +2887,30 @@ void CParticle::DrawParticleTriangle(int i)
     mat.Set(3, 4, pos.z);
     m_device->SetTransform(TRANSFORM_WORLD, mat);
 
-    m_device->DrawPrimitive(PRIMITIVE_TRIANGLES, m_triangle[i].triangle, 3);
+    m_device->DrawPrimitive(PRIMITIVE_TRIANGLES, m_particle.triangle[i].triangle, 3);
     m_engine->AddStatisticTriangle(1);
 }
 
 void CParticle::DrawParticleNorm(int i)
 {
-    float zoom = m_particle[i].zoom;
+    float zoom = m_particle.zoom[i];
 
     if (zoom == 0.0f) return;
-    if (m_particle[i].intensity == 0.0f) return;
+    if (m_particle.intensity[i] == 0.0f) return;
 
 
     Math::Vector corner[4];
     Vertex vertex[4];
 
-    if (m_particle[i].sheet == SH_INTERFACE)
+    if (m_particle.sheet[i] == SH_INTERFACE)
     {
-        Math::Vector pos = m_particle[i].pos;
+        Math::Vector pos = m_particle.pos[i];
 
         Math::Vector n(0.0f, 0.0f, -1.0f);
 
         Math::Point dim;
-        dim.x = m_particle[i].dim.x * zoom;
-        dim.y = m_particle[i].dim.y * zoom;
+        dim.x = m_particle.dim[i].x * zoom;
+        dim.y = m_particle.dim[i].y * zoom;
 
         corner[0].x = pos.x+dim.x;
         corner[0].y = pos.y+dim.y;
@@ -2736,40 +2928,39 @@ void CParticle::DrawParticleNorm(int i)
         corner[3].y = pos.y-dim.y;
         corner[3].z = 0.0f;
 
-        vertex[0] = Vertex(corner[1], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texSup.y));
-        vertex[1] = Vertex(corner[0], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texSup.y));
-        vertex[2] = Vertex(corner[3], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texInf.y));
-        vertex[3] = Vertex(corner[2], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texInf.y));
+        vertex[0] = Vertex(corner[1], n, Math::Point(m_particle.texSup[i].x, m_particle.texSup[i].y));
+        vertex[1] = Vertex(corner[0], n, Math::Point(m_particle.texInf[i].x, m_particle.texSup[i].y));
+        vertex[2] = Vertex(corner[3], n, Math::Point(m_particle.texSup[i].x, m_particle.texInf[i].y));
+        vertex[3] = Vertex(corner[2], n, Math::Point(m_particle.texInf[i].x, m_particle.texInf[i].y));
 
-        m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, 4);
+        DrawParticleQuad(i, vertex, nullptr);
         m_engine->AddStatisticTriangle(2);
     }
     else
     {
         Math::Vector eye = m_engine->GetEyePt();
-        Math::Vector pos = m_particle[i].pos;
+        Math::Vector pos = m_particle.pos[i];
 
-        CObject* object = m_particle[i].objLink;
+        CObject* object = m_particle.objLink[i];
         if (object != nullptr)
             pos += object->GetPosition();
 
         Math::Vector angle;
         angle.x = -Math::RotateAngle(Math::DistanceProjected(pos, eye), pos.y-eye.y);
         angle.y = Math::RotateAngle(pos.z-eye.z, pos.x-eye.x);
-        angle.z = m_particle[i].angle;
+        angle.z = m_particle.angle[i];
 
         Math::Matrix mat;
         Math::LoadRotationXZYMatrix(mat, angle);
         mat.Set(1, 4, pos.x);
         mat.Set(2, 4, pos.y);
         mat.Set(3, 4, pos.z);
-        m_device->SetTransform(TRANSFORM_WORLD, mat);
 
         Math::Vector n(0.0f, 0.0f, -1.0f);
 
         Math::Point dim;
-        dim.x = m_particle[i].dim.x * zoom;
-        dim.y = m_particle[i].dim.y * zoom;
+        dim.x = m_particle.dim[i].x * zoom;
+        dim.y = m_particle.dim[i].y * zoom;
 
         corner[0].x =  dim.x;
         corner[0].y =  dim.y;
@@ -2787,31 +2978,31 @@ void CParticle::DrawParticleNorm(int i)
         corner[3].y = -dim.y;
         corner[3].z =  0.0f;
 
-        vertex[0] = Vertex(corner[1], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texSup.y));
-        vertex[1] = Vertex(corner[0], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texSup.y));
-        vertex[2] = Vertex(corner[3], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texInf.y));
-        vertex[3] = Vertex(corner[2], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texInf.y));
+        vertex[0] = Vertex(corner[1], n, Math::Point(m_particle.texSup[i].x, m_particle.texSup[i].y));
+        vertex[1] = Vertex(corner[0], n, Math::Point(m_particle.texInf[i].x, m_particle.texSup[i].y));
+        vertex[2] = Vertex(corner[3], n, Math::Point(m_particle.texSup[i].x, m_particle.texInf[i].y));
+        vertex[3] = Vertex(corner[2], n, Math::Point(m_particle.texInf[i].x, m_particle.texInf[i].y));
 
-        m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, 4, m_particle[i].color);
+        DrawParticleQuad(i, vertex, &mat, m_particle.color[i]);
         m_engine->AddStatisticTriangle(2);
     }
 }
 
 void CParticle::DrawParticleFlat(int i)
 {
-    if (m_particle[i].zoom == 0.0f) return;
-    if (m_particle[i].intensity == 0.0f) return;
+    if (m_particle.zoom[i] == 0.0f) return;
+    if (m_particle.intensity[i] == 0.0f) return;
 
-    Math::Vector pos = m_particle[i].pos;
+    Math::Vector pos = m_particle.pos[i];
 
-    CObject* object = m_particle[i].objLink;
+    CObject* object = m_particle.objLink[i];
     if (object != nullptr)
         pos += object->GetPosition();
 
     Math::Vector angle;
     angle.x = Math::PI/2.0f;
     angle.y = 0.0f;
-    angle.z = m_particle[i].angle;
+    angle.z = m_particle.angle[i];
 
     if (m_engine->GetRankView() == 1)  // underwater?
         pos.y -= 1.0f;
@@ -2825,13 +3016,12 @@ void CParticle::DrawParticleFlat(int i)
     mat.Set(1, 4, pos.x);
     mat.Set(2, 4, pos.y);
     mat.Set(3, 4, pos.z);
-    m_device->SetTransform(TRANSFORM_WORLD, mat);
 
     Math::Vector n(0.0f, 0.0f, -1.0f);
 
     Math::Point dim;
-    dim.x = m_particle[i].dim.x * m_particle[i].zoom;
-    dim.y = m_particle[i].dim.y * m_particle[i].zoom;
+    dim.x = m_particle.dim[i].x * m_particle.zoom[i];
+    dim.y = m_particle.dim[i].y * m_particle.zoom[i];
 
     Math::Vector corner[4];
     corner[0].x =  dim.x;
@@ -2851,56 +3041,56 @@ void CParticle::DrawParticleFlat(int i)
     corner[3].z =  0.0f;
 
     Vertex vertex[4];
-    vertex[0] = Vertex(corner[1], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texSup.y));
-    vertex[1] = Vertex(corner[0], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texSup.y));
-    vertex[2] = Vertex(corner[3], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texInf.y));
-    vertex[3] = Vertex(corner[2], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texInf.y));
+    vertex[0] = Vertex(corner[1], n, Math::Point(m_particle.texSup[i].x, m_particle.texSup[i].y));
+    vertex[1] = Vertex(corner[0], n, Math::Point(m_particle.texInf[i].x, m_particle.texSup[i].y));
+    vertex[2] = Vertex(corner[3], n, Math::Point(m_particle.texSup[i].x, m_particle.texInf[i].y));
+    vertex[3] = Vertex(corner[2], n, Math::Point(m_particle.texInf[i].x, m_particle.texInf[i].y));
 
-    m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, 4);
+    DrawParticleQuad(i, vertex, &mat);
     m_engine->AddStatisticTriangle(2);
 }
 
 void CParticle::DrawParticleFog(int i)
 {
     if (!m_engine->GetFog()) return;
-    if (m_particle[i].intensity == 0.0f) return;
+    if (m_particle.intensity[i] == 0.0f) return;
 
-    Math::Vector pos = m_particle[i].pos;
+    Math::Vector pos = m_particle.pos[i];
 
     Math::Point dim;
-    dim.x = m_particle[i].dim.x;
-    dim.y = m_particle[i].dim.y;
+    dim.x = m_particle.dim[i].x;
+    dim.y = m_particle.dim[i].y;
 
     Math::Point zoom;
 
-    if ( m_particle[i].type == PARTIFOG0 ||
-         m_particle[i].type == PARTIFOG2 ||
-         m_particle[i].type == PARTIFOG4 ||
-         m_particle[i].type == PARTIFOG6 )
+    if ( m_particle.type[i] == PARTIFOG0 ||
+         m_particle.type[i] == PARTIFOG2 ||
+         m_particle.type[i] == PARTIFOG4 ||
+         m_particle.type[i] == PARTIFOG6 )
     {
-        zoom.x = 1.0f+sinf(m_particle[i].zoom*2.0f)/6.0f;
-        zoom.y = 1.0f+cosf(m_particle[i].zoom*2.7f)/6.0f;
+        zoom.x = 1.0f+sinf(m_particle.zoom[i]*2.0f)/6.0f;
+        zoom.y = 1.0f+cosf(m_particle.zoom[i]*2.7f)/6.0f;
     }
-    if ( m_particle[i].type == PARTIFOG1 ||
-         m_particle[i].type == PARTIFOG3 ||
-         m_particle[i].type == PARTIFOG5 ||
-         m_particle[i].type == PARTIFOG7 )
+    if ( m_particle.type[i] == PARTIFOG1 ||
+         m_particle.type[i] == PARTIFOG3 ||
+         m_particle.type[i] == PARTIFOG5 ||
+         m_particle.type[i] == PARTIFOG7 )
     {
-        zoom.x = 1.0f+sinf(m_particle[i].zoom*3.0f)/6.0f;
-        zoom.y = 1.0f+cosf(m_particle[i].zoom*3.7f)/6.0f;
+        zoom.x = 1.0f+sinf(m_particle.zoom[i]*3.0f)/6.0f;
+        zoom.y = 1.0f+cosf(m_particle.zoom[i]*3.7f)/6.0f;
     }
 
     dim.x *= zoom.x;
     dim.y *= zoom.y;
 
-    CObject* object = m_particle[i].objLink;
+    CObject* object = m_particle.objLink[i];
     if (object != nullptr)
         pos += object->GetPosition();
 
     Math::Vector angle;
     angle.x = Math::PI/2.0f;
     angle.y = 0.0f;
-    angle.z = m_particle[i].angle;
+    angle.z = m_particle.angle[i];
 
     if (m_engine->GetRankView() == 1)  // underwater?
         pos.y -= 1.0f;
@@ -2914,7 +3104,6 @@ void CParticle::DrawParticleFog(int i)
     mat.Set(1, 4, pos.x);
     mat.Set(2, 4, pos.y);
     mat.Set(3, 4, pos.z);
-    m_device->SetTransform(TRANSFORM_WORLD, mat);
 
     Math::Vector n(0.0f, 0.0f, -1.0f);
 
@@ -2938,25 +3127,25 @@ void CParticle::DrawParticleFog(int i)
 
     Vertex vertex[4];
 
-    vertex[0] = Vertex(corner[1], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texSup.y));
-    vertex[1] = Vertex(corner[0], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texSup.y));
-    vertex[2] = Vertex(corner[3], n, Math::Point(m_particle[i].texSup.x, m_particle[i].texInf.y));
-    vertex[3] = Vertex(corner[2], n, Math::Point(m_particle[i].texInf.x, m_particle[i].texInf.y));
+    vertex[0] = Vertex(corner[1], n, Math::Point(m_particle.texSup[i].x, m_particle.texSup[i].y));
+    vertex[1] = Vertex(corner[0], n, Math::Point(m_particle.texInf[i].x, m_particle.texSup[i].y));
+    vertex[2] = Vertex(corner[3], n, Math::Point(m_particle.texSup[i].x, m_particle.texInf[i].y));
+    vertex[3] = Vertex(corner[2], n, Math::Point(m_particle.texInf[i].x, m_particle.texInf[i].y));
 
-    m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, 4);
+    DrawParticleQuad(i, vertex, &mat);
     m_engine->AddStatisticTriangle(2);
 }
 
 void CParticle::DrawParticleRay(int i)
 {
-    if (m_particle[i].zoom == 0.0f)  return;
-    if (m_particle[i].intensity == 0.0f)  return;
+    if (m_particle.zoom[i] == 0.0f)  return;
+    if (m_particle.intensity[i] == 0.0f)  return;
 
     Math::Vector eye = m_engine->GetEyePt();
-    Math::Vector pos = m_particle[i].pos;
-    Math::Vector goal = m_particle[i].goal;
+    Math::Vector pos = m_particle.pos[i];
+    Math::Vector goal = m_particle.goal[i];
 
-    CObject* object = m_particle[i].objLink;
+    CObject* object = m_particle.objLink[i];
     if (object != nullptr)
         pos += object->GetPosition();
 
@@ -2975,13 +3164,12 @@ void CParticle::DrawParticleRay(int i)
     mat.Set(1, 4, pos.x);
     mat.Set(2, 4, pos.y);
     mat.Set(3, 4, pos.z);
-    m_device->SetTransform(TRANSFORM_WORLD, mat);
 
     Math::Vector n(0.0f, 0.0f, left ? 1.0f : -1.0f);
 
     Math::Point dim;
-    dim.x = m_particle[i].dim.x * m_particle[i].zoom;
-    dim.y = m_particle[i].dim.y * m_particle[i].zoom;
+    dim.x = m_particle.dim[i].x * m_particle.zoom[i];
+    dim.y = m_particle.dim[i].y * m_particle.zoom[i];
 
     if (left) dim.y = -dim.y;
 
@@ -3005,49 +3193,49 @@ void CParticle::DrawParticleRay(int i)
 
     int first, last;
 
-    if (m_particle[i].type == PARTIRAY2)
+    if (m_particle.type[i] == PARTIRAY2)
     {
         first = 0;
         last  = step;
         vario1 = 0.0f;
         vario2 = 0.0f;
     }
-    else if (m_particle[i].type == PARTIRAY3)
+    else if (m_particle.type[i] == PARTIRAY3)
     {
-        if (m_particle[i].time < m_particle[i].duration*0.40f)
+        if (m_particle.time[i] < m_particle.duration[i]*0.40f)
         {
-            float prop = m_particle[i].time / (m_particle[i].duration*0.40f);
+            float prop = m_particle.time[i] / (m_particle.duration[i]*0.40f);
             first = 0;
             last  = static_cast<int>(prop*step);
         }
-        else if (m_particle[i].time < m_particle[i].duration*0.60f)
+        else if (m_particle.time[i] < m_particle.duration[i]*0.60f)
         {
             first = 0;
             last  = step;
         }
         else
         {
-            float prop = (m_particle[i].time-m_particle[i].duration*0.60f) / (m_particle[i].duration*0.40f);
+            float prop = (m_particle.time[i]-m_particle.duration[i]*0.60f) / (m_particle.duration[i]*0.40f);
             first = static_cast<int>(prop*step);
             last  = step;
         }
     }
     else
     {
-        if (m_particle[i].time < m_particle[i].duration*0.50f)
+        if (m_particle.time[i] < m_particle.duration[i]*0.50f)
         {
-            float prop = m_particle[i].time / (m_particle[i].duration*0.50f);
+            float prop = m_particle.time[i] / (m_particle.duration[i]*0.50f);
             first = 0;
             last  = static_cast<int>(prop*step);
         }
-        else if (m_particle[i].time < m_particle[i].duration*0.75f)
+        else if (m_particle.time[i] < m_particle.duration[i]*0.75f)
         {
             first = 0;
             last  = step;
         }
         else
         {
-            float prop = (m_particle[i].time-m_particle[i].duration*0.75f) / (m_particle[i].duration*0.25f);
+            float prop = (m_particle.time[i]-m_particle.duration[i]*0.75f) / (m_particle.duration[i]*0.25f);
             first = static_cast<int>(prop*step);
             last  = step;
         }
@@ -3080,13 +3268,13 @@ void CParticle::DrawParticleRay(int i)
 
         if (rank >= first && rank <= last)
         {
-            Math::Point texInf = m_particle[i].texInf;
-            Math::Point texSup = m_particle[i].texSup;
+            Math::Point texInf = m_particle.texInf[i];
+            Math::Point texSup = m_particle.texSup[i];
 
             int r = rand() % 16;
             texInf.x += 0.25f*(r/4);
             texSup.x += 0.25f*(r/4);
-            if (r % 2 < 1 && adv > 0.0f && m_particle[i].type != PARTIRAY1)
+            if (r % 2 < 1 && adv > 0.0f && m_particle.type[i] != PARTIRAY1)
                 Math::Swap(texInf.x, texSup.x);
 
             if (r % 4 < 2)
@@ -3097,7 +3285,7 @@ void CParticle::DrawParticleRay(int i)
             vertex[2] = Vertex(corner[3], n, Math::Point(texSup.x, texInf.y));
             vertex[3] = Vertex(corner[2], n, Math::Point(texInf.x, texInf.y));
 
-            m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, 4);
+            DrawParticleQuad(i, vertex, &mat);
             m_engine->AddStatisticTriangle(2);
         }
         adv += dim.x*2.0f;
@@ -3106,28 +3294,28 @@ void CParticle::DrawParticleRay(int i)
 
 void CParticle::DrawParticleSphere(int i)
 {
-    float zoom = m_particle[i].zoom;
+    float zoom = m_particle.zoom[i];
 
     if (zoom == 0.0f) return;
 
     m_engine->SetState(ENG_RSTATE_TTEXTURE_BLACK | ENG_RSTATE_2FACE | ENG_RSTATE_WRAP,
-                       IntensityToColor(m_particle[i].intensity));
+                       IntensityToColor(m_particle.intensity[i]));
 
     Math::Matrix mat;
     mat.LoadIdentity();
     mat.Set(1, 1, zoom);
     mat.Set(2, 2, zoom);
     mat.Set(3, 3, zoom);
-    mat.Set(1, 4, m_particle[i].pos.x);
-    mat.Set(2, 4, m_particle[i].pos.y);
-    mat.Set(3, 4, m_particle[i].pos.z);
+    mat.Set(1, 4, m_particle.pos[i].x);
+    mat.Set(2, 4, m_particle.pos[i].y);
+    mat.Set(3, 4, m_particle.pos[i].z);
 
-    if (m_particle[i].angle != 0.0f)
+    if (m_particle.angle[i] != 0.0f)
     {
         Math::Vector angle;
-        angle.x = m_particle[i].angle*0.4f;
-        angle.y = m_particle[i].angle*1.0f;
-        angle.z = m_particle[i].angle*0.7f;
+        angle.x = m_particle.angle[i]*0.4f;
+        angle.y = m_particle.angle[i]*1.0f;
+        angle.z = m_particle.angle[i]*0.7f;
         Math::Matrix rot;
         Math::LoadRotationZXYMatrix(rot, angle);
         mat = Math::MultiplyMatrices(mat, rot);
@@ -3136,16 +3324,16 @@ void CParticle::DrawParticleSphere(int i)
     m_device->SetTransform(TRANSFORM_WORLD, mat);
 
     Math::Point ts, ti;
-    ts.x = m_particle[i].texSup.x;
-    ts.y = m_particle[i].texSup.y;
-    ti.x = m_particle[i].texInf.x;
-    ti.y = m_particle[i].texInf.y;
+    ts.x = m_particle.texSup[i].x;
+    ts.y = m_particle.texSup[i].y;
+    ti.x = m_particle.texInf[i].x;
+    ti.y = m_particle.texInf[i].y;
 
     int numRings, numSegments;
 
     // Choose a tesselation level.
-    if ( m_particle[i].type == PARTISPHERE3 ||
-         m_particle[i].type == PARTISPHERE5 )
+    if ( m_particle.type[i] == PARTISPHERE3 ||
+         m_particle.type[i] == PARTISPHERE5 )
     {
         numRings    = 16;
         numSegments = 16;
@@ -3200,7 +3388,7 @@ void CParticle::DrawParticleSphere(int i)
     m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, j);
     m_engine->AddStatisticTriangle(j);
 
-    m_engine->SetState(ENG_RSTATE_TTEXTURE_BLACK, IntensityToColor(m_particle[i].intensity));
+    m_engine->SetState(ENG_RSTATE_TTEXTURE_BLACK, IntensityToColor(m_particle.intensity[i]));
 }
 
 //! Returns the height depending on the progress
@@ -3214,29 +3402,29 @@ static float ProgressCylinder(float progress)
 
 void CParticle::DrawParticleCylinder(int i)
 {
-    float progress = m_particle[i].zoom;
-    float zoom = m_particle[i].dim.x;
-    float diam = m_particle[i].dim.y;
+    float progress = m_particle.zoom[i];
+    float zoom = m_particle.dim[i].x;
+    float diam = m_particle.dim[i].y;
     if (progress >= 1.0f || zoom == 0.0f)  return;
 
     m_engine->SetState(ENG_RSTATE_TTEXTURE_BLACK | ENG_RSTATE_2FACE | ENG_RSTATE_WRAP,
-                       IntensityToColor(m_particle[i].intensity));
+                       IntensityToColor(m_particle.intensity[i]));
 
     Math::Matrix mat;
     mat.LoadIdentity();
     mat.Set(1, 1, zoom);
     mat.Set(2, 2, zoom);
     mat.Set(3, 3, zoom);
-    mat.Set(1, 4, m_particle[i].pos.x);
-    mat.Set(2, 4, m_particle[i].pos.y);
-    mat.Set(3, 4, m_particle[i].pos.z);
+    mat.Set(1, 4, m_particle.pos[i].x);
+    mat.Set(2, 4, m_particle.pos[i].y);
+    mat.Set(3, 4, m_particle.pos[i].z);
     m_device->SetTransform(TRANSFORM_WORLD, mat);
 
     Math::Point ts, ti;
-    ts.x = m_particle[i].texSup.x;
-    ts.y = m_particle[i].texSup.y;
-    ti.x = m_particle[i].texInf.x;
-    ti.y = m_particle[i].texInf.y;
+    ts.x = m_particle.texSup[i].x;
+    ts.y = m_particle.texSup[i].y;
+    ti.x = m_particle.texInf[i].x;
+    ti.y = m_particle.texInf[i].y;
 
     int numRings = 5;
     int numSegments = 10;
@@ -3245,7 +3433,7 @@ void CParticle::DrawParticleCylinder(int i)
     float h[6] = { 0.0f };
     float d[6] = { 0.0f };
 
-    if (m_particle[i].type == PARTIPLOUF0)
+    if (m_particle.type[i] == PARTIPLOUF0)
     {
         float p1 = progress;  // front
         float p2 = powf(progress, 5.0f);  // back
@@ -3295,23 +3483,23 @@ void CParticle::DrawParticleCylinder(int i)
     m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, vertex, j);
     m_engine->AddStatisticTriangle(j);
 
-    m_engine->SetState(ENG_RSTATE_TTEXTURE_BLACK, IntensityToColor(m_particle[i].intensity));
+    m_engine->SetState(ENG_RSTATE_TTEXTURE_BLACK, IntensityToColor(m_particle.intensity[i]));
 }
 
 void CParticle::DrawParticleText(int i)
 {
-    CharTexture tex = m_engine->GetText()->GetCharTexture(static_cast<UTF8Char>(m_particle[i].text), FONT_STUDIO, FONT_SIZE_BIG*2.0f);
+    CharTexture tex = m_engine->GetText()->GetCharTexture(static_cast<UTF8Char>(m_particle.text[i]), FONT_STUDIO, FONT_SIZE_BIG*2.0f);
     if (tex.id == 0) return;
 
     m_device->SetTexture(0, tex.id);
-    m_engine->SetState(ENG_RSTATE_TTEXTURE_ALPHA, IntensityToColor(m_particle[i].intensity));
+    m_engine->SetState(ENG_RSTATE_TTEXTURE_ALPHA, IntensityToColor(m_particle.intensity[i]));
 
     Math::IntPoint fontTextureSize = m_engine->GetText()->GetFontTextureSize();
-    m_particle[i].texSup.x = static_cast<float>(tex.charPos.x) / fontTextureSize.x;
-    m_particle[i].texSup.y = static_cast<float>(tex.charPos.y) / fontTextureSize.y;
-    m_particle[i].texInf.x = static_cast<float>(tex.charPos.x + tex.charSize.x) / fontTextureSize.x;
-    m_particle[i].texInf.y = static_cast<float>(tex.charPos.y + tex.charSize.y) / fontTextureSize.y;
-    m_particle[i].color = Color(0.0f, 0.0f, 0.0f);
+    m_particle.texSup[i].x = static_cast<float>(tex.charPos.x) / fontTextureSize.x;
+    m_particle.texSup[i].y = static_cast<float>(tex.charPos.y) / fontTextureSize.y;
+    m_particle.texInf[i].x = static_cast<float>(tex.charPos.x + tex.charSize.x) / fontTextureSize.x;
+    m_particle.texInf[i].y = static_cast<float>(tex.charPos.y + tex.charSize.y) / fontTextureSize.y;
+    m_particle.color[i] = Color(0.0f, 0.0f, 0.0f);
 
     DrawParticleNorm(i);
 }
@@ -3380,15 +3568,16 @@ void CParticle::DrawParticle(int sheet)
     // Draw the basic particles of triangles.
     if (m_totalInterface[0][sheet] > 0)
     {
-        for (int i = 0; i < MAXPARTICULE; i++)
+        for (int i = 0; i < m_particle.GetCount(); i++)
         {
-            if (!m_particle[i].used)  continue;
-            if (m_particle[i].sheet != sheet)  continue;
-            if (m_particle[i].type == PARTIPART)  continue;
+            if (!m_particle.used[i])  continue;
+            if (m_particle.partiType[i] != 0)  continue;
+            if (m_particle.sheet[i] != sheet)  continue;
+            if (m_particle.type[i] == PARTIPART)  continue;
 
-            m_engine->SetTexture(!m_triangle[i].tex1Name.empty() ? "textures/"+m_triangle[i].tex1Name : "");
-            m_engine->SetMaterial(m_triangle[i].material);
-            m_engine->SetState(m_triangle[i].state);
+            m_engine->SetTexture(!m_particle.triangle[i].tex1Name.empty() ? "textures/"+m_particle.triangle[i].tex1Name : "");
+            m_engine->SetMaterial(m_particle.triangle[i].material);
+            m_engine->SetState(m_particle.triangle[i].state);
             DrawParticleTriangle(i);
         }
     }
@@ -3403,14 +3592,14 @@ void CParticle::DrawParticle(int sheet)
     m_engine->SetMaterial(mat);
 
     // Draw tire marks.
-    if (m_wheelTraceTotal > 0 && sheet == SH_WORLD)
+    if (!m_wheelTrace.empty() && sheet == SH_WORLD)
     {
         m_engine->SetState(ENG_RSTATE_OPAQUE_COLOR);
         Math::Matrix matrix;
         matrix.LoadIdentity();
         m_device->SetTransform(TRANSFORM_WORLD, matrix);
 
-        for (int i = 0; i < m_wheelTraceTotal; i++)
+        for (int i = 0; i < static_cast<int>(m_wheelTrace.size()); i++)
             DrawParticleWheel(i);
     }
 
@@ -3425,11 +3614,11 @@ void CParticle::DrawParticle(int sheet)
         else        state = ENG_RSTATE_TTEXTURE_BLACK;  // effect[00..02].png
         m_engine->SetState(state);
 
-        for (int j = 0; j < MAXPARTICULE; j++)
+        for (int i = 0; i < m_particle.GetCount(); i++)
         {
-            int i = MAXPARTICULE*t+j;
-            if (!m_particle[i].used)  continue;
-            if (m_particle[i].sheet != sheet)  continue;
+            if (!m_particle.used[i])  continue;
+            if (m_particle.partiType[i] != t)  continue;
+            if (m_particle.sheet[i] != sheet)  continue;
 
             if (!loadTexture && t != 5)
             {
@@ -3439,42 +3628,44 @@ void CParticle::DrawParticle(int sheet)
                 loadTexture = true;
             }
 
-            int r = m_particle[i].trackRank;
+            int r = m_particle.trackRank[i];
             if (r != -1)
             {
                 m_engine->SetState(state);
-                TrackDraw(r, m_particle[i].type);  // draws the drag
+                TrackDraw(r, m_particle.type[i]);  // draws the drag
                 if (!m_track[r].drawParticle)  continue;
             }
 
-            m_engine->SetState(state, IntensityToColor(m_particle[i].intensity));
+            // Batched particles get their state when the batch is drawn
+            if (!IsParticleBatched(i))
+                m_engine->SetState(state, IntensityToColor(m_particle.intensity[i]));
 
-            if (m_particle[i].ray)  // ray?
+            if (m_particle.ray[i])  // ray?
             {
                 DrawParticleRay(i);
             }
-            else if ( m_particle[i].type == PARTIFLIC  ||  // circle in the water?
-                      m_particle[i].type == PARTISHOW  ||
-                      m_particle[i].type == PARTICHOC  ||
-                      m_particle[i].type == PARTIGFLAT )
+            else if ( m_particle.type[i] == PARTIFLIC  ||  // circle in the water?
+                      m_particle.type[i] == PARTISHOW  ||
+                      m_particle.type[i] == PARTICHOC  ||
+                      m_particle.type[i] == PARTIGFLAT )
             {
                 DrawParticleFlat(i);
             }
-            else if ( m_particle[i].type >= PARTIFOG0 &&
-                      m_particle[i].type <= PARTIFOG7 )
+            else if ( m_particle.type[i] >= PARTIFOG0 &&
+                      m_particle.type[i] <= PARTIFOG7 )
             {
                 DrawParticleFog(i);
             }
-            else if ( m_particle[i].type >= PARTISPHERE0 &&
-                      m_particle[i].type <= PARTISPHERE6 )  // sphere?
+            else if ( m_particle.type[i] >= PARTISPHERE0 &&
+                      m_particle.type[i] <= PARTISPHERE6 )  // sphere?
             {
                 DrawParticleSphere(i);
             }
-            else if ( m_particle[i].type == PARTIPLOUF0 )  // cylinder?
+            else if ( m_particle.type[i] == PARTIPLOUF0 )  // cylinder?
             {
                 DrawParticleCylinder(i);
             }
-            else if ( m_particle[i].type == PARTIVIRUS )
+            else if ( m_particle.type[i] == PARTIVIRUS )
             {
                 DrawParticleText(i);
             }
@@ -3483,6 +3674,8 @@ void CParticle::DrawParticle(int sheet)
                 DrawParticleNorm(i);
             }
         }
+
+        DrawParticleBatch(state);
     }
 }
 
@@ -3495,6 +3688,31 @@ CObject* CParticle::SearchObjectGun(Math::Vector old, Math::Vector pos,
     if (type == PARTIGUN2) min = 2.0f;  // shooting insect?
     if (type == PARTIGUN3) min = 3.0f;  // suiciding spider?
 
+    unsigned int excluded = OBJECT_GRID_TOTO;
+    if (type == PARTIGUN1)  // fireball shooting?
+    {
+        excluded |= OBJECT_GRID_MOTHER;
+    }
+    else if (type == PARTIGUN2)  // shooting insect?
+    {
+        excluded |= OBJECT_GRID_ALIEN;
+    }
+    else if (type == PARTIGUN3)  // suiciding spider?
+    {
+        excluded |= OBJECT_GRID_ALIEN;
+    }
+    else if (type == PARTIGUN4)  // orgaball shooting?
+    {
+        excluded |= OBJECT_GRID_MOTHER;
+    }
+    else if (type == PARTITRACK11)  // phazer shooting?
+    {
+    }
+    else
+    {
+        return nullptr;
+    }
+
     Math::Vector box1 = old;
     Math::Vector box2 = pos;
     if (box1.x > box2.x)  Math::Swap(box1.x, box2.x);  // box1 < box2
@@ -3507,67 +3725,41 @@ CObject* CParticle::SearchObjectGun(Math::Vector old, Math::Vector pos,
     box2.y += min;
     box2.z += min;
 
+    CObjectGrid* grid = CObjectManager::GetInstancePointer()->GetObjectGrid();
+
+    if ( type == PARTIGUN2 ||  // shooting insect?
+         type == PARTIGUN3 )   // suiciding spider?
+    {
+        // Test if the ball is entered into the sphere of a shield; bounds of shielders include their shield.
+        // The last shielder found wins, as in the loop over all objects.
+        grid->FindNearSegment(pos, pos, 0.0f, OBJECT_GRID_SHOOTABLE | OBJECT_GRID_SHIELDER, excluded, m_searchObjects);
+        for (auto it = m_searchObjects.rbegin(); it != m_searchObjects.rend(); ++it)
+        {
+            CObject* obj = *it;
+            if (!obj->GetDetectable()) continue;  // inactive?
+            if (obj == father) continue;
+
+            CShielder* shielder = dynamic_cast<CShielder*>(obj);
+            if (shielder == nullptr) continue;
+
+            float shieldRadius = shielder->GetActiveShieldRadius();
+            if (shieldRadius > 0.0f && Math::Distance(obj->GetPosition(), pos) <= shieldRadius)
+                return obj;
+        }
+    }
+
+    // Only objects near the path of the shot can be hit
+    grid->FindNearSegment(old, pos, min, OBJECT_GRID_SHOOTABLE, excluded, m_searchObjects);
+
     CObject* best = nullptr;
     float best_dist = std::numeric_limits<float>::infinity();
-    bool shield = false;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : m_searchObjects)
     {
         if (!obj->GetDetectable()) continue;  // inactive?
         if (obj == father) continue;
 
-        ObjectType oType = obj->GetType();
-
-        if (oType == OBJECT_TOTO)  continue;
-
-        if (type == PARTIGUN1)  // fireball shooting?
-        {
-            if (oType == OBJECT_MOTHER)  continue;
-        }
-        else if (type == PARTIGUN2)  // shooting insect?
-        {
-            if (IsAlien(obj->GetType()))  continue;
-        }
-        else if (type == PARTIGUN3)  // suiciding spider?
-        {
-            if (IsAlien(obj->GetType()))  continue;
-        }
-        else if (type == PARTIGUN4)  // orgaball shooting?
-        {
-            if (oType == OBJECT_MOTHER)  continue;
-        }
-        else if (type == PARTITRACK11)  // phazer shooting?
-        {
-        }
-        else
-        {
-            continue;
-        }
-        if (!obj->Implements(ObjectInterfaceType::Damageable) && !obj->IsBulletWall())  continue;
-        if (obj->Implements(ObjectInterfaceType::Jostleable))  continue;
-
         Math::Vector oPos = obj->GetPosition();
 
-        if (obj->GetType() == OBJECT_MOBILErs)
-        {
-            CShielder* shielder = dynamic_cast<CShielder*>(obj);
-            if ( type == PARTIGUN2 ||  // shooting insect?
-                 type == PARTIGUN3 )   // suiciding spider?
-            {
-                // Test if the ball is entered into the sphere of a shield.
-                float shieldRadius = shielder->GetActiveShieldRadius();
-                if (shieldRadius > 0.0f)
-                {
-                    float dist = Math::Distance(oPos, pos);
-                    if (dist <= shieldRadius)
-                    {
-                        best = obj;
-                        shield = true;
-                    }
-                }
-            }
-        }
-        if (shield)  continue;
-
         // Test the center of the object, which is necessary for objects
         // that have no sphere in the center (station).
         float dist = Math::Distance(oPos, pos)-4.0f;
@@ -3620,15 +3812,16 @@ CObject* CParticle::SearchObjectRay(Math::Vector pos, Math::Vector goal,
     box2.y += min;
     box2.z += min;
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    CObjectGrid* grid = CObjectManager::GetInstancePointer()->GetObjectGrid();
+    grid->FindNearSegment(pos, goal, min, 0, OBJECT_GRID_TOTO, m_searchObjects);
+
+    for (CObject* obj : m_searchObjects)
     {
         if (!obj->GetDetectable()) continue;  // inactive?
         if (obj == father) continue;
 
         ObjectType oType = obj->GetType();
 
-        if (oType == OBJECT_TOTO)  continue;
-
         if ( type  == PARTIRAY1       &&
              oType != OBJECT_MOBILEtg &&
              oType != OBJECT_TEEN28   &&
@@ -3672,50 +3865,51 @@ Color CParticle::GetFogColor(Math::Vector pos)
 
     for (int fog = 0; fog < m_fogTotal; fog++)
     {
-        int i = m_fog[fog];  // i = rank of the particle
+        int i = m_fog[fog];  // i = channel of the particle
+        if (!CheckChannel(i))  continue;
 
-        if (pos.y >= m_particle[i].pos.y+FOG_HSUP)  continue;
-        if (pos.y <= m_particle[i].pos.y-FOG_HINF)  continue;
+        if (pos.y >= m_particle.pos[i].y+FOG_HSUP)  continue;
+        if (pos.y <= m_particle.pos[i].y-FOG_HINF)  continue;
 
-        float dist = Math::DistanceProjected(pos, m_particle[i].pos);
-        if (dist >= m_particle[i].dim.x*1.5f)  continue;
+        float dist = Math::DistanceProjected(pos, m_particle.pos[i]);
+        if (dist >= m_particle.dim[i].x*1.5f)  continue;
 
         // Calculates the horizontal distance.
-        float factor = 1.0f-powf(dist/(m_particle[i].dim.x*1.5f), 4.0f);
+        float factor = 1.0f-powf(dist/(m_particle.dim[i].x*1.5f), 4.0f);
 
         // Calculates the vertical distance.
-        if (pos.y > m_particle[i].pos.y)
-            factor *= 1.0f-(pos.y-m_particle[i].pos.y)/FOG_HSUP;
+        if (pos.y > m_particle.pos[i].y)
+            factor *= 1.0f-(pos.y-m_particle.pos[i].y)/FOG_HSUP;
         else
-            factor *= 1.0f-(m_particle[i].pos.y-pos.y)/FOG_HINF;
+            factor *= 1.0f-(m_particle.pos[i].y-pos.y)/FOG_HINF;
 
         factor *= 0.3f;
 
         Color color;
 
-        if ( m_particle[i].type == PARTIFOG0 ||
-             m_particle[i].type == PARTIFOG1 )  // blue?
+        if ( m_particle.type[i] == PARTIFOG0 ||
+             m_particle.type[i] == PARTIFOG1 )  // blue?
         {
             color.r = 0.0f;
             color.g = 0.5f;
             color.b = 1.0f;
         }
-        else if ( m_particle[i].type == PARTIFOG2 ||
-                  m_particle[i].type == PARTIFOG3 )  // red?
+        else if ( m_particle.type[i] == PARTIFOG2 ||
+                  m_particle.type[i] == PARTIFOG3 )  // red?
         {
             color.r = 2.0f;
             color.g = 1.0f;
             color.b = 0.0f;
         }
-        else if ( m_particle[i].type == PARTIFOG4 ||
-                  m_particle[i].type == PARTIFOG5 )  // white?
+        else if ( m_particle.type[i] == PARTIFOG4 ||
+                  m_particle.type[i] == PARTIFOG5 )  // white?
         {
             color.r = 1.0f;
             color.g = 1.0f;
             color.b = 1.0f;
         }
-        else if ( m_particle[i].type == PARTIFOG6 ||
-                  m_particle[i].type == PARTIFOG7 )  // yellow?
+        else if ( m_particle.type[i] == PARTIFOG6 ||
+                  m_particle.type[i] == PARTIFOG7 )  // yellow?
         {
             color.r = 0.8f;
             color.g = 1.0f;
@@ -3742,20 +3936,20 @@ Color CParticle::GetFogColor(Math::Vector pos)
 
 void CParticle::CutObjectLink(CObject* obj)
 {
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
+    for (int i = 0; i < m_particle.GetCount(); i++)
     {
-        if (!m_particle[i].used) continue;
+        if (!m_particle.used[i]) continue;
 
-        if (m_particle[i].objLink == obj)
+        if (m_particle.objLink[i] == obj)
         {
             // If the object this particle's coordinates are linked to doesn't exist anymore, remove the particle
             DeleteRank(i);
         }
 
-        if (m_particle[i].objFather == obj)
+        if (m_particle.objFather[i] == obj)
         {
             // If the object that spawned this partcle doesn't exist anymore, remove the link
-            m_particle[i].objFather = nullptr;
+            m_particle.objFather[i] = nullptr;
         }
     }
 }
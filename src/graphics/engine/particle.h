@@ -26,11 +26,16 @@
 
 
 #include "graphics/engine/engine.h"
+#include "graphics/engine/particle_store.h"
+#include "graphics/engine/particle_type.h"
 
 #include "object/interface/trace_drawing_object.h"
 
 #include "sound/sound_type.h"
 
+#include <utility>
+#include <vector>
+
 
 class CRobotMain;
 class CObject;
@@ -41,12 +46,18 @@ class CSoundInterface;
 namespace Gfx
 {
 
-const short MAXPARTICULE = 500;
 const short MAXPARTITYPE = 6;
-const short MAXTRACK = 100;
 const short MAXTRACKLEN = 10;
 const short MAXPARTIFOG = 100;
-const short MAXWHEELTRACE = 1000;
+/**
+ * \brief Number of intensity levels of batched particles
+ *
+ * Intensity is a factor of the texture stage, so particles with different intensities
+ * can't share a draw call. Batched particles have their intensity rounded
+ * to the nearest of these levels (steps of 1/64), so a batch makes
+ * at most PARTICLE_BATCH_LEVELS+1 draw calls per color instead of one per particle.
+ */
+const short PARTICLE_BATCH_LEVELS = 64;
 
 const short SH_WORLD = 0;       // particle in the world in the interface
 const short SH_FRONT = 1;       // particle in the world on the interface
@@ -60,139 +71,6 @@ const short SH_MAX = 3;
 // type == 4    ->  text     (white background)
 
 
-enum ParticleType
-{
-    PARTIEXPLOT     = 1,        //! < technology explosion
-    PARTIEXPLOO     = 2,        //! < organic explosion
-    PARTIMOTOR      = 3,        //! < the engine exhaust gas
-    PARTIGLINT      = 4,        //! < reflection
-    PARTIBLITZ      = 5,        //! < lightning recharging battery
-    PARTICRASH      = 6,        //! < dust after fall
-    PARTIGAS        = 7,        //! < gas from the reactor
-    PARTIFIRE       = 9,        //! < fireball shrinks
-    PARTIFIREZ      = 10,       //! < fireball grows
-    PARTIBLUE       = 11,       //! < blue ball
-    PARTISELY       = 12,       //! < yellow robot lights
-    PARTISELR       = 13,       //! < red robot lights
-    PARTIGUN1       = 18,       //! < bullet 1 (fireball)
-    PARTIGUN2       = 19,       //! < bullet 2 (ant)
-    PARTIGUN3       = 20,       //! < bullet 3 (spider)
-    PARTIGUN4       = 21,       //! < bullet 4 (orgaball)
-    PARTIFRAG       = 22,       //! < triangular fragment
-    PARTIQUEUE      = 23,       //! < inflamed tail (TODO: unused?)
-    PARTIORGANIC1   = 24,       //! < organic ball mother
-    PARTIORGANIC2   = 25,       //! < organic ball daughter
-    PARTISMOKE1     = 26,       //! < black smoke
-    PARTISMOKE2     = 27,       //! < black smoke
-    PARTISMOKE3     = 28,       //! < black smoke
-    PARTIBLOOD      = 30,       //! < human blood
-    PARTIBLOODM     = 31,       //! < AlienQueen blood
-    PARTIVAPOR      = 32,       //! < steam
-    PARTIVIRUS      = 33,       //! < virus (random letter)
-    PARTIRAY1       = 43,       //! < ray 1 (turn)
-    PARTIRAY2       = 44,       //! < ray 2 (electric arc)
-    PARTIRAY3       = 45,       //! < ray 3 (ExchangePost)
-    PARTIFLAME      = 47,       //! < flame
-    PARTIBUBBLE     = 48,       //! < bubble
-    PARTIFLIC       = 49,       //! < circles in the water
-    PARTIEJECT      = 50,       //! < ejection from the reactor
-    PARTISCRAPS     = 51,       //! < waste from the reactor
-    PARTITOTO       = 52,       //! < Robby's reactor
-    PARTIERROR      = 53,       //! < Robby says no
-    PARTIWARNING    = 54,       //! < Robby says blah
-    PARTIINFO       = 54,       //! < Robby says yes
-    PARTIQUARTZ     = 55,       //! < reflection crystal
-    PARTISPHERE0    = 56,       //! < explosion sphere
-    PARTISPHERE1    = 57,       //! < energy sphere
-    PARTISPHERE2    = 58,       //! < analysis sphere
-    PARTISPHERE3    = 59,       //! < shield sphere
-    PARTISPHERE4    = 60,       //! < information sphere (emit)
-    PARTISPHERE5    = 61,       //! < botanical sphere (gravity root)
-    PARTISPHERE6    = 62,       //! < information sphere (receive)
-    PARTIGUNDEL     = 66,       //! < bullet destroyed by shield
-    PARTIPART       = 67,       //! < object part
-    PARTITRACK1     = 68,       //! < drag 1
-    PARTITRACK2     = 69,       //! < drag 2
-    PARTITRACK3     = 70,       //! < drag 3
-    PARTITRACK4     = 71,       //! < drag 4
-    PARTITRACK5     = 72,       //! < drag 5
-    PARTITRACK6     = 73,       //! < drag 6
-    PARTITRACK7     = 74,       //! < drag 7
-    PARTITRACK8     = 75,       //! < drag 8
-    PARTITRACK9     = 76,       //! < drag 9
-    PARTITRACK10    = 77,       //! < drag 10
-    PARTITRACK11    = 78,       //! < drag 11
-    PARTITRACK12    = 79,       //! < drag 12 (TODO: unused?)
-    PARTIGLINTb     = 88,       //! < blue reflection
-    PARTIGLINTr     = 89,       //! < red reflection
-    PARTILENS1      = 90,       //! < brilliance 1 (orange)
-    PARTILENS2      = 91,       //! < brilliance 2 (yellow)
-    PARTILENS3      = 92,       //! < brilliance 3 (red)
-    PARTILENS4      = 93,       //! < brilliance 4 (violet)
-    PARTICONTROL    = 94,       //! < reflection on button
-    PARTISHOW       = 95,       //! < shows a place
-    PARTICHOC       = 96,       //! < shock wave
-    PARTIGFLAT      = 97,       //! < shows if the ground is flat
-    PARTIRECOVER    = 98,       //! < blue ball recycler
-    PARTIROOT       = 100,      //! < gravity root smoke
-    PARTIPLOUF0     = 101,      //! < splash
-    PARTIDROP       = 106,      //! < drop
-    PARTIFOG0       = 107,      //! < fog 0
-    PARTIFOG1       = 108,      //! < fog 1
-    PARTIFOG2       = 109,      //! < fog 2
-    PARTIFOG3       = 110,      //! < fog 3
-    PARTIFOG4       = 111,      //! < fog 4
-    PARTIFOG5       = 112,      //! < fog 5
-    PARTIFOG6       = 113,      //! < fog 6
-    PARTIFOG7       = 114,      //! < fog 7
-    PARTILIMIT1     = 117,      //! < shows the limits 1
-    PARTILIMIT2     = 118,      //! < shows the limits 2
-    PARTILIMIT3     = 119,      //! < shows the limits 3
-    PARTIWATER      = 121,      //! < drop of water
-    PARTIEXPLOG1    = 122,      //! < ball explosion 1
-    PARTIEXPLOG2    = 123,      //! < ball explosion 2
-    PARTIBASE       = 124,      //! < gases of spaceship
-};
-
-enum ParticlePhase
-{
-    PARPHSTART      = 0,
-    PARPHEND        = 1,
-};
-
-struct Particle
-{
-    bool            used = false;      // TRUE -> particle used
-    bool            ray = false;       // TRUE -> ray with goal
-    unsigned short  uniqueStamp = 0;    // unique mark
-    short           sheet = 0;      // sheet (0..n)
-    ParticleType    type = {};       // type PARTI*
-    ParticlePhase   phase = {};      // phase PARPH*
-    float           mass = 0.0f;       // mass of the particle (in rebounding)
-    float           weight = 0.0f;     // weight of the particle (for noise)
-    float           duration = 0.0f;   // length of life
-    Math::Vector    pos;        // absolute position (relative if object links)
-    Math::Vector    goal;       // goal position (if ray)
-    Math::Vector    speed;      // speed of displacement
-    float           windSensitivity = 0.0f;
-    short           bounce = 0;     // number of rebounds
-    Math::Point     dim;        // dimensions of the rectangle
-    float           zoom = 0.0f;       // zoom (0..1)
-    float           angle = 0.0f;      // angle of rotation
-    float           intensity = 0.0f;  // intensity
-    Math::Point     texSup;     // coordinated upper texture
-    Math::Point     texInf;     // coordinated lower texture
-    float           time = 0.0f;       // age of the particle (0..n)
-    float           phaseTime = 0.0f;  // age at the beginning of phase
-    float           testTime = 0.0f;   // time since last test
-    CObject*        objLink = nullptr;    // father object (for example reactor)
-    CObject*        objFather = nullptr;  // father object (for example reactor)
-    short           objRank = 0;    // rank of the object, or -1
-    short           trackRank = 0;  // rank of the drag
-    char            text = 0;
-    Color           color = Color(1.0f, 1.0f, 1.0f, 1.0f);
-};
-
 struct Track
 {
     char            used = 0;      // TRUE -> drag used
@@ -207,6 +85,14 @@ struct Track
     float           len[MAXTRACKLEN] = {};
 };
 
+//! Particle quad waiting in the batch of its texture
+struct ParticleBatchQuad
+{
+    int             intensity = 0;  // intensity in PARTICLE_BATCH_LEVELS steps
+    Color           color;
+    int             first = 0;      // first of 6 vertices in the vertex stream
+};
+
 struct WheelTrace
 {
     TraceColor      color = TraceColor::Black;
@@ -294,15 +180,43 @@ public:
     //! Indicates that the object binds to the particle no longer exists, without deleting it
     void        CutObjectLink(CObject* obj);
 
+    //! Management of batching of simple particles into a few draw calls, see PARTICLE_BATCH_LEVELS
+    void        SetBatching(bool batching);
+    bool        GetBatching();
+
+    //! Returns the number of live particles
+    int         GetParticleCount();
+    //! Returns the highest number of live particles since the last flush
+    int         GetParticlePeak();
+    //! Returns the number of particles culled because of the budget since the last flush
+    int         GetParticleCulled();
+
 protected:
+    //! Adds a particle, culling others if the budget is reached; returns its index or -1
+    int         AllocParticle(ParticleType type, int sheet, const Math::Vector& pos);
+    //! Returns true if the particle shouldn't be culled because it affects the game
+    bool        IsParticleEssential(ParticleType type, int sheet);
+    /**
+     * \brief Removes the particles with the lowest priority to make place for new ones
+     * \param score Culling score of the new particle, higher is culled first (negative for essential particles)
+     * \return true if the new particle can be created
+     */
+    bool        CullParticles(float score);
     //! Removes a particle of given rank
     void        DeleteRank(int rank);
     /**
-     * \brief Adapts the channel so it can be used as an offset in m_particle
+     * \brief Adapts the channel so it can be used as an index in m_particle
      * \param channel Channel number to process, will be modified to be index of particle in m_particle
      * \return true if success, false if particle doesn't exist anymore
      **/
     bool        CheckChannel(int &channel);
+    //! Returns true if the particle is drawn in the batch of its texture
+    bool        IsParticleBatched(int i);
+    //! Draws a particle quad given as a triangle strip, transformed by \a mat if not null, or adds it to the batch
+    void        DrawParticleQuad(int i, const Vertex vertex[4], const Math::Matrix* mat,
+                                 const Color& color = Color(1.0f, 1.0f, 1.0f, 1.0f));
+    //! Draws the batched particles with given state, a draw call for each intensity level and color
+    void        DrawParticleBatch(int state);
     //! Draws a triangular particle
     void        DrawParticleTriangle(int i);
     //! Draw a normal particle
@@ -340,12 +254,27 @@ protected:
     CRobotMain*       m_main = nullptr;
     CSoundInterface*  m_sound = nullptr;
 
-    Particle       m_particle[MAXPARTICULE*MAXPARTITYPE];
-    EngineTriangle m_triangle[MAXPARTICULE];  // triangle if PartiType == 0
-    Track          m_track[MAXTRACK];
-    int           m_wheelTraceTotal = 0;
+    ParticleStore  m_particle;
+    int           m_particlePeak = 0;
+    int           m_particleCulled = 0;
+    //! Buffer for culling candidates as (score, index) pairs
+    std::vector<std::pair<float, int>> m_cullCandidates;
+    //! True if the last culling found no candidates and none were created since
+    bool          m_cullExhausted = false;
+    bool          m_batching = true;
+    std::vector<ParticleBatchQuad> m_batchQuads;
+    //! Vertices of batched quads, in the order of adding
+    std::vector<Vertex> m_batchVertices;
+    //! Vertices of the draw call being prepared
+    std::vector<Vertex> m_batchSorted;
+    //! Buffer for objects found by spatial queries
+    std::vector<CObject*> m_searchObjects;
+    std::vector<Track> m_track;
+    //! Indexes of unused drags in m_track
+    std::vector<int> m_freeTracks;
     int           m_wheelTraceIndex = 0;
-    WheelTrace    m_wheelTrace[MAXWHEELTRACE];
+    //! Tire marks, reused from the oldest one when the limit is reached
+    std::vector<WheelTrace> m_wheelTrace;
     int           m_totalInterface[MAXPARTITYPE][SH_MAX] = {};
     bool          m_frameUpdate[SH_MAX] = {};
     int           m_fogTotal = 0;
@@ -0,0 +1,303 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "graphics/engine/particle_store.h"
+
+#include <utility>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PARTICLE_STORE_SSE
+#include <xmmintrin.h>
+#endif
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+//! Handles are limited to 16 bits, as they are combined with unique stamps in particle channels
+const int MAX_PARTICLE_HANDLES = 0x10000;
+
+
+int ParticleStore::GetCount() const
+{
+    return static_cast<int>(used.size());
+}
+
+int ParticleStore::Add()
+{
+    int newHandle;
+    if (!m_freeHandles.empty())
+    {
+        newHandle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        if (static_cast<int>(m_handleIndex.size()) >= MAX_PARTICLE_HANDLES)
+            return -1;
+
+        newHandle = m_handleIndex.size();
+        m_handleIndex.push_back(-1);
+    }
+
+    int index = GetCount();
+    m_handleIndex[newHandle] = index;
+
+    used.push_back(false);
+    ray.push_back(false);
+    uniqueStamp.push_back(0);
+    sheet.push_back(0);
+    partiType.push_back(0);
+    type.push_back(ParticleType());
+    phase.push_back(PARPHSTART);
+    mass.push_back(0.0f);
+    weight.push_back(0.0f);
+    duration.push_back(0.0f);
+    pos.x.push_back(0.0f);
+    pos.y.push_back(0.0f);
+    pos.z.push_back(0.0f);
+    goal.push_back(Math::Vector());
+    speed.x.push_back(0.0f);
+    speed.y.push_back(0.0f);
+    speed.z.push_back(0.0f);
+    windSensitivity.push_back(0.0f);
+    bounce.push_back(0);
+    dim.push_back(Math::Point());
+    zoom.push_back(0.0f);
+    angle.push_back(0.0f);
+    intensity.push_back(0.0f);
+    texSup.push_back(Math::Point());
+    texInf.push_back(Math::Point());
+    time.push_back(0.0f);
+    phaseTime.push_back(0.0f);
+    testTime.push_back(0.0f);
+    objLink.push_back(nullptr);
+    objFather.push_back(nullptr);
+    objRank.push_back(0);
+    trackRank.push_back(0);
+    text.push_back(0);
+    color.push_back(Color(1.0f, 1.0f, 1.0f, 1.0f));
+    triangle.push_back(EngineTriangle());
+    handle.push_back(newHandle);
+    moveStep.push_back(0.0f);
+    windStep.push_back(0.0f);
+    ageStep.push_back(0.0f);
+
+    return index;
+}
+
+int ParticleStore::GetIndex(int particleHandle) const
+{
+    if (particleHandle < 0 || particleHandle >= static_cast<int>(m_handleIndex.size()))
+        return -1;
+
+    return m_handleIndex[particleHandle];
+}
+
+void ParticleStore::Compact()
+{
+    int i = 0;
+    while (i < GetCount())
+    {
+        if (used[i])
+        {
+            i++;
+            continue;
+        }
+
+        m_handleIndex[handle[i]] = -1;
+        m_freeHandles.push_back(handle[i]);
+
+        int last = GetCount() - 1;
+        if (i != last)
+            MoveParticle(last, i);
+
+        RemoveLast();
+    }
+}
+
+void ParticleStore::Clear()
+{
+    while (GetCount() > 0)
+        RemoveLast();
+
+    m_handleIndex.clear();
+    m_freeHandles.clear();
+}
+
+void ParticleStore::MoveParticle(int from, int to)
+{
+    used[to] = used[from];
+    ray[to] = ray[from];
+    uniqueStamp[to] = uniqueStamp[from];
+    sheet[to] = sheet[from];
+    partiType[to] = partiType[from];
+    type[to] = type[from];
+    phase[to] = phase[from];
+    mass[to] = mass[from];
+    weight[to] = weight[from];
+    duration[to] = duration[from];
+    pos[to] = pos[from];
+    goal[to] = goal[from];
+    speed[to] = speed[from];
+    windSensitivity[to] = windSensitivity[from];
+    bounce[to] = bounce[from];
+    dim[to] = dim[from];
+    zoom[to] = zoom[from];
+    angle[to] = angle[from];
+    intensity[to] = intensity[from];
+    texSup[to] = texSup[from];
+    texInf[to] = texInf[from];
+    time[to] = time[from];
+    phaseTime[to] = phaseTime[from];
+    testTime[to] = testTime[from];
+    objLink[to] = objLink[from];
+    objFather[to] = objFather[from];
+    objRank[to] = objRank[from];
+    trackRank[to] = trackRank[from];
+    text[to] = text[from];
+    color[to] = color[from];
+    triangle[to] = std::move(triangle[from]);
+    handle[to] = handle[from];
+    moveStep[to] = moveStep[from];
+    windStep[to] = windStep[from];
+    ageStep[to] = ageStep[from];
+
+    m_handleIndex[handle[to]] = to;
+}
+
+void ParticleStore::RemoveLast()
+{
+    used.pop_back();
+    ray.pop_back();
+    uniqueStamp.pop_back();
+    sheet.pop_back();
+    partiType.pop_back();
+    type.pop_back();
+    phase.pop_back();
+    mass.pop_back();
+    weight.pop_back();
+    duration.pop_back();
+    pos.x.pop_back();
+    pos.y.pop_back();
+    pos.z.pop_back();
+    goal.pop_back();
+    speed.x.pop_back();
+    speed.y.pop_back();
+    speed.z.pop_back();
+    windSensitivity.pop_back();
+    bounce.pop_back();
+    dim.pop_back();
+    zoom.pop_back();
+    angle.pop_back();
+    intensity.pop_back();
+    texSup.pop_back();
+    texInf.pop_back();
+    time.pop_back();
+    phaseTime.pop_back();
+    testTime.pop_back();
+    objLink.pop_back();
+    objFather.pop_back();
+    objRank.pop_back();
+    trackRank.pop_back();
+    text.pop_back();
+    color.pop_back();
+    triangle.pop_back();
+    handle.pop_back();
+    moveStep.pop_back();
+    windStep.pop_back();
+    ageStep.pop_back();
+}
+
+void ParticleStore::Integrate(const Math::Vector& wind, int first, int last)
+{
+    float* px = pos.x.data();
+    float* py = pos.y.data();
+    float* pz = pos.z.data();
+    float* sx = speed.x.data();
+    float* sy = speed.y.data();
+    float* sz = speed.z.data();
+    const float* step = moveStep.data();
+    const float* wstep = windStep.data();
+    const float* m = mass.data();
+
+    int i = first;
+
+#ifdef PARTICLE_STORE_SSE
+    const __m128 windX = _mm_set1_ps(wind.x);
+    const __m128 windY = _mm_set1_ps(wind.y);
+    const __m128 windZ = _mm_set1_ps(wind.z);
+
+    for (; i + 4 <= last; i += 4)
+    {
+        __m128 s = _mm_loadu_ps(step + i);
+        __m128 w = _mm_loadu_ps(wstep + i);
+        __m128 vy = _mm_loadu_ps(sy + i);
+
+        __m128 x = _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(_mm_loadu_ps(sx + i), s));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(vy, s));
+        __m128 z = _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(_mm_loadu_ps(sz + i), s));
+
+        _mm_storeu_ps(px + i, _mm_add_ps(x, _mm_mul_ps(windX, w)));
+        _mm_storeu_ps(py + i, _mm_add_ps(y, _mm_mul_ps(windY, w)));
+        _mm_storeu_ps(pz + i, _mm_add_ps(z, _mm_mul_ps(windZ, w)));
+
+        // Gravity, particles without mass are not affected
+        _mm_storeu_ps(sy + i, _mm_sub_ps(vy, _mm_mul_ps(_mm_loadu_ps(m + i), s)));
+    }
+#endif
+
+    for (; i < last; i++)
+    {
+        px[i] = (px[i] + sx[i]*step[i]) + wind.x*wstep[i];
+        py[i] = (py[i] + sy[i]*step[i]) + wind.y*wstep[i];
+        pz[i] = (pz[i] + sz[i]*step[i]) + wind.z*wstep[i];
+
+        sy[i] -= m[i]*step[i];
+    }
+}
+
+void ParticleStore::Age(int first, int last)
+{
+    float* t = time.data();
+    float* tt = testTime.data();
+    const float* step = ageStep.data();
+
+    int i = first;
+
+#ifdef PARTICLE_STORE_SSE
+    for (; i + 4 <= last; i += 4)
+    {
+        __m128 s = _mm_loadu_ps(step + i);
+        _mm_storeu_ps(t + i,  _mm_add_ps(_mm_loadu_ps(t + i),  s));
+        _mm_storeu_ps(tt + i, _mm_add_ps(_mm_loadu_ps(tt + i), s));
+    }
+#endif
+
+    for (; i < last; i++)
+    {
+        t[i]  += step[i];
+        tt[i] += step[i];
+    }
+}
+
+
+} // namespace Gfx
@@ -0,0 +1,201 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/particle_store.h
+ * \brief Structure of arrays storage of particles - ParticleStore struct
+ */
+
+#pragma once
+
+#include "graphics/engine/engine.h"
+#include "graphics/engine/particle_type.h"
+
+#include "math/point.h"
+#include "math/vector.h"
+
+#include <vector>
+
+
+class CObject;
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+/**
+ * \struct ParticleVectorRef
+ * \brief Reference to a vector in ParticleVectorArray, usable like Math::Vector
+ */
+struct ParticleVectorRef
+{
+    float& x;
+    float& y;
+    float& z;
+
+    operator Math::Vector() const
+    {
+        return Math::Vector(x, y, z);
+    }
+
+    ParticleVectorRef& operator=(const Math::Vector& vector)
+    {
+        x = vector.x;
+        y = vector.y;
+        z = vector.z;
+        return *this;
+    }
+
+    ParticleVectorRef& operator=(const ParticleVectorRef& other)
+    {
+        return *this = Math::Vector(other);
+    }
+
+    ParticleVectorRef& operator+=(const Math::Vector& vector)
+    {
+        return *this = Math::Vector(*this) + vector;
+    }
+
+    ParticleVectorRef& operator-=(const Math::Vector& vector)
+    {
+        return *this = Math::Vector(*this) - vector;
+    }
+
+    friend Math::Vector operator+(const ParticleVectorRef& left, const Math::Vector& right)
+    {
+        return Math::Vector(left) + right;
+    }
+
+    friend Math::Vector operator-(const ParticleVectorRef& left, const Math::Vector& right)
+    {
+        return Math::Vector(left) - right;
+    }
+
+    friend Math::Vector operator*(const ParticleVectorRef& left, float right)
+    {
+        return Math::Vector(left) * right;
+    }
+};
+
+/**
+ * \struct ParticleVectorArray
+ * \brief Array of vectors with each coordinate stored in its own array
+ */
+struct ParticleVectorArray
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+
+    ParticleVectorRef operator[](int index)
+    {
+        return ParticleVectorRef{x[index], y[index], z[index]};
+    }
+
+    Math::Vector operator[](int index) const
+    {
+        return Math::Vector(x[index], y[index], z[index]);
+    }
+};
+
+/**
+ * \struct ParticleStore
+ * \brief Particles stored as a structure of arrays
+ *
+ * Particles occupy indexes 0 .. GetCount()-1 of every array, so the common
+ * update steps run over contiguous memory instead of a table with holes.
+ *
+ * Deleted particles keep their place (with used == false) until Compact()
+ * moves the last particles into the gaps, so indexes stay valid only
+ * between calls to Compact(). Particles are referred to from outside
+ * by handles, which stay valid for their whole life, see GetIndex().
+ */
+struct ParticleStore
+{
+    std::vector<char>           used;           // true -> particle used
+    std::vector<char>           ray;            // true -> ray with goal
+    std::vector<unsigned short> uniqueStamp;    // unique mark
+    std::vector<short>          sheet;          // sheet (0..n)
+    std::vector<short>          partiType;      // texture type (0 = triangles, 1..4 = effectNN, 5 = text)
+    std::vector<ParticleType>   type;           // type PARTI*
+    std::vector<ParticlePhase>  phase;          // phase PARPH*
+    std::vector<float>          mass;           // mass of the particle (in rebounding)
+    std::vector<float>          weight;         // weight of the particle (for noise)
+    std::vector<float>          duration;       // length of life
+    ParticleVectorArray         pos;            // absolute position (relative if object links)
+    std::vector<Math::Vector>   goal;           // goal position (if ray)
+    ParticleVectorArray         speed;          // speed of displacement
+    std::vector<float>          windSensitivity;
+    std::vector<short>          bounce;         // number of rebounds
+    std::vector<Math::Point>    dim;            // dimensions of the rectangle
+    std::vector<float>          zoom;           // zoom (0..1)
+    std::vector<float>          angle;          // angle of rotation
+    std::vector<float>          intensity;      // intensity
+    std::vector<Math::Point>    texSup;         // coordinated upper texture
+    std::vector<Math::Point>    texInf;         // coordinated lower texture
+    std::vector<float>          time;           // age of the particle (0..n)
+    std::vector<float>          phaseTime;      // age at the beginning of phase
+    std::vector<float>          testTime;       // time since last test
+    std::vector<CObject*>       objLink;        // father object (for example reactor)
+    std::vector<CObject*>       objFather;      // father object (for example reactor)
+    std::vector<short>          objRank;        // rank of the object, or -1
+    std::vector<short>          trackRank;      // rank of the drag
+    std::vector<char>           text;
+    std::vector<Color>          color;
+    std::vector<EngineTriangle> triangle;       // triangle if partiType == 0
+    std::vector<int>            handle;         // handle of the particle
+
+    //! Time step of movement in the current frame (0 if the particle doesn't move)
+    std::vector<float>          moveStep;
+    //! Time step of wind in the current frame, including wind sensitivity
+    std::vector<float>          windStep;
+    //! Time step of ageing in the current frame (0 if the particle isn't updated)
+    std::vector<float>          ageStep;
+
+    //! Returns the number of particles, including deleted ones not compacted yet
+    int         GetCount() const;
+    //! Adds a particle with default values and returns its index
+    int         Add();
+    //! Returns the index of particle with given handle or -1 if there is none
+    int         GetIndex(int handle) const;
+    //! Removes deleted particles, moving others to fill the gaps
+    void        Compact();
+    //! Removes all particles
+    void        Clear();
+
+    //! Moves particles \a first .. \a last-1 by their speed and the wind, and applies gravity to them
+    void        Integrate(const Math::Vector& wind, int first, int last);
+    //! Advances time of particles \a first .. \a last-1
+    void        Age(int first, int last);
+
+private:
+    //! Moves particle \a from to index \a to, overwriting it
+    void        MoveParticle(int from, int to);
+    //! Removes the last particle
+    void        RemoveLast();
+
+    //! Index of particle by handle, -1 for unused handles
+    std::vector<int> m_handleIndex;
+    //! Unused handles
+    std::vector<int> m_freeHandles;
+};
+
+
+} // namespace Gfx
@@ -0,0 +1,130 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/particle_type.h
+ * \brief ParticleType and ParticlePhase enums
+ */
+
+#pragma once
+
+namespace Gfx
+{
+
+enum ParticleType
+{
+    PARTIEXPLOT     = 1,        //! < technology explosion
+    PARTIEXPLOO     = 2,        //! < organic explosion
+    PARTIMOTOR      = 3,        //! < the engine exhaust gas
+    PARTIGLINT      = 4,        //! < reflection
+    PARTIBLITZ      = 5,        //! < lightning recharging battery
+    PARTICRASH      = 6,        //! < dust after fall
+    PARTIGAS        = 7,        //! < gas from the reactor
+    PARTIFIRE       = 9,        //! < fireball shrinks
+    PARTIFIREZ      = 10,       //! < fireball grows
+    PARTIBLUE       = 11,       //! < blue ball
+    PARTISELY       = 12,       //! < yellow robot lights
+    PARTISELR       = 13,       //! < red robot lights
+    PARTIGUN1       = 18,       //! < bullet 1 (fireball)
+    PARTIGUN2       = 19,       //! < bullet 2 (ant)
+    PARTIGUN3       = 20,       //! < bullet 3 (spider)
+    PARTIGUN4       = 21,       //! < bullet 4 (orgaball)
+    PARTIFRAG       = 22,       //! < triangular fragment
+    PARTIQUEUE      = 23,       //! < inflamed tail (TODO: unused?)
+    PARTIORGANIC1   = 24,       //! < organic ball mother
+    PARTIORGANIC2   = 25,       //! < organic ball daughter
+    PARTISMOKE1     = 26,       //! < black smoke
+    PARTISMOKE2     = 27,       //! < black smoke
+    PARTISMOKE3     = 28,       //! < black smoke
+    PARTIBLOOD      = 30,       //! < human blood
+    PARTIBLOODM     = 31,       //! < AlienQueen blood
+    PARTIVAPOR      = 32,       //! < steam
+    PARTIVIRUS      = 33,       //! < virus (random letter)
+    PARTIRAY1       = 43,       //! < ray 1 (turn)
+    PARTIRAY2       = 44,       //! < ray 2 (electric arc)
+    PARTIRAY3       = 45,       //! < ray 3 (ExchangePost)
+    PARTIFLAME      = 47,       //! < flame
+    PARTIBUBBLE     = 48,       //! < bubble
+    PARTIFLIC       = 49,       //! < circles in the water
+    PARTIEJECT      = 50,       //! < ejection from the reactor
+    PARTISCRAPS     = 51,       //! < waste from the reactor
+    PARTITOTO       = 52,       //! < Robby's reactor
+    PARTIERROR      = 53,       //! < Robby says no
+    PARTIWARNING    = 54,       //! < Robby says blah
+    PARTIINFO       = 54,       //! < Robby says yes
+    PARTIQUARTZ     = 55,       //! < reflection crystal
+    PARTISPHERE0    = 56,       //! < explosion sphere
+    PARTISPHERE1    = 57,       //! < energy sphere
+    PARTISPHERE2    = 58,       //! < analysis sphere
+    PARTISPHERE3    = 59,       //! < shield sphere
+    PARTISPHERE4    = 60,       //! < information sphere (emit)
+    PARTISPHERE5    = 61,       //! < botanical sphere (gravity root)
+    PARTISPHERE6    = 62,       //! < information sphere (receive)
+    PARTIGUNDEL     = 66,       //! < bullet destroyed by shield
+    PARTIPART       = 67,       //! < object part
+    PARTITRACK1     = 68,       //! < drag 1
+    PARTITRACK2     = 69,       //! < drag 2
+    PARTITRACK3     = 70,       //! < drag 3
+    PARTITRACK4     = 71,       //! < drag 4
+    PARTITRACK5     = 72,       //! < drag 5
+    PARTITRACK6     = 73,       //! < drag 6
+    PARTITRACK7     = 74,       //! < drag 7
+    PARTITRACK8     = 75,       //! < drag 8
+    PARTITRACK9     = 76,       //! < drag 9
+    PARTITRACK10    = 77,       //! < drag 10
+    PARTITRACK11    = 78,       //! < drag 11
+    PARTITRACK12    = 79,       //! < drag 12 (TODO: unused?)
+    PARTIGLINTb     = 88,       //! < blue reflection
+    PARTIGLINTr     = 89,       //! < red reflection
+    PARTILENS1      = 90,       //! < brilliance 1 (orange)
+    PARTILENS2      = 91,       //! < brilliance 2 (yellow)
+    PARTILENS3      = 92,       //! < brilliance 3 (red)
+    PARTILENS4      = 93,       //! < brilliance 4 (violet)
+    PARTICONTROL    = 94,       //! < reflection on button
+    PARTISHOW       = 95,       //! < shows a place
+    PARTICHOC       = 96,       //! < shock wave
+    PARTIGFLAT      = 97,       //! < shows if the ground is flat
+    PARTIRECOVER    = 98,       //! < blue ball recycler
+    PARTIROOT       = 100,      //! < gravity root smoke
+    PARTIPLOUF0     = 101,      //! < splash
+    PARTIDROP       = 106,      //! < drop
+    PARTIFOG0       = 107,      //! < fog 0
+    PARTIFOG1       = 108,      //! < fog 1
+    PARTIFOG2       = 109,      //! < fog 2
+    PARTIFOG3       = 110,      //! < fog 3
+    PARTIFOG4       = 111,      //! < fog 4
+    PARTIFOG5       = 112,      //! < fog 5
+    PARTIFOG6       = 113,      //! < fog 6
+    PARTIFOG7       = 114,      //! < fog 7
+    PARTILIMIT1     = 117,      //! < shows the limits 1
+    PARTILIMIT2     = 118,      //! < shows the limits 2
+    PARTILIMIT3     = 119,      //! < shows the limits 3
+    PARTIWATER      = 121,      //! < drop of water
+    PARTIEXPLOG1    = 122,      //! < ball explosion 1
+    PARTIEXPLOG2    = 123,      //! < ball explosion 2
+    PARTIBASE       = 124,      //! < gases of spaceship
+};
+
+enum ParticlePhase
+{
+    PARPHSTART      = 0,
+    PARPHEND        = 1,
+};
+
+} // namespace Gfx
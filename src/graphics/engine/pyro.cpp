@@ -26,6 +26,7 @@
 
 #include "graphics/engine/lightman.h"
 #include "graphics/engine/particle.h"
+#include "graphics/engine/pyro_manager.h"
 #include "graphics/engine/terrain.h"
 
 #include "level/robotmain.h"
@@ -69,6 +70,51 @@ void CPyro::DeleteObject()
         m_lightMan->DeleteLight(m_lightRank);
         m_lightRank = -1;
     }
+
+    if ( m_freeLightRank != -1 )
+    {
+        m_lightMan->DeleteLight(m_freeLightRank);
+        m_freeLightRank = -1;
+    }
+}
+
+void CPyro::Reset()
+{
+    ReleaseLight();
+
+    m_object = nullptr;
+    m_pos = Math::Vector();
+    m_posPower = Math::Vector();
+    m_power = false;
+    m_type = PT_NULL;
+    m_force = 0.0f;
+    m_size = 0.0f;
+    m_progress = 0.0f;
+    m_speed = 0.0f;
+    m_time = 0.0f;
+    m_lastParticle = 0.0f;
+    m_lastParticleSmoke = 0.0f;
+    m_soundChannel = -1;
+    m_lightHeight = 0.0f;
+    m_lightOper.clear();
+
+    m_burnType = OBJECT_NULL;
+    m_burnPartTotal = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        m_burnPart[i] = PyroBurnPart();
+        m_burnKeepPart[i] = 0;
+    }
+    m_burnFall = 0.0f;
+
+    m_fallFloor = 0.0f;
+    m_fallSpeed = 0.0f;
+    m_fallBulletTime = 0.0f;
+    m_fallEnding = false;
+
+    m_crashSpheres.clear();
+
+    m_resetAngle = 0.0f;
 }
 
 bool CPyro::Create(PyroType type, CObject* obj, float force)
@@ -1247,11 +1293,7 @@ Error CPyro::IsEnded()
         m_object->SetType(OBJECT_PLANT19);
     }
 
-    if ( m_lightRank != -1 )
-    {
-        m_lightMan->DeleteLight(m_lightRank);
-        m_lightRank = -1;
-    }
+    ReleaseLight();
 
     return ERR_STOP;
 }
@@ -1366,7 +1408,16 @@ void CPyro::CreateLight(Math::Vector pos, float height)
     light.attenuation2 = 0.0f;
     light.spotAngle = Math::PI/4.0f;
 
-    m_lightRank = m_lightMan->CreateLight();
+    if (m_freeLightRank != -1)
+    {
+        m_lightRank = m_freeLightRank;
+        m_freeLightRank = -1;
+        m_lightMan->SetLightEnabled(m_lightRank, true);
+    }
+    else
+    {
+        m_lightRank = m_lightMan->CreateLight();
+    }
 
     m_lightMan->SetLight(m_lightRank, light);
     m_lightMan->SetLightIntensity(m_lightRank, 0.0f);
@@ -1375,6 +1426,23 @@ void CPyro::CreateLight(Math::Vector pos, float height)
     m_lightMan->SetLightIncludeType(m_lightRank, ENG_OBJTYPE_TERRAIN);
 }
 
+void CPyro::ReleaseLight()
+{
+    if (m_lightRank == -1) return;
+
+    if (m_freeLightRank == -1)
+    {
+        m_lightMan->SetLightIntensity(m_lightRank, 0.0f);
+        m_lightMan->SetLightEnabled(m_lightRank, false);
+        m_freeLightRank = m_lightRank;
+    }
+    else
+    {
+        m_lightMan->DeleteLight(m_lightRank);
+    }
+    m_lightRank = -1;
+}
+
 void CPyro::DeleteObject(bool primary, bool secondary)
 {
     if (m_object == nullptr) return;
@@ -1567,8 +1635,7 @@ void CPyro::CreateTriangle(CObject* obj, ObjectType oType, int part)
         if ( oType == OBJECT_STONE   )  speed *= 0.5f;
         if ( oType == OBJECT_URANIUM )  speed *= 0.4f;
         float duration = Math::Rand()*3.0f+3.0f;
-        m_particle->CreateFrag(pos, speed, &buffer[i], PARTIFRAG,
-                               duration, mass, 0.5f);
+        m_engine->GetPyroManager()->CreateFrag(pos, speed, buffer[i], duration, mass);
     }
 }
 
@@ -68,6 +68,8 @@ protected:
     bool        Create(PyroType type, CObject* obj, float force);
     //! Destroys the object
     void        DeleteObject();
+    //! Restores the state of a new object, for reuse by another effect
+    void        Reset();
 
 public:
     CPyro(); // should only be called by CPyroManager
@@ -89,6 +91,8 @@ protected:
 
     //! Creates light to accompany a pyrotechnic effect
     void        CreateLight(Math::Vector pos, float height);
+    //! Turns off the light, keeping it for the next effect created with this instance
+    void        ReleaseLight();
     //! Removes the binding to a pyrotechnic effect
     void        DeleteObject(bool primary, bool secondary);
 
@@ -151,6 +155,8 @@ protected:
     int             m_soundChannel = -1;
 
     int             m_lightRank = -1;
+    //! Light turned off by ReleaseLight(), or -1
+    int             m_freeLightRank = -1;
     float           m_lightHeight = 0.0f;
 
     struct PyroLightOper
@@ -19,13 +19,20 @@
 
 #include "graphics/engine/pyro_manager.h"
 
+#include "common/event.h"
 #include "common/make_unique.h"
 
+#include "graphics/engine/particle.h"
 #include "graphics/engine/pyro.h"
 
 namespace Gfx
 {
 
+//! Maximum number of fragments created in one frame
+const int PYRO_MAX_FRAGS_PER_FRAME = 300;
+//! Maximum number of ended effects kept for reuse
+const int PYRO_MAX_FREE = 32;
+
 
 Gfx::CPyroManager::CPyroManager()
 {}
@@ -35,9 +42,20 @@ CPyroManager::~CPyroManager()
 
 void Gfx::CPyroManager::Create(PyroType type, CObject* obj, float force)
 {
-    auto pyroUPtr = MakeUnique<CPyro>();
-    pyroUPtr->Create(type, obj, force);
-    m_pyros.insert(std::move(pyroUPtr));
+    CPyroUPtr pyroUPtr;
+    if (!m_freePyros.empty())
+    {
+        pyroUPtr = std::move(m_freePyros.back());
+        m_freePyros.pop_back();
+    }
+    else
+    {
+        pyroUPtr = MakeUnique<CPyro>();
+    }
+
+    CPyro* pyro = pyroUPtr.get();
+    m_pyros.push_back(std::move(pyroUPtr));
+    pyro->Create(type, obj, force);
 }
 
 void CPyroManager::DeleteAll()
@@ -47,7 +65,16 @@ void CPyroManager::DeleteAll()
         pyro->DeleteObject();
     }
 
+    for (auto& pyro : m_freePyros)
+    {
+        pyro->DeleteObject();
+    }
+
     m_pyros.clear();
+    m_freePyros.clear();
+
+    m_pendingFrags.clear();
+    m_pendingFragFirst = 0;
 }
 
 void Gfx::CPyroManager::CutObjectLink(CObject* obj)
@@ -60,19 +87,116 @@ void Gfx::CPyroManager::CutObjectLink(CObject* obj)
 
 void Gfx::CPyroManager::EventProcess(const Event& event)
 {
-    auto it = m_pyros.begin();
-    while (it != m_pyros.end())
+    if (event.type == EVENT_FRAME && !CEngine::GetInstancePointer()->GetPause())
     {
-        (*it)->EventProcess(event);
-        if ((*it)->IsEnded() == ERR_CONTINUE)
-        {
-            ++it;
-        }
-        else
+        // Fragments delayed in previous frames come before those of this frame
+        m_fragCount = 0;
+        for (std::size_t i = m_pendingFragFirst; i < m_pendingFrags.size(); i++)
+            m_pendingFrags[i].delay += event.rTime;
+
+        CreatePendingFrags();
+    }
+
+    // Effects created by the processed ones are processed in the next frame
+    std::size_t count = m_pyros.size();
+    m_ended.assign(count, false);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        CPyro* pyro = m_pyros[i].get();
+        pyro->EventProcess(event);
+        m_ended[i] = (pyro->IsEnded() != ERR_CONTINUE);
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m_pyros.size(); i++)
+    {
+        if (i < count && m_ended[i])
         {
-            (*it)->DeleteObject();
-            it = m_pyros.erase(it);
+            ReleasePyro(std::move(m_pyros[i]));
+            continue;
         }
+
+        if (kept != i)
+            m_pyros[kept] = std::move(m_pyros[i]);
+        kept++;
+    }
+    m_pyros.resize(kept);
+}
+
+void CPyroManager::CreateFrag(const Math::Vector& pos, const Math::Vector& speed,
+                              const EngineTriangle& triangle, float duration, float mass)
+{
+    if (m_fragCount < PYRO_MAX_FRAGS_PER_FRAME)
+    {
+        EngineTriangle copy = triangle;
+        CEngine::GetInstancePointer()->GetParticle()->CreateFrag(pos, speed, &copy, PARTIFRAG,
+                                                                 duration, mass, 0.5f);
+        m_fragCount++;
+        return;
+    }
+
+    PendingFrag frag;
+    frag.pos      = pos;
+    frag.speed    = speed;
+    frag.triangle = triangle;
+    frag.duration = duration;
+    frag.mass     = mass;
+    m_pendingFrags.push_back(std::move(frag));
+}
+
+int CPyroManager::GetPyroCount() const
+{
+    return m_pyros.size();
+}
+
+int CPyroManager::GetPendingFragCount() const
+{
+    return m_pendingFrags.size() - m_pendingFragFirst;
+}
+
+void CPyroManager::ReleasePyro(CPyroUPtr pyro)
+{
+    if (static_cast<int>(m_freePyros.size()) >= PYRO_MAX_FREE)
+    {
+        pyro->DeleteObject();
+        return;
+    }
+
+    pyro->Reset();
+    m_freePyros.push_back(std::move(pyro));
+}
+
+void CPyroManager::CreatePendingFrags()
+{
+    CParticle* particle = CEngine::GetInstancePointer()->GetParticle();
+
+    while (m_fragCount < PYRO_MAX_FRAGS_PER_FRAME &&
+           m_pendingFragFirst < static_cast<int>(m_pendingFrags.size()))
+    {
+        PendingFrag& frag = m_pendingFrags[m_pendingFragFirst++];
+        if (frag.delay >= frag.duration) continue;  // would have disappeared already
+
+        // Moves the fragment where it would be, were it created in time
+        float t = frag.delay;
+        Math::Vector pos = frag.pos + frag.speed*t;
+        pos.y -= 0.5f*frag.mass*t*t;
+        Math::Vector speed = frag.speed;
+        speed.y -= frag.mass*t;
+
+        particle->CreateFrag(pos, speed, &frag.triangle, PARTIFRAG,
+                             frag.duration - t, frag.mass, 0.5f);
+        m_fragCount++;
+    }
+
+    if (m_pendingFragFirst == static_cast<int>(m_pendingFrags.size()))
+    {
+        m_pendingFrags.clear();
+        m_pendingFragFirst = 0;
+    }
+    else if (m_pendingFragFirst > static_cast<int>(m_pendingFrags.size())/2)
+    {
+        m_pendingFrags.erase(m_pendingFrags.begin(), m_pendingFrags.begin() + m_pendingFragFirst);
+        m_pendingFragFirst = 0;
     }
 }
 
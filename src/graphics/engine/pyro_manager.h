@@ -24,10 +24,13 @@
 
 #pragma once
 
+#include "graphics/engine/engine.h"
 #include "graphics/engine/pyro_type.h"
 
+#include "math/vector.h"
+
 #include <memory>
-#include <set>
+#include <vector>
 
 struct Event;
 class CObject;
@@ -38,6 +41,17 @@ namespace Gfx
 class CPyro;
 using CPyroUPtr = std::unique_ptr<CPyro>;
 
+/**
+ * \class CPyroManager
+ * \brief Owner of all pyrotechnic effects
+ *
+ * Ended effects are kept in a pool and reused by next calls to Create(),
+ * together with their light, so that a chain of explosions doesn't allocate.
+ *
+ * Fragments of exploding objects are created through CreateFrag(), which creates
+ * at most PYRO_MAX_FRAGS_PER_FRAME of them per frame; the others are created
+ * in the following frames, where they appear as if they had been flying since.
+ */
 class CPyroManager
 {
 public:
@@ -51,8 +65,45 @@ public:
 
     void EventProcess(const Event& event);
 
+    //! Creates a fragment particle, now or in one of next frames
+    void CreateFrag(const Math::Vector& pos, const Math::Vector& speed,
+                    const EngineTriangle& triangle, float duration, float mass);
+
+    //! Returns the number of running effects
+    int  GetPyroCount() const;
+    //! Returns the number of fragments waiting to be created
+    int  GetPendingFragCount() const;
+
+private:
+    //! Resets an ended effect and puts it into the pool
+    void ReleasePyro(CPyroUPtr pyro);
+    //! Creates waiting fragments, as long as this frame's limit allows it
+    void CreatePendingFrags();
+
 private:
-    std::set<CPyroUPtr> m_pyros;
+    struct PendingFrag
+    {
+        Math::Vector    pos;
+        Math::Vector    speed;
+        EngineTriangle  triangle;
+        float           duration = 0.0f;
+        float           mass = 0.0f;
+        //! Time since the fragment should have been created
+        float           delay = 0.0f;
+    };
+
+    //! Running effects
+    std::vector<CPyroUPtr>      m_pyros;
+    //! Ended effects ready for reuse
+    std::vector<CPyroUPtr>      m_freePyros;
+    //! Whether each of the effects processed by EventProcess() ended, reused between frames
+    std::vector<char>           m_ended;
+
+    //! Fragments waiting for creation, from m_pendingFragFirst on
+    std::vector<PendingFrag>    m_pendingFrags;
+    int                         m_pendingFragFirst = 0;
+    //! Number of fragments created since the beginning of the frame
+    int                         m_fragCount = 0;
 };
 
 } // namespace Gfx
@@ -0,0 +1,542 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "graphics/engine/ray_query.h"
+
+#include "graphics/engine/engine.h"
+#include "graphics/engine/terrain.h"
+
+#include "math/geometry.h"
+
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+namespace
+{
+
+const int OBJECT_LEAF_SIZE = 2;
+const int TRIANGLE_LEAF_SIZE = 4;
+const int MAX_TREE_DEPTH = 64;
+
+//! Ray prepared for repeated box tests
+struct PreparedRay
+{
+    Math::Vector origin;
+    Math::Vector invDir;
+};
+
+PreparedRay PrepareRay(const Math::Vector& origin, const Math::Vector& dir)
+{
+    PreparedRay ray;
+    ray.origin = origin;
+    ray.invDir.x = dir.x != 0.0f ? 1.0f / dir.x : std::numeric_limits<float>::max();
+    ray.invDir.y = dir.y != 0.0f ? 1.0f / dir.y : std::numeric_limits<float>::max();
+    ray.invDir.z = dir.z != 0.0f ? 1.0f / dir.z : std::numeric_limits<float>::max();
+    return ray;
+}
+
+//! Slab test of the ray against a box, limited to t in [0, maxDist]
+bool IntersectBox(const PreparedRay& ray, const Math::Vector& min, const Math::Vector& max, float maxDist)
+{
+    float t1 = (min.x - ray.origin.x) * ray.invDir.x;
+    float t2 = (max.x - ray.origin.x) * ray.invDir.x;
+    float tNear = std::min(t1, t2);
+    float tFar  = std::max(t1, t2);
+
+    t1 = (min.y - ray.origin.y) * ray.invDir.y;
+    t2 = (max.y - ray.origin.y) * ray.invDir.y;
+    tNear = std::max(tNear, std::min(t1, t2));
+    tFar  = std::min(tFar,  std::max(t1, t2));
+
+    t1 = (min.z - ray.origin.z) * ray.invDir.z;
+    t2 = (max.z - ray.origin.z) * ray.invDir.z;
+    tNear = std::max(tNear, std::min(t1, t2));
+    tFar  = std::min(tFar,  std::max(t1, t2));
+
+    return tNear <= tFar && tFar >= 0.0f && tNear <= maxDist;
+}
+
+void ExtendBox(Math::Vector& min, Math::Vector& max, const Math::Vector& p)
+{
+    min.x = Math::Min(min.x, p.x);
+    min.y = Math::Min(min.y, p.y);
+    min.z = Math::Min(min.z, p.z);
+    max.x = Math::Max(max.x, p.x);
+    max.y = Math::Max(max.y, p.y);
+    max.z = Math::Max(max.z, p.z);
+}
+
+float GetAxis(const Math::Vector& v, int axis)
+{
+    if (axis == 0) return v.x;
+    if (axis == 1) return v.y;
+    return v.z;
+}
+
+} // anonymous namespace
+
+
+CRayQuery::CRayQuery(CEngine* engine)
+    : m_engine(engine),
+      m_objectsValid(false),
+      m_refitCount(0)
+{
+}
+
+CRayQuery::~CRayQuery()
+{
+}
+
+void CRayQuery::InvalidateObjects()
+{
+    m_objectsValid = false;
+}
+
+void CRayQuery::InvalidateObjectTransform(int objRank)
+{
+    // The hierarchy is rebuilt anyway
+    if (! m_objectsValid)
+        return;
+
+    if (objRank < 0 || objRank >= static_cast<int>(m_objectItems.size()))
+    {
+        m_objectsValid = false;
+        return;
+    }
+
+    if (m_objectMoved[objRank])
+        return;
+
+    m_objectMoved[objRank] = true;
+    m_movedObjects.push_back(objRank);
+}
+
+void CRayQuery::InvalidateBaseObject(int baseObjRank)
+{
+    m_objectsValid = false;
+
+    if (baseObjRank < 0 || baseObjRank >= static_cast<int>(m_triangleTrees.size()))
+        return;
+
+    TriangleTree& tree = m_triangleTrees[baseObjRank];
+    tree.valid = false;
+    tree.nodes.clear();
+    tree.vertices.clear();
+}
+
+void CRayQuery::InvalidateAll()
+{
+    m_objectsValid = false;
+    m_objectNodes.clear();
+    m_objectRanks.clear();
+    m_objectInverse.clear();
+    m_objectMins.clear();
+    m_objectMaxs.clear();
+    m_objectItems.clear();
+    m_movedObjects.clear();
+    m_objectMoved.clear();
+    m_triangleTrees.clear();
+}
+
+void CRayQuery::BuildTree(std::vector<Node>& nodes, std::vector<int>& order,
+                          const std::vector<Math::Vector>& mins, const std::vector<Math::Vector>& maxs,
+                          int leafSize)
+{
+    nodes.clear();
+    order.resize(mins.size());
+    for (int i = 0; i < static_cast<int>(order.size()); i++)
+        order[i] = i;
+
+    if (order.empty())
+        return;
+
+    nodes.reserve(2 * order.size() / leafSize + 1);
+    BuildNode(nodes, order, 0, order.size(), mins, maxs, leafSize);
+}
+
+void CRayQuery::BuildNode(std::vector<Node>& nodes, std::vector<int>& order, int first, int count,
+                          const std::vector<Math::Vector>& mins, const std::vector<Math::Vector>& maxs,
+                          int leafSize)
+{
+    int nodeIndex = nodes.size();
+    nodes.push_back(Node());
+
+    Math::Vector min( std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(),  std::numeric_limits<float>::max());
+    Math::Vector max(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+    Math::Vector centerMin = min;
+    Math::Vector centerMax = max;
+
+    for (int i = first; i < first + count; i++)
+    {
+        ExtendBox(min, max, mins[order[i]]);
+        ExtendBox(min, max, maxs[order[i]]);
+        ExtendBox(centerMin, centerMax, (mins[order[i]] + maxs[order[i]]) * 0.5f);
+    }
+
+    nodes[nodeIndex].min = min;
+    nodes[nodeIndex].max = max;
+
+    if (count <= leafSize)
+    {
+        nodes[nodeIndex].offset = first;
+        nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // Median split along the longest axis of the item centers
+    Math::Vector extent = centerMax - centerMin;
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > GetAxis(extent, axis)) axis = 2;
+
+    auto center = [&](int item)
+    {
+        return GetAxis(mins[item], axis) + GetAxis(maxs[item], axis);
+    };
+
+    int half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                     [&](int a, int b) { return center(a) < center(b); });
+
+    BuildNode(nodes, order, first, half, mins, maxs, leafSize);
+    nodes[nodeIndex].offset = nodes.size();
+    BuildNode(nodes, order, first + half, count - half, mins, maxs, leafSize);
+}
+
+void CRayQuery::UpdateObjectTree()
+{
+    if (m_objectsValid && m_movedObjects.empty())
+        return;
+
+    // Refitted bounds get looser as objects move away from where they were sorted,
+    // so the hierarchy is rebuilt after as many refits as it has objects
+    int refitCount = m_refitCount + m_movedObjects.size();
+    if (m_objectsValid && refitCount <= static_cast<int>(m_objectRanks.size()) && RefitObjectTree())
+        return;
+
+    BuildObjectTree();
+}
+
+void CRayQuery::BuildObjectTree()
+{
+    m_objectsValid = true;
+    m_refitCount = 0;
+
+    std::vector<int> ranks;
+    std::vector<Math::Vector> mins, maxs;
+
+    int objectCount = m_engine->m_objects.size();
+    for (int objRank = 0; objRank < objectCount; objRank++)
+    {
+        Math::Vector min, max;
+        if (! GetObjectBounds(objRank, min, max))
+            continue;
+
+        ranks.push_back(objRank);
+        mins.push_back(min);
+        maxs.push_back(max);
+    }
+
+    std::vector<int> order;
+    BuildTree(m_objectNodes, order, mins, maxs, OBJECT_LEAF_SIZE);
+
+    m_objectItems.assign(objectCount, -1);
+    m_objectMoved.assign(objectCount, false);
+    m_movedObjects.clear();
+
+    m_objectRanks.resize(order.size());
+    m_objectInverse.resize(order.size());
+    m_objectMins.resize(order.size());
+    m_objectMaxs.resize(order.size());
+    for (int i = 0; i < static_cast<int>(order.size()); i++)
+    {
+        int objRank = ranks[order[i]];
+        m_objectRanks[i] = objRank;
+        m_objectInverse[i] = m_engine->m_objects[objRank].transform.Inverse();
+        m_objectMins[i] = mins[order[i]];
+        m_objectMaxs[i] = maxs[order[i]];
+        m_objectItems[objRank] = i;
+    }
+}
+
+bool CRayQuery::RefitObjectTree()
+{
+    for (int objRank : m_movedObjects)
+    {
+        int item = m_objectItems[objRank];
+
+        Math::Vector min, max;
+        bool hittable = GetObjectBounds(objRank, min, max);
+
+        // Objects entering or leaving the hierarchy change its leaves
+        if (item == -1 && ! hittable)
+            continue;
+        if (item == -1 || ! hittable)
+            return false;
+
+        m_objectMins[item] = min;
+        m_objectMaxs[item] = max;
+        m_objectInverse[item] = m_engine->m_objects[objRank].transform.Inverse();
+    }
+
+    m_refitCount += m_movedObjects.size();
+    for (int objRank : m_movedObjects)
+        m_objectMoved[objRank] = false;
+    m_movedObjects.clear();
+
+    // Children are stored after their parent, so going backwards updates them first
+    for (int i = static_cast<int>(m_objectNodes.size()) - 1; i >= 0; i--)
+    {
+        Node& node = m_objectNodes[i];
+        if (node.count == 0)
+        {
+            node.min = m_objectNodes[i + 1].min;
+            node.max = m_objectNodes[i + 1].max;
+            ExtendBox(node.min, node.max, m_objectNodes[node.offset].min);
+            ExtendBox(node.min, node.max, m_objectNodes[node.offset].max);
+        }
+        else
+        {
+            node.min = m_objectMins[node.offset];
+            node.max = m_objectMaxs[node.offset];
+            for (int j = node.offset + 1; j < node.offset + node.count; j++)
+            {
+                ExtendBox(node.min, node.max, m_objectMins[j]);
+                ExtendBox(node.min, node.max, m_objectMaxs[j]);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CRayQuery::GetObjectBounds(int objRank, Math::Vector& min, Math::Vector& max)
+{
+    const EngineObject& obj = m_engine->m_objects[objRank];
+    if (! obj.used)
+        return false;
+
+    // Terrain is walked through the heightfield instead
+    if (obj.type == ENG_OBJTYPE_TERRAIN)
+        return false;
+
+    const auto& baseObjects = m_engine->m_baseObjects;
+    int baseObjRank = obj.baseObjRank;
+    if (baseObjRank < 0 || baseObjRank >= static_cast<int>(baseObjects.size()))
+        return false;
+
+    const EngineBaseObject& p1 = baseObjects[baseObjRank];
+    if (! p1.used || p1.totalTriangles == 0)
+        return false;
+
+    // Objects scaled down to nothing cannot be hit
+    if (Math::IsZero(obj.transform.Det()))
+        return false;
+
+    min = Math::Vector( std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(),  std::numeric_limits<float>::max());
+    max = Math::Vector(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+    for (int i = 0; i < 8; i++)
+    {
+        Math::Vector p;
+        p.x = (i & (1<<0)) ? p1.bboxMin.x : p1.bboxMax.x;
+        p.y = (i & (1<<1)) ? p1.bboxMin.y : p1.bboxMax.y;
+        p.z = (i & (1<<2)) ? p1.bboxMin.z : p1.bboxMax.z;
+        ExtendBox(min, max, Math::Transform(obj.transform, p));
+    }
+
+    return true;
+}
+
+CRayQuery::TriangleTree& CRayQuery::GetTriangleTree(int baseObjRank)
+{
+    if (baseObjRank >= static_cast<int>(m_triangleTrees.size()))
+        m_triangleTrees.resize(baseObjRank + 1);
+
+    TriangleTree& tree = m_triangleTrees[baseObjRank];
+    if (tree.valid)
+        return tree;
+
+    tree.valid = true;
+
+    std::vector<Math::Vector> vertices;
+    std::vector<Math::Vector> mins, maxs;
+
+    auto addTriangle = [&](const VertexTex2* v)
+    {
+        Math::Vector min = v[0].coord, max = v[0].coord;
+        ExtendBox(min, max, v[1].coord);
+        ExtendBox(min, max, v[2].coord);
+        mins.push_back(min);
+        maxs.push_back(max);
+
+        vertices.push_back(v[0].coord);
+        vertices.push_back(v[1].coord);
+        vertices.push_back(v[2].coord);
+    };
+
+    const EngineBaseObject& p1 = m_engine->m_baseObjects[baseObjRank];
+    for (const EngineBaseObjTexTier& p2 : p1.next)
+    {
+        for (const EngineBaseObjDataTier& p3 : p2.next)
+        {
+            int size = p3.vertices.size();
+            if (p3.type == ENG_TRIANGLE_TYPE_TRIANGLES)
+            {
+                for (int i = 0; i + 2 < size; i += 3)
+                    addTriangle(&p3.vertices[i]);
+            }
+            else if (p3.type == ENG_TRIANGLE_TYPE_SURFACE)
+            {
+                for (int i = 0; i + 2 < size; i++)
+                    addTriangle(&p3.vertices[i]);
+            }
+        }
+    }
+
+    std::vector<int> order;
+    BuildTree(tree.nodes, order, mins, maxs, TRIANGLE_LEAF_SIZE);
+
+    tree.vertices.resize(vertices.size());
+    for (int i = 0; i < static_cast<int>(order.size()); i++)
+    {
+        for (int j = 0; j < 3; j++)
+            tree.vertices[3*i+j] = vertices[3*order[i]+j];
+    }
+
+    return tree;
+}
+
+bool CRayQuery::IntersectTriangles(TriangleTree& tree, const Math::Vector& origin, const Math::Vector& dir,
+                                   float& dist)
+{
+    if (tree.nodes.empty())
+        return false;
+
+    PreparedRay ray = PrepareRay(origin, dir);
+
+    bool found = false;
+    int stack[MAX_TREE_DEPTH];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const Node& node = tree.nodes[stack[--stackSize]];
+        if (! IntersectBox(ray, node.min, node.max, dist))
+            continue;
+
+        if (node.count == 0)
+        {
+            assert(stackSize + 2 <= MAX_TREE_DEPTH);
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = &node - &tree.nodes[0] + 1;
+            continue;
+        }
+
+        for (int i = node.offset; i < node.offset + node.count; i++)
+        {
+            const Math::Vector* v = &tree.vertices[3*i];
+            float t = 0.0f;
+            if (Math::IntersectRayTriangle(origin, dir, v[0], v[1], v[2], t) && t <= dist)
+            {
+                dist = t;
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+bool CRayQuery::CastRay(const Math::Vector& origin, const Math::Vector& dir, float maxDist,
+                        bool terrain, RayHit& hit)
+{
+    float best = maxDist;
+    int nearest = -1;
+
+    UpdateObjectTree();
+
+    if (! m_objectNodes.empty())
+    {
+        PreparedRay ray = PrepareRay(origin, dir);
+
+        int stack[MAX_TREE_DEPTH];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = m_objectNodes[stack[--stackSize]];
+            if (! IntersectBox(ray, node.min, node.max, best))
+                continue;
+
+            if (node.count == 0)
+            {
+                assert(stackSize + 2 <= MAX_TREE_DEPTH);
+                stack[stackSize++] = node.offset;
+                stack[stackSize++] = &node - &m_objectNodes[0] + 1;
+                continue;
+            }
+
+            for (int i = node.offset; i < node.offset + node.count; i++)
+            {
+                int objRank = m_objectRanks[i];
+                int baseObjRank = m_engine->m_objects[objRank].baseObjRank;
+
+                // Direction is transformed unnormalized, so t stays comparable between objects
+                const Math::Matrix& inverse = m_objectInverse[i];
+                Math::Vector localOrigin = Math::Transform(inverse, origin);
+                Math::Vector localDir = Math::Transform(inverse, origin + dir) - localOrigin;
+
+                if (IntersectTriangles(GetTriangleTree(baseObjRank), localOrigin, localDir, best))
+                    nearest = objRank;
+            }
+        }
+    }
+
+    if (terrain && m_engine->m_terrain != nullptr)
+    {
+        float dist = 0.0f;
+        int objRank = -1;
+        if (m_engine->m_terrain->IntersectRay(origin, dir, best, dist, objRank) && objRank != -1)
+        {
+            best = dist;
+            nearest = objRank;
+        }
+    }
+
+    if (nearest == -1)
+        return false;
+
+    hit.objRank = nearest;
+    hit.distance = best;
+    hit.pos = origin + dir * best;
+    return true;
+}
+
+
+} // namespace Gfx
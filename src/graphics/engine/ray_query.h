@@ -0,0 +1,163 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file graphics/engine/ray_query.h
+ * \brief Ray queries against engine objects and terrain - CRayQuery class
+ */
+
+#pragma once
+
+#include "math/matrix.h"
+#include "math/vector.h"
+
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+class CEngine;
+
+/**
+ * \struct RayHit
+ * \brief Result of a ray query
+ */
+struct RayHit
+{
+    //! Rank of the hit engine object
+    int             objRank = -1;
+    //! Distance from the ray origin, in units of the ray direction
+    float           distance = 0.0f;
+    //! Hit position in world coordinates
+    Math::Vector    pos;
+};
+
+/**
+ * \class CRayQuery
+ * \brief Accelerated ray casting against engine objects and terrain
+ *
+ * Objects are found through a bounding volume hierarchy built over their
+ * world-space bounding boxes. It is rebuilt lazily on the first query after
+ * any object was created or deleted. Objects that only moved are refitted:
+ * their leaf bounds are recomputed in place and the node bounds are updated
+ * bottom-up, without sorting the objects again.
+ *
+ * Each base object gets its own triangle hierarchy in model space, built on
+ * first use and kept until its geometry changes, so moving an object never
+ * requires rebuilding it.
+ *
+ * Terrain mosaics are not part of the object hierarchy; terrain hits are
+ * found by walking the relief heightfield with CTerrain::IntersectRay().
+ */
+class CRayQuery
+{
+public:
+    explicit CRayQuery(CEngine* engine);
+    ~CRayQuery();
+
+    //! Marks the set of objects as changed, so that the object hierarchy is rebuilt
+    void        InvalidateObjects();
+    //! Marks the transform of given object as changed, so that its bounds are refitted
+    void        InvalidateObjectTransform(int objRank);
+    //! Drops the cached triangle hierarchy of given base object
+    void        InvalidateBaseObject(int baseObjRank);
+    //! Drops all cached data
+    void        InvalidateAll();
+
+    //! Finds the nearest object hit by the ray \a origin + t * \a dir, with t in [0, \a maxDist]
+    /**
+     * \param terrain  whether terrain mosaics can be hit
+     * \returns true if anything was hit; \a hit is filled in that case
+     */
+    bool        CastRay(const Math::Vector& origin, const Math::Vector& dir, float maxDist,
+                        bool terrain, RayHit& hit);
+
+protected:
+    //! Node of a flattened hierarchy; the left child directly follows its parent
+    struct Node
+    {
+        Math::Vector min;
+        Math::Vector max;
+        //! First item of a leaf or index of the right child
+        int          offset = 0;
+        //! Number of items in a leaf, 0 for inner nodes
+        int          count = 0;
+    };
+
+    //! Triangle hierarchy of one base object
+    struct TriangleTree
+    {
+        bool                      valid = false;
+        std::vector<Node>         nodes;
+        //! Vertices of the triangles, three per triangle in leaf order
+        std::vector<Math::Vector> vertices;
+    };
+
+    //! Builds a hierarchy over items given by their bounds; \a order receives item order of leaves
+    static void BuildTree(std::vector<Node>& nodes, std::vector<int>& order,
+                          const std::vector<Math::Vector>& mins, const std::vector<Math::Vector>& maxs,
+                          int leafSize);
+    static void BuildNode(std::vector<Node>& nodes, std::vector<int>& order, int first, int count,
+                          const std::vector<Math::Vector>& mins, const std::vector<Math::Vector>& maxs,
+                          int leafSize);
+
+    //! Rebuilds or refits the object hierarchy if needed
+    void        UpdateObjectTree();
+    //! Rebuilds the object hierarchy from scratch
+    void        BuildObjectTree();
+    //! Updates the bounds of moved objects; returns false if the hierarchy must be rebuilt instead
+    bool        RefitObjectTree();
+    //! Computes world-space bounds of an object; returns false if the object cannot be hit
+    bool        GetObjectBounds(int objRank, Math::Vector& min, Math::Vector& max);
+    //! Returns the triangle hierarchy of base object, building it if needed
+    TriangleTree& GetTriangleTree(int baseObjRank);
+
+    //! Tests the ray in model space against triangles of a base object
+    bool        IntersectTriangles(TriangleTree& tree, const Math::Vector& origin, const Math::Vector& dir,
+                                   float& dist);
+
+protected:
+    CEngine*                  m_engine;
+
+    bool                      m_objectsValid;
+    std::vector<Node>         m_objectNodes;
+    //! Object ranks in leaf order
+    std::vector<int>          m_objectRanks;
+    //! Inverse object transforms in leaf order
+    std::vector<Math::Matrix> m_objectInverse;
+    //! Object bounds in leaf order
+    std::vector<Math::Vector> m_objectMins;
+    std::vector<Math::Vector> m_objectMaxs;
+    //! Leaf order index of each object rank, -1 if the object isn't in the hierarchy
+    std::vector<int>          m_objectItems;
+    //! Ranks of objects moved since the last query, each once
+    std::vector<int>          m_movedObjects;
+    //! Whether each object rank is in m_movedObjects
+    std::vector<bool>         m_objectMoved;
+    //! Number of objects refitted since the last rebuild
+    int                       m_refitCount;
+
+    //! Triangle hierarchies indexed by base object rank
+    std::vector<TriangleTree> m_triangleTrees;
+};
+
+
+} // namespace Gfx
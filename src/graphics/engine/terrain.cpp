@@ -30,6 +30,7 @@
 
 #include "math/geometry.h"
 
+#include <limits>
 #include <sstream>
 
 #include <SDL.h>
@@ -1507,6 +1508,111 @@ float CTerrain::GetHeightToFloor(const Math::Vector &pos, bool brut, bool water)
     return pos.y-ps.y;
 }
 
+bool CTerrain::IntersectRay(const Math::Vector& origin, const Math::Vector& dir, float maxDist,
+                            float& dist, int& objRank)
+{
+    int size = m_mosaicCount*m_brickCount;
+    if (m_relief.empty() || size <= 0)
+        return false;
+
+    float dim = (size*m_brickSize)/2.0f;
+
+    // Clip the ray to the horizontal extent of the terrain
+    float tEnter = 0.0f;
+    float tExit = maxDist;
+    float o[2] = { origin.x, origin.z };
+    float d[2] = { dir.x, dir.z };
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (d[axis] == 0.0f)
+        {
+            if (o[axis] < -dim || o[axis] > dim)
+                return false;
+            continue;
+        }
+
+        float t1 = (-dim - o[axis]) / d[axis];
+        float t2 = ( dim - o[axis]) / d[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        tEnter = Math::Max(tEnter, t1);
+        tExit  = Math::Min(tExit,  t2);
+    }
+
+    if (tEnter > tExit)
+        return false;
+
+    // Walk the cells crossed by the ray (Amanatides & Woo)
+    Math::Vector start = origin + dir * tEnter;
+    int x = Math::Clamp(static_cast<int>(floorf((start.x + dim) / m_brickSize)), 0, size-1);
+    int y = Math::Clamp(static_cast<int>(floorf((start.z + dim) / m_brickSize)), 0, size-1);
+
+    int stepX = dir.x > 0.0f ? 1 : -1;
+    int stepY = dir.z > 0.0f ? 1 : -1;
+    float tDeltaX = dir.x != 0.0f ? m_brickSize / fabs(dir.x) : std::numeric_limits<float>::max();
+    float tDeltaY = dir.z != 0.0f ? m_brickSize / fabs(dir.z) : std::numeric_limits<float>::max();
+    float tMaxX = dir.x != 0.0f ? ((x + (stepX > 0 ? 1 : 0))*m_brickSize - dim - origin.x) / dir.x
+                                : std::numeric_limits<float>::max();
+    float tMaxY = dir.z != 0.0f ? ((y + (stepY > 0 ? 1 : 0))*m_brickSize - dim - origin.z) / dir.z
+                                : std::numeric_limits<float>::max();
+
+    float tCell = tEnter;
+    while (true)
+    {
+        float tNext = Math::Min(tMaxX, tMaxY, tExit);
+
+        float h1 = m_relief[(x+0)+(y+0)*(size+1)];
+        float h2 = m_relief[(x+1)+(y+0)*(size+1)];
+        float h3 = m_relief[(x+0)+(y+1)*(size+1)];
+        float h4 = m_relief[(x+1)+(y+1)*(size+1)];
+
+        // Skip the cell if the ray passes entirely above it
+        float rayMin = origin.y + dir.y * (dir.y < 0.0f ? tNext : tCell);
+        if (rayMin <= Math::Max(h1, h2, h3, h4))
+        {
+            Math::Vector p1 = GetVector(x+0, y+0);
+            Math::Vector p2 = GetVector(x+1, y+0);
+            Math::Vector p3 = GetVector(x+0, y+1);
+            Math::Vector p4 = GetVector(x+1, y+1);
+
+            // Same split as the mosaic strips and GetFloorLevel()
+            float best = std::numeric_limits<float>::max();
+            float t = 0.0f;
+            if (Math::IntersectRayTriangle(origin, dir, p1, p2, p3, t) && t < best)
+                best = t;
+            if (Math::IntersectRayTriangle(origin, dir, p2, p4, p3, t) && t < best)
+                best = t;
+
+            if (best <= maxDist)
+            {
+                dist = best;
+                objRank = m_objRanks[(x/m_brickCount)+(y/m_brickCount)*m_mosaicCount];
+                return true;
+            }
+        }
+
+        if (tNext >= tExit)
+            break;
+
+        if (tMaxX < tMaxY)
+        {
+            x += stepX;
+            tMaxX += tDeltaX;
+        }
+        else
+        {
+            y += stepY;
+            tMaxY += tDeltaY;
+        }
+
+        if (x < 0 || x >= size || y < 0 || y >= size)
+            break;
+
+        tCell = tNext;
+    }
+
+    return false;
+}
+
 bool CTerrain::AdjustToFloor(Math::Vector &pos, bool brut, bool water)
 {
     float dim = (m_mosaicCount*m_brickCount*m_brickSize)/2.0f;
@@ -198,6 +198,10 @@ public:
     float       GetFloorLevel(const Math::Vector& pos, bool brut=false, bool water=false);
     //! Returns the distance to the ground level from 3D position
     float       GetHeightToFloor(const Math::Vector& pos, bool brut=false, bool water=false);
+    //! Finds the first intersection of the ray \a origin + t * \a dir with the relief
+    /** Walks the heightfield cells crossed by the ray; \a objRank receives the hit mosaic. */
+    bool        IntersectRay(const Math::Vector& origin, const Math::Vector& dir, float maxDist,
+                             float& dist, int& objRank);
     //! Modifies the Y coordinate of 3D position to rest on the ground floor
     bool        AdjustToFloor(Math::Vector& pos, bool brut=false, bool water=false);
     //! Adjusts 3D position so that it is within standard terrain boundaries
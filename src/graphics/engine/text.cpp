@@ -34,6 +34,7 @@
 #include "math/func.h"
 
 #include <algorithm>
+#include <unordered_map>
 #include <SDL.h>
 #include <SDL_ttf.h>
 
@@ -66,6 +67,80 @@ struct FontTexture
     int freeSlots = 0;
 };
 
+/**
+ * \struct CharTextureCache
+ * \brief Textures of characters of a font
+ *
+ * Characters of 1 and 2 bytes (ASCII, Latin and other alphabets up to U+07FF)
+ * are kept in a table indexed directly by their bytes, others in a hash map.
+ */
+struct CharTextureCache
+{
+    //! Returns texture of character or nullptr if it isn't cached
+    const CharTexture* Find(UTF8Char ch) const
+    {
+        int index = GetTableIndex(ch);
+        if (index >= 0)
+        {
+            if (index < static_cast<int>(table.size()) && table[index].id != 0)
+                return &table[index];
+            return nullptr;
+        }
+
+        auto it = others.find(GetKey(ch));
+        if (it == others.end())
+            return nullptr;
+        return &it->second;
+    }
+
+    //! Adds texture of character, which must be valid
+    void Insert(UTF8Char ch, const CharTexture& tex)
+    {
+        int index = GetTableIndex(ch);
+        if (index >= 0)
+        {
+            if (table.empty())
+                table.resize(TABLE_SIZE);
+            table[index] = tex;
+        }
+        else
+        {
+            others[GetKey(ch)] = tex;
+        }
+    }
+
+    void Clear()
+    {
+        table.clear();
+        others.clear();
+    }
+
+private:
+    //! Single bytes, then code points of 2-byte characters
+    static const int TABLE_SIZE = 256 + 2048;
+
+    static int GetTableIndex(UTF8Char ch)
+    {
+        unsigned char c1 = static_cast<unsigned char>(ch.c1);
+        unsigned char c2 = static_cast<unsigned char>(ch.c2);
+        if (ch.c2 == '\0')
+            return c1;
+        if (ch.c3 == '\0')
+            return 256 + (((c1 & 0x1F) << 6) | (c2 & 0x3F));
+        return -1;
+    }
+
+    static unsigned int GetKey(UTF8Char ch)
+    {
+        return static_cast<unsigned char>(ch.c1) |
+               static_cast<unsigned char>(ch.c2) << 8 |
+               static_cast<unsigned char>(ch.c3) << 16;
+    }
+
+    std::vector<CharTexture> table;
+    std::unordered_map<unsigned int, CharTexture> others;
+};
+
 /**
  * \struct CachedFont
  * \brief Base TTF font with UTF-8 char cache
@@ -74,7 +149,7 @@ struct CachedFont
 {
     std::unique_ptr<CSDLMemoryWrapper> fontFile;
     TTF_Font* font = nullptr;
-    std::map<UTF8Char, CharTexture> cache;
+    CharTextureCache cache;
 
     CachedFont(std::unique_ptr<CSDLMemoryWrapper> fontFile, int pointSize)
         : fontFile(std::move(fontFile))
@@ -94,8 +169,62 @@ namespace
 {
 const Math::IntPoint REFERENCE_SIZE(800, 600);
 const Math::IntPoint FONT_TEXTURE_SIZE(256, 256);
+
+//! Maximum number of cached layouts and widths, the caches are cleared when it is exceeded
+const std::size_t MAX_LAYOUT_CACHE_SIZE = 2048;
+
+//! Appends bytes of \a value to cache \a key
+template<typename T>
+void AppendToKey(std::string& key, const T& value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//! Appends text and formats used by its characters to cache \a key
+void AppendTextToKey(std::string& key, const std::string& text,
+                     std::vector<FontMetaChar>::iterator format,
+                     std::vector<FontMetaChar>::iterator end)
+{
+    AppendToKey(key, text.size());
+    key.append(text);
+    for (std::size_t i = 0; i < text.size() && format + i != end; ++i)
+        AppendToKey(key, format[i]);
+}
+
 } // anonymous namespace
 
+/**
+ * \struct CText::CachedLayout
+ * \brief Quads of a drawn string, relative to its position
+ *
+ * Strings drawn again with the same text, format, size and color are drawn
+ * from their layout, without decoding UTF-8, looking up characters
+ * and computing their sizes.
+ */
+struct CText::CachedLayout
+{
+    struct Quad
+    {
+        Vertex vertices[4];
+        unsigned int texID;
+        EngineRenderState renderState;
+        Color color;
+    };
+
+    struct Highlight
+    {
+        VertexCol vertices[4];
+        //! Number of quads drawn before the highlight
+        std::size_t quadIndex;
+    };
+
+    Math::IntPoint origin;
+    std::vector<Quad> quads;
+    std::vector<Highlight> highlights;
+    //! False if the layout depends on something else than the key (button icons, missing characters)
+    bool cacheable = true;
+};
+
 /// The QuadBatch is responsible for collecting as many quad (aka rectangle) draws as possible and
 /// sending them to the CDevice in one big batch. This avoids making one CDevice::DrawPrimitive call
 /// for every CText::DrawCharAndAdjustPos call, which makes text rendering much faster.
@@ -111,6 +240,12 @@ public:
         m_quads.reserve(1024);
     }
 
+    /// Set the layout to which added quads are recorded, or nullptr.
+    void SetRecorder(CachedLayout* layout)
+    {
+        m_recorder = layout;
+    }
+
     /// Add a quad to be rendered.
     /// This may trigger a call to Flush() if necessary.
     void Add(Vertex vertices[4], unsigned int texID, EngineRenderState renderState, Color color)
@@ -123,6 +258,12 @@ public:
             m_color = color;
         }
         m_quads.emplace_back(Quad{{vertices[0], vertices[1], vertices[2], vertices[3]}});
+
+        if (m_recorder != nullptr)
+        {
+            m_recorder->quads.push_back(CachedLayout::Quad{{vertices[0], vertices[1], vertices[2], vertices[3]},
+                                                           texID, renderState, color});
+        }
     }
 
     /// Draw all pending quads immediately.
@@ -165,6 +306,8 @@ private:
     Color m_color;
     unsigned int m_texID{};
     EngineRenderState m_renderState{};
+
+    CachedLayout* m_recorder = nullptr;
 };
 
 
@@ -213,6 +356,8 @@ bool CText::ReloadFonts()
         GetLogger()->Debug("Error on parsing fonts config file: failed to open file\n");
     }
 
+    ClearLayoutCache();
+
     // Backup previous fonts
     auto fonts = std::move(m_fonts);
     m_fonts.clear();
@@ -240,6 +385,7 @@ bool CText::ReloadFonts()
 
 void CText::Destroy()
 {
+    ClearLayoutCache();
     m_fonts.clear();
 
     m_lastCachedFont = nullptr;
@@ -273,10 +419,12 @@ void CText::FlushCache()
     {
         for (auto& cachedFont : multisizeFont.second->fonts)
         {
-            cachedFont.second->cache.clear();
+            cachedFont.second->cache.Clear();
         }
     }
 
+    ClearLayoutCache();
+
     m_lastCachedFont = nullptr;
     m_lastFontType = FONT_COMMON;
     m_lastFontSize = 0;
@@ -437,6 +585,15 @@ float CText::GetStringWidth(const std::string &text,
                             std::vector<FontMetaChar>::iterator format,
                             std::vector<FontMetaChar>::iterator end, float size)
 {
+    std::string key(1, 'w');
+    AppendToKey(key, m_engine->GetWindowSize());
+    AppendToKey(key, size);
+    AppendTextToKey(key, text, format, end);
+
+    auto it = m_widthCache.find(key);
+    if (it != m_widthCache.end())
+        return it->second;
+
     float width = 0.0f;
     unsigned int index = 0;
     unsigned int fmtIndex = 0;
@@ -462,6 +619,10 @@ float CText::GetStringWidth(const std::string &text,
         fmtIndex += len;
     }
 
+    if (m_widthCache.size() >= MAX_LAYOUT_CACHE_SIZE)
+        m_widthCache.clear();
+    m_widthCache[key] = width;
+
     return width;
 }
 
@@ -478,9 +639,24 @@ float CText::GetStringWidth(std::string text, FontType font, float size)
 
     CachedFont* cf = GetOrOpenFont(font, size);
     assert(cf != nullptr);
+
+    std::string key(1, 'v');
+    AppendToKey(key, m_engine->GetWindowSize());
+    AppendToKey(key, cf);
+    key.append(text);
+
+    auto it = m_widthCache.find(key);
+    if (it != m_widthCache.end())
+        return it->second;
+
     Math::IntPoint wndSize;
     TTF_SizeUTF8(cf->font, text.c_str(), &wndSize.x, &wndSize.y);
     Math::Point ifSize = m_engine->WindowToInterfaceSize(wndSize);
+
+    if (m_widthCache.size() >= MAX_LAYOUT_CACHE_SIZE)
+        m_widthCache.clear();
+    m_widthCache[key] = ifSize.x;
+
     return ifSize.x;
 }
 
@@ -509,10 +685,10 @@ float CText::GetCharWidth(UTF8Char ch, FontType font, float size, float offset)
     assert(cf != nullptr);
 
     Math::Point charSize;
-    auto it = cf->cache.find(ch);
-    if (it != cf->cache.end())
+    const CharTexture* tex = cf->cache.Find(ch);
+    if (tex != nullptr)
     {
-        charSize = m_engine->WindowToInterfaceSize((*it).second.charSize);
+        charSize = m_engine->WindowToInterfaceSize(tex->charSize);
     }
     else
     {
@@ -551,10 +727,10 @@ int CText::GetCharWidthInt(UTF8Char ch, FontType font, float size, float offset)
     assert(cf != nullptr);
 
     Math::IntPoint charSize;
-    auto it = cf->cache.find(ch);
-    if (it != cf->cache.end())
+    const CharTexture* tex = cf->cache.Find(ch);
+    if (tex != nullptr)
     {
-        charSize = (*it).second.charSize;
+        charSize = tex->charSize;
     }
     else
     {
@@ -787,6 +963,22 @@ void CText::DrawString(const std::string &text, std::vector<FontMetaChar>::itera
 {
     m_engine->SetWindowCoordinates();
 
+    std::string key(1, 'm');
+    AppendToKey(key, m_engine->GetWindowSize());
+    AppendToKey(key, size);
+    AppendToKey(key, width);
+    AppendToKey(key, eol);
+    AppendToKey(key, color);
+    AppendTextToKey(key, text, format, end);
+
+    if (DrawCachedLayout(key, pos))
+    {
+        m_engine->SetInterfaceCoordinates();
+        return;
+    }
+
+    BeginLayout(pos);
+
     int start = pos.x;
 
     unsigned int fmtIndex = 0;
@@ -873,7 +1065,8 @@ void CText::DrawString(const std::string &text, std::vector<FontMetaChar>::itera
         color = Color(1.0f, 0.0f, 0.0f);
         DrawCharAndAdjustPos(ch, font, size, pos, color);
     }
-    m_quadBatch->Flush();
+
+    EndLayout(key);
     m_engine->SetInterfaceCoordinates();
 }
 
@@ -947,17 +1140,105 @@ void CText::DrawString(const std::string &text, FontType font,
 {
     assert(font != FONT_BUTTON);
 
+    m_engine->SetWindowCoordinates();
+
+    std::string key(1, 's');
+    AppendToKey(key, m_engine->GetWindowSize());
+    AppendToKey(key, font);
+    AppendToKey(key, size);
+    AppendToKey(key, color);
+    key.append(text);
+
+    if (DrawCachedLayout(key, pos))
+    {
+        m_engine->SetInterfaceCoordinates();
+        return;
+    }
+
+    BeginLayout(pos);
+
     std::vector<UTF8Char> chars;
     StringToUTFCharList(text, chars);
-    m_engine->SetWindowCoordinates();
     for (auto it = chars.begin(); it != chars.end(); ++it)
     {
         DrawCharAndAdjustPos(*it, font, size, pos, color);
     }
-    m_quadBatch->Flush();
+
+    EndLayout(key);
     m_engine->SetInterfaceCoordinates();
 }
 
+bool CText::DrawCachedLayout(const std::string& key, Math::IntPoint pos)
+{
+    auto it = m_layoutCache.find(key);
+    if (it == m_layoutCache.end())
+        return false;
+
+    const CachedLayout& layout = *it->second;
+    float dx = pos.x - layout.origin.x;
+    float dy = pos.y - layout.origin.y;
+
+    auto highlight = layout.highlights.begin();
+    for (std::size_t i = 0; i <= layout.quads.size(); ++i)
+    {
+        for (; highlight != layout.highlights.end() && highlight->quadIndex == i; ++highlight)
+        {
+            VertexCol quad[4];
+            for (int j = 0; j < 4; ++j)
+            {
+                quad[j] = highlight->vertices[j];
+                quad[j].coord.x += dx;
+                quad[j].coord.y += dy;
+            }
+            DrawHighlightQuad(quad);
+        }
+
+        if (i == layout.quads.size())
+            break;
+
+        const CachedLayout::Quad& cached = layout.quads[i];
+        Vertex quad[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            quad[j] = cached.vertices[j];
+            quad[j].coord.x += dx;
+            quad[j].coord.y += dy;
+        }
+        m_quadBatch->Add(quad, cached.texID, cached.renderState, cached.color);
+    }
+
+    m_quadBatch->Flush();
+    return true;
+}
+
+void CText::BeginLayout(Math::IntPoint pos)
+{
+    m_recordedLayout = MakeUnique<CachedLayout>();
+    m_recordedLayout->origin = pos;
+    m_quadBatch->SetRecorder(m_recordedLayout.get());
+}
+
+void CText::EndLayout(const std::string& key)
+{
+    m_quadBatch->Flush();
+    m_quadBatch->SetRecorder(nullptr);
+
+    if (m_recordedLayout->cacheable)
+    {
+        if (m_layoutCache.size() >= MAX_LAYOUT_CACHE_SIZE)
+            m_layoutCache.clear();
+        m_layoutCache[key] = std::move(m_recordedLayout);
+    }
+
+    m_recordedLayout.reset();
+}
+
+void CText::ClearLayoutCache()
+{
+    m_layoutCache.clear();
+    m_widthCache.clear();
+}
+
 void CText::DrawHighlight(FontMetaChar hl, Math::IntPoint pos, Math::IntPoint size)
 {
     // Gradient colors
@@ -979,8 +1260,6 @@ void CText::DrawHighlight(FontMetaChar hl, Math::IntPoint pos, Math::IntPoint si
         return;
     }
 
-    m_quadBatch->Flush();
-
     Math::IntPoint vsize = m_engine->GetWindowSize();
     float h = 0.0f;
     if (vsize.y <= 768.0f)    // 1024x768 or less?
@@ -999,8 +1278,6 @@ void CText::DrawHighlight(FontMetaChar hl, Math::IntPoint pos, Math::IntPoint si
         p1.y = pos.y - h;  // just emphasized
     }
 
-    m_device->SetTextureEnabled(0, false);
-
     VertexCol quad[] =
     {
         VertexCol(Math::Vector(p1.x, p2.y, 0.0f), grad[3]),
@@ -1009,6 +1286,23 @@ void CText::DrawHighlight(FontMetaChar hl, Math::IntPoint pos, Math::IntPoint si
         VertexCol(Math::Vector(p2.x, p1.y, 0.0f), grad[1])
     };
 
+    if (m_recordedLayout != nullptr)
+    {
+        CachedLayout::Highlight highlight;
+        std::copy(quad, quad + 4, highlight.vertices);
+        highlight.quadIndex = m_recordedLayout->quads.size();
+        m_recordedLayout->highlights.push_back(highlight);
+    }
+
+    DrawHighlightQuad(quad);
+}
+
+void CText::DrawHighlightQuad(const VertexCol* quad)
+{
+    m_quadBatch->Flush();
+
+    m_device->SetTextureEnabled(0, false);
+
     m_device->DrawPrimitive(PRIMITIVE_TRIANGLE_STRIP, quad, 4);
     m_engine->AddStatisticTriangle(2);
 
@@ -1057,6 +1351,10 @@ void CText::DrawCharAndAdjustPos(UTF8Char ch, FontType font, float size, Math::I
 
         m_quadBatch->Add(quad, texID, ENG_RSTATE_TTEXTURE_WHITE, color);
 
+        // Button textures may be reloaded with other IDs
+        if (m_recordedLayout != nullptr)
+            m_recordedLayout->cacheable = false;
+
         pos.x += width;
     }
     else
@@ -1074,6 +1372,8 @@ void CText::DrawCharAndAdjustPos(UTF8Char ch, FontType font, float size, Math::I
         }
 
         CharTexture tex = GetCharTexture(ch, font, size);
+        if (tex.id == 0 && m_recordedLayout != nullptr)
+            m_recordedLayout->cacheable = false;
 
         Math::Point p1(pos.x, pos.y - tex.charSize.y);
         Math::Point p2(pos.x + tex.charSize.x, pos.y);
@@ -1156,11 +1456,11 @@ CharTexture CText::GetCharTexture(UTF8Char ch, FontType font, float size)
     if (cf == nullptr)
         return CharTexture();
 
-    auto it = cf->cache.find(ch);
+    const CharTexture* cached = cf->cache.Find(ch);
     CharTexture tex;
-    if (it != cf->cache.end())
+    if (cached != nullptr)
     {
-        tex = (*it).second;
+        tex = *cached;
     }
     else
     {
@@ -1169,7 +1469,7 @@ CharTexture CText::GetCharTexture(UTF8Char ch, FontType font, float size)
         if (tex.id == 0) // invalid
             return CharTexture();
 
-        cf->cache[ch] = tex;
+        cf->cache.Insert(ch, tex);
     }
     return tex;
 }
@@ -32,6 +32,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -41,6 +43,7 @@ namespace Gfx
 
 class CEngine;
 class CDevice;
+struct VertexCol;
 
 //! Standard small font size
 const float FONT_SIZE_SMALL = 12.0f;
@@ -335,12 +338,22 @@ protected:
     void        DrawString(const std::string &text, FontType font,
                            float size, Math::IntPoint pos, int width, int eol, Color color);
     void        DrawHighlight(FontMetaChar hl, Math::IntPoint pos, Math::IntPoint size);
+    void        DrawHighlightQuad(const VertexCol* quad);
     void        DrawCharAndAdjustPos(UTF8Char ch, FontType font, float size, Math::IntPoint &pos, Color color);
     void        StringToUTFCharList(const std::string &text, std::vector<UTF8Char> &chars);
     void        StringToUTFCharList(const std::string &text, std::vector<UTF8Char> &chars, std::vector<FontMetaChar>::iterator format, std::vector<FontMetaChar>::iterator end);
 
     int GetCharSizeAt(Gfx::FontType font, const std::string& text, unsigned int index) const;
 
+    //! Draws cached layout with given \a key at \a pos, returns false if there is none
+    bool        DrawCachedLayout(const std::string& key, Math::IntPoint pos);
+    //! Starts recording quads drawn at \a pos as layout
+    void        BeginLayout(Math::IntPoint pos);
+    //! Stops recording and saves the layout with given \a key
+    void        EndLayout(const std::string& key);
+    //! Clears cached layouts and string widths
+    void        ClearLayoutCache();
+
 protected:
     CEngine*       m_engine;
     CDevice*       m_device;
@@ -358,6 +371,14 @@ protected:
 
     class CQuadBatch;
     std::unique_ptr<CQuadBatch> m_quadBatch;
+
+    //! Quads of drawn strings, by string, format, size and color
+    struct CachedLayout;
+    std::unordered_map<std::string, std::unique_ptr<CachedLayout>> m_layoutCache;
+    //! Layout being recorded, or nullptr
+    std::unique_ptr<CachedLayout> m_recordedLayout;
+    //! Widths of strings, by string, format and size
+    std::unordered_map<std::string, float> m_widthCache;
 };
 
 
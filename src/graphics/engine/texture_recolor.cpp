@@ -0,0 +1,447 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "graphics/engine/texture_recolor.h"
+
+#include "math/func.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_RECOLOR_SSE
+#include <emmintrin.h>
+#endif
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+namespace
+{
+
+//! Values computed once for all pixels
+struct RecolorSetup
+{
+    int         sx = 0;
+    int         sy = 0;
+    int         ex = 0;
+    int         ey = 0;
+    ColorHSV    cr1;
+    ColorHSV    cn1;
+    ColorHSV    cr2;
+    ColorHSV    cn2;
+};
+
+RecolorSetup PrepareRecolor(const RecolorImage& image, const RecolorParams& params)
+{
+    RecolorSetup setup;
+
+    int dx = image.width;
+    int dy = image.height;
+
+    setup.sx = static_cast<int>(Math::Max(params.ts.x*dx, 0));
+    setup.sy = static_cast<int>(Math::Max(params.ts.y*dy, 0));
+    setup.ex = static_cast<int>(Math::Min(params.ti.x*dx, dx));
+    setup.ey = static_cast<int>(Math::Min(params.ti.y*dy, dy));
+
+    setup.cr1 = RGB2HSV(params.colorRef1);
+    setup.cn1 = RGB2HSV(params.colorNew1);
+    setup.cr2 = RGB2HSV(params.colorRef2);
+    setup.cn2 = RGB2HSV(params.colorNew2);
+
+    return setup;
+}
+
+bool IsExcluded(const RecolorParams& params, int x, int y)
+{
+    const std::vector<Math::Point>& exclude = params.exclude;
+    for (std::size_t i = 0; i + 1 < exclude.size(); i += 2)
+    {
+        if ( x >= static_cast<int>(exclude[i+0].x*256.0f) &&
+             x <  static_cast<int>(exclude[i+1].x*256.0f) &&
+             y >= static_cast<int>(exclude[i+0].y*256.0f) &&
+             y <  static_cast<int>(exclude[i+1].y*256.0f) )
+            return true;
+    }
+    return false;
+}
+
+//! Returns the bits of a pixel which aren't changed by Pack()
+std::uint32_t GetKeptBits(const RecolorImage& image)
+{
+    std::uint32_t changed = (0xFFu << image.rShift) | (0xFFu << image.gShift) | (0xFFu << image.bShift);
+    if (image.alpha)
+        changed |= 0xFFu << image.aShift;
+    return ~changed;
+}
+
+std::uint32_t Pack(const RecolorImage& image, std::uint32_t pixel, IntColor color)
+{
+    pixel &= GetKeptBits(image);
+    pixel |= static_cast<std::uint32_t>(color.r) << image.rShift;
+    pixel |= static_cast<std::uint32_t>(color.g) << image.gShift;
+    pixel |= static_cast<std::uint32_t>(color.b) << image.bShift;
+    if (image.alpha)
+        pixel |= static_cast<std::uint32_t>(color.a) << image.aShift;
+    return pixel;
+}
+
+//! Changes one pixel, in the same way as done before by CEngine::ChangeTextureColor() with CImage::GetPixel()
+void RecolorPixel(std::uint32_t& pixel, const RecolorImage& image, const RecolorParams& params,
+                  const RecolorSetup& setup)
+{
+    IntColor intColor((pixel >> image.rShift) & 0xFF, (pixel >> image.gShift) & 0xFF,
+                      (pixel >> image.bShift) & 0xFF, (pixel >> image.aShift) & 0xFF);
+    Color color = IntColorToColor(intColor);
+
+    if (params.hsv)
+    {
+        const ColorHSV* ref = nullptr;
+        const ColorHSV* neu = nullptr;
+
+        ColorHSV c = RGB2HSV(color);
+        if (c.s > 0.01f && std::fabs(c.h - setup.cr1.h) < params.tolerance1)
+        {
+            ref = &setup.cr1;
+            neu = &setup.cn1;
+        }
+        else if (params.tolerance2 != -1.0f &&
+                 c.s > 0.01f && std::fabs(c.h - setup.cr2.h) < params.tolerance2)
+        {
+            ref = &setup.cr2;
+            neu = &setup.cn2;
+        }
+        else
+        {
+            return;
+        }
+
+        c.h += neu->h - ref->h;
+        c.s += neu->s - ref->s;
+        c.v += neu->v - ref->v;
+        if (c.h < 0.0f) c.h -= 1.0f;
+        if (c.h > 1.0f) c.h += 1.0f;
+        color = HSV2RGB(c);  // alpha is 0
+        color.r = Math::Norm(color.r + params.shift);
+        color.g = Math::Norm(color.g + params.shift);
+        color.b = Math::Norm(color.b + params.shift);
+    }
+    else
+    {
+        const Color* ref = nullptr;
+        const Color* neu = nullptr;
+
+        if ( std::fabs(color.r - params.colorRef1.r) +
+             std::fabs(color.g - params.colorRef1.g) +
+             std::fabs(color.b - params.colorRef1.b) < params.tolerance1 * 3.0f )
+        {
+            ref = &params.colorRef1;
+            neu = &params.colorNew1;
+        }
+        else if ( params.tolerance2 != -1.0f &&
+                  std::fabs(color.r - params.colorRef2.r) +
+                  std::fabs(color.g - params.colorRef2.g) +
+                  std::fabs(color.b - params.colorRef2.b) < params.tolerance2 * 3.0f )
+        {
+            ref = &params.colorRef2;
+            neu = &params.colorNew2;
+        }
+        else
+        {
+            return;
+        }
+
+        color.r = Math::Norm(neu->r + color.r - ref->r + params.shift);
+        color.g = Math::Norm(neu->g + color.g - ref->g + params.shift);
+        color.b = Math::Norm(neu->b + color.b - ref->b + params.shift);
+    }
+
+    pixel = Pack(image, pixel, ColorToIntColor(color));
+}
+
+#ifdef TEXTURE_RECOLOR_SSE
+
+// The functions below do the same operations as the scalar code, in the same order,
+// so that results are exactly the same
+
+inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 Abs(__m128 a)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+
+//! Same as Math::Norm()
+inline __m128 Norm(__m128 a)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    return Select(_mm_cmplt_ps(a, zero), zero, Select(_mm_cmpgt_ps(a, one), one, a));
+}
+
+//! Same as RGB2HSV()
+inline void RGB2HSV(__m128 r, __m128 g, __m128 b, __m128& h, __m128& s, __m128& v)
+{
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 min = Select(_mm_cmple_ps(r, g), r, g);
+    min = Select(_mm_cmple_ps(min, b), min, b);
+    __m128 max = Select(_mm_cmpge_ps(r, g), r, g);
+    max = Select(_mm_cmpge_ps(max, b), max, b);
+
+    v = max;
+
+    __m128 delta = _mm_sub_ps(max, min);
+    s = _mm_div_ps(delta, max);
+
+    __m128 hr = _mm_div_ps(_mm_sub_ps(g, b), delta);
+    __m128 hg = _mm_add_ps(_mm_set1_ps(2.0f), _mm_div_ps(_mm_sub_ps(b, r), delta));
+    __m128 hb = _mm_add_ps(_mm_set1_ps(4.0f), _mm_div_ps(_mm_sub_ps(r, g), delta));
+    h = Select(_mm_cmpeq_ps(r, max), hr, Select(_mm_cmpeq_ps(g, max), hg, hb));
+
+    h = _mm_mul_ps(h, _mm_set1_ps(60.0f));
+    h = Select(_mm_cmplt_ps(h, zero), _mm_add_ps(h, _mm_set1_ps(360.0f)), h);
+    h = _mm_div_ps(h, _mm_set1_ps(360.0f));
+
+    __m128 black = _mm_cmpeq_ps(max, zero);
+    s = Select(black, zero, s);
+    h = Select(black, zero, h);
+}
+
+//! Same as HSV2RGB()
+inline void HSV2RGB(__m128 h, __m128 s, __m128 v, __m128& r, __m128& g, __m128& b)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    h = _mm_mul_ps(Norm(h), _mm_set1_ps(360.0f));
+    s = Norm(s);
+    v = Norm(v);
+
+    h = Select(_mm_cmpeq_ps(h, _mm_set1_ps(360.0f)), _mm_setzero_ps(), h);
+    h = _mm_div_ps(h, _mm_set1_ps(60.0f));
+    __m128i i = _mm_cvttps_epi32(h);
+    __m128 f = _mm_sub_ps(h, _mm_cvtepi32_ps(i));
+
+    __m128 p = _mm_mul_ps(v, _mm_sub_ps(one, s));
+    __m128 q = _mm_mul_ps(v, _mm_sub_ps(one, _mm_mul_ps(s, f)));
+    __m128 t = _mm_mul_ps(v, _mm_sub_ps(one, _mm_mul_ps(s, _mm_sub_ps(one, f))));
+
+    __m128 i0 = _mm_castsi128_ps(_mm_cmpeq_epi32(i, _mm_set1_epi32(0)));
+    __m128 i1 = _mm_castsi128_ps(_mm_cmpeq_epi32(i, _mm_set1_epi32(1)));
+    __m128 i2 = _mm_castsi128_ps(_mm_cmpeq_epi32(i, _mm_set1_epi32(2)));
+    __m128 i3 = _mm_castsi128_ps(_mm_cmpeq_epi32(i, _mm_set1_epi32(3)));
+    __m128 i4 = _mm_castsi128_ps(_mm_cmpeq_epi32(i, _mm_set1_epi32(4)));
+
+    r = Select(i0, v, Select(i1, q, Select(i2, p, Select(i3, p, Select(i4, t, v)))));
+    g = Select(i0, t, Select(i1, v, Select(i2, v, Select(i3, q, Select(i4, p, p)))));
+    b = Select(i0, p, Select(i1, p, Select(i2, t, Select(i3, v, Select(i4, v, q)))));
+
+    __m128 gray = _mm_cmpeq_ps(s, _mm_setzero_ps());
+    r = Select(gray, v, r);
+    g = Select(gray, v, g);
+    b = Select(gray, v, b);
+}
+
+inline __m128 GetChannel(__m128i pixels, int shift)
+{
+    __m128i channel = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(shift)), _mm_set1_epi32(0xFF));
+    return _mm_div_ps(_mm_cvtepi32_ps(channel), _mm_set1_ps(255.0f));
+}
+
+//! Same as ColorToIntColor() for one channel
+inline __m128i PutChannel(__m128 value, int shift)
+{
+    __m128i channel = _mm_cvttps_epi32(_mm_mul_ps(value, _mm_set1_ps(255.0f)));
+    return _mm_sll_epi32(_mm_and_si128(channel, _mm_set1_epi32(0xFF)), _mm_cvtsi32_si128(shift));
+}
+
+//! Changes 4 pixels, if enabled in \a enabled mask
+void RecolorPixels4(std::uint32_t* pixels, __m128i enabled, const RecolorImage& image,
+                    const RecolorParams& params, const RecolorSetup& setup)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 shift = _mm_set1_ps(params.shift);
+    const __m128 useSecond = (params.tolerance2 != -1.0f) ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+    __m128 r = GetChannel(in, image.rShift);
+    __m128 g = GetChannel(in, image.gShift);
+    __m128 b = GetChannel(in, image.bShift);
+    __m128 a = GetChannel(in, image.aShift);
+
+    __m128 first, second;
+
+    if (params.hsv)
+    {
+        __m128 h, s, v;
+        RGB2HSV(r, g, b, h, s, v);
+
+        __m128 saturated = _mm_cmpgt_ps(s, _mm_set1_ps(0.01f));
+        first = _mm_and_ps(saturated,
+                           _mm_cmplt_ps(Abs(_mm_sub_ps(h, _mm_set1_ps(setup.cr1.h))), _mm_set1_ps(params.tolerance1)));
+        second = _mm_and_ps(_mm_and_ps(useSecond, saturated),
+                            _mm_cmplt_ps(Abs(_mm_sub_ps(h, _mm_set1_ps(setup.cr2.h))), _mm_set1_ps(params.tolerance2)));
+        second = _mm_andnot_ps(first, second);
+
+        h = _mm_add_ps(h, Select(first, _mm_set1_ps(setup.cn1.h - setup.cr1.h), _mm_set1_ps(setup.cn2.h - setup.cr2.h)));
+        s = _mm_add_ps(s, Select(first, _mm_set1_ps(setup.cn1.s - setup.cr1.s), _mm_set1_ps(setup.cn2.s - setup.cr2.s)));
+        v = _mm_add_ps(v, Select(first, _mm_set1_ps(setup.cn1.v - setup.cr1.v), _mm_set1_ps(setup.cn2.v - setup.cr2.v)));
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        h = Select(_mm_cmplt_ps(h, zero), _mm_sub_ps(h, one), h);
+        h = Select(_mm_cmpgt_ps(h, one), _mm_add_ps(h, one), h);
+
+        HSV2RGB(h, s, v, r, g, b);
+        r = Norm(_mm_add_ps(r, shift));
+        g = Norm(_mm_add_ps(g, shift));
+        b = Norm(_mm_add_ps(b, shift));
+        a = zero;
+    }
+    else
+    {
+        const Color& ref1 = params.colorRef1;
+        const Color& ref2 = params.colorRef2;
+        const Color& new1 = params.colorNew1;
+        const Color& new2 = params.colorNew2;
+
+        __m128 dist1 = _mm_add_ps(_mm_add_ps(Abs(_mm_sub_ps(r, _mm_set1_ps(ref1.r))),
+                                             Abs(_mm_sub_ps(g, _mm_set1_ps(ref1.g)))),
+                                  Abs(_mm_sub_ps(b, _mm_set1_ps(ref1.b))));
+        __m128 dist2 = _mm_add_ps(_mm_add_ps(Abs(_mm_sub_ps(r, _mm_set1_ps(ref2.r))),
+                                             Abs(_mm_sub_ps(g, _mm_set1_ps(ref2.g)))),
+                                  Abs(_mm_sub_ps(b, _mm_set1_ps(ref2.b))));
+        first = _mm_cmplt_ps(dist1, _mm_set1_ps(params.tolerance1 * 3.0f));
+        second = _mm_and_ps(useSecond, _mm_cmplt_ps(dist2, _mm_set1_ps(params.tolerance2 * 3.0f)));
+        second = _mm_andnot_ps(first, second);
+
+        __m128 nr = Select(first, _mm_set1_ps(new1.r), _mm_set1_ps(new2.r));
+        __m128 ng = Select(first, _mm_set1_ps(new1.g), _mm_set1_ps(new2.g));
+        __m128 nb = Select(first, _mm_set1_ps(new1.b), _mm_set1_ps(new2.b));
+        __m128 rr = Select(first, _mm_set1_ps(ref1.r), _mm_set1_ps(ref2.r));
+        __m128 rg = Select(first, _mm_set1_ps(ref1.g), _mm_set1_ps(ref2.g));
+        __m128 rb = Select(first, _mm_set1_ps(ref1.b), _mm_set1_ps(ref2.b));
+
+        r = Norm(_mm_add_ps(_mm_sub_ps(_mm_add_ps(nr, r), rr), shift));
+        g = Norm(_mm_add_ps(_mm_sub_ps(_mm_add_ps(ng, g), rg), shift));
+        b = Norm(_mm_add_ps(_mm_sub_ps(_mm_add_ps(nb, b), rb), shift));
+    }
+
+    __m128i out = _mm_and_si128(in, _mm_set1_epi32(GetKeptBits(image)));
+    out = _mm_or_si128(out, PutChannel(r, image.rShift));
+    out = _mm_or_si128(out, PutChannel(g, image.gShift));
+    out = _mm_or_si128(out, PutChannel(b, image.bShift));
+    if (image.alpha)
+        out = _mm_or_si128(out, PutChannel(a, image.aShift));
+
+    __m128i changed = _mm_and_si128(enabled, _mm_castps_si128(_mm_or_ps(first, second)));
+    out = _mm_or_si128(_mm_and_si128(changed, out), _mm_andnot_si128(changed, in));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), out);
+}
+
+#endif
+
+} // anonymous namespace
+
+
+std::string RecolorParams::GetKey() const
+{
+    std::string key;
+    auto add = [&key](float value)
+    {
+        key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto addColor = [&add](const Color& color)
+    {
+        add(color.r);
+        add(color.g);
+        add(color.b);
+    };
+
+    addColor(colorRef1);
+    addColor(colorNew1);
+    addColor(colorRef2);
+    addColor(colorNew2);
+    add(tolerance1);
+    add(tolerance2);
+    add(ts.x);
+    add(ts.y);
+    add(ti.x);
+    add(ti.y);
+    for (const Math::Point& point : exclude)
+    {
+        add(point.x);
+        add(point.y);
+    }
+    add(shift);
+    key += hsv ? 'h' : 'r';
+    return key;
+}
+
+void RecolorPixelsScalar(const RecolorImage& image, const RecolorParams& params)
+{
+    RecolorSetup setup = PrepareRecolor(image, params);
+
+    for (int y = setup.sy; y < setup.ey; y++)
+    {
+        std::uint32_t* row = image.pixels + y * image.pitch;
+        for (int x = setup.sx; x < setup.ex; x++)
+        {
+            if (IsExcluded(params, x, y)) continue;
+            RecolorPixel(row[x], image, params, setup);
+        }
+    }
+}
+
+void RecolorPixels(const RecolorImage& image, const RecolorParams& params)
+{
+#ifdef TEXTURE_RECOLOR_SSE
+    RecolorSetup setup = PrepareRecolor(image, params);
+
+    for (int y = setup.sy; y < setup.ey; y++)
+    {
+        std::uint32_t* row = image.pixels + y * image.pitch;
+
+        int x = setup.sx;
+        for (; x + 4 <= setup.ex; x += 4)
+        {
+            int enabled[4];
+            for (int i = 0; i < 4; i++)
+                enabled[i] = IsExcluded(params, x + i, y) ? 0 : -1;
+
+            __m128i mask = _mm_setr_epi32(enabled[0], enabled[1], enabled[2], enabled[3]);
+            RecolorPixels4(row + x, mask, image, params, setup);
+        }
+
+        for (; x < setup.ex; x++)
+        {
+            if (IsExcluded(params, x, y)) continue;
+            RecolorPixel(row[x], image, params, setup);
+        }
+    }
+#else
+    RecolorPixelsScalar(image, params);
+#endif
+}
+
+} // namespace Gfx
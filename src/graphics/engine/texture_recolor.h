@@ -0,0 +1,95 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+/**
+ * \file graphics/engine/texture_recolor.h
+ * \brief Changing colors in textures
+ */
+
+#pragma once
+
+#include "graphics/core/color.h"
+
+#include "math/point.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// Graphics module namespace
+namespace Gfx
+{
+
+/**
+ * \struct RecolorParams
+ * \brief Parameters of CEngine::ChangeTextureColor()
+ *
+ * Pixels close to colorRef1 are changed by the difference between colorNew1 and colorRef1,
+ * otherwise pixels close to colorRef2 by the difference between colorNew2 and colorRef2
+ * (unless tolerance2 is -1). Colors are compared in RGB space or by hue if hsv is set.
+ */
+struct RecolorParams
+{
+    Color       colorRef1;
+    Color       colorNew1;
+    Color       colorRef2;
+    Color       colorNew2;
+    float       tolerance1 = 0.0f;
+    float       tolerance2 = -1.0f;
+    //! Changed part of the texture, in texture coordinates
+    Math::Point ts;
+    Math::Point ti;
+    //! Excluded rectangles given by pairs of corners, in 1/256 of pixels from upper left
+    std::vector<Math::Point> exclude;
+    //! Value added to changed color channels
+    float       shift = 0.0f;
+    bool        hsv = false;
+
+    //! Returns a string identifying the parameters, for caching results
+    std::string GetKey() const;
+};
+
+/**
+ * \struct RecolorImage
+ * \brief 32-bit pixels to be changed by RecolorPixels()
+ */
+struct RecolorImage
+{
+    std::uint32_t*  pixels = nullptr;
+    int             width = 0;
+    int             height = 0;
+    //! Distance between rows, in pixels
+    int             pitch = 0;
+    //! Positions of channels in pixels, in bits
+    int             rShift = 16;
+    int             gShift = 8;
+    int             bShift = 0;
+    int             aShift = 24;
+    //! Whether the alpha channel is used; if not, it is left as is
+    bool            alpha = true;
+};
+
+//! Changes colors of an image; uses SIMD instructions when available
+void RecolorPixels(const RecolorImage& image, const RecolorParams& params);
+//! Same as RecolorPixels() but processes one pixel at a time
+void RecolorPixelsScalar(const RecolorImage& image, const RecolorParams& params);
+
+} // namespace Gfx
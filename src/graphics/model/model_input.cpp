@@ -49,6 +49,7 @@ namespace ModelInput
     void ReadBinaryModel(CModel &model, std::istream &stream);
     void ReadBinaryModelV1AndV2(CModel &model, std::istream &stream);
     void ReadBinaryModelV3(CModel &model, std::istream &stream);
+    CModelMesh ReadBinaryMeshV3(std::istream &stream);
 
     void ReadOldModel(CModel &model, std::istream &stream);
     std::vector<ModelTriangle> ReadOldModelV1(std::istream &stream, int totalTriangles);
@@ -117,8 +118,9 @@ void ModelInput::ReadBinaryModel(CModel &model, std::istream &stream)
     int version = 0;
     try
     {
+        std::streampos start = stream.tellg();
         version = ReadBinary<4, int>(stream);
-        stream.seekg(std::ios_base::beg);
+        stream.seekg(start);
     }
     catch (const std::exception& e)
     {
@@ -196,7 +198,157 @@ void ModelInput::ReadBinaryModelV1AndV2(CModel &model, std::istream &stream)
 
 void ModelInput::ReadBinaryModelV3(CModel &model, std::istream &stream)
 {
-    // TODO...
+    ModelHeaderV3 header;
+    try
+    {
+        header.version = ReadBinary<4, int>(stream);
+        header.totalCrashSpheres = ReadBinary<4, int>(stream);
+        header.hasShadowSpot = ReadBinaryBool(stream);
+        header.hasCameraCollisionSphere = ReadBinaryBool(stream);
+        header.totalMeshes = ReadBinary<4, int>(stream);
+    }
+    catch (const std::exception& e)
+    {
+        throw CModelIOException(std::string("Error reading model header: ") + e.what());
+    }
+
+    try
+    {
+        for (int i = 0; i < header.totalCrashSpheres; ++i)
+        {
+            ModelCrashSphere crashSphere;
+            crashSphere.position.x = ReadBinaryFloat(stream);
+            crashSphere.position.y = ReadBinaryFloat(stream);
+            crashSphere.position.z = ReadBinaryFloat(stream);
+            crashSphere.radius = ReadBinaryFloat(stream);
+            crashSphere.sound = ReadBinaryString<1>(stream);
+            crashSphere.hardness = ReadBinaryFloat(stream);
+            model.AddCrashSphere(crashSphere);
+        }
+
+        if (header.hasShadowSpot)
+        {
+            ModelShadowSpot shadowSpot;
+            shadowSpot.radius = ReadBinaryFloat(stream);
+            shadowSpot.intensity = ReadBinaryFloat(stream);
+            model.SetShadowSpot(shadowSpot);
+        }
+
+        if (header.hasCameraCollisionSphere)
+        {
+            Math::Sphere sphere;
+            sphere.pos.x = ReadBinaryFloat(stream);
+            sphere.pos.y = ReadBinaryFloat(stream);
+            sphere.pos.z = ReadBinaryFloat(stream);
+            sphere.radius = ReadBinaryFloat(stream);
+            model.SetCameraCollisionSphere(sphere);
+        }
+
+        for (int i = 0; i < header.totalMeshes; ++i)
+        {
+            std::string meshName = ReadBinaryString<1>(stream);
+            CModelMesh mesh = ReadBinaryMeshV3(stream);
+            model.AddMesh(meshName, std::move(mesh));
+        }
+    }
+    catch (const CModelIOException& e)
+    {
+        throw;
+    }
+    catch (const std::exception& e)
+    {
+        throw CModelIOException(std::string("Error reading model data: ") + e.what());
+    }
+}
+
+CModelMesh ModelInput::ReadBinaryMeshV3(std::istream &stream)
+{
+    CModelMesh mesh;
+
+    ModelMeshHeaderV3 header;
+    header.parentName = ReadBinaryString<1>(stream);
+    header.position.x = ReadBinaryFloat(stream);
+    header.position.y = ReadBinaryFloat(stream);
+    header.position.z = ReadBinaryFloat(stream);
+    header.rotation.x = ReadBinaryFloat(stream);
+    header.rotation.y = ReadBinaryFloat(stream);
+    header.rotation.z = ReadBinaryFloat(stream);
+    header.scale.x = ReadBinaryFloat(stream);
+    header.scale.y = ReadBinaryFloat(stream);
+    header.scale.z = ReadBinaryFloat(stream);
+    header.totalTriangles = ReadBinary<4, int>(stream);
+
+    if (header.totalTriangles < 0)
+        throw CModelIOException("Invalid number of triangles");
+
+    mesh.SetParent(header.parentName);
+    mesh.SetPosition(header.position);
+    mesh.SetRotation(header.rotation);
+    mesh.SetScale(header.scale);
+
+    int totalTextures = ReadBinary<2, int>(stream);
+    std::vector<std::string> textures;
+    textures.reserve(totalTextures);
+    for (int i = 0; i < totalTextures; ++i)
+        textures.push_back(ReadBinaryString<1>(stream));
+
+    int count = header.totalTriangles;
+
+    std::vector<float> vertices(count * 30);
+    ReadBinaryFloats(vertices.data(), vertices.size(), stream);
+
+    std::vector<float> materials(count * 12);
+    ReadBinaryFloats(materials.data(), materials.size(), stream);
+
+    std::string attributes(count * 8, '\0');
+    stream.read(&attributes[0], attributes.size());
+
+    std::vector<ModelTriangle> triangles(count);
+    for (int i = 0; i < count; ++i)
+    {
+        ModelTriangle& triangle = triangles[i];
+
+        const float* v = &vertices[i * 30];
+        for (VertexTex2* p : { &triangle.p1, &triangle.p2, &triangle.p3 })
+        {
+            p->coord     = Math::Vector(v[0], v[1], v[2]);
+            p->normal    = Math::Vector(v[3], v[4], v[5]);
+            p->texCoord  = Math::Point(v[6], v[7]);
+            p->texCoord2 = Math::Point(v[8], v[9]);
+            v += 10;
+        }
+
+        const float* m = &materials[i * 12];
+        triangle.diffuse  = Color(m[0], m[1], m[2],  m[3]);
+        triangle.ambient  = Color(m[4], m[5], m[6],  m[7]);
+        triangle.specular = Color(m[8], m[9], m[10], m[11]);
+
+        const unsigned char* a = reinterpret_cast<const unsigned char*>(&attributes[i * 8]);
+        ModelBinaryTriangleAttributesV3 t;
+        t.tex1Index = a[0] | (a[1] << 8);
+        t.tex2Index = a[2] | (a[3] << 8);
+        t.flags = a[4];
+        t.transparentMode = a[5];
+        t.specialMark = a[6];
+
+        if (t.tex1Index >= totalTextures || t.tex2Index >= totalTextures)
+            throw CModelIOException("Invalid texture index");
+
+        if (t.transparentMode > static_cast<int>(ModelTransparentMode::MapWhiteToAlpha) ||
+            t.specialMark > static_cast<int>(ModelSpecialMark::Part3))
+            throw CModelIOException("Invalid triangle attributes");
+
+        triangle.tex1Name = textures[t.tex1Index];
+        triangle.tex2Name = textures[t.tex2Index];
+        triangle.variableTex2 = (t.flags & 1) != 0;
+        triangle.doubleSided = (t.flags & 2) != 0;
+        triangle.transparentMode = static_cast<ModelTransparentMode>(t.transparentMode);
+        triangle.specialMark = static_cast<ModelSpecialMark>(t.specialMark);
+    }
+
+    mesh.SetTriangles(std::move(triangles));
+
+    return mesh;
 }
 
 void ModelInput::ReadTextModel(CModel &model, std::istream &stream)
@@ -141,6 +141,30 @@ struct ModelMeshHeaderV3
     Math::Vector scale;
 };
 
+/**
+ * \struct ModelBinaryTriangleAttributesV3
+ * \brief Per-triangle attributes of mesh saved in new binary model file version 3
+ *
+ * Binary version 3 stores each mesh as its header, a table of texture names,
+ * and then three fixed-size blocks, each read at once:
+ *  - vertices of all triangles (3 x VertexTex2 as 10 floats each),
+ *  - materials of all triangles (diffuse, ambient, specular as 12 floats),
+ *  - attributes of all triangles (this struct, 8 bytes each).
+ */
+struct ModelBinaryTriangleAttributesV3
+{
+    //! Index of 1st texture in the table of texture names
+    int tex1Index = 0;
+    //! Index of 2nd texture in the table of texture names
+    int tex2Index = 0;
+    //! Flags: 1 = variable 2nd texture, 2 = double-sided
+    int flags = 0;
+    //! Transparent mode
+    int transparentMode = 0;
+    //! Special mark
+    int specialMark = 0;
+};
+
 /**
  * \struct ModelTriangleV3
  * \brief Mesh triangle saved in new model file version 3
@@ -19,12 +19,18 @@
 
 #include "graphics/model/model_manager.h"
 
+#include "common/ioutils.h"
 #include "common/logger.h"
 
 #include "common/resources/inputstream.h"
+#include "common/resources/outputstream.h"
+#include "common/resources/resourcemanager.h"
 
 #include "graphics/model/model_input.h"
 #include "graphics/model/model_io_exception.h"
+#include "graphics/model/model_output.h"
+
+#include <utility>
 
 namespace Gfx
 {
@@ -36,18 +42,91 @@ CModel& CModelManager::GetModel(const std::string& modelName)
         return it->second;
 
     std::string modelFile = "models-new/" + modelName + ".txt";
+    std::string cacheFile = "cache/models-new/" + modelName + ".bin";
+
+    long long modTime = CResourceManager::GetLastModificationTime(modelFile);
+    long long size = CResourceManager::GetFileSize(modelFile);
+
+    CModel model;
+    if (LoadCachedModel(cacheFile, modTime, size, model))
+    {
+        GetLogger()->Debug("Loading new model: %s (from %s)\n", modelFile.c_str(), cacheFile.c_str());
+    }
+    else
+    {
+        GetLogger()->Debug("Loading new model: %s\n", modelFile.c_str());
+
+        CInputStream stream;
+        stream.open(modelFile.c_str());
+        if (!stream.is_open())
+            throw CModelIOException(std::string("Could not open file '") + modelName + "'");
+
+        model = ModelInput::Read(stream, ModelFormat::Text);
+
+        SaveCachedModel(cacheFile, modTime, size, model);
+    }
+
+    m_models[modelName] = std::move(model);
+
+    return m_models[modelName];
+}
 
-    GetLogger()->Debug("Loading new model: %s\n", modelFile.c_str());
+bool CModelManager::LoadCachedModel(const std::string& cacheFile, long long modTime, long long size, CModel& model)
+{
+    if (modTime < 0 || size < 0 || !CResourceManager::Exists(cacheFile))
+        return false;
 
     CInputStream stream;
-    stream.open(modelFile.c_str());
+    stream.open(cacheFile);
     if (!stream.is_open())
-        throw CModelIOException(std::string("Could not open file '") + modelName + "'");
+        return false;
 
-    CModel model = ModelInput::Read(stream, ModelFormat::Text);
-    m_models[modelName] = model;
+    try
+    {
+        stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        if (IOUtils::ReadBinary<8, long long>(stream) != modTime ||
+            IOUtils::ReadBinary<8, long long>(stream) != size)
+            return false;
 
-    return m_models[modelName];
+        model = ModelInput::Read(stream, ModelFormat::Binary);
+    }
+    catch (const std::exception& e)
+    {
+        GetLogger()->Warn("Ignoring invalid model cache file '%s': %s\n", cacheFile.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
+void CModelManager::SaveCachedModel(const std::string& cacheFile, long long modTime, long long size, const CModel& model)
+{
+    if (modTime < 0 || size < 0)
+        return;
+
+    CResourceManager::CreateDirectory(cacheFile.substr(0, cacheFile.rfind('/')));
+
+    COutputStream stream;
+    stream.open(cacheFile);
+    if (!stream.is_open())
+    {
+        GetLogger()->Warn("Could not create model cache file '%s'\n", cacheFile.c_str());
+        return;
+    }
+
+    try
+    {
+        stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        IOUtils::WriteBinary<8, long long>(modTime, stream);
+        IOUtils::WriteBinary<8, long long>(size, stream);
+        ModelOutput::Write(model, stream, ModelFormat::Binary);
+    }
+    catch (const std::exception& e)
+    {
+        GetLogger()->Warn("Error writing model cache file '%s': %s\n", cacheFile.c_str(), e.what());
+        stream.close();
+        CResourceManager::Remove(cacheFile);
+    }
 }
 
 void CModelManager::ClearCache()
@@ -30,6 +30,11 @@ namespace Gfx
 /**
  * \class CModelManager
  * \brief Manager for models read from model files
+ *
+ * Text models are converted on first load to the binary format, which is
+ * much faster to read, and saved in "cache/models-new" in the save directory.
+ * The cached file is used as long as the size and modification time
+ * of the text model don't change.
  */
 class CModelManager
 {
@@ -41,6 +46,12 @@ public:
     //! Clears cached models
     void ClearCache();
 
+private:
+    //! Reads model from binary cache file if it was created from text model of given \a modTime and \a size
+    bool LoadCachedModel(const std::string& cacheFile, long long modTime, long long size, CModel& model);
+    //! Writes binary cache file of model read from text model of given \a modTime and \a size
+    void SaveCachedModel(const std::string& cacheFile, long long modTime, long long size, const CModel& model);
+
 private:
     std::unordered_map<std::string, CModel> m_models;
 };
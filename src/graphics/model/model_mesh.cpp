@@ -19,6 +19,8 @@
 
 #include "graphics/model/model_mesh.h"
 
+#include <utility>
+
 namespace Gfx
 {
 
@@ -29,7 +31,7 @@ void CModelMesh::AddTriangle(const ModelTriangle& triangle)
 
 void CModelMesh::SetTriangles(std::vector<ModelTriangle>&& triangles)
 {
-    m_triangles = triangles;
+    m_triangles = std::move(triangles);
 }
 
 const std::vector<ModelTriangle>& CModelMesh::GetTriangles() const
@@ -26,6 +26,8 @@
 #include "graphics/model/model_io_structs.h"
 
 #include <fstream>
+#include <map>
+#include <vector>
 
 namespace Gfx
 {
@@ -44,6 +46,7 @@ namespace ModelOutput
     std::string SpecialMarkToString(ModelSpecialMark specialMark);
 
     void WriteBinaryModel(const CModel& model, std::ostream &stream);
+    void WriteBinaryMesh(const CModelMesh* mesh, const std::string& meshName, std::ostream &stream);
 
     void WriteOldModel(const CModel& model, std::ostream &stream);
 
@@ -260,42 +263,140 @@ std::string ModelOutput::SpecialMarkToString(ModelSpecialMark specialMark)
 
 void ModelOutput::WriteBinaryModel(const CModel& model, std::ostream &stream)
 {
-    const CModelMesh* mesh = model.GetMesh("main");
-    if (mesh == nullptr)
-        throw CModelIOException("No main mesh found in model");
+    ModelHeaderV3 header;
+    header.version = 3;
+    header.totalCrashSpheres = model.GetCrashSphereCount();
+    header.hasShadowSpot = model.HasShadowSpot();
+    header.hasCameraCollisionSphere = model.HasCameraCollisionSphere();
+    header.totalMeshes = model.GetMeshCount();
 
-    ModelHeaderV1AndV2 header;
+    WriteBinary<4, int>(header.version, stream);
+    WriteBinary<4, int>(header.totalCrashSpheres, stream);
+    WriteBinaryBool(header.hasShadowSpot, stream);
+    WriteBinaryBool(header.hasCameraCollisionSphere, stream);
+    WriteBinary<4, int>(header.totalMeshes, stream);
 
-    header.version = 2;
-    header.totalTriangles = mesh->GetTriangleCount();
+    for (const auto& crashSphere : model.GetCrashSpheres())
+    {
+        WriteBinaryFloat(crashSphere.position.x, stream);
+        WriteBinaryFloat(crashSphere.position.y, stream);
+        WriteBinaryFloat(crashSphere.position.z, stream);
+        WriteBinaryFloat(crashSphere.radius, stream);
+        WriteBinaryString<1>(crashSphere.sound, stream);
+        WriteBinaryFloat(crashSphere.hardness, stream);
+    }
 
-    WriteBinary<4, int>(header.version, stream);
-    WriteBinary<4, int>(header.totalTriangles, stream);
+    if (model.HasShadowSpot())
+    {
+        WriteBinaryFloat(model.GetShadowSpot().radius, stream);
+        WriteBinaryFloat(model.GetShadowSpot().intensity, stream);
+    }
 
-    for (const ModelTriangle& triangle : mesh->GetTriangles())
+    if (model.HasCameraCollisionSphere())
     {
-        ModelTriangleV1AndV2 t;
+        const Math::Sphere& sphere = model.GetCameraCollisionSphere();
+        WriteBinaryFloat(sphere.pos.x, stream);
+        WriteBinaryFloat(sphere.pos.y, stream);
+        WriteBinaryFloat(sphere.pos.z, stream);
+        WriteBinaryFloat(sphere.radius, stream);
+    }
 
-        t.p1 = triangle.p1;
-        t.p2 = triangle.p2;
-        t.p3 = triangle.p3;
-        t.material.ambient = triangle.ambient;
-        t.material.diffuse = triangle.diffuse;
-        t.material.specular = triangle.specular;
-        t.tex1Name = triangle.tex1Name;
-        t.tex2Name = triangle.tex2Name;
-        t.variableTex2 = triangle.variableTex2;
-        t.state = ConvertToOldState(triangle);
+    for (const std::string& meshName : model.GetMeshNames())
+    {
+        const CModelMesh* mesh = model.GetMesh(meshName);
+        assert(mesh != nullptr);
+        WriteBinaryMesh(mesh, meshName, stream);
+    }
+}
 
-        WriteBinaryVertexTex2(t.p1, stream);
-        WriteBinaryVertexTex2(t.p2, stream);
-        WriteBinaryVertexTex2(t.p3, stream);
-        WriteBinaryMaterial(t.material, stream);
-        WriteBinaryString<1>(t.tex1Name, stream);
-        WriteBinaryString<1>(t.tex2Name, stream);
-        WriteBinaryBool(t.variableTex2, stream);
-        WriteBinary<4, int>(t.state, stream);
+void ModelOutput::WriteBinaryMesh(const CModelMesh* mesh, const std::string& meshName, std::ostream &stream)
+{
+    const std::vector<ModelTriangle>& triangles = mesh->GetTriangles();
+    int count = triangles.size();
+
+    std::vector<std::string> textures;
+    std::map<std::string, int> textureIndexes;
+    std::vector<ModelBinaryTriangleAttributesV3> attributes(count);
+
+    auto getTextureIndex = [&](const std::string& name)
+    {
+        auto it = textureIndexes.find(name);
+        if (it != textureIndexes.end())
+            return it->second;
+
+        if (name.size() > 255)
+            throw CModelIOException("Texture name too long: " + name);
+        if (textures.size() >= 0xFFFF)
+            throw CModelIOException("Too many textures in mesh " + meshName);
+
+        int index = textures.size();
+        textures.push_back(name);
+        textureIndexes[name] = index;
+        return index;
+    };
+
+    std::vector<float> vertices;
+    vertices.reserve(count * 30);
+    std::vector<float> materials;
+    materials.reserve(count * 12);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const ModelTriangle& triangle = triangles[i];
+
+        for (const VertexTex2* p : { &triangle.p1, &triangle.p2, &triangle.p3 })
+        {
+            vertices.insert(vertices.end(), {
+                p->coord.x, p->coord.y, p->coord.z,
+                p->normal.x, p->normal.y, p->normal.z,
+                p->texCoord.x, p->texCoord.y,
+                p->texCoord2.x, p->texCoord2.y });
+        }
+
+        for (const Color* c : { &triangle.diffuse, &triangle.ambient, &triangle.specular })
+            materials.insert(materials.end(), { c->r, c->g, c->b, c->a });
+
+        ModelBinaryTriangleAttributesV3& t = attributes[i];
+        t.tex1Index = getTextureIndex(triangle.tex1Name);
+        t.tex2Index = getTextureIndex(triangle.tex2Name);
+        t.flags = (triangle.variableTex2 ? 1 : 0) | (triangle.doubleSided ? 2 : 0);
+        t.transparentMode = static_cast<int>(triangle.transparentMode);
+        t.specialMark = static_cast<int>(triangle.specialMark);
+    }
+
+    WriteBinaryString<1>(meshName, stream);
+    WriteBinaryString<1>(mesh->GetParent(), stream);
+    WriteBinaryFloat(mesh->GetPosition().x, stream);
+    WriteBinaryFloat(mesh->GetPosition().y, stream);
+    WriteBinaryFloat(mesh->GetPosition().z, stream);
+    WriteBinaryFloat(mesh->GetRotation().x, stream);
+    WriteBinaryFloat(mesh->GetRotation().y, stream);
+    WriteBinaryFloat(mesh->GetRotation().z, stream);
+    WriteBinaryFloat(mesh->GetScale().x, stream);
+    WriteBinaryFloat(mesh->GetScale().y, stream);
+    WriteBinaryFloat(mesh->GetScale().z, stream);
+    WriteBinary<4, int>(count, stream);
+
+    WriteBinary<2, int>(textures.size(), stream);
+    for (const std::string& texture : textures)
+        WriteBinaryString<1>(texture, stream);
+
+    WriteBinaryFloats(vertices.data(), vertices.size(), stream);
+    WriteBinaryFloats(materials.data(), materials.size(), stream);
+
+    std::string bytes(count * 8, '\0');
+    for (int i = 0; i < count; ++i)
+    {
+        const ModelBinaryTriangleAttributesV3& t = attributes[i];
+        bytes[i*8 + 0] = static_cast<char>(t.tex1Index & 0xFF);
+        bytes[i*8 + 1] = static_cast<char>((t.tex1Index >> 8) & 0xFF);
+        bytes[i*8 + 2] = static_cast<char>(t.tex2Index & 0xFF);
+        bytes[i*8 + 3] = static_cast<char>((t.tex2Index >> 8) & 0xFF);
+        bytes[i*8 + 4] = static_cast<char>(t.flags);
+        bytes[i*8 + 5] = static_cast<char>(t.transparentMode);
+        bytes[i*8 + 6] = static_cast<char>(t.specialMark);
     }
+    stream.write(bytes.data(), bytes.size());
 }
 
 void ModelOutput::WriteOldModel(const CModel& model, std::ostream &stream)
@@ -297,6 +297,19 @@ void CGLFramebuffer::CopyToScreen(int fromX, int fromY, int fromWidth, int fromH
     glBindFramebuffer(GL_FRAMEBUFFER, m_currentFBO);
 }
 
+void CGLFramebuffer::CopyDepthTo(CFramebuffer* target)
+{
+    GLuint targetFBO = target->IsDefault() ? 0 : static_cast<CGLFramebuffer*>(target)->m_fbo;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFBO);
+
+    glBlitFramebuffer(0, 0, m_width, m_height,
+        0, 0, target->GetWidth(), target->GetHeight(), GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_currentFBO);
+}
+
 // CGLFramebufferEXT
 GLuint CGLFramebufferEXT::m_currentFBO = 0;
 
@@ -572,4 +585,17 @@ void CGLFramebufferEXT::CopyToScreen(int fromX, int fromY, int fromWidth, int fr
     glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, m_currentFBO);
 }
 
+void CGLFramebufferEXT::CopyDepthTo(CFramebuffer* target)
+{
+    GLuint targetFBO = target->IsDefault() ? 0 : static_cast<CGLFramebufferEXT*>(target)->m_fbo;
+
+    glBindFramebufferEXT(GL_READ_FRAMEBUFFER_EXT, m_fbo);
+    glBindFramebufferEXT(GL_DRAW_FRAMEBUFFER_EXT, targetFBO);
+
+    glBlitFramebufferEXT(0, 0, m_width, m_height,
+        0, 0, target->GetWidth(), target->GetHeight(), GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, m_currentFBO);
+}
+
 } // end of Gfx
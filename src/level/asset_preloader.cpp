@@ -0,0 +1,220 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "level/asset_preloader.h"
+
+#include "common/logger.h"
+#include "common/stringutils.h"
+
+#include "common/system/system.h"
+
+#include "common/resources/inputstream.h"
+#include "common/resources/outputstream.h"
+#include "common/resources/resourcemanager.h"
+
+#include "graphics/engine/oldmodelmanager.h"
+
+#include "level/parser/parser.h"
+#include "level/parser/parserexceptions.h"
+#include "level/parser/parsernames.h"
+
+#include "object/object_factory.h"
+
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+
+//! File with models used by object types, one type per line followed by its model files
+const char* const OBJECT_MODELS_FILE = "cache/object_models.txt";
+
+} // anonymous namespace
+
+
+CAssetPreloader::CAssetPreloader(Gfx::COldModelManager* modelManager, CSystemUtils* systemUtils)
+    : m_modelManager(modelManager),
+      m_systemUtils(systemUtils)
+{
+    m_phaseStart = m_systemUtils->CreateTimeStamp();
+    m_phaseEnd = m_systemUtils->CreateTimeStamp();
+}
+
+CAssetPreloader::~CAssetPreloader()
+{
+    m_systemUtils->DestroyTimeStamp(m_phaseStart);
+    m_systemUtils->DestroyTimeStamp(m_phaseEnd);
+}
+
+void CAssetPreloader::Start()
+{
+    m_phases.clear();
+    m_systemUtils->GetCurrentTimeStamp(m_phaseStart);
+}
+
+void CAssetPreloader::EndPhase(const std::string& name)
+{
+    m_systemUtils->GetCurrentTimeStamp(m_phaseEnd);
+    m_phases.push_back({ name, m_systemUtils->TimeStampDiff(m_phaseStart, m_phaseEnd, STU_SEC) });
+    m_systemUtils->CopyTimeStamp(m_phaseStart, m_phaseEnd);
+}
+
+int CAssetPreloader::Preload(CLevelParser& level)
+{
+    LoadTable();
+
+    std::set<ObjectType> types;
+    for (auto& line : level.GetLines())
+    {
+        const std::string& command = line->GetCommand();
+        if (command != "CreateObject" && command != "CreatePower" && command != "CreateFret")
+            continue;
+
+        try
+        {
+            types.insert(line->GetParam("type")->AsObjectType(OBJECT_NULL));
+        }
+        catch (const CLevelParserException&)
+        {
+            // Reported when the object is created
+        }
+    }
+
+    std::set<std::string> models;
+    for (ObjectType type : types)
+    {
+        std::vector<std::string> fixed = CObjectFactory::GetFixedModels(type);
+        models.insert(fixed.begin(), fixed.end());
+
+        auto it = m_objectModels.find(type);
+        if (it != m_objectModels.end())
+            models.insert(it->second.begin(), it->second.end());
+    }
+
+    std::vector<std::string> files;
+    for (const std::string& file : models)
+    {
+        if (CResourceManager::Exists("models/" + file))  // the table may come from other mods
+            files.push_back(file);
+    }
+
+    int count = m_modelManager->PreloadModels(files);
+    if (count > 0)
+        GetLogger()->Debug("Preloaded %d models on %d threads\n", count, m_modelManager->GetPreloadThreadCount());
+    return count;
+}
+
+void CAssetPreloader::BeginObject(ObjectType type)
+{
+    m_currentType = type;
+    m_modelManager->BeginRecordUsedFiles();
+}
+
+void CAssetPreloader::EndObject()
+{
+    std::vector<std::string> files = m_modelManager->EndRecordUsedFiles();
+    if (m_currentType == OBJECT_NULL) return;
+
+    std::set<std::string>& known = m_objectModels[m_currentType];
+    for (const std::string& file : files)
+    {
+        if (known.insert(file).second)
+            m_tableChanged = true;
+    }
+    m_currentType = OBJECT_NULL;
+}
+
+void CAssetPreloader::Finish()
+{
+    // An object may have failed to load in the middle of recording
+    m_modelManager->EndRecordUsedFiles();
+    m_currentType = OBJECT_NULL;
+
+    m_modelManager->ClearPreloadedModels();
+
+    if (m_tableChanged)
+        SaveTable();
+}
+
+void CAssetPreloader::LogPhases()
+{
+    float total = 0.0f;
+    std::string details;
+    for (const auto& phase : m_phases)
+    {
+        total += phase.second;
+        details += StrUtils::Format(", %s %.3f s", phase.first.c_str(), phase.second);
+    }
+    GetLogger()->Info("Level loaded in %.3f s%s\n", total, details.c_str());
+}
+
+void CAssetPreloader::LoadTable()
+{
+    if (m_tableLoaded) return;
+    m_tableLoaded = true;
+
+    if (!CResourceManager::Exists(OBJECT_MODELS_FILE))
+        return;
+
+    CInputStream stream;
+    stream.open(OBJECT_MODELS_FILE);
+    if (!stream.is_open())
+        return;
+
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        std::istringstream words(line);
+        std::string name;
+        ObjectType type = OBJECT_NULL;
+        if (!(words >> name) || !GetObjectTypeNames().GetValue(name, type))
+            continue;
+
+        std::string file;
+        while (words >> file)
+            m_objectModels[type].insert(file);
+    }
+}
+
+void CAssetPreloader::SaveTable()
+{
+    CResourceManager::CreateDirectory("cache");
+
+    COutputStream stream;
+    stream.open(OBJECT_MODELS_FILE);
+    if (!stream.is_open())
+    {
+        GetLogger()->Warn("Could not write '%s'\n", OBJECT_MODELS_FILE);
+        return;
+    }
+
+    for (const auto& objectModels : m_objectModels)
+    {
+        const char* name = GetObjectTypeNames().GetName(objectModels.first);
+        if (name == nullptr || objectModels.second.empty()) continue;
+
+        stream << name;
+        for (const std::string& file : objectModels.second)
+            stream << " " << file;
+        stream << "\n";
+    }
+
+    m_tableChanged = false;
+}
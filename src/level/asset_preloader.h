@@ -0,0 +1,98 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file level/asset_preloader.h
+ * \brief Reading of assets needed by a level before its objects are created - CAssetPreloader class
+ */
+
+#pragma once
+
+#include "object/object_type.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+class CLevelParser;
+class CSystemUtils;
+struct SystemTimeStamp;
+
+namespace Gfx
+{
+class COldModelManager;
+} // namespace Gfx
+
+/**
+ * \class CAssetPreloader
+ * \brief Reads models of objects of a level on worker threads before the objects are created
+ *
+ * Models which depend only on the object type are given by CObjectFactory::GetFixedModels().
+ * Models of other objects depend on the code creating them, so they are learned:
+ * models added while an object is created are recorded for its type
+ * and kept in a file in the cache directory for later games.
+ * Objects of types not seen yet load their models as they are created.
+ *
+ * Textures of a level are decoded in parallel by CEngine::EndTextureBatch()
+ * and sounds are cached when the game starts, so only models are handled here.
+ *
+ * The preloader also measures phases of loading a level, see LogPhases().
+ */
+class CAssetPreloader
+{
+public:
+    CAssetPreloader(Gfx::COldModelManager* modelManager, CSystemUtils* systemUtils);
+    ~CAssetPreloader();
+
+    //! Starts measuring the time of loading a level
+    void        Start();
+    //! Ends a phase of loading started by Start() or the previous phase
+    void        EndPhase(const std::string& name);
+
+    //! Reads models of objects created by given level, returns the number of models read
+    int         Preload(CLevelParser& level);
+    //! Starts recording models of an object of given type
+    void        BeginObject(ObjectType type);
+    //! Stops recording started by BeginObject()
+    void        EndObject();
+    //! Frees models which weren't used and saves models of object types learned since Preload()
+    void        Finish();
+    //! Logs the time of phases since Start()
+    void        LogPhases();
+
+protected:
+    void        LoadTable();
+    void        SaveTable();
+
+protected:
+    Gfx::COldModelManager* m_modelManager;
+    CSystemUtils* m_systemUtils;
+    SystemTimeStamp* m_phaseStart;
+    SystemTimeStamp* m_phaseEnd;
+    //! Phases of loading with their time in seconds
+    std::vector<std::pair<std::string, float>> m_phases;
+    //! Model files used by each object type
+    std::map<ObjectType, std::set<std::string>> m_objectModels;
+    ObjectType  m_currentType = OBJECT_NULL;
+    bool        m_tableLoaded = false;
+    bool        m_tableChanged = false;
+};
@@ -21,6 +21,9 @@
 
 #include "app/app.h"
 
+#include "common/compression.h"
+#include "common/ioutils.h"
+#include "common/logger.h"
 #include "common/make_unique.h"
 #include "common/stringutils.h"
 
@@ -31,17 +34,48 @@
 #include "level/robotmain.h"
 
 #include "level/parser/parserexceptions.h"
+#include "level/parser/parserlexer.h"
 
+#include <algorithm>
 #include <string>
 #include <exception>
 #include <sstream>
 #include <iomanip>
+#include <map>
 #include <set>
+#include <vector>
 
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/replace.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
+
+namespace
+{
+
+//! Magic of binary level files, text files never start with a zero byte
+const char BINARY_MAGIC[] = "\0CLB";
+
+void WriteVarInt(std::size_t value, std::string& data)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<char>(value));
+}
+
+bool ReadVarInt(const std::string& data, std::size_t& pos, std::size_t& value)
+{
+    value = 0;
+    for (int shift = 0; pos < data.size() && shift < 35; shift += 7)
+    {
+        unsigned char byte = data[pos++];
+        value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+} // anonymous namespace
 
 CLevelParser::CLevelParser()
 {
@@ -50,6 +84,8 @@ CLevelParser::CLevelParser()
     m_pathCat  = "";
     m_pathChap = "";
     m_pathLvl  = "";
+
+    m_useCache = false;
 }
 
 CLevelParser::CLevelParser(std::string filename)
@@ -156,59 +192,138 @@ bool CLevelParser::Exists()
 
 void CLevelParser::Load()
 {
+    if (m_useCache && LoadCache())
+        return;
+
     CInputStream file;
     file.open(m_filename);
     if (!file.is_open())
         throw CLevelParserException("Failed to open file: " + m_filename);
 
-    char lang = CApplication::GetInstancePointer()->GetLanguageChar();
+    // Read the whole file at once, parsing it from memory is much faster
+    std::string data(file.size(), '\0');
+    file.read(&data[0], data.size());
+    data.resize(file.gcount());
+    file.close();
 
-    std::string line;
-    int lineNumber = 0;
-    std::set<std::string> translatableLines;
-    while (getline(file, line))
+    if (Compression::IsPacked(data, BINARY_MAGIC))
+    {
+        LoadBinary(data);
+    }
+    else
     {
-        lineNumber++;
+        LoadText(data);
+        if (m_useCache)
+            SaveCache();
+    }
+}
 
-        boost::replace_all(line, "\t", " "); // replace tab by space
+std::string CLevelParser::GetCacheFilename()
+{
+    return "cache/" + m_filename + "." + CApplication::GetInstancePointer()->GetLanguageChar() + ".bin";
+}
 
-        // ignore comments
-        size_t pos = 0;
-        std::string linesuffix = line;
-        boost::regex commentRegex{ R"(("[^"]*")|('[^']*')|(//.*$))" };
-        boost::smatch matches;
-        while (boost::regex_search(linesuffix, matches, commentRegex))
-        {
-            if (matches[3].matched)
-            {
-                pos += std::distance(linesuffix.cbegin(), matches.prefix().second);
-                line = line.substr(0, pos);
-                linesuffix = "";
-            }
-            else
-            {
-                pos += std::distance(linesuffix.cbegin(), matches.suffix().first);
-                linesuffix = matches.suffix().str();
-            }
-        }
+/*
+ * Cache file has a list of files the level was made of (the level itself and included files),
+ * with their modification times and sizes, followed by the level in binary format.
+ */
+bool CLevelParser::LoadCache()
+{
+    std::string cacheFile = GetCacheFilename();
+    if (!CResourceManager::Exists(cacheFile))
+        return false;
+
+    CInputStream stream;
+    stream.open(cacheFile);
+    if (!stream.is_open())
+        return false;
 
-        boost::algorithm::trim(line);
+    try
+    {
+        stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
 
-        pos = line.find_first_of(" \t\n");
-        std::string command = line.substr(0, pos);
-        if (pos != std::string::npos)
+        int count = IOUtils::ReadBinary<2, int>(stream);
+        for (int i = 0; i < count; i++)
         {
-            line = line.substr(pos + 1);
-            boost::algorithm::trim(line);
+            std::string filename = IOUtils::ReadBinaryString<2>(stream);
+            long long modTime = IOUtils::ReadBinary<8, long long>(stream);
+            long long size = IOUtils::ReadBinary<8, long long>(stream);
+            if (CResourceManager::GetLastModificationTime(filename) != modTime ||
+                CResourceManager::GetFileSize(filename) != size)
+                return false;
+            if (i > 0)
+                m_includes.push_back(filename);
         }
-        else
+
+        std::size_t headerSize = static_cast<std::size_t>(stream.tellg());
+        std::string data(stream.size() - headerSize, '\0');
+        stream.read(&data[0], data.size());
+        LoadBinary(data);
+    }
+    catch (const std::exception& e)
+    {
+        GetLogger()->Warn("Ignoring invalid level cache file '%s': %s\n", cacheFile.c_str(), e.what());
+        m_lines.clear();
+        m_includes.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void CLevelParser::SaveCache()
+{
+    std::vector<std::string> files = { m_filename };
+    files.insert(files.end(), m_includes.begin(), m_includes.end());
+    for (const std::string& filename : files)
+    {
+        if (CResourceManager::GetLastModificationTime(filename) < 0 || CResourceManager::GetFileSize(filename) < 0)
+            return;
+    }
+
+    std::string cacheFile = GetCacheFilename();
+    CResourceManager::CreateDirectory(cacheFile.substr(0, cacheFile.rfind('/')));
+
+    COutputStream stream;
+    stream.open(cacheFile);
+    if (!stream.is_open())
+    {
+        GetLogger()->Warn("Could not create level cache file '%s'\n", cacheFile.c_str());
+        return;
+    }
+
+    try
+    {
+        stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        IOUtils::WriteBinary<2, int>(files.size(), stream);
+        for (const std::string& filename : files)
         {
-            line = "";
+            IOUtils::WriteBinaryString<2>(filename, stream);
+            IOUtils::WriteBinary<8, long long>(CResourceManager::GetLastModificationTime(filename), stream);
+            IOUtils::WriteBinary<8, long long>(CResourceManager::GetFileSize(filename), stream);
         }
 
-        if (command.empty())
-            continue;
+        std::string data = SaveBinary();
+        stream.write(data.data(), data.size());
+    }
+    catch (const std::exception& e)
+    {
+        GetLogger()->Warn("Error writing level cache file '%s': %s\n", cacheFile.c_str(), e.what());
+        stream.close();
+        CResourceManager::Remove(cacheFile);
+    }
+}
 
+void CLevelParser::LoadText(const std::string& data)
+{
+    CLevelParserLexer lexer(data, m_filename);
+    std::string command;
+    std::string paramName;
+    std::string paramValue;
+    std::set<std::string> translatableLines;
+    while (lexer.NextLine(command))
+    {
+        int lineNumber = lexer.GetLineNumber();
         auto parserLine = MakeUnique<CLevelParserLine>(lineNumber, command);
         parserLine->SetLevel(this);
 
@@ -222,7 +337,7 @@ void CLevelParser::Load()
             {
                 translatableLines.insert(baseCommand);
             }
-            else if (languageChar == lang)
+            else if (languageChar == CApplication::GetInstancePointer()->GetLanguageChar())
             {
                 if (translatableLines.count(baseCommand) > 0)
                 {
@@ -244,49 +359,9 @@ void CLevelParser::Load()
             }
         }
 
-        while (!line.empty())
+        while (lexer.NextParam(paramName, paramValue))
         {
-            pos = line.find_first_of("=");
-            std::string paramName = line.substr(0, pos);
-            boost::algorithm::trim(paramName);
-            line = line.substr(pos + 1);
-            boost::algorithm::trim(line);
-
-            if (line[0] == '\"')
-            {
-                pos = line.find_first_of("\"", 1);
-                if (pos == std::string::npos)
-                    throw CLevelParserException("Unclosed \" in " + m_filename + ":" + boost::lexical_cast<std::string>(lineNumber));
-            }
-            else if (line[0] == '\'')
-            {
-                pos = line.find_first_of("'", 1);
-                if (pos == std::string::npos)
-                    throw CLevelParserException("Unclosed ' in " + m_filename + ":" + boost::lexical_cast<std::string>(lineNumber));
-            }
-            else
-            {
-                pos = line.find_first_of("=");
-                if (pos != std::string::npos)
-                {
-                    std::size_t pos2 = line.find_last_of(" \t\n", line.find_last_not_of(" \t\n", pos-1));
-                    if (pos2 != std::string::npos)
-                        pos = pos2;
-                }
-                else
-                {
-                    pos = line.length()-1;
-                }
-            }
-            std::string paramValue = line.substr(0, pos + 1);
-            boost::algorithm::trim(paramValue);
-
             parserLine->AddParam(paramName, MakeUnique<CLevelParserParam>(paramName, paramValue));
-
-            if (pos == std::string::npos)
-                break;
-            line = line.substr(pos + 1);
-            boost::algorithm::trim(line);
         }
 
         if (parserLine->GetCommand().length() > 1 && parserLine->GetCommand()[0] == '#')
@@ -296,6 +371,8 @@ void CLevelParser::Load()
             {
                 std::unique_ptr<CLevelParser> includeParser = MakeUnique<CLevelParser>(parserLine->GetParam("file")->AsPath(""));
                 includeParser->Load();
+                m_includes.push_back(includeParser->m_filename);
+                m_includes.insert(m_includes.end(), includeParser->m_includes.begin(), includeParser->m_includes.end());
                 for(CLevelParserLineUPtr& line : includeParser->m_lines)
                 {
                     AddLine(std::move(line));
@@ -311,20 +388,141 @@ void CLevelParser::Load()
             AddLine(std::move(parserLine));
         }
     }
+}
 
-    file.close();
+/*
+ * Binary format, stored with Compression::Pack():
+ *  - number of strings, then strings: length and characters
+ *  - number of lines, then lines: line number, source file, command,
+ *    number of params, then name and value of each param
+ * Numbers are variable length integers (7 bits per byte), and source files, commands,
+ * names and values are indexes into the table of strings. Source file is empty
+ * for lines of the file itself and the name of included file for other lines.
+ */
+void CLevelParser::LoadBinary(const std::string& packed)
+{
+    std::string data;
+    if (!Compression::Unpack(packed, BINARY_MAGIC, data))
+        throw CLevelParserException("Corrupted binary level file: " + m_filename);
+
+    auto corrupted = [this]() { return CLevelParserException("Corrupted binary level file: " + m_filename); };
+
+    std::size_t pos = 0;
+    std::size_t count = 0;
+    if (!ReadVarInt(data, pos, count) || count > data.size())
+        throw corrupted();
+
+    std::vector<std::string> strings(count);
+    for (std::string& string : strings)
+    {
+        std::size_t length = 0;
+        if (!ReadVarInt(data, pos, length) || length > data.size() - pos)
+            throw corrupted();
+        string = data.substr(pos, length);
+        pos += length;
+    }
+
+    auto readString = [&]() -> const std::string&
+    {
+        std::size_t index = 0;
+        if (!ReadVarInt(data, pos, index) || index >= strings.size())
+            throw corrupted();
+        return strings[index];
+    };
+
+    std::size_t lineCount = 0;
+    if (!ReadVarInt(data, pos, lineCount) || lineCount > data.size())
+        throw corrupted();
+
+    m_lines.reserve(m_lines.size() + lineCount);
+    for (std::size_t i = 0; i < lineCount; i++)
+    {
+        std::size_t lineNumber = 0;
+        if (!ReadVarInt(data, pos, lineNumber))
+            throw corrupted();
+        const std::string& source = readString();
+        auto line = MakeUnique<CLevelParserLine>(lineNumber, readString());
+        if (!source.empty())
+            line->SetLevelFilename(source);
+
+        std::size_t paramCount = 0;
+        if (!ReadVarInt(data, pos, paramCount))
+            throw corrupted();
+        for (std::size_t j = 0; j < paramCount; j++)
+        {
+            const std::string& name = readString();
+            const std::string& value = readString();
+            line->AddParam(name, MakeUnique<CLevelParserParam>(name, value));
+        }
+
+        AddLine(std::move(line));
+    }
 }
 
-void CLevelParser::Save()
+std::string CLevelParser::SaveBinary()
+{
+    std::vector<const std::string*> strings;
+    std::map<std::string, std::size_t> stringIndex;
+    std::string records;
+
+    auto writeString = [&](const std::string& string)
+    {
+        auto it = stringIndex.find(string);
+        if (it == stringIndex.end())
+        {
+            it = stringIndex.insert(std::make_pair(string, strings.size())).first;
+            strings.push_back(&it->first);
+        }
+        WriteVarInt(it->second, records);
+    };
+
+    WriteVarInt(m_lines.size(), records);
+    for (auto& line : m_lines)
+    {
+        WriteVarInt(line->GetLineNumber(), records);
+        const std::string& source = line->GetLevelFilename();
+        writeString(source != m_filename ? source : "");
+        writeString(line->GetCommand());
+
+        const auto& params = line->GetParams();
+        WriteVarInt(params.size(), records);
+        for (const auto& param : params)
+        {
+            writeString(param.first);
+            writeString(param.second->GetValue());
+        }
+    }
+
+    std::string data;
+    WriteVarInt(strings.size(), data);
+    for (const std::string* string : strings)
+    {
+        WriteVarInt(string->size(), data);
+        data += *string;
+    }
+    data += records;
+
+    return Compression::Pack(data, BINARY_MAGIC);
+}
+
+void CLevelParser::Save(bool binary)
 {
     COutputStream file;
     file.open(m_filename);
     if (!file.is_open())
         throw CLevelParserException("Failed to open file: " + m_filename);
 
-    for (auto& line : m_lines)
+    if (binary)
+    {
+        std::string data = SaveBinary();
+        file.write(data.data(), data.size());
+    }
+    else
     {
-        file << *(line.get()) << "\n";
+        for (auto& line : m_lines)
+        {
+            file << *(line.get()) << "\n";
+        }
     }
 
     file.close();
@@ -362,6 +560,11 @@ std::string CLevelParser::InjectLevelPaths(const std::string& path, const std::s
     return langPath; // Return current language file if none of the files exist
 }
 
+void CLevelParser::SetUseCache(bool useCache)
+{
+    m_useCache = useCache;
+}
+
 const std::string& CLevelParser::GetFilename()
 {
     return m_filename;
@@ -63,10 +63,18 @@ public:
 
     //! Check if level file exists
     bool Exists();
-    //! Load file
+    //! Load file, in text or binary format
     void Load();
-    //! Save file
-    void Save();
+    //! Save file, in the compressed binary format if \a binary is true
+    void Save(bool binary = false);
+
+    /**
+     * \brief Enable binary cache of the parsed file
+     *
+     * The cache keeps lines after processing includes and translations,
+     * and is used while the file and its included files don't change.
+     */
+    void SetUseCache(bool useCache);
 
     //! Configure level paths for the given level
     void SetLevelPaths(LevelCategory category, int chapter = 0, int rank = 0);
@@ -94,6 +102,22 @@ public:
     //! Count lines with given command
     int CountLines(const std::string& command);
 
+protected:
+    //! Parse level in text format
+    void LoadText(const std::string& data);
+    //! Read level in binary format
+    void LoadBinary(const std::string& data);
+    //! Write level in binary format
+    std::string SaveBinary();
+
+private:
+    //! Returns name of the cache file for the current language
+    std::string GetCacheFilename();
+    //! Load the level from cache, returns false if it isn't cached or the cache is out of date
+    bool LoadCache();
+    //! Save the level to cache
+    void SaveCache();
+
 private:
     std::string m_filename;
     std::vector<CLevelParserLineUPtr> m_lines;
@@ -101,6 +125,10 @@ private:
     std::string m_pathCat;
     std::string m_pathChap;
     std::string m_pathLvl;
+
+    bool m_useCache;
+    //! Files included by this file, including nested includes
+    std::vector<std::string> m_includes;
 };
 
 inline std::string InjectLevelPathsForCurrentLevel(const std::string& path, const std::string& defaultDir = "")
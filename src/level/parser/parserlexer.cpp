@@ -0,0 +1,168 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "level/parser/parserlexer.h"
+
+#include "level/parser/parserexceptions.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+//! Same characters as std::isspace() in the "C" locale
+bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+//! Separator of command and params
+bool IsSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n';
+}
+
+//! Returns the end of line without comment
+const char* StripComment(const char* begin, const char* end)
+{
+    const char* p = begin;
+    while (p < end)
+    {
+        if (*p == '"' || *p == '\'')
+        {
+            // Quotes without their pair are just ordinary characters
+            const char* close = std::find(p + 1, end, *p);
+            p = close != end ? close + 1 : p + 1;
+        }
+        else if (*p == '/' && p + 1 < end && p[1] == '/')
+        {
+            return p;
+        }
+        else
+        {
+            p++;
+        }
+    }
+    return end;
+}
+
+} // anonymous namespace
+
+
+CLevelParserLexer::CLevelParserLexer(const std::string& data, const std::string& filename)
+    : m_filename(filename),
+      m_pos(data.data()),
+      m_end(data.data() + data.size()),
+      m_lineNumber(0),
+      m_rest{nullptr, nullptr}
+{
+}
+
+void CLevelParserLexer::Assign(std::string& string, Range range)
+{
+    string.assign(range.begin, range.end);
+    std::replace(string.begin(), string.end(), '\t', ' ');
+}
+
+bool CLevelParserLexer::NextLine(std::string& command)
+{
+    while (m_pos < m_end)
+    {
+        const char* lineEnd = static_cast<const char*>(memchr(m_pos, '\n', m_end - m_pos));
+        if (lineEnd == nullptr) lineEnd = m_end;
+
+        Range line{m_pos, StripComment(m_pos, lineEnd)};
+        m_pos = lineEnd < m_end ? lineEnd + 1 : m_end;
+        m_lineNumber++;
+
+        while (line.begin < line.end && IsSpace(*line.begin)) line.begin++;
+        while (line.end > line.begin && IsSpace(line.end[-1])) line.end--;
+
+        const char* commandEnd = std::find_if(line.begin, line.end, IsSeparator);
+        if (commandEnd == line.begin)
+            continue;
+
+        Assign(command, Range{line.begin, commandEnd});
+
+        m_rest = Range{commandEnd, line.end};
+        while (m_rest.begin < m_rest.end && IsSpace(*m_rest.begin)) m_rest.begin++;
+        return true;
+    }
+    return false;
+}
+
+int CLevelParserLexer::GetLineNumber() const
+{
+    return m_lineNumber;
+}
+
+bool CLevelParserLexer::NextParam(std::string& name, std::string& value)
+{
+    if (m_rest.begin == m_rest.end)
+        return false;
+
+    auto trim = [](Range range)
+    {
+        while (range.begin < range.end && IsSpace(*range.begin)) range.begin++;
+        while (range.end > range.begin && IsSpace(range.end[-1])) range.end--;
+        return range;
+    };
+
+    // Name is everything before '='; without '=' the whole rest is both name and value
+    Range line = m_rest;
+    const char* equals = std::find(line.begin, line.end, '=');
+    Assign(name, trim(Range{line.begin, equals}));
+    if (equals != line.end)
+        line = trim(Range{equals + 1, line.end});
+
+    // Value ends with a closing quote, or before the name of the next param
+    const char* valueEnd = line.end;
+    if (line.begin < line.end && (*line.begin == '"' || *line.begin == '\''))
+    {
+        const char* close = std::find(line.begin + 1, line.end, *line.begin);
+        if (close == line.end)
+        {
+            throw CLevelParserException(std::string("Unclosed ") + *line.begin + " in " +
+                                        m_filename + ":" + std::to_string(m_lineNumber));
+        }
+        valueEnd = close + 1;
+    }
+    else
+    {
+        equals = std::find(line.begin, line.end, '=');
+        if (equals != line.end)
+        {
+            // Last separator before the name of the next param; if there is no name before
+            // the '=', the name is searched in the whole rest of line
+            const char* nameEnd = equals;
+            if (nameEnd == line.begin) nameEnd = line.end;
+            while (nameEnd > line.begin && IsSeparator(nameEnd[-1])) nameEnd--;
+            const char* separator = nameEnd;
+            while (separator > line.begin && !IsSeparator(separator[-1])) separator--;
+            valueEnd = separator > line.begin ? separator : equals + 1;
+        }
+    }
+
+    Assign(value, trim(Range{line.begin, valueEnd}));
+    m_rest = trim(Range{valueEnd, line.end});
+    return true;
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+/**
+ * \file level/parser/parserlexer.h
+ * \brief Lexer of level files
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * \class CLevelParserLexer
+ * \brief Splits the text of a level file into commands and params
+ *
+ * The whole file is scanned in a single pass over a buffer in memory;
+ * text is copied only to make the resulting command, names and values.
+ * Comments (// to the end of line, except inside quotes) are removed
+ * and tabs are treated as spaces.
+ */
+class CLevelParserLexer
+{
+public:
+    //! Creates lexer of \a data, which has to outlive it; a copy of \a filename is used in error messages
+    CLevelParserLexer(const std::string& data, const std::string& filename);
+
+    //! Goes to the next line with a command, returns false at the end of file
+    bool NextLine(std::string& command);
+    //! Returns the number of the current line, starting from 1
+    int GetLineNumber() const;
+    /**
+     * \brief Reads the next param of the current line
+     * \return false if there are no more params
+     * \throws CLevelParserException if a quoted value isn't closed
+     */
+    bool NextParam(std::string& name, std::string& value);
+
+private:
+    //! Part of the buffer, [begin, end)
+    struct Range
+    {
+        const char* begin;
+        const char* end;
+    };
+
+    //! Copies text of the range, replacing tabs by spaces
+    static void Assign(std::string& string, Range range);
+
+private:
+    std::string m_filename;
+    const char* m_pos;
+    const char* m_end;
+    int m_lineNumber;
+    //! Unread params of the current line
+    Range m_rest;
+};
@@ -64,6 +64,11 @@ const std::string& CLevelParserLine::GetLevelFilename()
     return m_levelFilename;
 }
 
+void CLevelParserLine::SetLevelFilename(const std::string& filename)
+{
+    m_levelFilename = filename;
+}
+
 std::string CLevelParserLine::GetCommand()
 {
     return m_command;
@@ -95,6 +100,11 @@ void CLevelParserLine::AddParam(std::string name, CLevelParserParamUPtr value)
     m_params.insert(std::make_pair(name, std::move(value)));
 }
 
+const std::map<std::string, CLevelParserParamUPtr>& CLevelParserLine::GetParams() const
+{
+    return m_params;
+}
+
 std::ostream& operator<<(std::ostream& str, const CLevelParserLine& line)
 {
     str << line.m_command;
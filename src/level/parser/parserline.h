@@ -49,12 +49,16 @@ public:
     void SetLevel(CLevelParser* level);
 
     const std::string& GetLevelFilename();
+    //! Set name of the file the line comes from, if it's not the file of its CLevelParser
+    void SetLevelFilename(const std::string& filename);
 
     std::string GetCommand();
     void SetCommand(std::string command);
 
     CLevelParserParam* GetParam(std::string name);
     void AddParam(std::string name, CLevelParserParamUPtr value);
+    //! Get all params, ordered by name
+    const std::map<std::string, CLevelParserParamUPtr>& GetParams() const;
 
     friend std::ostream& operator<<(std::ostream& str, const CLevelParserLine& line);
 
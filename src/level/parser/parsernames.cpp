@@ -0,0 +1,373 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "level/parser/parsernames.h"
+
+#include "level/build_type.h"
+#include "level/research_type.h"
+
+
+// The names are the only list of enum values in level files: both reading
+// and writing of level files use these tables.
+
+const CLevelParserNameTable<ObjectType>& GetObjectTypeNames()
+{
+    static const CLevelParserNameTable<ObjectType> names(
+    {
+        { "Portico",             OBJECT_PORTICO },
+        { "SpaceShip",           OBJECT_BASE },
+        { "WheeledTrainer",      OBJECT_MOBILEwt },
+        { "WingedTrainer",       OBJECT_MOBILEft },
+        { "TrackedTrainer",      OBJECT_MOBILEtt },
+        { "LeggedTrainer",       OBJECT_MOBILEit },
+        { "HeavyTrainer",        OBJECT_MOBILErp },
+        { "AmphibiousTrainer",   OBJECT_MOBILEst },
+        { "WingedGrabber",       OBJECT_MOBILEfa },
+        { "TrackedGrabber",      OBJECT_MOBILEta },
+        { "WheeledGrabber",      OBJECT_MOBILEwa },
+        { "LeggedGrabber",       OBJECT_MOBILEia },
+        { "WingedShooter",       OBJECT_MOBILEfc },
+        { "TrackedShooter",      OBJECT_MOBILEtc },
+        { "WheeledShooter",      OBJECT_MOBILEwc },
+        { "LeggedShooter",       OBJECT_MOBILEic },
+        { "WingedOrgaShooter",   OBJECT_MOBILEfi },
+        { "TrackedOrgaShooter",  OBJECT_MOBILEti },
+        { "WheeledOrgaShooter",  OBJECT_MOBILEwi },
+        { "LeggedOrgaShooter",   OBJECT_MOBILEii },
+        { "WingedSniffer",       OBJECT_MOBILEfs },
+        { "TrackedSniffer",      OBJECT_MOBILEts },
+        { "WheeledSniffer",      OBJECT_MOBILEws },
+        { "LeggedSniffer",       OBJECT_MOBILEis },
+        { "WingedBuilder",       OBJECT_MOBILEfb },
+        { "TrackedBuilder",      OBJECT_MOBILEtb },
+        { "WheeledBuilder",      OBJECT_MOBILEwb },
+        { "LeggedBuilder",       OBJECT_MOBILEib },
+        { "Thumper",             OBJECT_MOBILErt },
+        { "PhazerShooter",       OBJECT_MOBILErc },
+        { "Recycler",            OBJECT_MOBILErr },
+        { "Shielder",            OBJECT_MOBILErs },
+        { "Subber",              OBJECT_MOBILEsa },
+        { "TargetBot",           OBJECT_MOBILEtg },
+        { "Scribbler",           OBJECT_MOBILEdr },
+        { "PowerSpot",           OBJECT_MARKPOWER },
+        { "TitaniumSpot",        OBJECT_MARKSTONE },
+        { "UraniumSpot",         OBJECT_MARKURANIUM },
+        { "KeyASpot",            OBJECT_MARKKEYa },
+        { "KeyBSpot",            OBJECT_MARKKEYb },
+        { "KeyCSpot",            OBJECT_MARKKEYc },
+        { "KeyDSpot",            OBJECT_MARKKEYd },
+        { "WayPoint",            OBJECT_WAYPOINT },
+        { "BlueFlag",            OBJECT_FLAGb },
+        { "RedFlag",             OBJECT_FLAGr },
+        { "GreenFlag",           OBJECT_FLAGg },
+        { "YellowFlag",          OBJECT_FLAGy },
+        { "VioletFlag",          OBJECT_FLAGv },
+        { "PowerCell",           OBJECT_POWER },
+        { "NuclearCell",         OBJECT_ATOMIC },
+        { "TitaniumOre",         OBJECT_STONE },
+        { "UraniumOre",          OBJECT_URANIUM },
+        { "Titanium",            OBJECT_METAL },
+        { "OrgaMatter",          OBJECT_BULLET },
+        { "BlackBox",            OBJECT_BBOX },
+        { "KeyA",                OBJECT_KEYa },
+        { "KeyB",                OBJECT_KEYb },
+        { "KeyC",                OBJECT_KEYc },
+        { "KeyD",                OBJECT_KEYd },
+        { "TNT",                 OBJECT_TNT },
+        { "Mine",                OBJECT_BOMB },
+        { "Firework",            OBJECT_WINFIRE },
+        { "Bag",                 OBJECT_BAG },
+        { "Greenery0",           OBJECT_PLANT0 },
+        { "Greenery1",           OBJECT_PLANT1 },
+        { "Greenery2",           OBJECT_PLANT2 },
+        { "Greenery3",           OBJECT_PLANT3 },
+        { "Greenery4",           OBJECT_PLANT4 },
+        { "Greenery5",           OBJECT_PLANT5 },
+        { "Greenery6",           OBJECT_PLANT6 },
+        { "Greenery7",           OBJECT_PLANT7 },
+        { "Greenery8",           OBJECT_PLANT8 },
+        { "Greenery9",           OBJECT_PLANT9 },
+        { "Greenery10",          OBJECT_PLANT10 },
+        { "Greenery11",          OBJECT_PLANT11 },
+        { "Greenery12",          OBJECT_PLANT12 },
+        { "Greenery13",          OBJECT_PLANT13 },
+        { "Greenery14",          OBJECT_PLANT14 },
+        { "Greenery15",          OBJECT_PLANT15 },
+        { "Greenery16",          OBJECT_PLANT16 },
+        { "Greenery17",          OBJECT_PLANT17 },
+        { "Greenery18",          OBJECT_PLANT18 },
+        { "Greenery19",          OBJECT_PLANT19 },
+        { "Tree0",               OBJECT_TREE0 },
+        { "Tree1",               OBJECT_TREE1 },
+        { "Tree2",               OBJECT_TREE2 },
+        { "Tree3",               OBJECT_TREE3 },
+        { "Tree4",               OBJECT_TREE4 },
+        { "Tree5",               OBJECT_TREE5 },
+        { "Mushroom1",           OBJECT_MUSHROOM1 },
+        { "Mushroom2",           OBJECT_MUSHROOM2 },
+        { "Home",                OBJECT_HOME1 },
+        { "Derrick",             OBJECT_DERRICK },
+        { "BotFactory",          OBJECT_FACTORY },
+        { "PowerStation",        OBJECT_STATION },
+        { "Converter",           OBJECT_CONVERT },
+        { "RepairCenter",        OBJECT_REPAIR },
+        { "Destroyer",           OBJECT_DESTROYER },
+        { "DefenseTower",        OBJECT_TOWER },
+        { "AlienNest",           OBJECT_NEST },
+        { "ResearchCenter",      OBJECT_RESEARCH },
+        { "RadarStation",        OBJECT_RADAR },
+        { "ExchangePost",        OBJECT_INFO },
+        { "PowerPlant",          OBJECT_ENERGY },
+        { "AutoLab",             OBJECT_LABO },
+        { "NuclearPlant",        OBJECT_NUCLEAR },
+        { "PowerCaptor",         OBJECT_PARA },
+        { "Vault",               OBJECT_SAFE },
+        { "Houston",             OBJECT_HUSTON },
+        { "Target1",             OBJECT_TARGET1 },
+        { "Target2",             OBJECT_TARGET2 },
+        { "StartArea",           OBJECT_START },
+        { "GoalArea",            OBJECT_END },
+        { "AlienQueen",          OBJECT_MOTHER },
+        { "AlienEgg",            OBJECT_EGG },
+        { "AlienAnt",            OBJECT_ANT },
+        { "AlienSpider",         OBJECT_SPIDER },
+        { "AlienWasp",           OBJECT_BEE },
+        { "AlienWorm",           OBJECT_WORM },
+        { "WreckBotw1",          OBJECT_RUINmobilew1 },
+        { "WreckBotw2",          OBJECT_RUINmobilew2 },
+        { "WreckBott1",          OBJECT_RUINmobilet1 },
+        { "WreckBott2",          OBJECT_RUINmobilet2 },
+        { "WreckBotr1",          OBJECT_RUINmobiler1 },
+        { "WreckBotr2",          OBJECT_RUINmobiler2 },
+        { "RuinBotFactory",      OBJECT_RUINfactory },
+        { "RuinDoor",            OBJECT_RUINdoor },
+        { "RuinSupport",         OBJECT_RUINsupport },
+        { "RuinRadar",           OBJECT_RUINradar },
+        { "RuinConvert",         OBJECT_RUINconvert },
+        { "RuinBaseCamp",        OBJECT_RUINbase },
+        { "RuinHeadCamp",        OBJECT_RUINhead },
+        { "Barrier0",            OBJECT_BARRIER0 },
+        { "Barrier1",            OBJECT_BARRIER1 },
+        { "Barrier2",            OBJECT_BARRIER2 },
+        { "Barrier3",            OBJECT_BARRIER3 },
+        { "Barricade0",          OBJECT_BARRICADE0 },
+        { "Barricade1",          OBJECT_BARRICADE1 },
+        { "Teen0",               OBJECT_TEEN0 },
+        { "Teen1",               OBJECT_TEEN1 },
+        { "Teen2",               OBJECT_TEEN2 },
+        { "Teen3",               OBJECT_TEEN3 },
+        { "Teen4",               OBJECT_TEEN4 },
+        { "Teen5",               OBJECT_TEEN5 },
+        { "Teen6",               OBJECT_TEEN6 },
+        { "Teen7",               OBJECT_TEEN7 },
+        { "Teen8",               OBJECT_TEEN8 },
+        { "Teen9",               OBJECT_TEEN9 },
+        { "Teen10",              OBJECT_TEEN10 },
+        { "Teen11",              OBJECT_TEEN11 },
+        { "Teen12",              OBJECT_TEEN12 },
+        { "Teen13",              OBJECT_TEEN13 },
+        { "Teen14",              OBJECT_TEEN14 },
+        { "Teen15",              OBJECT_TEEN15 },
+        { "Teen16",              OBJECT_TEEN16 },
+        { "Teen17",              OBJECT_TEEN17 },
+        { "Teen18",              OBJECT_TEEN18 },
+        { "Teen19",              OBJECT_TEEN19 },
+        { "Teen20",              OBJECT_TEEN20 },
+        { "Teen21",              OBJECT_TEEN21 },
+        { "Teen22",              OBJECT_TEEN22 },
+        { "Teen23",              OBJECT_TEEN23 },
+        { "Teen24",              OBJECT_TEEN24 },
+        { "Teen25",              OBJECT_TEEN25 },
+        { "Teen26",              OBJECT_TEEN26 },
+        { "Teen27",              OBJECT_TEEN27 },
+        { "Teen28",              OBJECT_TEEN28 },
+        { "Teen29",              OBJECT_TEEN29 },
+        { "Teen30",              OBJECT_TEEN30 },
+        { "Teen31",              OBJECT_TEEN31 },
+        { "Teen32",              OBJECT_TEEN32 },
+        { "Teen33",              OBJECT_TEEN33 },
+        { "Stone",               OBJECT_TEEN34 },
+        { "Teen35",              OBJECT_TEEN35 },
+        { "Teen36",              OBJECT_TEEN36 },
+        { "Teen37",              OBJECT_TEEN37 },
+        { "Teen38",              OBJECT_TEEN38 },
+        { "Teen39",              OBJECT_TEEN39 },
+        { "Teen40",              OBJECT_TEEN40 },
+        { "Teen41",              OBJECT_TEEN41 },
+        { "Teen42",              OBJECT_TEEN42 },
+        { "Teen43",              OBJECT_TEEN43 },
+        { "Teen44",              OBJECT_TEEN44 },
+        { "Quartz0",             OBJECT_QUARTZ0 },
+        { "Quartz1",             OBJECT_QUARTZ1 },
+        { "Quartz2",             OBJECT_QUARTZ2 },
+        { "Quartz3",             OBJECT_QUARTZ3 },
+        { "MegaStalk0",          OBJECT_ROOT0 },
+        { "MegaStalk1",          OBJECT_ROOT1 },
+        { "MegaStalk2",          OBJECT_ROOT2 },
+        { "MegaStalk3",          OBJECT_ROOT3 },
+        { "MegaStalk4",          OBJECT_ROOT4 },
+        { "MegaStalk5",          OBJECT_ROOT5 },
+        { "ApolloLEM",           OBJECT_APOLLO1 },
+        { "ApolloJeep",          OBJECT_APOLLO2 },
+        { "ApolloFlag",          OBJECT_APOLLO3 },
+        { "ApolloModule",        OBJECT_APOLLO4 },
+        { "ApolloAntenna",       OBJECT_APOLLO5 },
+        { "Me",                  OBJECT_HUMAN },
+        { "Tech",                OBJECT_TECH },
+        { "MissionController",   OBJECT_CONTROLLER },
+    },
+    {
+        { "All",            OBJECT_NULL },
+        { "Any",            OBJECT_NULL },
+        { "PracticeBot",    OBJECT_MOBILEwt },
+        { "PlatinumSpot",   OBJECT_MARKURANIUM },
+        { "FuelCellPlant",  OBJECT_NUCLEAR },
+        { "FuelCell",       OBJECT_ATOMIC },
+        { "PlatinumOre",    OBJECT_URANIUM },
+    });
+    return names;
+}
+
+const CLevelParserNameTable<int>& GetBuildFlagNames()
+{
+    static const CLevelParserNameTable<int> names(
+    {
+        { "BotFactory",      BUILD_FACTORY },
+        { "Derrick",         BUILD_DERRICK },
+        { "Converter",       BUILD_CONVERT },
+        { "RadarStation",    BUILD_RADAR },
+        { "PowerPlant",      BUILD_ENERGY },
+        { "NuclearPlant",    BUILD_NUCLEAR },
+        { "PowerStation",    BUILD_STATION },
+        { "RepairCenter",    BUILD_REPAIR },
+        { "DefenseTower",    BUILD_TOWER },
+        { "ResearchCenter",  BUILD_RESEARCH },
+        { "AutoLab",         BUILD_LABO },
+        { "PowerCaptor",     BUILD_PARA },
+        { "ExchangePost",    BUILD_INFO },
+        { "Vault",           BUILD_SAFE },
+        { "Destroyer",       BUILD_DESTROYER },
+        { "FlatGround",      BUILD_GFLAT },
+        { "Flag",            BUILD_FLAG },
+    },
+    {
+        { "FuelCellPlant",  BUILD_NUCLEAR },
+    });
+    return names;
+}
+
+const CLevelParserNameTable<int>& GetResearchFlagNames()
+{
+    static const CLevelParserNameTable<int> names(
+    {
+        { "TRACKER",   RESEARCH_TANK },
+        { "WINGER",    RESEARCH_FLY },
+        { "THUMPER",   RESEARCH_THUMP },
+        { "SHOOTER",   RESEARCH_CANON },
+        { "TOWER",     RESEARCH_TOWER },
+        { "PHAZER",    RESEARCH_PHAZER },
+        { "SHIELDER",  RESEARCH_SHIELD },
+        { "ATOMIC",    RESEARCH_ATOMIC },
+        { "iPAW",      RESEARCH_iPAW },
+        { "iGUN",      RESEARCH_iGUN },
+        { "RECYCLER",  RESEARCH_RECYCLER },
+        { "SUBBER",    RESEARCH_SUBM },
+        { "SNIFFER",   RESEARCH_SNIFFER },
+        { "BUILDER",   RESEARCH_BUILDER },
+        { "TARGET",    RESEARCH_TARGET },
+    },
+    {
+        /* /9j/4AAQSkZJRgABAQEAYABgAAD//gATQ3JlYXRlZCB3aXRoIEdJTVD/2wBDACAWGBwYFCAcGhwk
+         * IiAmMFA0MCwsMGJGSjpQdGZ6eHJmcG6AkLicgIiuim5woNqirr7EztDOfJri8uDI8LjKzsb/2wBD
+         * ASIkJDAqMF40NF7GhHCExsbGxsbGxsbGxsbGxsbGxsbGxsbGxsbGxsbGxsbGxsbGxsbGxsbGxsbG
+         * xsbGxsbGxsb/wgARCAAgAWwDAREAAhEBAxEB/8QAGQABAQEBAQEAAAAAAAAAAAAAAAECAwQF/8QA
+         * FwEBAQEBAAAAAAAAAAAAAAAAAAECA//aAAwDAQACEAMQAAAB+gZTKdGsmiAhSghDnL2sAAAAAAAA
+         * AAAAAAAh4Zw5t+yRrrgAApAWXhN+7XPJQbAAAAAAAAAAAAAIfPzx5Xp7ZjtrrAQgAOhgFMGiFIDR
+         * oyCmSlIQpDQIUgBAaNgHNOR6CKAABQZKAAACggAAABCgyaAAAKU//8QAIRAAAwACAwACAwEAAAAA
+         * AAAAAAERAhIDECEgQSIxQFD/2gAIAQEAAQUCG4brqpfBO/FuLHkWX+Dk6fs42Z4ttrI1yNch4NDx
+         * yJka5muSM8W+Pi43fv09Pv8Asy8E/eL0bhsbGxv7sbO7dLI2NjZlYm2beVysWVbfmxi6U3NhOmxs
+         * bfi8oXxuGxTY2NjY2E78MsVkLhx6hEREIREROtUREIQiIiE7hCEREQiIiERCGqIRERERERF3/8QA
+         * HxEAAQMEAwEAAAAAAAAAAAAAAQACEQMhMFAQEiJg/9oACAEDAQE/AeOwyRoQZcneblU3TiCMRoRT
+         * cTZGm4iAmNj5n//EABsRAQACAgMAAAAAAAAAAAAAAAEAETFQAiFg/9oACAECAQE/Adfliwb1mGcu
+         * 4FeZ/8QAHRAAAQMFAQAAAAAAAAAAAAAAEQAQIQEgMDFQYf/aAAgBAQAGPwJt3RyQosh9qq94QY3j
+         * HXzGWOWeb//EACMQAAMAAgICAwADAQAAAAAAAAABESExUWEQQXGBkSBAUPH/2gAIAQEAAT8hEJW4
+         * Jvg2I2l5birEJWpVZ5TT0Is9DuJ5/wAFz0SeCUGZb6PiQpbzOKe/3OSydbkcVEW9e8mE03c+zfl/
+         * pg2/Rew96I+8hBXGoOhqGNM9+hJ7f3Wu06jadNnqVHxz2Twx8cMWBOF8f9MHD8G6Txn0XM6EtabJ
+         * vR8GbmtGaYXGBEsrVEzZ8IwnVvg6v0IC/SDNej4M9rcHN6I4ZHBwmTLBY5NiJ4Xs+941X0TwxWTi
+         * +z4E8MeOFmUnhif4E+Am7liUUQ0brOo6iOCODo7G52ETRBIR1EcCRKQhOwsljR1EQm0hsi6IJOrx
+         * JEdRL0RJMHUQNHtDtSJIdR1HUdR1HUJTx//aAAwDAQACAAMAAAAQFggkgAFwAAAAAAAAAAAAAAAl
+         * aAkgACwggAAAAAAAAAAAAAlyAAAAEkkkkAkEggAgEAAkAFdAEkAEEkAgkgAEAkkkAAAg/8QAGxEB
+         * AAIDAQEAAAAAAAAAAAAAAQARMDFQQVH/2gAIAQMBAT8QihuCe4wVoiwt4OyYAbJQpxKmI1OCxYqB
+         * HbfMSU/YFcv/xAAcEQEAAwACAwAAAAAAAAAAAAABABEhMFAxUWD/2gAIAQIBAT8Q5r6EcPUMPEqb
+         * xMBvoQbYgZKm/M//xAAnEAEBAAICAgAGAQUAAAAAAAABEQAhMVFBYRBxgZGhscEgQFDR8P/aAAgB
+         * AQABPxDIZD3iUAL3r4GFjwLz8KWXeAiAG1chAOxuIBILwd/GhQxjMePBiWLo+f8AAOjGS2PB0YUE
+         * nytypVAqw88Bnz3xhQAcAK8n8ZBhan13x9sibBeAvA94FtczST5YvWKm+HgOsvYDFOzdGbVRJO3d
+         * wZqBorh8fPBxTdF/GIwrqusPFZPGKAo/PHCQeHvChVJP7xKJhqJwJ+85rp1N5TgkQvnDMa3gDERi
+         * Is0ynDblmrZliFp5L5xNeXSefX/e8nKdCKfh+P1jtAtrT1/vNNpX0Qz95lRwtoerm5qwSb5cnXm1
+         * iyERxrxLzgjrRaq5rJWjPxzkBBt+u8ZXYDbOfrm+GuBW9d4gBrj0esgyvYybNxzrjIwEg+sNhGcm
+         * kwUHQl+kuanajJ5wakDzOc8ggV9ZyRG8zxZjYk0Ac4Ok8HvWsQACjwd5PEZtiSCC+HCvSIWOAE3o
+         * 94btYQQ87c3zyT8z+MMVOAOfe5Z7mcaJod/0TF+nyZTj0LgEABwGcqNTPwJgDcBti4raNtc1Om2v
+         * nlA27M2CI4h35kuEgOCXPUzj6YsAB5MJgXEAiCHrFH5J9MDiat25tRt53zkWzjEAiUcXrlgaISdY
+         * qqnLec0SdAfbjFmzfdxJQl5zg6YUQbwNkVpM38MXAmhpHEzZCYg7U4wNDR05uFpO8U5HEyhJkT75
+         * sWN6zZY5ueh1gCBPPw//2Q==
+         */
+        { "\x6a\x65\x73\x74\x65\x6d\x50\x41\x57\x49\x45\x4d",                  RESEARCH_iPAW },
+        { "\x6a\x65\x73\x74\x65\x6d\x50\x49\x53\x54\x4f\x4c\x45\x54\x45\x4d",  RESEARCH_iGUN },
+    });
+    return names;
+}
+
+const CLevelParserNameTable<Gfx::PyroType>& GetPyroTypeNames()
+{
+    static const CLevelParserNameTable<Gfx::PyroType> names(
+    {
+        { "FRAGt",   Gfx::PT_FRAGT },
+        { "FRAGo",   Gfx::PT_FRAGO },
+        { "FRAGw",   Gfx::PT_FRAGW },
+        { "EXPLOt",  Gfx::PT_EXPLOT },
+        { "EXPLOo",  Gfx::PT_EXPLOO },
+        { "EXPLOw",  Gfx::PT_EXPLOW },
+        { "SHOTt",   Gfx::PT_SHOTT },
+        { "SHOTh",   Gfx::PT_SHOTH },
+        { "SHOTm",   Gfx::PT_SHOTM },
+        { "SHOTw",   Gfx::PT_SHOTW },
+        { "EGG",     Gfx::PT_EGG },
+        { "BURNt",   Gfx::PT_BURNT },
+        { "BURNo",   Gfx::PT_BURNO },
+        { "SPIDER",  Gfx::PT_SPIDER },
+        { "FALL",    Gfx::PT_FALL },
+        { "RESET",   Gfx::PT_RESET },
+        { "WIN",     Gfx::PT_WIN },
+        { "LOST",    Gfx::PT_LOST },
+    });
+    return names;
+}
+
+const CLevelParserNameTable<Gfx::CameraType>& GetCameraTypeNames()
+{
+    static const CLevelParserNameTable<Gfx::CameraType> names(
+    {
+        { "BACK",     Gfx::CAM_TYPE_BACK },
+        { "PLANE",    Gfx::CAM_TYPE_PLANE },
+        { "ONBOARD",  Gfx::CAM_TYPE_ONBOARD },
+        { "FIX",      Gfx::CAM_TYPE_FIX },
+    });
+    return names;
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+/**
+ * \file level/parser/parsernames.h
+ * \brief Names of enum values in level files
+ */
+
+#pragma once
+
+#include "graphics/engine/camera.h"
+#include "graphics/engine/pyro_type.h"
+
+#include "object/object_type.h"
+
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \class CLevelParserNameTable
+ * \brief Two-way table of names of enum values
+ *
+ * Each value has one name, which is used when writing; aliases are
+ * other names of values which are accepted only when reading.
+ * Lookups in both directions are done in hash tables.
+ */
+template<typename T>
+class CLevelParserNameTable
+{
+public:
+    struct Entry
+    {
+        const char* name;
+        T value;
+    };
+
+    CLevelParserNameTable(std::initializer_list<Entry> names, std::initializer_list<Entry> aliases = {})
+        : m_entries(names)
+    {
+        for (const Entry& entry : names)
+        {
+            m_values.insert({ entry.name, entry.value });
+            m_names.insert({ static_cast<int>(entry.value), entry.name });
+        }
+        for (const Entry& entry : aliases)
+        {
+            m_values.insert({ entry.name, entry.value });
+        }
+    }
+
+    //! Finds value of given name or alias, returns false if there is none
+    bool GetValue(const std::string& name, T& value) const
+    {
+        auto it = m_values.find(name);
+        if (it == m_values.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    //! Returns name of given value or nullptr if it has none
+    const char* GetName(T value) const
+    {
+        auto it = m_names.find(static_cast<int>(value));
+        return it != m_names.end() ? it->second : nullptr;
+    }
+
+    //! Returns all values with their names, without aliases
+    const std::vector<Entry>& GetEntries() const
+    {
+        return m_entries;
+    }
+
+private:
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string, T> m_values;
+    std::unordered_map<int, const char*> m_names;
+};
+
+//! Names of object types
+const CLevelParserNameTable<ObjectType>& GetObjectTypeNames();
+//! Names of build flags (BuildType)
+const CLevelParserNameTable<int>& GetBuildFlagNames();
+//! Names of research flags (ResearchType)
+const CLevelParserNameTable<int>& GetResearchFlagNames();
+//! Names of pyro effects
+const CLevelParserNameTable<Gfx::PyroType>& GetPyroTypeNames();
+//! Names of camera types
+const CLevelParserNameTable<Gfx::CameraType>& GetCameraTypeNames();
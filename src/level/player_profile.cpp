@@ -472,6 +472,8 @@ bool CPlayerProfile::HasAnySavedScene()
 
 std::vector<SavedScene> CPlayerProfile::GetSavedSceneList()
 {
+    CRobotMain::GetInstancePointer()->IOWaitForWrite();
+
     auto saveDirs = CResourceManager::ListDirectories(GetSaveDir());
     std::map<int, SavedScene> sortedSaveDirs;
 
@@ -515,6 +517,8 @@ void CPlayerProfile::SaveScene(std::string dir, std::string info)
 
 void CPlayerProfile::LoadScene(std::string dir)
 {
+    CRobotMain::GetInstancePointer()->IOWaitForWrite();
+
     CLevelParser levelParser(dir + "/data.sav");
     levelParser.Load();
 
@@ -25,8 +25,10 @@
 #include "app/input.h"
 #include "app/pausemanager.h"
 
+#include "common/compression.h"
 #include "common/config_file.h"
 #include "common/event.h"
+#include "common/image.h"
 #include "common/logger.h"
 #include "common/make_unique.h"
 #include "common/restext.h"
@@ -37,6 +39,8 @@
 #include "common/resources/outputstream.h"
 #include "common/resources/resourcemanager.h"
 
+#include "common/thread/job_system.h"
+
 #include "graphics/engine/camera.h"
 #include "graphics/engine/cloud.h"
 #include "graphics/engine/engine.h"
@@ -52,6 +56,7 @@
 
 #include "graphics/model/model_manager.h"
 
+#include "level/asset_preloader.h"
 #include "level/mainmovie.h"
 #include "level/player_profile.h"
 #include "level/scene_conditions.h"
@@ -109,6 +114,8 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <ctime>
 
@@ -167,6 +174,8 @@ CRobotMain::CRobotMain()
         m_modelManager.get(),
         m_particle);
 
+    m_assetPreloader = MakeUnique<CAssetPreloader>(m_oldModelManager, m_app->GetSystemUtils());
+
     m_debugMenu   = MakeUnique<Ui::CDebugMenu>(this, m_engine, m_objMan.get(), m_sound);
 
     m_time = 0.0f;
@@ -284,6 +293,7 @@ CRobotMain::CRobotMain()
 //! Destructor of robot application
 CRobotMain::~CRobotMain()
 {
+    IOWaitForWrite();
 }
 
 Gfx::CCamera* CRobotMain::GetCamera()
@@ -761,7 +771,7 @@ bool CRobotMain::ProcessEvent(Event &event)
 
     if (event.type == EVENT_WRITE_SCENE_FINISHED)
     {
-        IOWriteSceneFinished();
+        IOWriteSceneFinished(event.customParam != 0);
         return false;
     }
 
@@ -1463,6 +1473,12 @@ void CRobotMain::ExecuteCmd(const std::string& cmd)
         return;
     }
 
+    if (cmd == "invbatch")
+    {
+        m_engine->GetParticle()->SetBatching(!m_engine->GetParticle()->GetBatching());
+        return;
+    }
+
     if (cmd == "invui")
     {
         m_engine->SetRenderInterface(!m_engine->GetRenderInterface());
@@ -2814,14 +2830,26 @@ void CRobotMain::CreateScene(bool soluce, bool fixScene, bool resetObject)
         m_ui->GetDialog()->StartInformation("Level loading warning", "This level contains problems. It may stop working in future versions of the game.", message);
     };
 
+    // Textures of all objects are loaded together at the end
+    m_engine->BeginTextureBatch();
+    m_assetPreloader->Start();
+
     try
     {
         m_ui->GetLoadingScreen()->SetProgress(0.05f, RT_LOADING_PROCESSING);
         GetLogger()->Info("Loading level: %s\n", m_levelFile.c_str());
         CLevelParser levelParser(m_levelFile);
         levelParser.SetLevelPaths(m_levelCategory, m_levelChap, m_levelRank);
+        levelParser.SetUseCache(m_levelCategory != LevelCategory::CustomLevels); // built-in levels don't change
         levelParser.Load();
         int numObjects = levelParser.CountLines("CreateObject");
+        m_assetPreloader->EndPhase("parsing");
+
+        if (!resetObject && m_sceneReadPath.empty())  // saved games are preloaded by IOReadScene()
+        {
+            m_assetPreloader->Preload(levelParser);
+            m_assetPreloader->EndPhase("models");
+        }
         m_ui->GetLoadingScreen()->SetProgress(0.1f, RT_LOADING_LEVEL_SETTINGS);
 
         int rankObj = 0;
@@ -3410,7 +3438,9 @@ void CRobotMain::CreateScene(bool soluce, bool fixScene, bool resetObject)
 
                 try
                 {
+                    m_assetPreloader->BeginObject(params.type);
                     CObject* obj = m_objMan->CreateObject(params);
+                    m_assetPreloader->EndObject();
                     obj->Read(line.get());
 
                     if (m_fixScene && obj->GetType() == OBJECT_HUMAN)
@@ -3747,6 +3777,13 @@ void CRobotMain::CreateScene(bool soluce, bool fixScene, bool resetObject)
             throw CLevelParserException("Unknown command: '" + line->GetCommand() + "' in " + line->GetLevelFilename() + ":" + boost::lexical_cast<std::string>(line->GetLineNumber()));
         }
 
+        m_assetPreloader->EndPhase("scene");
+
+        m_engine->EndTextureBatch();
+        m_assetPreloader->EndPhase("textures");
+        m_assetPreloader->Finish();
+        m_assetPreloader->LogPhases();
+
         // Do this here to prevent the first frame from taking a long time to render
         m_engine->UpdateGroundSpotTextures();
 
@@ -3840,6 +3877,8 @@ void CRobotMain::CreateScene(bool soluce, bool fixScene, bool resetObject)
     }
     catch (...)
     {
+        m_engine->EndTextureBatch();
+        m_assetPreloader->Finish();
         m_sceneReadPath = "";
         throw;
     }
@@ -4648,8 +4687,75 @@ void CRobotMain::IOWriteObject(CLevelParserLine* line, CObject* obj, const std::
     }
 }
 
+namespace
+{
+
+//! Magic of compressed cbot.run files, uncompressed ones start with version 1
+const char CBOT_PACK_MAGIC[] = "\0CBT";
+
+//! Snapshot of a saved game, to be written to files
+struct SceneWriteData
+{
+    std::unique_ptr<CLevelParser> levelParser;
+    std::string cbotFile;
+    std::string cbotData;
+    //! Write files in the compressed binary format
+    bool binary = true;
+    std::unique_ptr<CImage> screenshot;
+    std::string screenshotFile;
+    //! Set when the level and CBot files were written successfully
+    bool written = false;
+};
+
+//! Formats the snapshot and writes the level and CBot files; doesn't touch the game state
+void WriteSceneFiles(SceneWriteData& data)
+{
+    try
+    {
+        data.levelParser->Save(data.binary);
+    }
+    catch (CLevelParserException& e)
+    {
+        GetLogger()->Error("Failed to save level state - %s\n", e.what());
+        return;
+    }
+
+    COutputStream ostr(data.cbotFile);
+    if (ostr.is_open())
+    {
+        if (data.binary)
+            data.cbotData = Compression::Pack(data.cbotData, CBOT_PACK_MAGIC);
+        ostr.write(data.cbotData.data(), data.cbotData.size());
+        ostr.close();
+        data.written = true;
+    }
+    else
+    {
+        GetLogger()->Error("Failed to open file: %s\n", data.cbotFile.c_str());
+    }
+}
+
+//! Writes the screenshot of the snapshot
+void WriteSceneScreenshot(SceneWriteData& data)
+{
+    if (data.screenshot->SavePNG(data.screenshotFile.c_str()))
+        GetLogger()->Debug("Save screenshot saved successfully\n");
+    else
+        GetLogger()->Error("%s!\n", data.screenshot->GetError().c_str());
+}
+
+} // anonymous namespace
+
 //! Saves the current game
-bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::string filescreenshot, const std::string& info, bool emergencySave)
+/**
+ * Only a snapshot of the game is taken here: the level file lines, the CBot stacks
+ * and the screenshot. Formatting and writing the files is done by jobs of CJobSystem,
+ * except for emergency saves, and EVENT_WRITE_SCENE_FINISHED is sent when it's done,
+ * with customParam 1 if the level and CBot files were written and 0 if not.
+ * The screenshot is written in parallel with the other files; saves are finished in order.
+ * Emergency saves are written immediately and failures are only logged.
+ */
+void CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::string filescreenshot, const std::string& info, bool emergencySave)
 {
     if (!emergencySave)
     {
@@ -4660,7 +4766,9 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
 
     std::string dirname = filename.substr(0, filename.find_last_of("/"));
 
-    CLevelParser levelParser(filename);
+    auto data = std::make_shared<SceneWriteData>();
+    data->levelParser = MakeUnique<CLevelParser>(filename);
+    CLevelParser& levelParser = *data->levelParser;
     CLevelParserLineUPtr line;
 
     line = MakeUnique<CLevelParserLine>("Title");
@@ -4743,19 +4851,9 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
         IOWriteObject(line.get(), obj, dirname, objRank++);
         levelParser.AddLine(std::move(line));
     }
-    try
-    {
-        levelParser.Save();
-    }
-    catch (CLevelParserException& e)
-    {
-        GetLogger()->Error("Failed to save level state - %s\n", e.what()); // TODO add visual error to notify user that save failed
-        return false;
-    }
 
-    // Writes the file of stacks of execution.
-    COutputStream ostr(filecbot);
-    if (!ostr.is_open()) return false;
+    // Writes the stacks of execution
+    std::ostringstream ostr;
 
     bool bError = false;
     long version = 1;
@@ -4783,36 +4881,58 @@ bool CRobotMain::IOWriteScene(std::string filename, std::string filecbot, std::s
         GetLogger()->Error("CBotClass save static state failed\n");
     }
 
-    ostr.close();
+    data->cbotFile = filecbot;
+    data->cbotData = ostr.str();
+    data->binary = !m_textSaves;
 
-    if (!emergencySave)
+    if (emergencySave)
     {
-        ShowSaveIndicator(false); // force hide for screenshot
-        MouseMode oldMouseMode = m_app->GetMouseMode();
-        m_app->SetMouseMode(MOUSE_NONE); // disable the mouse
-        m_displayText->HideText(true); // hide
-        m_engine->SetScreenshotMode(true);
+        WriteSceneFiles(*data);
+        return;
+    }
 
-        m_engine->Render(); // update (but don't show, we're not swapping buffers here!)
-        m_engine->WriteScreenShot(filescreenshot);
-        m_shotSaving++;
+    ShowSaveIndicator(false); // force hide for screenshot
+    MouseMode oldMouseMode = m_app->GetMouseMode();
+    m_app->SetMouseMode(MOUSE_NONE); // disable the mouse
+    m_displayText->HideText(true); // hide
+    m_engine->SetScreenshotMode(true);
 
-        m_engine->SetScreenshotMode(false);
-        m_displayText->HideText(false);
-        m_app->SetMouseMode(oldMouseMode);
+    m_engine->Render(); // update (but don't show, we're not swapping buffers here!)
+    data->screenshot = m_engine->CaptureScreenShot();
+    data->screenshotFile = filescreenshot;
+    m_shotSaving++;
 
-        m_app->ResetTimeAfterLoading();
-    }
-    return true;
+    m_engine->SetScreenshotMode(false);
+    m_displayText->HideText(false);
+    m_app->SetMouseMode(oldMouseMode);
+
+    // Both jobs wait for the previous save, which may write to the same files
+    CJobSystem* jobs = CJobSystem::GetInstancePointer();
+    JobHandle screenshotJob = jobs->Schedule([data]() { WriteSceneScreenshot(*data); }, { m_saveJob });
+    JobHandle filesJob = jobs->Schedule([data]() { WriteSceneFiles(*data); }, { m_saveJob });
+    m_saveJob = jobs->Schedule([data]()
+    {
+        Event event(EVENT_WRITE_SCENE_FINISHED);
+        event.customParam = data->written ? 1 : 0;
+        CApplication::GetInstancePointer()->GetEventQueue()->AddEvent(std::move(event));
+    }, { screenshotJob, filesJob });
+
+    m_app->ResetTimeAfterLoading();
 }
 
 //! Notifies the user that scene write is finished
-void CRobotMain::IOWriteSceneFinished()
+void CRobotMain::IOWriteSceneFinished(bool success)
 {
-    m_displayText->DisplayError(INFO_WRITEOK, Math::Vector(0.0f,0.0f,0.0f));
+    m_displayText->DisplayError(success ? INFO_WRITEOK : INFO_WRITEFAILED, Math::Vector(0.0f,0.0f,0.0f));
     m_shotSaving--;
 }
 
+void CRobotMain::IOWaitForWrite()
+{
+    CJobSystem::GetInstancePointer()->Wait(m_saveJob);
+    m_saveJob.reset();
+}
+
 //! Resumes the game
 CObject* CRobotMain::IOReadObject(CLevelParserLine *line, const std::string& programDir, const std::string& objCounterText, float objectProgress, int objRank)
 {
@@ -4827,7 +4947,9 @@ CObject* CRobotMain::IOReadObject(CLevelParserLine *line, const std::string& pro
     #endif
     m_ui->GetLoadingScreen()->SetProgress(0.25f+objectProgress*0.7f, RT_LOADING_OBJECTS_SAVED, details);
 
+    m_assetPreloader->BeginObject(params.type);
     CObject* obj = m_objMan->CreateObject(params);
+    m_assetPreloader->EndObject();
 
     if (obj->Implements(ObjectInterfaceType::Old))
     {
@@ -4862,12 +4984,15 @@ CObject* CRobotMain::IOReadObject(CLevelParserLine *line, const std::string& pro
 //! Resumes some part of the game
 CObject* CRobotMain::IOReadScene(std::string filename, std::string filecbot)
 {
+    IOWaitForWrite();
+
     std::string dirname = filename.substr(0, filename.find_last_of("/"));
 
     CLevelParser levelParser(filename);
     levelParser.SetLevelPaths(m_levelCategory, m_levelChap, m_levelRank);
     levelParser.Load();
     int numObjects = levelParser.CountLines("CreateObject") + levelParser.CountLines("CreatePower") + levelParser.CountLines("CreateFret");
+    m_assetPreloader->Preload(levelParser);
 
     m_base = nullptr;
 
@@ -4940,10 +5065,30 @@ CObject* CRobotMain::IOReadScene(std::string filename, std::string filecbot)
 
     m_ui->GetLoadingScreen()->SetProgress(0.95f, RT_LOADING_CBOT_SAVE);
 
-    // Reads the file of stacks of execution.
-    CInputStream istr(filecbot);
+    // Reads the file of stacks of execution, all at once as it may be compressed
+    std::string cbotData;
+    CInputStream file(filecbot);
+    if (file.is_open())
+    {
+        cbotData.resize(file.size());
+        file.read(&cbotData[0], cbotData.size());
+        cbotData.resize(file.gcount());
+        file.close();
 
-    if (istr.is_open())
+        if (Compression::IsPacked(cbotData, CBOT_PACK_MAGIC))
+        {
+            std::string packed;
+            packed.swap(cbotData);
+            if (!Compression::Unpack(packed, CBOT_PACK_MAGIC, cbotData))
+            {
+                GetLogger()->Error("Corrupted file: %s\n", filecbot.c_str());
+                cbotData.clear();
+            }
+        }
+    }
+
+    std::istringstream istr(cbotData);
+    if (!cbotData.empty())
     {
         bool bError = false;
         long version = 0;
@@ -4981,8 +5126,7 @@ CObject* CRobotMain::IOReadScene(std::string filename, std::string filecbot)
                 GetLogger()->Error("cbot.run file is wrong version: %i\n", version);
         }
 
-        if (bError) GetLogger()->Error("Restoring CBOT state failed at stream position: %li\n", istr.tellg());
-        istr.close();
+        if (bError) GetLogger()->Error("Restoring CBOT state failed at stream position: %li\n", static_cast<long>(istr.tellg()));
     }
 
     m_ui->GetLoadingScreen()->SetProgress(1.0f, RT_LOADING_FINISHED);
@@ -5748,12 +5892,24 @@ int CRobotMain::GetAutosaveSlots()
     return m_autosaveSlots;
 }
 
+void CRobotMain::SetTextSaves(bool text)
+{
+    m_textSaves = text;
+}
+
+bool CRobotMain::GetTextSaves()
+{
+    return m_textSaves;
+}
+
 // Remove oldest saves with autosave prefix
 void CRobotMain::AutosaveRotate()
 {
     if (m_playerProfile == nullptr)
         return;
 
+    IOWaitForWrite();
+
     GetLogger()->Debug("Rotate autosaves...\n");
     auto saveDirs = CResourceManager::ListDirectories(m_playerProfile->GetSaveDir());
     const std::string autosavePrefix = "autosave";
@@ -82,6 +82,8 @@ bool IsMainMenuPhase(Phase phase);
 
 
 class CEventQueue;
+class CJob;
+class CAssetPreloader;
 class CSoundInterface;
 class CLevelParserLine;
 class CInput;
@@ -329,8 +331,12 @@ public:
      */
     //@{
     bool        IOIsBusy();
-    bool        IOWriteScene(std::string filename, std::string filecbot, std::string filescreenshot, const std::string& info, bool emergencySave = false);
-    void        IOWriteSceneFinished();
+    //! Saves the current game; the result is sent with EVENT_WRITE_SCENE_FINISHED, see the implementation
+    void        IOWriteScene(std::string filename, std::string filecbot, std::string filescreenshot, const std::string& info, bool emergencySave = false);
+    //! Shows the result of a save written in the background
+    void        IOWriteSceneFinished(bool success);
+    //! Waits until saved games being written in the background are finished
+    void        IOWaitForWrite();
     CObject*    IOReadScene(std::string filename, std::string filecbot);
     void        IOWriteObject(CLevelParserLine *line, CObject* obj, const std::string& programDir, int objRank);
     CObject*    IOReadObject(CLevelParserLine *line, const std::string& programDir, const std::string& objCounterText, float objectProgress, int objRank = -1);
@@ -365,6 +371,10 @@ public:
     int         GetAutosaveSlots();
     //@}
 
+    //! Enable saving games as text files instead of the compressed binary format
+    void        SetTextSaves(bool text);
+    bool        GetTextSaves();
+
     //! Enable mode where completing mission closes the game
     void        SetExitAfterMission(bool exit);
 
@@ -563,6 +573,7 @@ protected:
     CSoundInterface*    m_sound = nullptr;
     CInput*             m_input = nullptr;
     std::unique_ptr<CObjectManager> m_objMan;
+    std::unique_ptr<CAssetPreloader> m_assetPreloader;
     std::unique_ptr<CMainMovie> m_movie;
     std::unique_ptr<CPauseManager> m_pause;
     std::unique_ptr<Gfx::CModelManager> m_modelManager;
@@ -727,7 +738,11 @@ protected:
     int             m_autosaveSlots = 0;
     float           m_autosaveLast = 0.0f;
 
+    bool            m_textSaves = false;
+
     int             m_shotSaving = 0;
+    //! Last job of the saved game being written, see IOWriteScene()
+    std::shared_ptr<CJob> m_saveJob;
 
     std::deque<CObject*> m_selectionHistory;
     bool            m_debugCrashSpheres;
@@ -599,6 +599,40 @@ inline bool IntersectY(const Math::Vector &a, const Math::Vector &b, const Math:
     return true;
 }
 
+//! Calculates the intersection of the ray \a origin + t * \a dir with the triangle \a a, \a b, \a c
+/**
+ * Both faces of the triangle are tested.
+ * \param t      ray parameter of the hit, only valid if the function returns true
+ * \returns true if the ray hits the triangle at t >= 0
+ */
+inline bool IntersectRayTriangle(const Math::Vector &origin, const Math::Vector &dir,
+                                 const Math::Vector &a, const Math::Vector &b, const Math::Vector &c,
+                                 float &t)
+{
+    Math::Vector e1 = b - a;
+    Math::Vector e2 = c - a;
+    Math::Vector p = CrossProduct(dir, e2);
+
+    float det = DotProduct(e1, p);
+    if (fabs(det) < 1e-12f)
+        return false;
+
+    float invDet = 1.0f / det;
+
+    Math::Vector s = origin - a;
+    float u = DotProduct(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    Math::Vector q = CrossProduct(s, e1);
+    float v = DotProduct(dir, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    t = DotProduct(e2, q) * invDet;
+    return t >= 0.0f;
+}
+
 //! Calculates the end point
 inline Math::Vector LookatPoint(const Math::Vector &eye, float angleH, float angleV, float length)
 {
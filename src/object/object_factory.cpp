@@ -53,6 +53,54 @@
 
 using COldObjectUPtr = std::unique_ptr<COldObject>;
 
+namespace
+{
+
+//! Returns the model of a resource, empty for other types
+std::string GetResourceModel(ObjectType type)
+{
+    std::string name;
+    if ( type == OBJECT_STONE       )  name = "stone.mod";
+    if ( type == OBJECT_URANIUM     )  name = "uranium.mod";
+    if ( type == OBJECT_METAL       )  name = "metal.mod";
+    if ( type == OBJECT_POWER       )  name = "power.mod";
+    if ( type == OBJECT_ATOMIC      )  name = "atomic.mod";
+    if ( type == OBJECT_BULLET      )  name = "bullet.mod";
+    if ( type == OBJECT_BBOX        )  name = "bbox.mod";
+    if ( type == OBJECT_KEYa        )  name = "keya.mod";
+    if ( type == OBJECT_KEYb        )  name = "keyb.mod";
+    if ( type == OBJECT_KEYc        )  name = "keyc.mod";
+    if ( type == OBJECT_KEYd        )  name = "keyd.mod";
+    if ( type == OBJECT_TNT         )  name = "tnt.mod";
+    if ( type == OBJECT_BOMB        )  name = "bomb.mod";
+    if ( type == OBJECT_WAYPOINT    )  name = "waypoint.mod";
+    if ( type == OBJECT_SHOW        )  name = "show.mod";
+    if ( type == OBJECT_WINFIRE     )  name = "winfire.mod";
+    if ( type == OBJECT_BAG         )  name = "bag.mod";
+    if ( type == OBJECT_MARKSTONE   )  name = "cross1.mod";
+    if ( type == OBJECT_MARKURANIUM )  name = "cross3.mod";
+    if ( type == OBJECT_MARKPOWER   )  name = "cross2.mod";
+    if ( type == OBJECT_MARKKEYa    )  name = "crossa.mod";
+    if ( type == OBJECT_MARKKEYb    )  name = "crossb.mod";
+    if ( type == OBJECT_MARKKEYc    )  name = "crossc.mod";
+    if ( type == OBJECT_MARKKEYd    )  name = "crossd.mod";
+    if ( type == OBJECT_EGG         )  name = "egg.mod";
+    return name;
+}
+
+//! Returns the letter of the color of a flag in the names of its models, 0 for other types
+char GetFlagColor(ObjectType type)
+{
+    if ( type == OBJECT_FLAGb )  return 'b';
+    if ( type == OBJECT_FLAGr )  return 'r';
+    if ( type == OBJECT_FLAGg )  return 'g';
+    if ( type == OBJECT_FLAGy )  return 'y';
+    if ( type == OBJECT_FLAGv )  return 'v';
+    return 0;
+}
+
+} // anonymous namespace
+
 CObjectFactory::CObjectFactory(Gfx::CEngine* engine,
                                Gfx::CTerrain* terrain,
                                Gfx::COldModelManager* oldModelManager,
@@ -65,6 +113,19 @@ CObjectFactory::CObjectFactory(Gfx::CEngine* engine,
    , m_particle(particle)
 {}
 
+std::vector<std::string> CObjectFactory::GetFixedModels(ObjectType type)
+{
+    std::string resource = GetResourceModel(type);
+    if (!resource.empty())
+        return { resource };
+
+    char flagColor = GetFlagColor(type);
+    if (flagColor != 0)
+        return { std::string("flag1") + flagColor + ".mod", std::string("flag2") + flagColor + ".mod" };
+
+    return {};
+}
+
 CObjectUPtr CObjectFactory::CreateObject(const ObjectCreateParams& params)
 {
     if (CStaticObject::IsStaticObject(params.type))
@@ -345,32 +406,7 @@ CObjectUPtr CObjectFactory::CreateResource(const ObjectCreateParams& params)
     obj->SetObjectRank(0, rank);
     obj->SetEnergyLevel(power);
 
-    std::string name;
-    if ( type == OBJECT_STONE       )  name = "stone.mod";
-    if ( type == OBJECT_URANIUM     )  name = "uranium.mod";
-    if ( type == OBJECT_METAL       )  name = "metal.mod";
-    if ( type == OBJECT_POWER       )  name = "power.mod";
-    if ( type == OBJECT_ATOMIC      )  name = "atomic.mod";
-    if ( type == OBJECT_BULLET      )  name = "bullet.mod";
-    if ( type == OBJECT_BBOX        )  name = "bbox.mod";
-    if ( type == OBJECT_KEYa        )  name = "keya.mod";
-    if ( type == OBJECT_KEYb        )  name = "keyb.mod";
-    if ( type == OBJECT_KEYc        )  name = "keyc.mod";
-    if ( type == OBJECT_KEYd        )  name = "keyd.mod";
-    if ( type == OBJECT_TNT         )  name = "tnt.mod";
-    if ( type == OBJECT_BOMB        )  name = "bomb.mod";
-    if ( type == OBJECT_WAYPOINT    )  name = "waypoint.mod";
-    if ( type == OBJECT_SHOW        )  name = "show.mod";
-    if ( type == OBJECT_WINFIRE     )  name = "winfire.mod";
-    if ( type == OBJECT_BAG         )  name = "bag.mod";
-    if ( type == OBJECT_MARKSTONE   )  name = "cross1.mod";
-    if ( type == OBJECT_MARKURANIUM )  name = "cross3.mod";
-    if ( type == OBJECT_MARKPOWER   )  name = "cross2.mod";
-    if ( type == OBJECT_MARKKEYa    )  name = "crossa.mod";
-    if ( type == OBJECT_MARKKEYb    )  name = "crossb.mod";
-    if ( type == OBJECT_MARKKEYc    )  name = "crossc.mod";
-    if ( type == OBJECT_MARKKEYd    )  name = "crossd.mod";
-    if ( type == OBJECT_EGG         )  name = "egg.mod";
+    std::string name = GetResourceModel(type);
 
     if (type == OBJECT_POWER || type == OBJECT_ATOMIC)
     {
@@ -455,14 +491,7 @@ CObjectUPtr CObjectFactory::CreateFlag(const ObjectCreateParams& params)
     obj->SetType(type);
     obj->SetTeam(params.team);
 
-    std::string name;
-
-    name = "";
-    if ( type == OBJECT_FLAGb )  name = "flag1b.mod";
-    if ( type == OBJECT_FLAGr )  name = "flag1r.mod";
-    if ( type == OBJECT_FLAGg )  name = "flag1g.mod";
-    if ( type == OBJECT_FLAGy )  name = "flag1y.mod";
-    if ( type == OBJECT_FLAGv )  name = "flag1v.mod";
+    std::string name = std::string("flag1") + GetFlagColor(type) + ".mod";
 
     int rank = m_engine->CreateObject();
     m_engine->SetObjectType(rank, Gfx::ENG_OBJTYPE_FIX);  // it is a stationary object
@@ -471,12 +500,7 @@ CObjectUPtr CObjectFactory::CreateFlag(const ObjectCreateParams& params)
     obj->SetPosition(pos);
     obj->SetRotationY(angle);
 
-    name = "";
-    if ( type == OBJECT_FLAGb )  name = "flag2b.mod";
-    if ( type == OBJECT_FLAGr )  name = "flag2r.mod";
-    if ( type == OBJECT_FLAGg )  name = "flag2g.mod";
-    if ( type == OBJECT_FLAGy )  name = "flag2y.mod";
-    if ( type == OBJECT_FLAGv )  name = "flag2v.mod";
+    name = std::string("flag2") + GetFlagColor(type) + ".mod";
 
     for (int i=0 ; i<4 ; i++ )
     {
@@ -29,6 +29,8 @@
 #include "object/object_type.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace Gfx
 {
@@ -56,6 +58,9 @@ public:
 
     CObjectUPtr CreateObject(const ObjectCreateParams& params);
 
+    //! Returns model files used by every object of given type, empty if they depend on more than the type
+    static std::vector<std::string> GetFixedModels(ObjectType type);
+
 private:
     CObjectUPtr CreateResource(const ObjectCreateParams& params);
     CObjectUPtr CreateFlag(const ObjectCreateParams& params);
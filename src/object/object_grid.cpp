@@ -0,0 +1,267 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/object_grid.h"
+
+#include "math/geometry.h"
+
+#include "object/object.h"
+
+#include "object/subclass/shielder.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+
+//! Number of cells along each axis
+const int GRID_SIZE = 64;
+//! Size of a cell in world units
+const float GRID_CELL_SIZE = 16.0f;
+
+//! Check if an object is a destroyable enemy
+bool IsAlien(ObjectType type)
+{
+    return ( type == OBJECT_ANT      ||
+             type == OBJECT_SPIDER   ||
+             type == OBJECT_BEE      ||
+             type == OBJECT_WORM     ||
+             type == OBJECT_MOTHER   ||
+             type == OBJECT_NEST     ||
+             type == OBJECT_BULLET   ||
+             type == OBJECT_EGG      ||
+             type == OBJECT_TEEN28   ||
+             type == OBJECT_TEEN31   );
+}
+
+} // anonymous namespace
+
+
+CObjectGrid::CObjectGrid()
+    : m_cells(GRID_SIZE*GRID_SIZE),
+      m_queryStamp(0),
+      m_updateStamp(0)
+{
+}
+
+CObjectGrid::~CObjectGrid()
+{
+}
+
+void CObjectGrid::Clear()
+{
+    m_entries.clear();
+    m_freeEntries.clear();
+    m_objectEntries.clear();
+    for (auto& cell : m_cells)
+        cell.clear();
+}
+
+int CObjectGrid::GetCellCoord(float coord)
+{
+    return static_cast<int>(floorf(coord / GRID_CELL_SIZE));
+}
+
+std::vector<int>& CObjectGrid::GetCell(int x, int z)
+{
+    x %= GRID_SIZE;
+    z %= GRID_SIZE;
+    if (x < 0) x += GRID_SIZE;
+    if (z < 0) z += GRID_SIZE;
+    return m_cells[z*GRID_SIZE + x];
+}
+
+void CObjectGrid::Update(const std::vector<CObject*>& objects)
+{
+    m_updateStamp++;
+
+    for (CObject* object : objects)
+    {
+        Math::Vector center = object->GetPosition();
+
+        // Objects without a sphere in the center (station) are hit at their center
+        float radius = 4.0f;
+        for (const auto& crashSphere : object->GetAllCrashSpheres())
+            radius = std::max(radius, Math::Distance(center, crashSphere.sphere.pos) + crashSphere.sphere.radius);
+
+        unsigned int flags = 0;
+        ObjectType type = object->GetType();
+        if (IsAlien(type))          flags |= OBJECT_GRID_ALIEN;
+        if (type == OBJECT_MOTHER)  flags |= OBJECT_GRID_MOTHER;
+        if (type == OBJECT_TOTO)    flags |= OBJECT_GRID_TOTO;
+
+        if ( (object->Implements(ObjectInterfaceType::Damageable) || object->IsBulletWall()) &&
+             !object->Implements(ObjectInterfaceType::Jostleable) )
+        {
+            flags |= OBJECT_GRID_SHOOTABLE;
+        }
+
+        if (type == OBJECT_MOBILErs)
+        {
+            flags |= OBJECT_GRID_SHIELDER;
+            CShielder* shielder = dynamic_cast<CShielder*>(object);
+            if (shielder != nullptr)
+                radius = std::max(radius, shielder->GetActiveShieldRadius());
+        }
+
+        SetObject(object, center, radius, flags);
+    }
+
+    // Objects not given any more were deleted
+    for (int index = 0; index < static_cast<int>(m_entries.size()); index++)
+    {
+        Entry& entry = m_entries[index];
+        if (entry.object == nullptr || entry.updateStamp == m_updateStamp) continue;
+
+        RemoveEntry(index);
+        m_objectEntries.erase(entry.object);
+        entry.object = nullptr;
+        m_freeEntries.push_back(index);
+    }
+}
+
+void CObjectGrid::SetObject(CObject* object, const Math::Vector& center, float radius, unsigned int flags)
+{
+    int index;
+    auto it = m_objectEntries.find(object);
+    if (it != m_objectEntries.end())
+    {
+        index = it->second;
+    }
+    else
+    {
+        if (!m_freeEntries.empty())
+        {
+            index = m_freeEntries.back();
+            m_freeEntries.pop_back();
+        }
+        else
+        {
+            index = m_entries.size();
+            m_entries.push_back(Entry());
+        }
+        m_objectEntries[object] = index;
+        m_entries[index] = Entry();
+        m_entries[index].object = object;
+    }
+
+    Entry& entry = m_entries[index];
+    entry.center = center;
+    entry.radius = radius;
+    entry.flags = flags;
+    entry.updateStamp = m_updateStamp;
+
+    int x1 = GetCellCoord(center.x - radius);
+    int x2 = GetCellCoord(center.x + radius);
+    int z1 = GetCellCoord(center.z - radius);
+    int z2 = GetCellCoord(center.z + radius);
+    x2 = std::min(x2, x1 + GRID_SIZE - 1);  // wrapped cells are visited only once
+    z2 = std::min(z2, z1 + GRID_SIZE - 1);
+
+    // Most objects don't leave their cells between updates
+    if (x1 == entry.x1 && x2 == entry.x2 && z1 == entry.z1 && z2 == entry.z2)
+        return;
+
+    RemoveEntry(index);
+    entry.x1 = x1;
+    entry.x2 = x2;
+    entry.z1 = z1;
+    entry.z2 = z2;
+    InsertEntry(index);
+}
+
+void CObjectGrid::InsertEntry(int index)
+{
+    const Entry& entry = m_entries[index];
+    for (int z = entry.z1; z <= entry.z2; z++)
+    {
+        for (int x = entry.x1; x <= entry.x2; x++)
+            GetCell(x, z).push_back(index);
+    }
+}
+
+void CObjectGrid::RemoveEntry(int index)
+{
+    const Entry& entry = m_entries[index];
+    for (int z = entry.z1; z <= entry.z2; z++)
+    {
+        for (int x = entry.x1; x <= entry.x2; x++)
+        {
+            std::vector<int>& cell = GetCell(x, z);
+            auto it = std::find(cell.begin(), cell.end(), index);
+            if (it == cell.end()) continue;
+
+            *it = cell.back();
+            cell.pop_back();
+        }
+    }
+}
+
+void CObjectGrid::FindNearSegment(const Math::Vector& a, const Math::Vector& b, float margin,
+                                  unsigned int required, unsigned int excluded,
+                                  std::vector<CObject*>& result)
+{
+    result.clear();
+    m_queryStamp++;
+
+    Math::Vector box1 = a;
+    Math::Vector box2 = b;
+    if (box1.x > box2.x)  Math::Swap(box1.x, box2.x);  // box1 < box2
+    if (box1.y > box2.y)  Math::Swap(box1.y, box2.y);
+    if (box1.z > box2.z)  Math::Swap(box1.z, box2.z);
+    box1.x -= margin;
+    box1.y -= margin;
+    box1.z -= margin;
+    box2.x += margin;
+    box2.y += margin;
+    box2.z += margin;
+
+    int x1 = GetCellCoord(box1.x);
+    int x2 = std::min(GetCellCoord(box2.x), x1 + GRID_SIZE - 1);
+    int z1 = GetCellCoord(box1.z);
+    int z2 = std::min(GetCellCoord(box2.z), z1 + GRID_SIZE - 1);
+
+    for (int z = z1; z <= z2; z++)
+    {
+        for (int x = x1; x <= x2; x++)
+        {
+            for (int index : GetCell(x, z))
+            {
+                Entry& entry = m_entries[index];
+                if (entry.queryStamp == m_queryStamp) continue;
+                entry.queryStamp = m_queryStamp;
+
+                if ((entry.flags & required) != required) continue;
+                if ((entry.flags & excluded) != 0) continue;
+
+                if ( entry.center.x+entry.radius < box1.x || entry.center.x-entry.radius > box2.x ||  // outside the box?
+                     entry.center.y+entry.radius < box1.y || entry.center.y-entry.radius > box2.y ||
+                     entry.center.z+entry.radius < box1.z || entry.center.z-entry.radius > box2.z )  continue;
+
+                result.push_back(entry.object);
+            }
+        }
+    }
+
+    // Same order as CObjectManager::GetAllObjects()
+    std::sort(result.begin(), result.end(),
+              [](CObject* left, CObject* right) { return left->GetID() < right->GetID(); });
+}
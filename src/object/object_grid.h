@@ -0,0 +1,118 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file object/object_grid.h
+ * \brief Spatial index of objects - CObjectGrid class
+ */
+
+#pragma once
+
+#include "math/vector.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+class CObject;
+
+/**
+ * \enum ObjectGridFlag
+ * \brief Categories of objects in CObjectGrid, used as bitmask filters of queries
+ */
+enum ObjectGridFlag
+{
+    OBJECT_GRID_ALIEN     = 1 << 0,   //!< destroyable enemy (ant, spider, nest, ...)
+    OBJECT_GRID_MOTHER    = 1 << 1,   //!< alien queen
+    OBJECT_GRID_TOTO      = 1 << 2,   //!< robot helper
+    OBJECT_GRID_SHOOTABLE = 1 << 3,   //!< can be hit by shots (damageable or bullet wall, not jostleable)
+    OBJECT_GRID_SHIELDER  = 1 << 4,   //!< shielder, may have an active shield
+};
+
+/**
+ * \class CObjectGrid
+ * \brief Uniform grid of objects in the XZ plane, for finding objects near a point or a segment
+ *
+ * Each object is represented by a sphere containing its position, its crash spheres
+ * and its active shield, and is registered in all cells touched by that sphere.
+ * The grid doesn't follow objects; it has to be updated after they moved or
+ * were created or deleted, see CObjectManager::GetObjectGrid(). An update moves
+ * only the objects whose sphere now touches other cells.
+ *
+ * Cells are addressed modulo the size of the grid, so the grid covers any terrain;
+ * objects found in wrapped cells are rejected by the bounding test.
+ */
+class CObjectGrid
+{
+public:
+    CObjectGrid();
+    ~CObjectGrid();
+
+    //! Removes all objects
+    void        Clear();
+    //! Adds or updates given objects, computing their bounds and flags, and removes all other objects
+    void        Update(const std::vector<CObject*>& objects);
+    //! Adds an object with given bounds and flags, or updates it if it's already in the grid
+    void        SetObject(CObject* object, const Math::Vector& center, float radius, unsigned int flags);
+
+    /**
+     * \brief Finds objects whose bounding sphere touches the bounding box of a segment
+     * \param a, b      ends of the segment
+     * \param margin    distance added to the box in all directions
+     * \param required  flags the objects must all have
+     * \param excluded  flags the objects must not have any of
+     * \param result    receives the objects, ordered by their ID
+     */
+    void        FindNearSegment(const Math::Vector& a, const Math::Vector& b, float margin,
+                                unsigned int required, unsigned int excluded,
+                                std::vector<CObject*>& result);
+
+protected:
+    struct Entry
+    {
+        CObject*        object = nullptr;
+        Math::Vector    center;
+        float           radius = 0.0f;
+        unsigned int    flags = 0;
+        //! Number of the last query which found the entry, for removing duplicates
+        int             queryStamp = 0;
+        //! Number of the last Update() which included the object
+        int             updateStamp = 0;
+        //! Cell coordinates of the cells which contain the entry, inclusive
+        int             x1 = 0, z1 = 0, x2 = -1, z2 = -1;
+    };
+
+    //! Returns cell coordinate of given world coordinate
+    static int  GetCellCoord(float coord);
+    //! Returns the cell of given cell coordinates
+    std::vector<int>& GetCell(int x, int z);
+    //! Adds the entry to its cells, or removes it from them
+    void        InsertEntry(int index);
+    void        RemoveEntry(int index);
+
+protected:
+    //! Entries of objects, entries of removed objects have a null object and are reused
+    std::vector<Entry>              m_entries;
+    std::vector<int>                m_freeEntries;
+    std::unordered_map<CObject*, int> m_objectEntries;
+    //! Indexes of entries by cell, GRID_SIZE x GRID_SIZE cells
+    std::vector<std::vector<int>>   m_cells;
+    int                             m_queryStamp;
+    int                             m_updateStamp;
+};
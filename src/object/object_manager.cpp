@@ -28,6 +28,7 @@
 #include "object/object_create_exception.h"
 #include "object/object_create_params.h"
 #include "object/object_factory.h"
+#include "object/object_grid.h"
 #include "object/old_object.h"
 
 #include "object/auto/auto.h"
@@ -46,6 +47,8 @@ CObjectManager::CObjectManager(Gfx::CEngine* engine,
                                                oldModelManager,
                                                modelManager,
                                                particle)),
+    m_grid(MakeUnique<CObjectGrid>()),
+    m_gridValid(false),
     m_nextId(0),
     m_activeObjectIterators(0),
     m_shouldCleanRemovedObjects(false)
@@ -70,6 +73,7 @@ bool CObjectManager::DeleteObject(CObject* instance)
     {
         it->second.reset();
         m_shouldCleanRemovedObjects = true;
+        m_gridValid = false;
         return true;
     } else assert(false);
 
@@ -108,6 +112,7 @@ void CObjectManager::DeleteAllObjects()
     }
 
     m_objects.clear();
+    m_gridValid = false;
 
     m_nextId = 0;
 }
@@ -154,10 +159,31 @@ CObject* CObjectManager::CreateObject(ObjectCreateParams params)
     CObject* objectPtr = objectUPtr.get();
 
     m_objects[params.id] = std::move(objectUPtr);
+    m_gridValid = false;
 
     return objectPtr;
 }
 
+CObjectGrid* CObjectManager::GetObjectGrid()
+{
+    if (!m_gridValid)
+    {
+        m_gridObjects.clear();
+        for (CObject* object : GetAllObjects())
+            m_gridObjects.push_back(object);
+        m_grid->Update(m_gridObjects);
+
+        m_gridValid = true;
+    }
+
+    return m_grid.get();
+}
+
+void CObjectManager::InvalidateObjectGrid()
+{
+    m_gridValid = false;
+}
+
 CObject* CObjectManager::CreateObject(Math::Vector pos, float angle, ObjectType type, float power)
 {
     ObjectCreateParams params;
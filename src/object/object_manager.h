@@ -50,6 +50,7 @@ class CTerrain;
 
 class CObject;
 class CObjectFactory;
+class CObjectGrid;
 
 enum RadarFilter
 {
@@ -187,6 +188,11 @@ public:
     //! Counts all objects implementing given interface
     int CountObjectsImplementing(ObjectInterfaceType interface);
 
+    //! Returns the spatial index of all objects, updating it if outdated
+    CObjectGrid* GetObjectGrid();
+    //! Marks the spatial index as outdated; to be called after objects moved
+    void InvalidateObjectGrid();
+
     //! Returns all objects
     CObjectContainerProxy GetAllObjects()
     {
@@ -310,6 +316,10 @@ private:
 private:
     CObjectMap m_objects;
     std::unique_ptr<CObjectFactory> m_objectFactory;
+    std::unique_ptr<CObjectGrid> m_grid;
+    bool m_gridValid;
+    //! Buffer for the objects given to m_grid
+    std::vector<CObject*> m_gridObjects;
     int m_nextId;
     int m_activeObjectIterators;
     bool m_shouldCleanRemovedObjects;
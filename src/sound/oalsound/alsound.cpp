@@ -32,13 +32,13 @@ CALSound::CALSound()
       m_musicVolume(1.0f),
       m_channelsLimit(2048),
       m_device{},
-      m_context{},
-      m_thread("Music loading thread")
+      m_context{}
 {
 }
 
 CALSound::~CALSound()
 {
+    WaitForCacheMusic();
     CleanUp();
 }
 
@@ -86,6 +86,8 @@ bool CALSound::Create()
 
 void CALSound::Reset()
 {
+    WaitForCacheMusic();
+
     StopAll();
     StopMusic();
 
@@ -150,17 +152,54 @@ bool CALSound::Cache(SoundType sound, const std::string &filename)
 
 void CALSound::CacheMusic(const std::string &filename)
 {
-    m_thread.Start([this, filename]()
+    m_musicJobsMutex.Lock();
+    bool started = m_musicJobs.find(filename) != m_musicJobs.end();
+    if (!started)
     {
-        if (m_music.find(filename) == m_music.end())
+        // Files are opened in parallel, but m_music is changed only in music jobs
+        auto stream = std::make_shared<CStream>();
+        m_musicJobs[filename] = CJobSystem::GetInstancePointer()->Schedule([this, filename, stream]()
         {
-            auto buffer = MakeUnique<CBuffer>();
-            if (buffer->LoadFromFile(filename, static_cast<SoundType>(-1)))
+            if (!stream->Open(filename))
             {
-                m_music[filename] = std::move(buffer);
+                return;
             }
-        }
-    });
+
+            StartMusicJob([this, filename, stream]()
+            {
+                if (m_music.find(filename) == m_music.end())
+                {
+                    m_music[filename] = stream;
+                }
+            });
+        });
+    }
+    m_musicJobsMutex.Unlock();
+}
+
+void CALSound::WaitForCacheMusic()
+{
+    std::map<std::string, JobHandle> jobs;
+    m_musicJobsMutex.Lock();
+    jobs.swap(m_musicJobs);
+    m_musicJobsMutex.Unlock();
+
+    for (auto& job : jobs)
+    {
+        CJobSystem::GetInstancePointer()->Wait(job.second);
+    }
+
+    m_lastMusicJobMutex.Lock();
+    JobHandle last = m_lastMusicJob;
+    m_lastMusicJobMutex.Unlock();
+    CJobSystem::GetInstancePointer()->Wait(last);
+}
+
+void CALSound::StartMusicJob(std::function<void()> func)
+{
+    m_lastMusicJobMutex.Lock();
+    m_lastMusicJob = CJobSystem::GetInstancePointer()->Schedule(std::move(func), { m_lastMusicJob });
+    m_lastMusicJobMutex.Unlock();
 }
 
 bool CALSound::IsCached(SoundType sound)
@@ -542,6 +581,13 @@ void CALSound::FrameMove(float rTime)
         }
     }
 
+    RefillMusic(m_currentMusic.get());
+    RefillMusic(m_previousMusic.music.get());
+    for (auto& old : m_oldMusic)
+    {
+        RefillMusic(old.music.get());
+    }
+
     auto it = m_oldMusic.begin();
     while (it != m_oldMusic.end())
     {
@@ -571,6 +617,23 @@ void CALSound::FrameMove(float rTime)
     }
 }
 
+void CALSound::RefillMusic(CChannel* music)
+{
+    if (music == nullptr)
+    {
+        return;
+    }
+
+    std::shared_ptr<CStream> stream = music->GetStream();
+    if (stream != nullptr && stream->RequestRefill())
+    {
+        StartMusicJob([stream]()
+        {
+            stream->Refill();
+        });
+    }
+}
+
 void CALSound::SetListener(const Math::Vector &eye, const Math::Vector &lookat)
 {
     m_eye = eye;
@@ -590,27 +653,38 @@ void CALSound::PlayMusic(const std::string &filename, bool repeat, float fadeTim
         return;
     }
 
-    m_thread.Start([this, filename, repeat, fadeTime]()
+    StartMusicJob([this, filename, repeat, fadeTime]()
     {
-        CBuffer* buffer = nullptr;
+        std::shared_ptr<CStream> stream;
 
         // check if we have music in cache
-        if (m_music.find(filename) == m_music.end())
+        auto it = m_music.find(filename);
+        if (it == m_music.end())
         {
             GetLogger()->Debug("Music %s was not cached!\n", filename.c_str());
 
-            auto newBuffer = MakeUnique<CBuffer>();
-            buffer = newBuffer.get();
-            if (!newBuffer->LoadFromFile(filename, static_cast<SoundType>(-1)))
+            stream = std::make_shared<CStream>();
+            if (!stream->Open(filename))
+            {
+                return;
+            }
+            m_music[filename] = stream;
+        }
+        else if (it->second.use_count() > 1)
+        {
+            // The cached stream is still used, e.g. by the same music fading out
+            GetLogger()->Debug("Music %s is already playing, opening it again\n", filename.c_str());
+
+            stream = std::make_shared<CStream>();
+            if (!stream->Open(filename))
             {
                 return;
             }
-            m_music[filename] = std::move(newBuffer);
         }
         else
         {
             GetLogger()->Debug("Music loaded from cache\n");
-            buffer = m_music[filename].get();
+            stream = it->second;
         }
 
         if (m_currentMusic)
@@ -623,7 +697,7 @@ void CALSound::PlayMusic(const std::string &filename, bool repeat, float fadeTim
         }
 
         m_currentMusic = MakeUnique<CChannel>();
-        m_currentMusic->SetBuffer(buffer);
+        m_currentMusic->SetStream(stream);
         m_currentMusic->SetVolume(m_musicVolume);
         m_currentMusic->SetLoop(repeat);
         m_currentMusic->Play();
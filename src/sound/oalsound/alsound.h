@@ -26,11 +26,13 @@
 
 #include "sound/sound.h"
 
-#include "common/thread/worker_thread.h"
+#include "common/thread/job_system.h"
+#include "common/thread/sdl_mutex_wrapper.h"
 
 #include "sound/oalsound/buffer.h"
 #include "sound/oalsound/channel.h"
 #include "sound/oalsound/check.h"
+#include "sound/oalsound/stream.h"
 
 #include <map>
 #include <memory>
@@ -121,6 +123,12 @@ private:
     int GetPriority(SoundType);
     bool SearchFreeBuffer(SoundType sound, int &channel, bool &alreadyLoaded);
     bool CheckChannel(int &channel);
+    //! Decodes more of music playing in given channel in a music job, if needed
+    void RefillMusic(CChannel* music);
+    //! Waits until music started by CacheMusic() is opened and added to the cache
+    void WaitForCacheMusic();
+    //! Schedules a job using m_music and music channels, after all such jobs scheduled before
+    void StartMusicJob(std::function<void()> func);
 
     bool m_enabled;
     float m_audioVolume;
@@ -129,12 +137,18 @@ private:
     ALCdevice* m_device;
     ALCcontext* m_context;
     std::map<SoundType, std::unique_ptr<CBuffer>> m_sounds;
-    std::map<std::string, std::unique_ptr<CBuffer>> m_music;
+    //! Streams of cached music, with their first buffers already decoded
+    std::map<std::string, std::shared_ptr<CStream>> m_music;
     std::map<int, std::unique_ptr<CChannel>> m_channels;
     std::unique_ptr<CChannel> m_currentMusic;
     std::list<OldMusic> m_oldMusic;
     OldMusic m_previousMusic;
     Math::Vector m_eye;
     Math::Vector m_lookat;
-    CWorkerThread m_thread;
+    //! Last job started by StartMusicJob(), music jobs are chained so they run one at a time
+    JobHandle m_lastMusicJob;
+    CSDLMutexWrapper m_lastMusicJobMutex;
+    //! Jobs opening music started by CacheMusic(), by file name
+    std::map<std::string, JobHandle> m_musicJobs;
+    CSDLMutexWrapper m_musicJobsMutex;
 };
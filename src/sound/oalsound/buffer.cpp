@@ -73,18 +73,25 @@ bool CBuffer::LoadFromFile(std::string filename, SoundType sound)
         return false;
     }
 
-    // read chunks of 4096 samples
-    std::vector<uint16_t> data;
-    std::array<int16_t, 4096> buffer;
-    data.reserve(file->GetFileInfo().frames);
+    // decode the whole file at once into memory allocated once, short effects only
+    std::vector<int16_t> data(file->GetFileInfo().frames * file->GetFileInfo().channels);
     std::size_t read = 0;
-    while ((read = file->Read(buffer.data(), buffer.size())) != 0)
+    while (read < data.size())
     {
-        data.insert(data.end(), buffer.begin(), buffer.begin() + read);
+        sf_count_t count = file->Read(data.data() + read, data.size() - read);
+        if (count <= 0) break;
+        read += count;
+    }
+    if (read == 0)
+    {
+        GetLogger()->Warn("Could not decode file %s\n", filename.c_str());
+        alDeleteBuffers(1, &m_buffer);
+        m_loaded = false;
+        return false;
     }
 
     ALenum format = file->GetFileInfo().channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-    alBufferData(m_buffer, format, &data.front(), data.size() * sizeof(uint16_t), file->GetFileInfo().samplerate);
+    alBufferData(m_buffer, format, data.data(), read * sizeof(int16_t), file->GetFileInfo().samplerate);
     m_duration = static_cast<float>(file->GetFileInfo().frames) / file->GetFileInfo().samplerate;
     m_loaded = true;
     return true;
@@ -21,9 +21,11 @@
 #include "sound/oalsound/channel.h"
 
 #include "sound/oalsound/buffer.h"
+#include "sound/oalsound/stream.h"
 
 CChannel::CChannel()
     : m_buffer(nullptr),
+      m_stream(),
       m_source(0),
       m_priority(0),
       m_id(0),
@@ -51,6 +53,9 @@ CChannel::CChannel()
 
 CChannel::~CChannel()
 {
+    if (m_stream != nullptr)
+        m_stream->Detach();
+
     if (m_ready)
     {
         alSourceStop(m_source);
@@ -63,12 +68,24 @@ CChannel::~CChannel()
 
 bool CChannel::Play()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
 
-    alSourcei(m_source, AL_LOOPING, static_cast<ALint>(m_loop));
+    if (m_stream != nullptr)
+    {
+        // Streams loop by themselves, a paused stream is only resumed
+        m_stream->SetLoop(m_loop);
+        ALint status = 0;
+        alGetSourcei(m_source, AL_SOURCE_STATE, &status);
+        if (status != AL_PAUSED && !m_stream->Start())
+            return false;
+    }
+    else
+    {
+        alSourcei(m_source, AL_LOOPING, static_cast<ALint>(m_loop));
+    }
     alSourcei(m_source, AL_REFERENCE_DISTANCE, 10.0f);
     alSourcei(m_source, AL_MAX_DISTANCE, 110.0f);
     alSourcePlay(m_source);
@@ -96,7 +113,7 @@ bool CChannel::Pause()
 
 bool CChannel::SetPosition(const Math::Vector &pos, bool relativeToListener)
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
@@ -113,7 +130,7 @@ bool CChannel::SetPosition(const Math::Vector &pos, bool relativeToListener)
 
 bool CChannel::SetFrequency(float freq)
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
@@ -130,7 +147,7 @@ bool CChannel::SetFrequency(float freq)
 float CChannel::GetFrequency()
 {
     ALfloat freq;
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0;
     }
@@ -147,7 +164,7 @@ float CChannel::GetFrequency()
 
 bool CChannel::SetVolume(float vol)
 {
-    if (!m_ready || vol < 0 || m_buffer == nullptr)
+    if (!m_ready || vol < 0 || !IsLoaded())
     {
         return false;
     }
@@ -164,7 +181,7 @@ bool CChannel::SetVolume(float vol)
 float CChannel::GetVolume()
 {
     ALfloat vol;
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0;
     }
@@ -260,6 +277,11 @@ bool CChannel::SetBuffer(CBuffer *buffer)
         return false;
 
     Stop();
+    if (m_stream != nullptr)
+    {
+        m_stream->Detach();
+        m_stream.reset();
+    }
     m_buffer = buffer;
     if (buffer == nullptr)
     {
@@ -277,10 +299,30 @@ bool CChannel::SetBuffer(CBuffer *buffer)
     return true;
 }
 
+bool CChannel::SetStream(std::shared_ptr<CStream> stream)
+{
+    if (!m_ready)
+        return false;
+
+    SetBuffer(nullptr);
+    m_stream = stream;
+    if (stream == nullptr)
+        return true;
+
+    stream->Attach(m_source);
+    m_initFrequency = GetFrequency();
+    return true;
+}
+
+std::shared_ptr<CStream> CChannel::GetStream()
+{
+    return m_stream;
+}
+
 bool CChannel::IsPlaying()
 {
     ALint status;
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
@@ -292,6 +334,10 @@ bool CChannel::IsPlaying()
         return false;
     }
 
+    // A stream stays playing while the worker catches up after running out of buffers
+    if (status == AL_STOPPED && m_stream != nullptr)
+        return m_stream->IsPlaying();
+
     return status == AL_PLAYING;
 }
 
@@ -302,17 +348,20 @@ bool CChannel::IsReady()
 
 bool CChannel::IsLoaded()
 {
-    return m_buffer != nullptr;
+    return m_buffer != nullptr || m_stream != nullptr;
 }
 
 bool CChannel::Stop()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return false;
     }
 
-    alSourceStop(m_source);
+    if (m_stream != nullptr)
+        m_stream->Stop();
+    else
+        alSourceStop(m_source);
     if (CheckOpenALError())
     {
         GetLogger()->Warn("Could not stop sound. Code: %d\n", GetOpenALErrorCode());
@@ -323,7 +372,7 @@ bool CChannel::Stop()
 
 float CChannel::GetCurrentTime()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0.0f;
     }
@@ -340,7 +389,7 @@ float CChannel::GetCurrentTime()
 
 void CChannel::SetCurrentTime(float current)
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return;
     }
@@ -354,11 +403,14 @@ void CChannel::SetCurrentTime(float current)
 
 float CChannel::GetDuration()
 {
-    if (!m_ready || m_buffer == nullptr)
+    if (!m_ready || !IsLoaded())
     {
         return 0.0f;
     }
 
+    if (m_stream != nullptr)
+        return m_stream->GetDuration();
+
     return m_buffer->GetDuration();
 }
 
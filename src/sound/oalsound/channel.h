@@ -33,11 +33,13 @@
 #include <string>
 #include <deque>
 #include <cassert>
+#include <memory>
 
 #include <al.h>
 #include <alc.h>
 
 class CBuffer;
+class CStream;
 
 struct SoundOper
 {
@@ -78,6 +80,9 @@ public:
     bool IsLoaded();
 
     bool SetBuffer(CBuffer *buffer);
+    //! Plays given stream instead of a buffer
+    bool SetStream(std::shared_ptr<CStream> stream);
+    std::shared_ptr<CStream> GetStream();
 
     bool HasEnvelope();
     SoundOper& GetEnvelope();
@@ -107,6 +112,7 @@ public:
 
 private:
     CBuffer *m_buffer;
+    std::shared_ptr<CStream> m_stream;
     ALuint m_source;
 
     int m_priority;
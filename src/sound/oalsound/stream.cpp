@@ -0,0 +1,334 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "sound/oalsound/stream.h"
+
+#include "common/logger.h"
+
+#include "common/resources/resourcemanager.h"
+#include "common/resources/sndfile_wrapper.h"
+
+#include "sound/oalsound/check.h"
+
+#include <algorithm>
+
+
+namespace
+{
+
+//! Number of 16-bit samples in one buffer, about 0.75 s of 44.1 kHz stereo
+const int STREAM_BUFFER_SAMPLES = 65536;
+
+} // anonymous namespace
+
+
+CStream::CStream()
+    : m_buffers(),
+      m_format(AL_FORMAT_MONO16),
+      m_source(0),
+      m_prefilled(0),
+      m_generation(0),
+      m_loaded(false),
+      m_loop(false),
+      m_restartPending(false),
+      m_playing(false),
+      m_refillPending(false),
+      m_duration(0.0f)
+{}
+
+CStream::~CStream()
+{
+    Detach();
+
+    if (m_loaded)
+    {
+        alDeleteBuffers(BUFFER_COUNT, m_buffers.data());
+        if (CheckOpenALError())
+            GetLogger()->Debug("Failed to unload stream buffers. Code %d\n", GetOpenALErrorCode());
+    }
+}
+
+bool CStream::Open(const std::string& filename)
+{
+    GetLogger()->Debug("Opening audio stream: %s\n", filename.c_str());
+
+    m_file = CResourceManager::GetSNDFileHandler(filename);
+    if (!m_file->IsOpen())
+    {
+        GetLogger()->Warn("Could not load file %s. Reason: %s\n", filename.c_str(), m_file->GetLastError().c_str());
+        return false;
+    }
+
+    alGenBuffers(BUFFER_COUNT, m_buffers.data());
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not create audio buffers. Code: %d\n", GetOpenALErrorCode());
+        return false;
+    }
+    m_loaded = true;
+
+    int channels = m_file->GetFileInfo().channels;
+    m_format = channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+    m_data.resize(STREAM_BUFFER_SAMPLES / channels * channels);  // whole frames only
+    m_duration = static_cast<float>(m_file->GetFileInfo().frames) / m_file->GetFileInfo().samplerate;
+
+    m_decodeMutex.Lock();
+    int prefilled = Prefill(false);
+    m_decodeMutex.Unlock();
+
+    m_mutex.Lock();
+    m_prefilled = prefilled;
+    m_mutex.Unlock();
+    return true;
+}
+
+bool CStream::IsLoaded()
+{
+    return m_loaded;
+}
+
+void CStream::SetLoop(bool loop)
+{
+    m_mutex.Lock();
+    m_loop = loop;
+    m_mutex.Unlock();
+}
+
+void CStream::Attach(ALuint source)
+{
+    Detach();
+
+    m_mutex.Lock();
+    m_source = source;
+    m_mutex.Unlock();
+}
+
+void CStream::Detach()
+{
+    m_mutex.Lock();
+    if (m_source != 0)
+    {
+        alSourceStop(m_source);
+        alSourcei(m_source, AL_BUFFER, 0);
+        m_source = 0;
+    }
+    m_playing = false;
+    m_restartPending = false;
+    m_generation++;
+    m_mutex.Unlock();
+}
+
+bool CStream::Start()
+{
+    m_mutex.Lock();
+    if (!m_loaded || m_source == 0)
+    {
+        m_mutex.Unlock();
+        return false;
+    }
+
+    alSourceStop(m_source);
+    alSourcei(m_source, AL_BUFFER, 0);
+    m_generation++;
+
+    // Buffers decoded when the stream was opened are used only once,
+    // afterwards the start of the file is decoded again in a music job
+    if (m_prefilled > 0)
+    {
+        alSourceQueueBuffers(m_source, m_prefilled, m_buffers.data());
+        m_prefilled = 0;
+        m_restartPending = false;
+    }
+    else
+    {
+        m_restartPending = true;
+    }
+    m_playing = true;
+
+    bool ok = !CheckOpenALError();
+    if (!ok)
+        GetLogger()->Warn("Could not queue stream buffers. Code: %d\n", GetOpenALErrorCode());
+
+    m_mutex.Unlock();
+    return ok;
+}
+
+void CStream::Stop()
+{
+    m_mutex.Lock();
+    if (m_source != 0)
+        alSourceStop(m_source);
+    m_playing = false;
+    m_restartPending = false;
+    m_generation++;
+    m_mutex.Unlock();
+}
+
+bool CStream::IsPlaying()
+{
+    return m_playing;
+}
+
+bool CStream::RequestRefill()
+{
+    if (m_refillPending || !m_playing)
+        return false;
+
+    // Refill() holds the mutex only for a moment, the next frame will try again
+    if (!m_mutex.TryLock())
+        return false;
+
+    bool request = false;
+    if (m_playing && m_source != 0)
+    {
+        ALint processed = 0;
+        alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+        request = m_restartPending || processed > 0;
+        m_refillPending = request;
+    }
+    m_mutex.Unlock();
+
+    return request;
+}
+
+void CStream::Refill()
+{
+    m_decodeMutex.Lock();
+
+    // Played buffers are taken from the source, then decoded without holding m_mutex
+    std::array<ALuint, BUFFER_COUNT> buffers;
+    int count = 0;
+
+    m_mutex.Lock();
+    int generation = m_generation;
+    bool restart = m_restartPending;
+    bool loop = m_loop;
+    bool active = m_playing && m_source != 0;
+    m_restartPending = false;
+    if (active && !restart)
+    {
+        ALint processed = 0;
+        alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+        count = std::min<int>(processed, BUFFER_COUNT);
+        alSourceUnqueueBuffers(m_source, count, buffers.data());
+    }
+    m_mutex.Unlock();
+
+    int decoded = 0;
+    if (restart)
+    {
+        decoded = Prefill(loop);
+        std::copy(m_buffers.begin(), m_buffers.end(), buffers.begin());
+    }
+    else if (active)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (Decode(buffers[i], loop))
+                buffers[decoded++] = buffers[i];
+        }
+    }
+
+    m_mutex.Lock();
+    m_refillPending = false;
+
+    // Buffers decoded for a playback that was stopped or restarted meanwhile are dropped
+    if (m_playing && m_source != 0 && m_generation == generation)
+    {
+        alSourceQueueBuffers(m_source, decoded, buffers.data());
+
+        ALint state = 0, queued = 0;
+        alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+        alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+        if (state != AL_PLAYING && state != AL_PAUSED)
+        {
+            if (queued > 0)
+            {
+                // After a restart, or when the worker was late and the source ran out of buffers
+                if (!restart)
+                    GetLogger()->Trace("Audio stream underrun\n");
+                alSourcePlay(m_source);
+            }
+            else
+            {
+                m_playing = false;
+            }
+        }
+
+        if (CheckOpenALError())
+            GetLogger()->Debug("Could not refill audio stream. Code: %d\n", GetOpenALErrorCode());
+    }
+
+    m_mutex.Unlock();
+    m_decodeMutex.Unlock();
+}
+
+float CStream::GetDuration()
+{
+    return m_duration;
+}
+
+bool CStream::Decode(ALuint buffer, bool loop)
+{
+    sf_count_t size = m_data.size();
+    sf_count_t total = 0;
+    bool rewound = false;
+    while (total < size)
+    {
+        sf_count_t read = m_file->Read(m_data.data() + total, size - total);
+        if (read > 0)
+        {
+            total += read;
+            rewound = false;
+            continue;
+        }
+
+        // End of file, a second rewind in a row means there is nothing to play
+        if (!loop || rewound || !m_file->Seek(0))
+            break;
+        rewound = true;
+    }
+
+    if (total == 0)
+        return false;
+
+    alBufferData(buffer, m_format, m_data.data(), total * sizeof(int16_t), m_file->GetFileInfo().samplerate);
+    if (CheckOpenALError())
+    {
+        GetLogger()->Warn("Could not fill stream buffer. Code: %d\n", GetOpenALErrorCode());
+        return false;
+    }
+    return true;
+}
+
+int CStream::Prefill(bool loop)
+{
+    if (!m_file->Seek(0))
+        return 0;
+
+    int count = 0;
+    for (ALuint buffer : m_buffers)
+    {
+        if (!Decode(buffer, loop))
+            break;
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,122 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file stream.h
+ * \brief OpenAL streamed sound
+ */
+
+#pragma once
+
+#include "common/thread/sdl_mutex_wrapper.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <al.h>
+
+class CSNDFileWrapper;
+
+/**
+ * \class CStream
+ * \brief Sound decoded while it plays, used for music
+ *
+ * Only a small ring of buffers is resident; buffers already played by
+ * the source are decoded again from the file by Refill(), which is meant
+ * to be run in a job of CJobSystem.
+ *
+ * The state of the source is guarded by a mutex, which Refill() holds only
+ * to unqueue and queue buffers. Decoding is guarded by a second mutex,
+ * so the main thread never waits for it.
+ */
+class CStream
+{
+public:
+    CStream();
+    ~CStream();
+
+    CStream(const CStream&) = delete;
+    CStream& operator=(const CStream&) = delete;
+
+    //! Opens the file and decodes the first buffers
+    bool Open(const std::string& filename);
+    bool IsLoaded();
+
+    //! Plays the file again from the start after it ends
+    void SetLoop(bool loop);
+
+    //! Starts feeding given source
+    void Attach(ALuint source);
+    //! Stops and releases the source
+    void Detach();
+
+    /**
+     * \brief Queues buffers from the start of the file, the source has to be played afterwards
+     *
+     * Only the buffers decoded when the file was opened are queued here. When playing again,
+     * the start of the file is decoded by the next Refill() and the source is started then.
+     */
+    bool Start();
+    //! Stops the source and refilling
+    void Stop();
+    //! Returns true from Start() until the end of file has been played or Stop()
+    bool IsPlaying();
+
+    //! Returns true if played buffers should be refilled and marks the refill as pending; never waits for Refill()
+    bool RequestRefill();
+    //! Decodes played buffers, or the start of the file after Start(), and queues them
+    void Refill();
+
+    float GetDuration();
+
+private:
+    //! Decodes next part of the file into given buffer, returns false at the end of file
+    bool Decode(ALuint buffer, bool loop);
+    //! Goes back to the start of the file and decodes all buffers, returns the number of decoded buffers
+    int  Prefill(bool loop);
+
+private:
+    static const int BUFFER_COUNT = 4;
+
+    std::unique_ptr<CSNDFileWrapper> m_file;
+    std::array<ALuint, BUFFER_COUNT> m_buffers;
+    //! Decoded samples of one buffer
+    std::vector<int16_t> m_data;
+    //! Guards the file and m_data
+    CSDLMutexWrapper m_decodeMutex;
+    //! Guards the source and the state below
+    CSDLMutexWrapper m_mutex;
+    ALenum m_format;
+    ALuint m_source;
+    //! Number of buffers decoded when the file was opened and not queued yet
+    int m_prefilled;
+    //! Incremented when the source is restarted or stopped, so that Refill() drops buffers decoded before
+    int m_generation;
+    bool m_loaded;
+    bool m_loop;
+    //! Set by Start() when the start of the file has to be decoded by Refill()
+    bool m_restartPending;
+    std::atomic<bool> m_playing;
+    std::atomic<bool> m_refillPending;
+    float m_duration;
+};
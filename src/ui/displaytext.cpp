@@ -145,7 +145,8 @@ void CDisplayText::DisplayError(Error err, Math::Vector goal, float height,
          err == ERR_VEH_VIRUS      ||
          err == ERR_DELETEMOBILE   ||
          err == ERR_DELETEBUILDING ||
-         err == INFO_LOST          )
+         err == INFO_LOST          ||
+         err == INFO_WRITEFAILED   )
     {
         type = TT_ERROR;
     }
@@ -0,0 +1,281 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+// Microbenchmark of lexing level files: the per-line boost::regex lexer previously
+// used by CLevelParser::Load() against CLevelParserLexer.
+// Level files can be given as arguments, e.g. the largest scene.txt files and all
+// chaptertitle.txt files scanned by the level list; otherwise a large scene and
+// a set of chapter titles are generated. Files are read into memory first,
+// so that only lexing is measured.
+// For generated scenes, parsing the text is also compared with reading the
+// binary format used by the level cache.
+
+#include "level/parser/parser.h"
+#include "level/parser/parserlexer.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/regex.hpp>
+
+namespace
+{
+
+//! Lexer of CLevelParser::Load() before CLevelParserLexer, returns the number of params
+int LexOld(const std::string& data)
+{
+    std::istringstream file(data);
+    std::string line;
+    int params = 0;
+    while (getline(file, line))
+    {
+        boost::replace_all(line, "\t", " ");
+
+        size_t pos = 0;
+        std::string linesuffix = line;
+        boost::regex commentRegex{ R"(("[^"]*")|('[^']*')|(//.*$))" };
+        boost::smatch matches;
+        while (boost::regex_search(linesuffix, matches, commentRegex))
+        {
+            if (matches[3].matched)
+            {
+                pos += std::distance(linesuffix.cbegin(), matches.prefix().second);
+                line = line.substr(0, pos);
+                linesuffix = "";
+            }
+            else
+            {
+                pos += std::distance(linesuffix.cbegin(), matches.suffix().first);
+                linesuffix = matches.suffix().str();
+            }
+        }
+
+        boost::algorithm::trim(line);
+
+        pos = line.find_first_of(" \t\n");
+        std::string command = line.substr(0, pos);
+        if (pos != std::string::npos)
+        {
+            line = line.substr(pos + 1);
+            boost::algorithm::trim(line);
+        }
+        else
+        {
+            line = "";
+        }
+
+        if (command.empty())
+            continue;
+
+        while (!line.empty())
+        {
+            pos = line.find_first_of("=");
+            std::string paramName = line.substr(0, pos);
+            boost::algorithm::trim(paramName);
+            line = line.substr(pos + 1);
+            boost::algorithm::trim(line);
+
+            if (line[0] == '\"')
+            {
+                pos = line.find_first_of("\"", 1);
+            }
+            else if (line[0] == '\'')
+            {
+                pos = line.find_first_of("'", 1);
+            }
+            else
+            {
+                pos = line.find_first_of("=");
+                if (pos != std::string::npos)
+                {
+                    std::size_t pos2 = line.find_last_of(" \t\n", line.find_last_not_of(" \t\n", pos-1));
+                    if (pos2 != std::string::npos)
+                        pos = pos2;
+                }
+                else
+                {
+                    pos = line.length()-1;
+                }
+            }
+            std::string paramValue = line.substr(0, pos + 1);
+            boost::algorithm::trim(paramValue);
+            params++;
+
+            if (pos == std::string::npos)
+                break;
+            line = line.substr(pos + 1);
+            boost::algorithm::trim(line);
+        }
+    }
+    return params;
+}
+
+int LexNew(const std::string& data)
+{
+    std::string filename = "bench";
+    CLevelParserLexer lexer(data, filename);
+    std::string command, name, value;
+    int params = 0;
+    while (lexer.NextLine(command))
+    {
+        while (lexer.NextParam(name, value))
+            params++;
+    }
+    return params;
+}
+
+//! Gives access to the text and binary formats without going through files
+class CLevelParserBench : public CLevelParser
+{
+public:
+    using CLevelParser::LoadText;
+    using CLevelParser::LoadBinary;
+    using CLevelParser::SaveBinary;
+};
+
+//! Generates a scene, translations need the application for the current language
+std::string MakeScene(int objects, bool translations = true)
+{
+    std::ostringstream scene;
+    scene << "// Generated scene\n"
+          << "Title.E text=\"Generated scene\"\n";
+    if (translations)
+        scene << "Title.F text=\"Scène générée\"\n";
+    scene << "Resume.E text=\"Scene with many objects // not a comment\"\n"
+          << "Terrain\tvision=1000 depth=1 hard=0.1\n";
+    for (int i = 0; i < objects; i++)
+    {
+        scene << "CreateObject pos=" << i % 100 << ";" << i / 100 << " dir=" << (i % 20) / 10.0f
+              << " type=" << (i % 3 == 0 ? "TitaniumOre" : "WheeledGrabber")
+              << " power=1 trainer=0 // object " << i << "\n";
+    }
+    return scene.str();
+}
+
+std::string MakeChapterTitle(int chapter)
+{
+    std::ostringstream title;
+    title << "Title.E text=\"Chapter " << chapter << "\"\n"
+          << "Resume.E text=\"Description of chapter " << chapter << ", which is quite long\"\n"
+          << "Title.F text=\"Chapitre " << chapter << "\"\n"
+          << "Resume.F text=\"Description du chapitre " << chapter << "\"\n";
+    return title.str();
+}
+
+template<typename Lex>
+double Measure(const std::vector<std::string>& files, int repeats, Lex lex, int& params)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++)
+    {
+        params = 0;
+        for (const std::string& file : files)
+            params += lex(file);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+}
+
+void Run(const std::string& name, const std::vector<std::string>& files, int repeats)
+{
+    std::size_t bytes = 0;
+    for (const std::string& file : files)
+        bytes += file.size();
+
+    int oldParams = 0, newParams = 0;
+    double oldTime = Measure(files, repeats, LexOld, oldParams);
+    double newTime = Measure(files, repeats, LexNew, newParams);
+
+    std::cout << name << ": " << files.size() << " files, " << bytes << " bytes" << std::endl;
+    std::cout << "  boost::regex lexer: " << oldTime << " ms (" << oldParams << " params)" << std::endl;
+    std::cout << "  CLevelParserLexer:  " << newTime << " ms (" << newParams << " params)" << std::endl;
+}
+
+void RunCache(int objects, int repeats)
+{
+    std::string text = MakeScene(objects, false);
+    CLevelParserBench parser;
+    parser.LoadText(text);
+    std::string binary = parser.SaveBinary();
+
+    int lines = 0;
+    auto measure = [&](void (CLevelParserBench::*load)(const std::string&), const std::string& data)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; i++)
+        {
+            CLevelParserBench loaded;
+            (loaded.*load)(data);
+            lines = loaded.GetLines().size();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+    };
+    double textTime = measure(&CLevelParserBench::LoadText, text);
+    double binaryTime = measure(&CLevelParserBench::LoadBinary, binary);
+
+    std::cout << "Level cache, scene with " << objects << " objects" << std::endl;
+    std::cout << "  text:   " << textTime << " ms (" << text.size() << " bytes)" << std::endl;
+    std::cout << "  binary: " << binaryTime << " ms (" << binary.size() << " bytes, " << lines << " lines)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int repeats = 20;
+
+    if (argc > 1)
+    {
+        std::vector<std::string> files;
+        for (int i = 1; i < argc; i++)
+        {
+            std::ifstream file(argv[i], std::ios::binary);
+            if (!file.is_open())
+            {
+                std::cerr << "Failed to open " << argv[i] << std::endl;
+                return 1;
+            }
+            std::ostringstream data;
+            data << file.rdbuf();
+            files.push_back(data.str());
+        }
+        Run("Given files", files, repeats);
+        return 0;
+    }
+
+    Run("Large scene", { MakeScene(5000) }, repeats);
+
+    std::vector<std::string> titles;
+    for (int chapter = 1; chapter <= 200; chapter++)
+        titles.push_back(MakeChapterTitle(chapter));
+    Run("Chapter titles", titles, repeats);
+
+    RunCache(200, repeats);
+    RunCache(5000, repeats);
+
+    return 0;
+}
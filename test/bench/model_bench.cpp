@@ -0,0 +1,96 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+// Microbenchmark of model loading: a generated model is read from the text
+// format used by models-new and from the binary format of its cache.
+// Both are read from memory, so that only parsing is measured.
+
+#include "graphics/model/model_input.h"
+#include "graphics/model/model_output.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace Gfx;
+
+namespace
+{
+
+CModel MakeModel(int triangleCount)
+{
+    CModelMesh mesh;
+    for (int i = 0; i < triangleCount; ++i)
+    {
+        ModelTriangle triangle;
+        float f = i * 0.001f;
+        triangle.p1 = VertexTex2(Math::Vector(f, 1.5f, -2.25f), Math::Vector(0.0f, 1.0f, 0.0f), Math::Point(0.125f, f), Math::Point(f, 0.5f));
+        triangle.p2 = VertexTex2(Math::Vector(3.75f, f, 5.5f), Math::Vector(0.0f, 0.0f, 1.0f), Math::Point(0.25f, 0.375f), Math::Point(0.5f, f));
+        triangle.p3 = VertexTex2(Math::Vector(-6.0f, 7.125f, f), Math::Vector(1.0f, 0.0f, 0.0f), Math::Point(f, 0.625f), Math::Point(0.75f, 0.25f));
+        triangle.diffuse = Color(0.8f, 0.8f, 0.8f, 1.0f);
+        triangle.ambient = Color(0.5f, 0.5f, 0.5f, 0.0f);
+        triangle.tex1Name = (i % 2 == 0) ? "base1.png" : "wheel.png";
+        triangle.variableTex2 = true;
+        mesh.AddTriangle(triangle);
+    }
+
+    CModel model;
+    model.AddMesh("main", std::move(mesh));
+    return model;
+}
+
+double Measure(const std::string& data, ModelFormat format, int iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        std::istringstream stream(data);
+        CModel model = ModelInput::Read(stream, format);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int triangles = 5000;  // a large robot
+    int iterations = 20;
+    if (argc > 1) triangles = atoi(argv[1]);
+    if (argc > 2) iterations = atoi(argv[2]);
+
+    CModel model = MakeModel(triangles);
+
+    std::ostringstream text;
+    ModelOutput::Write(model, text, ModelFormat::Text);
+    std::ostringstream binary;
+    ModelOutput::Write(model, binary, ModelFormat::Binary);
+
+    std::cout << "Model of " << triangles << " triangles, " << iterations << " iterations" << std::endl;
+    std::cout << "Text:    " << Measure(text.str(), ModelFormat::Text, iterations) << " ms, "
+              << text.str().size() / 1024 << " KiB" << std::endl;
+    std::cout << "Binary:  " << Measure(binary.str(), ModelFormat::Binary, iterations) << " ms, "
+              << binary.str().size() / 1024 << " KiB" << std::endl;
+
+    return 0;
+}
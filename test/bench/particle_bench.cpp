@@ -0,0 +1,138 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+// Microbenchmark of the common particle update: a large explosion is simulated
+// with ParticleStore kernels and with the old array of structures loop.
+// Random wind gusts are drawn once, so that rand() isn't measured.
+
+#include "graphics/engine/particle_store.h"
+
+#include "math/func.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+//! Subset of the old particle structure used by the common update
+struct OldParticle
+{
+    bool            used = false;
+    float           mass = 0.0f;
+    Math::Vector    pos;
+    Math::Vector    speed;
+    float           windSensitivity = 0.0f;
+    float           time = 0.0f;
+    float           testTime = 0.0f;
+    // Padding to the size of the rest of the old structure
+    char            rest[200];
+};
+
+const float FRAME_TIME = 1.0f / 60.0f;
+
+Math::Vector RandomSpeed()
+{
+    return Math::Vector((Math::Rand()-0.5f)*60.0f, Math::Rand()*40.0f, (Math::Rand()-0.5f)*60.0f);
+}
+
+double RunStore(int count, int frames, const Math::Vector& wind, float& checksum)
+{
+    Gfx::ParticleStore store;
+    for (int i = 0; i < count; i++)
+    {
+        int index = store.Add();
+        if (index == -1) break;
+        store.used[index] = true;
+        store.speed[index] = RandomSpeed();
+        store.mass[index] = Math::Rand()*30.0f;
+        store.windSensitivity[index] = Math::Rand();
+        store.moveStep[index] = FRAME_TIME;
+        store.windStep[index] = FRAME_TIME*store.windSensitivity[index];
+        store.ageStep[index] = FRAME_TIME;
+    }
+
+    count = store.GetCount();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        store.Integrate(wind, 0, count);
+        store.Age(0, count);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    checksum = 0.0f;
+    for (int i = 0; i < count; i++)
+        checksum += store.pos.x[i] + store.pos.y[i] + store.pos.z[i] + store.time[i];
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+double RunOld(int count, int frames, const Math::Vector& wind)
+{
+    std::vector<OldParticle> particles(count);
+    for (OldParticle& particle : particles)
+    {
+        particle.used = true;
+        particle.speed = RandomSpeed();
+        particle.mass = Math::Rand()*30.0f;
+        particle.windSensitivity = Math::Rand();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (OldParticle& particle : particles)
+        {
+            if (!particle.used) continue;
+
+            particle.pos += particle.speed*FRAME_TIME;
+            particle.pos += wind*(FRAME_TIME*particle.windSensitivity);
+            particle.speed.y -= particle.mass*FRAME_TIME;
+            particle.time     += FRAME_TIME;
+            particle.testTime += FRAME_TIME;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int count = 60000;  // limited by number of particle handles
+    int frames = 600;
+    if (argc > 1) count = atoi(argv[1]);
+    if (argc > 2) frames = atoi(argv[2]);
+
+    Math::Vector wind(2.0f, 0.0f, -1.0f);
+
+    std::cout << "Explosion of " << count << " particles, " << frames << " frames" << std::endl;
+    std::cout << "Array of structures:  " << RunOld(count, frames, wind) << " ms/frame" << std::endl;
+    float checksum = 0.0f;
+    double time = RunStore(count, frames, wind, checksum);
+    std::cout << "Structure of arrays:  " << time << " ms/frame, checksum " << checksum << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+// Microbenchmark of saved games: a level file with 500 objects, like data.sav
+// of a large game, is saved and loaded in the text and in the compressed binary format.
+// Files are written to the directory given as first argument (current directory by default).
+
+#include "common/logger.h"
+#include "common/make_unique.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "level/parser/parser.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+const char* const OBJECT_TYPES[] = { "WheeledGrabber", "TrackedShooter", "PowerCell", "Titanium", "Derrick", "Tree5" };
+
+void AddObjects(CLevelParser& level, int count)
+{
+    auto line = MakeUnique<CLevelParserLine>("Title");
+    line->AddParam("text", MakeUnique<CLevelParserParam>(std::string("Benchmark")));
+    level.AddLine(std::move(line));
+
+    for (int i = 0; i < count; i++)
+    {
+        line = MakeUnique<CLevelParserLine>("CreateObject");
+        line->AddParam("type", MakeUnique<CLevelParserParam>("type", OBJECT_TYPES[i % 6]));
+        line->AddParam("id", MakeUnique<CLevelParserParam>(i + 1));
+        line->AddParam("pos", MakeUnique<CLevelParserParam>(Math::Vector(rand() % 4000 / 10.0f, rand() % 300 / 10.0f, rand() % 4000 / 10.0f)));
+        line->AddParam("angle", MakeUnique<CLevelParserParam>(Math::Vector(0.0f, rand() % 360, 0.0f)));
+        line->AddParam("zoom", MakeUnique<CLevelParserParam>(Math::Vector(1.0f, 1.0f, 1.0f)));
+        line->AddParam("team", MakeUnique<CLevelParserParam>(0));
+        line->AddParam("trainer", MakeUnique<CLevelParserParam>(false));
+        line->AddParam("energy", MakeUnique<CLevelParserParam>(rand() % 1000 / 1000.0f));
+        line->AddParam("shield", MakeUnique<CLevelParserParam>(1.0f));
+        if (i % 6 < 2)
+        {
+            line->AddParam("cmdline", MakeUnique<CLevelParserParam>("cmdline", "0;0;0;0;0;0;0;0;0;0"));
+            line->AddParam("select", MakeUnique<CLevelParserParam>(i == 0));
+            line->AddParam("run", MakeUnique<CLevelParserParam>(1));
+        }
+        level.AddLine(std::move(line));
+    }
+}
+
+void Run(const std::string& filename, bool binary, int count, int repeats)
+{
+    CLevelParser level(filename);
+    AddObjects(level, count);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++)
+        level.Save(binary);
+    auto end = std::chrono::steady_clock::now();
+    double saveTime = std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+
+    start = std::chrono::steady_clock::now();
+    std::size_t lines = 0;
+    for (int i = 0; i < repeats; i++)
+    {
+        CLevelParser loaded(filename);
+        loaded.Load();
+        lines = loaded.GetLines().size();
+    }
+    end = std::chrono::steady_clock::now();
+    double loadTime = std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+
+    std::cout << (binary ? "Binary: " : "Text:   ")
+              << CResourceManager::GetFileSize(filename) << " bytes, "
+              << "save " << saveTime << " ms, load " << loadTime << " ms (" << lines << " lines)" << std::endl;
+
+    CResourceManager::Remove(filename);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    CLogger logger;
+    logger.SetLogLevel(LOG_WARN);
+
+    std::string directory = argc > 1 ? argv[1] : ".";
+    int count = argc > 2 ? atoi(argv[2]) : 500;
+    int repeats = 20;
+
+    CResourceManager resourceManager(argv[0]);
+    if (!CResourceManager::SetSaveLocation(directory) || !CResourceManager::AddLocation(directory))
+        return 1;
+
+    std::cout << "Saved game with " << count << " objects" << std::endl;
+    srand(1);
+    Run("save_bench.txt", false, count, repeats);
+    srand(1);
+    Run("save_bench.sav", true, count, repeats);
+
+    return 0;
+}
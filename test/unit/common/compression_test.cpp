@@ -0,0 +1,82 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "common/compression.h"
+
+#include <cstdlib>
+#include <string>
+
+#include <gtest/gtest.h>
+
+
+namespace
+{
+
+std::string MakeSaveLikeData()
+{
+    std::string data;
+    for (int i = 0; i < 500; i++)
+    {
+        data += "CreateObject type=WheeledGrabber id=" + std::to_string(i) +
+                " pos=" + std::to_string(i * 3 % 200) + ";0;" + std::to_string(i * 7 % 150) +
+                " angle=0;" + std::to_string(i % 360) + ";0 trainer=0 energy=1\n";
+    }
+    return data;
+}
+
+} // anonymous namespace
+
+TEST(CompressionTest, RoundTrip)
+{
+    std::string random;
+    srand(1);
+    for (int i = 0; i < 100000; i++)
+        random.push_back(static_cast<char>(rand() % 8));
+
+    for (const std::string& data : { std::string(), std::string("ab"), std::string(1000, 'x'), MakeSaveLikeData(), random })
+    {
+        std::string compressed = Compression::CompressLZ77(data);
+        std::string result;
+        ASSERT_TRUE(Compression::DecompressLZ77(compressed, data.size(), result));
+        EXPECT_EQ(data, result);
+
+        ASSERT_TRUE(Compression::Unpack(Compression::Pack(data, "TEST"), "TEST", result));
+        EXPECT_EQ(data, result);
+    }
+}
+
+TEST(CompressionTest, Ratio)
+{
+    std::string data = MakeSaveLikeData();
+    EXPECT_LT(Compression::CompressLZ77(data).size(), data.size() / 3);
+}
+
+TEST(CompressionTest, Corrupted)
+{
+    std::string data = MakeSaveLikeData();
+    std::string packed = Compression::Pack(data, "TEST");
+    std::string result;
+
+    EXPECT_FALSE(Compression::IsPacked(packed, "XXXX"));
+    EXPECT_FALSE(Compression::Unpack(packed, "XXXX", result));
+    EXPECT_FALSE(Compression::Unpack(packed.substr(0, packed.size() / 2), "TEST", result));
+    EXPECT_FALSE(Compression::DecompressLZ77(Compression::CompressLZ77(data), data.size() - 1, result));
+    EXPECT_FALSE(Compression::DecompressLZ77(Compression::CompressLZ77(data), 0xFFFFFFFF, result));
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/event.h"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+TEST(EventQueueTest, KeepsOrderOfEachProducer)
+{
+    const int PRODUCERS = 4;
+    const int EVENTS_PER_PRODUCER = 20000;
+
+    CEventQueue queue;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCERS; producer++)
+    {
+        producers.emplace_back([&queue, producer]()
+        {
+            for (int i = 0; i < EVENTS_PER_PRODUCER; i++)
+            {
+                Event event(EVENT_KEY_DOWN);
+                event.customParam = producer;
+                auto data = MakeUnique<KeyEventData>();
+                data->key = i;
+                event.data = std::move(data);
+
+                // Retry when the queue is full, so that nothing is lost
+                while (!queue.AddEvent(std::move(event)))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<int> nextKey(PRODUCERS, 0);
+    int received = 0;
+    while (received < PRODUCERS * EVENTS_PER_PRODUCER)
+    {
+        if (queue.IsEmpty())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        Event event = queue.GetEvent();
+        ASSERT_EQ(EVENT_KEY_DOWN, event.type);
+        ASSERT_GE(event.customParam, 0);
+        ASSERT_LT(event.customParam, PRODUCERS);
+        EXPECT_EQ(nextKey[event.customParam], static_cast<int>(event.GetData<KeyEventData>()->key));
+        nextKey[event.customParam]++;
+        received++;
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQ(EVENT_NULL, queue.GetEvent().type);
+    EXPECT_LE(queue.GetPeakCount(), CEventQueue::MAX_EVENT_QUEUE);
+}
+
+TEST(EventQueueTest, GrowsAndDropsWhenFull)
+{
+    CEventQueue queue;
+
+    for (int i = 0; i < CEventQueue::MAX_EVENT_QUEUE; i++)
+        EXPECT_TRUE(queue.AddEvent(Event(EVENT_FRAME)));
+
+    EXPECT_FALSE(queue.AddEvent(Event(EVENT_FRAME)));
+    EXPECT_FALSE(queue.AddEvent(Event(EVENT_FRAME)));
+    EXPECT_EQ(2, queue.GetDroppedCount());
+    EXPECT_EQ(CEventQueue::MAX_EVENT_QUEUE, queue.GetPeakCount());
+
+    for (int i = 0; i < CEventQueue::MAX_EVENT_QUEUE; i++)
+        EXPECT_EQ(EVENT_FRAME, queue.GetEvent().type);
+
+    EXPECT_TRUE(queue.IsEmpty());
+
+    // The largest ring is reused after it was drained
+    for (int i = 0; i < CEventQueue::MAX_EVENT_QUEUE; i++)
+        EXPECT_TRUE(queue.AddEvent(Event(EVENT_FRAME)));
+    EXPECT_EQ(2, queue.GetDroppedCount());
+}
+
+TEST(EventQueueTest, ClonesPooledEventData)
+{
+    Event event(EVENT_TEXT_INPUT);
+    auto data = MakeUnique<TextInputData>();
+    data->text = "a text longer than the small string buffer of std::string";
+    event.data = std::move(data);
+
+    Event clone = event.Clone();
+    event.data.reset();
+
+    EXPECT_EQ("a text longer than the small string buffer of std::string", clone.GetData<TextInputData>()->text);
+}
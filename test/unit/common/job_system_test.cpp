@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/thread/job_system.h"
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+TEST(JobSystemTest, RunsJobsAfterDependencies)
+{
+    CJobSystem jobs(4);
+
+    for (int repeat = 0; repeat < 100; repeat++)
+    {
+        std::atomic<int> step{0};
+        std::atomic<int> leftStep{-1};
+        std::atomic<int> rightStep{-1};
+        std::atomic<int> lastStep{-1};
+
+        JobHandle first = jobs.Schedule([&]() { step++; });
+        JobHandle left = jobs.Then(first, [&]() { leftStep = step++; });
+        JobHandle right = jobs.Then(first, [&]() { rightStep = step++; });
+        JobHandle last = jobs.Schedule([&]() { lastStep = step++; }, { left, right });
+
+        jobs.Wait(last);
+
+        EXPECT_TRUE(first->IsDone());
+        EXPECT_TRUE(left->IsDone());
+        EXPECT_TRUE(right->IsDone());
+        EXPECT_GE(leftStep, 1);
+        EXPECT_GE(rightStep, 1);
+        EXPECT_EQ(3, lastStep);
+    }
+}
+
+TEST(JobSystemTest, WaitsInsideJobs)
+{
+    CJobSystem jobs(1);
+
+    // With one worker, the outer job has to run the inner one itself
+    std::atomic<int> done{0};
+    JobHandle outer = jobs.Schedule([&]()
+    {
+        JobHandle inner = jobs.Schedule([&]() { done++; });
+        jobs.Wait(inner);
+        done++;
+    });
+
+    jobs.Wait(outer);
+    EXPECT_EQ(2, done);
+}
+
+TEST(JobSystemTest, ParallelForVisitsEachIndexOnce)
+{
+    CJobSystem jobs(3);
+
+    const int COUNT = 100000;
+    std::vector<int> visits(COUNT, 0);
+    jobs.ParallelFor(COUNT, 1000, [&](int first, int last)
+    {
+        for (int i = first; i < last; i++)
+            visits[i]++;
+    });
+
+    for (int i = 0; i < COUNT; i++)
+        ASSERT_EQ(1, visits[i]);
+}
+
+TEST(JobSystemTest, ParallelForSplitsRangeIntoChunks)
+{
+    CJobSystem jobs(2);
+
+    for (int count : { 0, 1, 7, 64, 1001 })
+    {
+        std::atomic<int> calls{0};
+        std::vector<int> visits(count, 0);
+        jobs.ParallelFor(count, 16, [&](int first, int last)
+        {
+            calls++;
+            EXPECT_EQ(0, first % 16);
+            EXPECT_LE(last - first, 16);
+            EXPECT_TRUE(last - first == 16 || last == count);
+            for (int i = first; i < last; i++)
+                visits[i]++;
+        });
+
+        EXPECT_EQ((count + 15) / 16, calls) << "count " << count;
+        for (int i = 0; i < count; i++)
+            ASSERT_EQ(1, visits[i]) << "count " << count;
+    }
+}
+
+TEST(JobSystemTest, ParallelForInsideJob)
+{
+    CJobSystem jobs(1);
+
+    std::atomic<int> sum{0};
+    JobHandle job = jobs.Schedule([&]()
+    {
+        jobs.ParallelFor(100, 1, [&](int first, int last)
+        {
+            for (int i = first; i < last; i++)
+                sum += i;
+        });
+    });
+
+    jobs.Wait(job);
+    EXPECT_EQ(4950, sum);
+}
+
+TEST(JobSystemTest, RunsAllJobsBeforeDestruction)
+{
+    std::atomic<int> done{0};
+    {
+        CJobSystem jobs(2);
+        JobHandle previous;
+        for (int i = 0; i < 1000; i++)
+            previous = jobs.Schedule([&]() { done++; }, { previous });
+    }
+    EXPECT_EQ(1000, done);
+}
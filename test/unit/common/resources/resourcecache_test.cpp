@@ -0,0 +1,137 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/resources/resourcecache.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::shared_ptr<std::string> MakeData(std::size_t size)
+{
+    return std::make_shared<std::string>(size, 'x');
+}
+
+} // anonymous namespace
+
+TEST(ResourceCacheTest, DropsLeastRecentlyUsedFiles)
+{
+    CResourceCache cache;
+    cache.SetLimits(300, 200);
+
+    cache.AddFile("a", MakeData(100));
+    cache.AddFile("b", MakeData(100));
+    cache.AddFile("c", MakeData(100));
+    EXPECT_EQ(300u, cache.GetSize());
+
+    // "a" becomes the most recently used, so "b" is dropped
+    EXPECT_NE(nullptr, cache.GetFile("a"));
+    cache.AddFile("d", MakeData(100));
+
+    EXPECT_EQ(300u, cache.GetSize());
+    EXPECT_NE(nullptr, cache.GetFile("a"));
+    EXPECT_EQ(nullptr, cache.GetFile("b"));
+    EXPECT_NE(nullptr, cache.GetFile("c"));
+    EXPECT_NE(nullptr, cache.GetFile("d"));
+
+    ResourceCacheCounters counters = cache.GetCounters();
+    EXPECT_EQ(4, counters.fileHits);
+    EXPECT_EQ(1, counters.fileMisses);
+}
+
+TEST(ResourceCacheTest, SkipsLargeFiles)
+{
+    CResourceCache cache;
+    cache.SetLimits(1000, 200);
+
+    EXPECT_TRUE(cache.IsCacheable(200));
+    EXPECT_FALSE(cache.IsCacheable(201));
+
+    cache.AddFile("large", MakeData(201));
+    EXPECT_EQ(nullptr, cache.GetFile("large"));
+    EXPECT_EQ(0u, cache.GetSize());
+
+    // Disabled cache keeps nothing
+    cache.SetLimits(0, 0);
+    cache.AddFile("empty", MakeData(0));
+    EXPECT_FALSE(cache.IsCacheable(1));
+}
+
+TEST(ResourceCacheTest, ReplacesFile)
+{
+    CResourceCache cache;
+    cache.SetLimits(1000, 1000);
+
+    cache.AddFile("a", MakeData(100));
+    cache.AddFile("a", MakeData(50));
+    EXPECT_EQ(50u, cache.GetSize());
+    EXPECT_EQ(50u, cache.GetFile("a")->size());
+}
+
+TEST(ResourceCacheTest, InvalidatesDirectoryQueriesOnWrite)
+{
+    CResourceCache cache;
+    cache.SetLimits(1000, 1000);
+
+    cache.AddFile("dir/a", MakeData(10));
+    cache.AddFile("dir/b", MakeData(10));
+    cache.AddList("dir", { "a", "b" });
+    cache.AddExists("dir/c", false);
+
+    std::vector<std::string> list;
+    bool exists = true;
+    EXPECT_TRUE(cache.GetList("dir", list));
+    EXPECT_EQ(2u, list.size());
+    EXPECT_TRUE(cache.GetExists("dir/c", exists));
+    EXPECT_FALSE(exists);
+
+    cache.InvalidateFile("dir/a");
+    EXPECT_EQ(nullptr, cache.GetFile("dir/a"));
+    EXPECT_NE(nullptr, cache.GetFile("dir/b"));
+    EXPECT_FALSE(cache.GetList("dir", list));
+    EXPECT_FALSE(cache.GetExists("dir/c", exists));
+
+    ResourceCacheCounters counters = cache.GetCounters();
+    EXPECT_EQ(2, counters.listHits);
+    EXPECT_EQ(2, counters.listMisses);
+
+    cache.Clear();
+    EXPECT_EQ(nullptr, cache.GetFile("dir/b"));
+    EXPECT_EQ(0u, cache.GetSize());
+}
+
+TEST(ResourceCacheTest, DisabledCacheKeepsNothing)
+{
+    CResourceCache cache;
+    cache.SetLimits(1000, 1000);
+    EXPECT_TRUE(cache.IsEnabled());
+    cache.AddList("dir", { "a" });
+
+    cache.SetLimits(0, 0);
+    EXPECT_FALSE(cache.IsEnabled());
+    cache.AddList("other", { "b" });
+    cache.AddExists("dir/a", true);
+
+    std::vector<std::string> list;
+    bool exists = false;
+    EXPECT_FALSE(cache.GetList("dir", list));
+    EXPECT_FALSE(cache.GetList("other", list));
+    EXPECT_FALSE(cache.GetExists("dir/a", exists));
+}
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/engine.h"
+
+#include "common/make_unique.h"
+
+#include "common/system/system.h"
+
+#include "math/geometry.h"
+
+#include <gtest/gtest.h>
+#include <hippomocks.h>
+
+#include <memory>
+
+using namespace Gfx;
+using namespace HippoMocks;
+
+//! Gives access to the state of the static shadow map cache
+class CEngineWrapper : public CEngine
+{
+public:
+    explicit CEngineWrapper(CSystemUtils* systemUtils)
+        : CEngine(nullptr, systemUtils)
+    {}
+
+    EngineObject& GetObject(int objRank)
+    {
+        return m_objects[objRank];
+    }
+
+    bool IsStaticShadowMapDirty()
+    {
+        return m_shadowStaticDirty;
+    }
+
+    void MarkStaticShadowMapRendered()
+    {
+        m_shadowStaticDirty = false;
+    }
+};
+
+class CEngineUT : public testing::Test
+{
+protected:
+    ~CEngineUT() NOEXCEPT
+    {}
+
+    void SetUp() override;
+    void TearDown() override;
+
+    MockRepository m_mocks;
+    CSystemUtils* m_systemUtils = nullptr;
+    std::unique_ptr<CEngineWrapper> m_engine;
+};
+
+void CEngineUT::SetUp()
+{
+    m_systemUtils = m_mocks.Mock<CSystemUtils>();
+    m_mocks.OnCall(m_systemUtils, CSystemUtils::CreateTimeStamp).Return(nullptr);
+    m_mocks.OnCall(m_systemUtils, CSystemUtils::DestroyTimeStamp);
+
+    m_engine = MakeUnique<CEngineWrapper>(m_systemUtils);
+}
+
+void CEngineUT::TearDown()
+{
+    m_engine.reset();
+}
+
+TEST_F(CEngineUT, SameTransformKeepsStaticShadowCache)
+{
+    int objRank = m_engine->CreateObject();
+    m_engine->SetObjectType(objRank, ENG_OBJTYPE_FIX);
+
+    Math::Matrix transform;
+    Math::LoadTranslationMatrix(transform, Math::Vector(10.0f, 0.0f, 20.0f));
+    m_engine->SetObjectTransform(objRank, transform);
+
+    // As after rendering the static shadow map with this object
+    m_engine->GetObject(objRank).shadowCached = true;
+    m_engine->MarkStaticShadowMapRendered();
+
+    Math::Matrix sameTransform;
+    Math::LoadTranslationMatrix(sameTransform, Math::Vector(10.0f, 0.0f, 20.0f));
+    m_engine->SetObjectTransform(objRank, sameTransform);
+
+    EXPECT_TRUE(m_engine->GetObject(objRank).shadowCached);
+    EXPECT_FALSE(m_engine->GetObject(objRank).shadowDynamic);
+    EXPECT_FALSE(m_engine->IsStaticShadowMapDirty());
+
+    Math::Matrix movedTransform;
+    Math::LoadTranslationMatrix(movedTransform, Math::Vector(10.0f, 0.0f, 20.001f));
+    m_engine->SetObjectTransform(objRank, movedTransform);
+
+    EXPECT_TRUE(m_engine->GetObject(objRank).shadowDynamic);
+    EXPECT_TRUE(m_engine->IsStaticShadowMapDirty());
+}
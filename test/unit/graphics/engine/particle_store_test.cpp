@@ -0,0 +1,146 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/particle_store.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Gfx;
+
+namespace
+{
+
+//! Adds \a count used particles and returns their handles
+std::vector<int> AddParticles(ParticleStore& store, int count)
+{
+    std::vector<int> handles;
+    for (int i = 0; i < count; i++)
+    {
+        int index = store.Add();
+        store.used[index] = true;
+        store.time[index] = static_cast<float>(i);
+        handles.push_back(store.handle[index]);
+    }
+    return handles;
+}
+
+} // anonymous namespace
+
+TEST(ParticleStoreTest, CompactMovesLastParticlesIntoGaps)
+{
+    ParticleStore store;
+    std::vector<int> handles = AddParticles(store, 5);
+
+    store.used[1] = false;
+    store.used[3] = false;
+    store.Compact();
+
+    // Particle 4 fills the gap at 1, particle 3 was the last one after that and is just removed
+    ASSERT_EQ(3, store.GetCount());
+    EXPECT_EQ(handles[0], store.handle[0]);
+    EXPECT_EQ(handles[4], store.handle[1]);
+    EXPECT_EQ(handles[2], store.handle[2]);
+    EXPECT_EQ(4.0f, store.time[1]);
+
+    for (int i = 0; i < store.GetCount(); i++)
+        EXPECT_TRUE(store.used[i]);
+}
+
+TEST(ParticleStoreTest, CompactRemapsHandles)
+{
+    ParticleStore store;
+    std::vector<int> handles = AddParticles(store, 5);
+
+    store.used[0] = false;
+    store.used[4] = false;
+    store.Compact();
+
+    EXPECT_EQ(-1, store.GetIndex(handles[0]));
+    EXPECT_EQ(-1, store.GetIndex(handles[4]));
+    for (int i : { 1, 2, 3 })
+    {
+        int index = store.GetIndex(handles[i]);
+        ASSERT_GE(index, 0);
+        EXPECT_EQ(handles[i], store.handle[index]);
+        EXPECT_EQ(static_cast<float>(i), store.time[index]);
+    }
+
+    // Freed handles are used again, and point to the new particles
+    int index = store.Add();
+    int handle = store.handle[index];
+    EXPECT_TRUE(handle == handles[0] || handle == handles[4]);
+    EXPECT_EQ(index, store.GetIndex(handle));
+    EXPECT_EQ(-1, store.GetIndex(-1));
+    EXPECT_EQ(-1, store.GetIndex(1000));
+
+    store.Clear();
+    EXPECT_EQ(0, store.GetCount());
+    EXPECT_EQ(-1, store.GetIndex(handles[1]));
+}
+
+TEST(ParticleStoreTest, CompactRemovesAllDeleted)
+{
+    ParticleStore store;
+    AddParticles(store, 8);
+    for (int i = 0; i < 8; i++)
+        store.used[i] = false;
+
+    store.Compact();
+    EXPECT_EQ(0, store.GetCount());
+}
+
+TEST(ParticleStoreTest, IntegrateMovesBeforeGravity)
+{
+    ParticleStore store;
+    const int COUNT = 7;  // not a multiple of the vector width, to cover the remainder
+    AddParticles(store, COUNT);
+    for (int i = 0; i < COUNT; i++)
+    {
+        store.pos[i] = Math::Vector(i, 2.0f * i, 3.0f * i);
+        store.speed[i] = Math::Vector(1.0f, 2.0f, -1.0f);
+        store.mass[i] = 10.0f;
+        store.moveStep[i] = 0.5f;
+        store.windStep[i] = 0.25f;
+        store.ageStep[i] = 0.1f;
+    }
+
+    const Math::Vector wind(4.0f, 0.0f, -8.0f);
+    store.Integrate(wind, 1, COUNT);
+    store.Age(1, COUNT);
+
+    // The first particle is outside of the range
+    EXPECT_EQ(0.0f, store.pos.x[0]);
+    EXPECT_EQ(2.0f, store.speed.y[0]);
+    EXPECT_EQ(0.0f, store.time[0]);
+
+    for (int i = 1; i < COUNT; i++)
+    {
+        // Position uses the speed from before gravity is applied
+        EXPECT_FLOAT_EQ(i + 0.5f + 1.0f, store.pos.x[i]) << i;
+        EXPECT_FLOAT_EQ(2.0f * i + 1.0f, store.pos.y[i]) << i;
+        EXPECT_FLOAT_EQ(3.0f * i - 0.5f - 2.0f, store.pos.z[i]) << i;
+        EXPECT_FLOAT_EQ(2.0f - 5.0f, store.speed.y[i]) << i;
+        EXPECT_FLOAT_EQ(1.0f, store.speed.x[i]) << i;
+
+        EXPECT_FLOAT_EQ(i + 0.1f, store.time[i]) << i;
+        EXPECT_FLOAT_EQ(0.1f, store.testTime[i]) << i;
+    }
+}
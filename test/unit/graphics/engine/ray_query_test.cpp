@@ -0,0 +1,215 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/ray_query.h"
+
+#include "common/make_unique.h"
+
+#include "common/system/system.h"
+
+#include "graphics/engine/engine.h"
+
+#include "graphics/model/model_triangle.h"
+
+#include "math/geometry.h"
+
+#include <gtest/gtest.h>
+#include <hippomocks.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Gfx;
+using namespace HippoMocks;
+
+class CRayQueryUT : public testing::Test
+{
+protected:
+    ~CRayQueryUT() NOEXCEPT
+    {}
+
+    void SetUp() override;
+    void TearDown() override;
+
+    //! Creates a cube of size 2 centered at \a pos; returns its object rank
+    int  CreateCube(const Math::Vector& pos);
+    void MoveObject(int objRank, const Math::Vector& pos);
+
+    MockRepository m_mocks;
+    CSystemUtils* m_systemUtils = nullptr;
+    std::unique_ptr<CEngine> m_engine;
+    int m_cubeBaseObjRank = -1;
+};
+
+void CRayQueryUT::SetUp()
+{
+    m_systemUtils = m_mocks.Mock<CSystemUtils>();
+    m_mocks.OnCall(m_systemUtils, CSystemUtils::CreateTimeStamp).Return(nullptr);
+    m_mocks.OnCall(m_systemUtils, CSystemUtils::DestroyTimeStamp);
+
+    m_engine = MakeUnique<CEngine>(nullptr, m_systemUtils);
+
+    Math::Vector corners[8];
+    for (int i = 0; i < 8; i++)
+    {
+        corners[i] = Math::Vector((i & 1) ? 1.0f : -1.0f,
+                                  (i & 2) ? 1.0f : -1.0f,
+                                  (i & 4) ? 1.0f : -1.0f);
+    }
+
+    // Two triangles for each face, given by corner indices
+    const int faces[6][4] = { {0, 1, 3, 2}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 3, 7, 5} };
+    std::vector<ModelTriangle> triangles;
+    for (const auto& face : faces)
+    {
+        for (int half = 0; half < 2; half++)
+        {
+            ModelTriangle triangle;
+            triangle.p1 = VertexTex2(corners[face[0]]);
+            triangle.p2 = VertexTex2(corners[face[half+1]]);
+            triangle.p3 = VertexTex2(corners[face[half+2]]);
+            triangles.push_back(triangle);
+        }
+    }
+
+    m_cubeBaseObjRank = m_engine->CreateBaseObject();
+    m_engine->AddBaseObjTriangles(m_cubeBaseObjRank, triangles);
+}
+
+void CRayQueryUT::TearDown()
+{
+    m_engine.reset();
+}
+
+int CRayQueryUT::CreateCube(const Math::Vector& pos)
+{
+    int objRank = m_engine->CreateObject();
+    m_engine->SetObjectBaseRank(objRank, m_cubeBaseObjRank);
+    m_engine->SetObjectType(objRank, ENG_OBJTYPE_FIX);
+    MoveObject(objRank, pos);
+    return objRank;
+}
+
+void CRayQueryUT::MoveObject(int objRank, const Math::Vector& pos)
+{
+    Math::Matrix transform;
+    Math::LoadTranslationMatrix(transform, pos);
+    m_engine->SetObjectTransform(objRank, transform);
+}
+
+TEST_F(CRayQueryUT, NearestObjectIsHit)
+{
+    int nearRank = CreateCube(Math::Vector(0.0f, 0.0f, 10.0f));
+    CreateCube(Math::Vector(0.0f, 0.0f, 20.0f));
+
+    RayHit hit;
+    ASSERT_TRUE(m_engine->GetRayQuery()->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f),
+                                                 1000.0f, false, hit));
+    EXPECT_EQ(nearRank, hit.objRank);
+    EXPECT_NEAR(9.0f, hit.distance, 1e-4f);
+    EXPECT_NEAR(9.0f, hit.pos.z, 1e-4f);
+
+    // Distance is given in units of the ray direction
+    ASSERT_TRUE(m_engine->GetRayQuery()->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 2.0f),
+                                                 1000.0f, false, hit));
+    EXPECT_EQ(nearRank, hit.objRank);
+    EXPECT_NEAR(4.5f, hit.distance, 1e-4f);
+}
+
+TEST_F(CRayQueryUT, ObjectsOutOfRangeAreNotHit)
+{
+    CreateCube(Math::Vector(0.0f, 0.0f, 10.0f));
+
+    RayHit hit;
+    CRayQuery* rayQuery = m_engine->GetRayQuery();
+    EXPECT_FALSE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 5.0f, false, hit));
+    EXPECT_FALSE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, -1.0f), 1000.0f, false, hit));
+    EXPECT_FALSE(rayQuery->CastRay(Math::Vector(3.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+}
+
+TEST_F(CRayQueryUT, MovedObjectIsFound)
+{
+    int objRank = CreateCube(Math::Vector(0.0f, 0.0f, 10.0f));
+    CreateCube(Math::Vector(-10.0f, 0.0f, 10.0f));
+
+    RayHit hit;
+    CRayQuery* rayQuery = m_engine->GetRayQuery();
+    ASSERT_TRUE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+
+    MoveObject(objRank, Math::Vector(5.0f, 0.0f, 10.0f));
+
+    EXPECT_FALSE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+    ASSERT_TRUE(rayQuery->CastRay(Math::Vector(5.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+    EXPECT_EQ(objRank, hit.objRank);
+    EXPECT_NEAR(9.0f, hit.distance, 1e-4f);
+}
+
+TEST_F(CRayQueryUT, ManyMovingObjectsAreFound)
+{
+    // Cubes on a grid are moved around their cell between queries, enough times
+    // for the hierarchy to be both refitted and rebuilt
+    const int size = 8;
+    std::vector<int> ranks;
+    std::vector<Math::Vector> positions;
+    for (int i = 0; i < size*size; i++)
+    {
+        positions.push_back(Math::Vector((i % size) * 8.0f, 0.0f, (i / size) * 8.0f));
+        ranks.push_back(CreateCube(positions[i]));
+    }
+
+    CRayQuery* rayQuery = m_engine->GetRayQuery();
+    for (int round = 0; round < 20; round++)
+    {
+        for (int i = round % 3; i < size*size; i += 3)
+        {
+            float offset = ((i * 7 + round * 13) % 7) - 3.0f;
+            positions[i] = Math::Vector((i % size) * 8.0f + offset, ((i * 11 + round * 5) % 50) * 1.0f, (i / size) * 8.0f);
+            MoveObject(ranks[i], positions[i]);
+        }
+
+        for (int i = 0; i < size*size; i++)
+        {
+            RayHit hit;
+            Math::Vector origin(positions[i].x + 0.5f, -100.0f, positions[i].z - 0.5f);
+            ASSERT_TRUE(rayQuery->CastRay(origin, Math::Vector(0.0f, 1.0f, 0.0f), 1000.0f, false, hit));
+            EXPECT_EQ(ranks[i], hit.objRank);
+            EXPECT_NEAR(positions[i].y + 99.0f, hit.distance, 1e-3f);
+        }
+    }
+}
+
+TEST_F(CRayQueryUT, HiddenObjectsAreNotHit)
+{
+    int objRank = CreateCube(Math::Vector(0.0f, 0.0f, 10.0f));
+
+    RayHit hit;
+    CRayQuery* rayQuery = m_engine->GetRayQuery();
+    ASSERT_TRUE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+
+    Math::Matrix transform;
+    Math::LoadScaleMatrix(transform, Math::Vector(0.0f, 0.0f, 0.0f));
+    m_engine->SetObjectTransform(objRank, transform);
+    EXPECT_FALSE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+
+    MoveObject(objRank, Math::Vector(0.0f, 0.0f, 10.0f));
+    EXPECT_TRUE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+
+    m_engine->DeleteObject(objRank);
+    EXPECT_FALSE(rayQuery->CastRay(Math::Vector(0.0f, 0.0f, 0.0f), Math::Vector(0.0f, 0.0f, 1.0f), 1000.0f, false, hit));
+}
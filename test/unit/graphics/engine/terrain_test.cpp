@@ -0,0 +1,156 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "graphics/engine/terrain.h"
+
+#include "common/make_unique.h"
+
+#include "common/system/system.h"
+
+#include "graphics/engine/engine.h"
+
+#include <gtest/gtest.h>
+#include <hippomocks.h>
+
+#include <cmath>
+#include <memory>
+
+using namespace Gfx;
+using namespace HippoMocks;
+
+//! Gives access to the relief, so that tests don't need relief images
+class CTerrainWrapper : public CTerrain
+{
+public:
+    void SetHeight(int x, int y, float height)
+    {
+        m_relief[x+y*(m_mosaicCount*m_brickCount+1)] = height;
+    }
+
+    void SetMosaicObject(int x, int y, int objRank)
+    {
+        m_objRanks[x+y*m_mosaicCount] = objRank;
+    }
+};
+
+class CTerrainUT : public testing::Test
+{
+protected:
+    ~CTerrainUT() NOEXCEPT
+    {}
+
+    void SetUp() override;
+    void TearDown() override;
+
+    MockRepository m_mocks;
+    CSystemUtils* m_systemUtils = nullptr;
+    std::unique_ptr<CEngine> m_engine;
+    std::unique_ptr<CTerrainWrapper> m_terrain;
+};
+
+void CTerrainUT::SetUp()
+{
+    m_systemUtils = m_mocks.Mock<CSystemUtils>();
+    m_mocks.OnCall(m_systemUtils, CSystemUtils::CreateTimeStamp).Return(nullptr);
+    m_mocks.OnCall(m_systemUtils, CSystemUtils::DestroyTimeStamp);
+
+    m_engine = MakeUnique<CEngine>(nullptr, m_systemUtils);
+
+    // 2x2 mosaics of 4x4 bricks of size 10, so the terrain spans [-40, 40]
+    m_terrain = MakeUnique<CTerrainWrapper>();
+    m_terrain->Generate(2, 2, 10.0f, 100.0f, 1, 0.5f);
+    for (int y = 0; y < 2; y++)
+    {
+        for (int x = 0; x < 2; x++)
+            m_terrain->SetMosaicObject(x, y, 100+x+y*2);
+    }
+}
+
+void CTerrainUT::TearDown()
+{
+    m_terrain.reset();
+    m_engine.reset();
+}
+
+TEST_F(CTerrainUT, IntersectRayFlat)
+{
+    float dist = 0.0f;
+    int objRank = -1;
+    ASSERT_TRUE(m_terrain->IntersectRay(Math::Vector(5.0f, 20.0f, -25.0f), Math::Vector(0.0f, -1.0f, 0.0f),
+                                        1000.0f, dist, objRank));
+    EXPECT_NEAR(20.0f, dist, 1e-4f);
+    EXPECT_EQ(101, objRank);
+
+    // Slanted ray entering the terrain from the side
+    ASSERT_TRUE(m_terrain->IntersectRay(Math::Vector(-60.0f, 10.0f, 15.0f), Math::Vector(1.0f, -0.1f, 0.0f),
+                                        1000.0f, dist, objRank));
+    EXPECT_NEAR(100.0f, dist, 1e-3f);
+    EXPECT_EQ(103, objRank);
+}
+
+TEST_F(CTerrainUT, IntersectRayMiss)
+{
+    float dist = 0.0f;
+    int objRank = -1;
+
+    // Pointing up, too short, parallel above the ground and outside of the terrain
+    EXPECT_FALSE(m_terrain->IntersectRay(Math::Vector(0.0f, 20.0f, 0.0f), Math::Vector(0.0f, 1.0f, 0.0f),
+                                         1000.0f, dist, objRank));
+    EXPECT_FALSE(m_terrain->IntersectRay(Math::Vector(0.0f, 20.0f, 0.0f), Math::Vector(0.0f, -1.0f, 0.0f),
+                                         10.0f, dist, objRank));
+    EXPECT_FALSE(m_terrain->IntersectRay(Math::Vector(-60.0f, 5.0f, 0.0f), Math::Vector(1.0f, 0.0f, 0.0f),
+                                         1000.0f, dist, objRank));
+    EXPECT_FALSE(m_terrain->IntersectRay(Math::Vector(60.0f, 20.0f, 0.0f), Math::Vector(0.0f, -1.0f, 0.0f),
+                                         1000.0f, dist, objRank));
+}
+
+TEST_F(CTerrainUT, IntersectRayBump)
+{
+    // Point of relief at (10, 10) raised to 10
+    m_terrain->SetHeight(5, 5, 10.0f);
+
+    float dist = 0.0f;
+    int objRank = -1;
+    ASSERT_TRUE(m_terrain->IntersectRay(Math::Vector(-35.0f, 5.0f, 12.0f), Math::Vector(1.0f, 0.0f, 0.0f),
+                                        1000.0f, dist, objRank));
+    EXPECT_NEAR(40.0f, dist, 1e-3f);
+    EXPECT_EQ(103, objRank);
+
+    EXPECT_FALSE(m_terrain->IntersectRay(Math::Vector(-35.0f, 5.0f, 12.0f), Math::Vector(1.0f, 0.0f, 0.0f),
+                                         39.0f, dist, objRank));
+}
+
+TEST_F(CTerrainUT, IntersectRayMatchesFloorLevel)
+{
+    for (int y = 0; y <= 8; y++)
+    {
+        for (int x = 0; x <= 8; x++)
+            m_terrain->SetHeight(x, y, 5.0f * sinf(x * 0.7f) * cosf(y * 1.3f));
+    }
+
+    for (int i = 0; i < 50; i++)
+    {
+        Math::Vector pos(-39.0f + (i * 37 % 78), 50.0f, -39.0f + (i * 53 % 78) + 0.25f);
+
+        float dist = 0.0f;
+        int objRank = -1;
+        ASSERT_TRUE(m_terrain->IntersectRay(pos, Math::Vector(0.0f, -1.0f, 0.0f), 1000.0f, dist, objRank));
+        EXPECT_NEAR(m_terrain->GetFloorLevel(pos, true), pos.y - dist, 1e-3f);
+    }
+}
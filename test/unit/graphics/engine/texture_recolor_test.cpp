@@ -0,0 +1,133 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "graphics/engine/texture_recolor.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace Gfx;
+
+namespace
+{
+
+const int WIDTH = 67;  // not a multiple of 4, to test the remaining pixels
+const int HEIGHT = 40;
+
+std::vector<std::uint32_t> RandomPixels()
+{
+    std::mt19937 generator(1234);
+    std::vector<std::uint32_t> pixels(WIDTH * HEIGHT);
+    for (std::uint32_t& pixel : pixels)
+        pixel = generator();
+
+    // Some gray and black pixels
+    for (int i = 0; i < WIDTH * HEIGHT; i += 7)
+    {
+        std::uint32_t value = pixels[i] & 0xFF;
+        pixels[i] = (pixels[i] & 0xFF000000) | (value << 16) | (value << 8) | value;
+    }
+    pixels[1] = 0xFF000000;
+    return pixels;
+}
+
+RecolorImage MakeImage(std::vector<std::uint32_t>& pixels)
+{
+    RecolorImage image;
+    image.pixels = pixels.data();
+    image.width = WIDTH;
+    image.height = HEIGHT;
+    image.pitch = WIDTH;
+    return image;
+}
+
+void CheckSameAsScalar(const RecolorParams& params, bool alpha)
+{
+    std::vector<std::uint32_t> expected = RandomPixels();
+    std::vector<std::uint32_t> result = expected;
+
+    RecolorImage image = MakeImage(expected);
+    image.alpha = alpha;
+    RecolorPixelsScalar(image, params);
+
+    image.pixels = result.data();
+    RecolorPixels(image, params);
+
+    for (int i = 0; i < WIDTH * HEIGHT; i++)
+        ASSERT_EQ(expected[i], result[i]) << "pixel " << i;
+}
+
+} // anonymous namespace
+
+TEST(TextureRecolorTest, RGBChangesCloseColors)
+{
+    std::vector<std::uint32_t> pixels(WIDTH * HEIGHT, 0xFF204060);
+    pixels[0] = 0xFF800000;
+
+    RecolorParams params;
+    params.colorRef1 = Color(0x20/255.0f, 0x40/255.0f, 0x60/255.0f);
+    params.colorNew1 = Color(0x30/255.0f, 0x40/255.0f, 0x60/255.0f);
+    params.tolerance1 = 0.1f;
+    params.ts = Math::Point(0.0f, 0.0f);
+    params.ti = Math::Point(1.0f, 1.0f);
+    params.exclude = { Math::Point(0.0f, 8.0f/256.0f), Math::Point(1.0f, 1.0f) };
+
+    RecolorPixels(MakeImage(pixels), params);
+
+    EXPECT_EQ(0xFF800000u, pixels[0]);            // too far from the reference color
+    EXPECT_EQ(0xFF30, pixels[1] >> 16);           // red changed, alpha kept
+    EXPECT_EQ(0xFF204060u, pixels[8 * WIDTH]);    // excluded
+}
+
+TEST(TextureRecolorTest, SIMDSameAsScalar)
+{
+    RecolorParams params;
+    params.colorRef1 = Color(206.0f/256.0f, 206.0f/256.0f, 204.0f/256.0f);
+    params.colorNew1 = Color(0.8f, 0.2f, 0.1f);
+    params.colorRef2 = Color(0.3f, 0.6f, 0.2f);
+    params.colorNew2 = Color(0.1f, 0.1f, 0.9f);
+    params.tolerance1 = 0.30f;
+    params.tolerance2 = 0.01f;
+    params.ts = Math::Point(0.0f, 0.1f);
+    params.ti = Math::Point(1.0f, 0.9f);
+    params.exclude = { Math::Point(10.0f/256.0f, 8.0f/256.0f), Math::Point(30.0f/256.0f, 20.0f/256.0f) };
+
+    CheckSameAsScalar(params, true);
+    CheckSameAsScalar(params, false);
+
+    params.shift = 0.1f;
+    params.tolerance2 = -1.0f;
+    CheckSameAsScalar(params, true);
+
+    params.hsv = true;
+    params.tolerance1 = 0.10f;
+    params.shift = 0.0f;
+    CheckSameAsScalar(params, true);
+    CheckSameAsScalar(params, false);
+
+    params.colorRef1 = Color(0.2f, 0.6f, 0.9f);
+    params.colorNew1 = Color(0.9f, 0.5f, 0.1f);
+    params.tolerance1 = 0.20f;
+    params.tolerance2 = 0.05f;
+    params.shift = -0.2f;
+    CheckSameAsScalar(params, true);
+}
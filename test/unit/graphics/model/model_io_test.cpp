@@ -0,0 +1,182 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "graphics/model/model_input.h"
+#include "graphics/model/model_io_exception.h"
+#include "graphics/model/model_output.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace Gfx;
+
+namespace
+{
+
+ModelTriangle MakeTriangle(int i)
+{
+    ModelTriangle triangle;
+    float f = i * 0.25f;
+    triangle.p1 = VertexTex2(Math::Vector(f, 1.0f, 2.0f), Math::Vector(0.0f, 1.0f, 0.0f), Math::Point(0.1f, f), Math::Point(0.5f, 0.5f));
+    triangle.p2 = VertexTex2(Math::Vector(3.0f, f, 5.0f), Math::Vector(1.0f, 0.0f, 0.0f), Math::Point(0.2f, 0.3f), Math::Point(f, 0.25f));
+    triangle.p3 = VertexTex2(Math::Vector(6.0f, 7.0f, -f), Math::Vector(0.0f, 0.0f, 1.0f), Math::Point(0.4f, 0.6f), Math::Point(0.75f, f));
+    triangle.diffuse = Color(f, 0.5f, 0.25f, 1.0f);
+    triangle.ambient = Color(0.1f, f, 0.3f, 0.0f);
+    triangle.specular = Color(0.7f, 0.8f, f, 0.5f);
+    triangle.tex1Name = (i % 2 == 0) ? "base1.png" : "lemt.png";
+    triangle.tex2Name = (i % 3 == 0) ? "" : "dirty04.png";
+    triangle.variableTex2 = (i % 4 == 0);
+    triangle.doubleSided = (i % 5 == 0);
+    triangle.transparentMode = static_cast<ModelTransparentMode>(i % 4);
+    triangle.specialMark = static_cast<ModelSpecialMark>(i % 3);
+    return triangle;
+}
+
+CModel MakeModel()
+{
+    CModel model;
+
+    ModelCrashSphere crashSphere;
+    crashSphere.position = Math::Vector(1.0f, 2.0f, 3.0f);
+    crashSphere.radius = 4.5f;
+    crashSphere.sound = "metal";
+    crashSphere.hardness = 0.45f;
+    model.AddCrashSphere(crashSphere);
+
+    ModelShadowSpot shadowSpot;
+    shadowSpot.radius = 6.0f;
+    shadowSpot.intensity = 0.5f;
+    model.SetShadowSpot(shadowSpot);
+
+    CModelMesh main;
+    for (int i = 0; i < 30; ++i)
+        main.AddTriangle(MakeTriangle(i));
+    model.AddMesh("main", std::move(main));
+
+    CModelMesh wheel;
+    wheel.SetParent("main");
+    wheel.SetPosition(Math::Vector(1.0f, -2.0f, 0.5f));
+    wheel.SetRotation(Math::Vector(0.0f, 1.5f, 0.0f));
+    wheel.SetScale(Math::Vector(1.0f, 2.0f, 1.0f));
+    wheel.AddTriangle(MakeTriangle(7));
+    model.AddMesh("wheel", std::move(wheel));
+
+    CModelMesh empty;
+    model.AddMesh("empty", std::move(empty));
+
+    return model;
+}
+
+void ExpectVertexEq(const VertexTex2& expected, const VertexTex2& actual)
+{
+    EXPECT_TRUE(Math::VectorsEqual(expected.coord, actual.coord));
+    EXPECT_TRUE(Math::VectorsEqual(expected.normal, actual.normal));
+    EXPECT_FLOAT_EQ(expected.texCoord.x, actual.texCoord.x);
+    EXPECT_FLOAT_EQ(expected.texCoord.y, actual.texCoord.y);
+    EXPECT_FLOAT_EQ(expected.texCoord2.x, actual.texCoord2.x);
+    EXPECT_FLOAT_EQ(expected.texCoord2.y, actual.texCoord2.y);
+}
+
+void ExpectModelEq(const CModel& expected, const CModel& actual)
+{
+    ASSERT_EQ(expected.GetCrashSphereCount(), actual.GetCrashSphereCount());
+    for (int i = 0; i < expected.GetCrashSphereCount(); ++i)
+    {
+        EXPECT_TRUE(Math::VectorsEqual(expected.GetCrashSpheres()[i].position, actual.GetCrashSpheres()[i].position));
+        EXPECT_FLOAT_EQ(expected.GetCrashSpheres()[i].radius, actual.GetCrashSpheres()[i].radius);
+        EXPECT_EQ(expected.GetCrashSpheres()[i].sound, actual.GetCrashSpheres()[i].sound);
+        EXPECT_FLOAT_EQ(expected.GetCrashSpheres()[i].hardness, actual.GetCrashSpheres()[i].hardness);
+    }
+
+    ASSERT_EQ(expected.HasShadowSpot(), actual.HasShadowSpot());
+    EXPECT_FLOAT_EQ(expected.GetShadowSpot().radius, actual.GetShadowSpot().radius);
+    EXPECT_FLOAT_EQ(expected.GetShadowSpot().intensity, actual.GetShadowSpot().intensity);
+    EXPECT_EQ(expected.HasCameraCollisionSphere(), actual.HasCameraCollisionSphere());
+
+    ASSERT_EQ(expected.GetMeshNames(), actual.GetMeshNames());
+    for (const std::string& name : expected.GetMeshNames())
+    {
+        const CModelMesh* expectedMesh = expected.GetMesh(name);
+        const CModelMesh* actualMesh = actual.GetMesh(name);
+        EXPECT_EQ(expectedMesh->GetParent(), actualMesh->GetParent());
+        EXPECT_TRUE(Math::VectorsEqual(expectedMesh->GetPosition(), actualMesh->GetPosition()));
+        EXPECT_TRUE(Math::VectorsEqual(expectedMesh->GetRotation(), actualMesh->GetRotation()));
+        EXPECT_TRUE(Math::VectorsEqual(expectedMesh->GetScale(), actualMesh->GetScale()));
+
+        ASSERT_EQ(expectedMesh->GetTriangleCount(), actualMesh->GetTriangleCount());
+        for (int i = 0; i < expectedMesh->GetTriangleCount(); ++i)
+        {
+            const ModelTriangle& e = expectedMesh->GetTriangles()[i];
+            const ModelTriangle& a = actualMesh->GetTriangles()[i];
+            ExpectVertexEq(e.p1, a.p1);
+            ExpectVertexEq(e.p2, a.p2);
+            ExpectVertexEq(e.p3, a.p3);
+            EXPECT_EQ(e.diffuse, a.diffuse);
+            EXPECT_EQ(e.ambient, a.ambient);
+            EXPECT_EQ(e.specular, a.specular);
+            EXPECT_EQ(e.tex1Name, a.tex1Name);
+            EXPECT_EQ(e.tex2Name, a.tex2Name);
+            EXPECT_EQ(e.variableTex2, a.variableTex2);
+            EXPECT_EQ(e.doubleSided, a.doubleSided);
+            EXPECT_EQ(e.transparentMode, a.transparentMode);
+            EXPECT_EQ(e.specialMark, a.specialMark);
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(ModelIOTest, BinaryRoundTrip)
+{
+    CModel model = MakeModel();
+
+    std::stringstream stream;
+    ModelOutput::Write(model, stream, ModelFormat::Binary);
+
+    stream.seekg(0);
+    CModel result = ModelInput::Read(stream, ModelFormat::Binary);
+
+    ExpectModelEq(model, result);
+}
+
+TEST(ModelIOTest, BinaryAfterPrefix)
+{
+    CModel model = MakeModel();
+
+    std::stringstream stream;
+    stream << "prefix";
+    ModelOutput::Write(model, stream, ModelFormat::Binary);
+
+    stream.seekg(6);
+    CModel result = ModelInput::Read(stream, ModelFormat::Binary);
+
+    ExpectModelEq(model, result);
+}
+
+TEST(ModelIOTest, TruncatedBinary)
+{
+    std::stringstream stream;
+    ModelOutput::Write(MakeModel(), stream, ModelFormat::Binary);
+
+    std::string data = stream.str();
+    std::stringstream truncated(data.substr(0, data.size() - 10));
+    EXPECT_THROW(ModelInput::Read(truncated, ModelFormat::Binary), CModelIOException);
+}
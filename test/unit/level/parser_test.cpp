@@ -0,0 +1,178 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "level/parser/parser.h"
+
+#include "common/compression.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+
+namespace
+{
+
+//! Gives access to the text and binary formats without going through files
+class CLevelParserWrapper : public CLevelParser
+{
+public:
+    explicit CLevelParserWrapper(const std::string& filename)
+        : CLevelParser(filename)
+    {}
+
+    using CLevelParser::LoadText;
+    using CLevelParser::LoadBinary;
+    using CLevelParser::SaveBinary;
+};
+
+const char LEVEL_TEXT[] =
+    "// Test level\n"
+    "Title text=\"Binary round trip\"\n"
+    "\n"
+    "Camera eye=10;20;30 lookat=0;0;0\n"
+    "CreateObject pos=1.5;2 dir=0.5 type=WheeledGrabber power=1 trainer=1\n"
+    "// Comment\n"
+    "EndMissionTake\n"
+    "CreateObject pos=-3;4 type=PowerCell\n";
+
+//! Number of lines in LEVEL_TEXT
+const std::size_t LEVEL_TEXT_LINES = 5;
+const char INCLUDED_FILENAME[] = "levels/included.txt";
+
+void AddIncludedLine(CLevelParser& parser, int lineNumber, const std::string& command,
+                     const std::string& name, const std::string& value)
+{
+    auto line = MakeUnique<CLevelParserLine>(lineNumber, command);
+    line->SetLevelFilename(INCLUDED_FILENAME);
+    line->AddParam(name, MakeUnique<CLevelParserParam>(name, value));
+    parser.AddLine(std::move(line));
+}
+
+void FillLevel(CLevelParserWrapper& parser)
+{
+    parser.LoadText(LEVEL_TEXT);
+    AddIncludedLine(parser, 3, "CreateObject", "type", "Titanium");
+    AddIncludedLine(parser, 12, "Terrain", "vision", "500");
+}
+
+void ExpectSameLines(CLevelParser& expected, CLevelParser& actual)
+{
+    const auto& expectedLines = expected.GetLines();
+    const auto& actualLines = actual.GetLines();
+    ASSERT_EQ(expectedLines.size(), actualLines.size());
+
+    for (std::size_t i = 0; i < expectedLines.size(); i++)
+    {
+        CLevelParserLine* expectedLine = expectedLines[i].get();
+        CLevelParserLine* actualLine = actualLines[i].get();
+        EXPECT_EQ(expectedLine->GetLineNumber(), actualLine->GetLineNumber());
+        EXPECT_EQ(expectedLine->GetCommand(), actualLine->GetCommand());
+
+        const auto& expectedParams = expectedLine->GetParams();
+        const auto& actualParams = actualLine->GetParams();
+        ASSERT_EQ(expectedParams.size(), actualParams.size());
+        for (auto it = expectedParams.begin(), jt = actualParams.begin(); it != expectedParams.end(); ++it, ++jt)
+        {
+            EXPECT_EQ(it->first, jt->first);
+            EXPECT_EQ(it->second->GetValue(), jt->second->GetValue());
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(CLevelParserTest, BinaryRoundTrip)
+{
+    CLevelParserWrapper parser("levels/test.txt");
+    FillLevel(parser);
+    ASSERT_EQ(LEVEL_TEXT_LINES + 2, parser.GetLines().size());
+
+    CLevelParserWrapper loaded("levels/test.txt");
+    loaded.LoadBinary(parser.SaveBinary());
+
+    ExpectSameLines(parser, loaded);
+
+    const auto& lines = loaded.GetLines();
+    EXPECT_EQ(2, lines[0]->GetLineNumber());
+    EXPECT_EQ(4, lines[1]->GetLineNumber());
+    EXPECT_EQ(8, lines[4]->GetLineNumber());
+    EXPECT_EQ("levels/test.txt", lines[4]->GetLevelFilename());
+    EXPECT_EQ(3, lines[5]->GetLineNumber());
+    EXPECT_EQ(INCLUDED_FILENAME, lines[5]->GetLevelFilename());
+    EXPECT_EQ("Titanium", lines[5]->GetParam("type")->GetValue());
+    EXPECT_EQ(12, lines[6]->GetLineNumber());
+    EXPECT_EQ(INCLUDED_FILENAME, lines[6]->GetLevelFilename());
+}
+
+TEST(CLevelParserTest, BinaryKeepsIncludedFilenames)
+{
+    CLevelParserWrapper parser("levels/test.txt");
+    FillLevel(parser);
+
+    // Lines of the file itself belong to the file that loads the binary data
+    CLevelParserWrapper loaded("levels/copy.txt");
+    loaded.LoadBinary(parser.SaveBinary());
+
+    ExpectSameLines(parser, loaded);
+    const auto& lines = loaded.GetLines();
+    for (std::size_t i = 0; i < lines.size(); i++)
+    {
+        if (i < LEVEL_TEXT_LINES)
+            EXPECT_EQ("levels/copy.txt", lines[i]->GetLevelFilename());
+        else
+            EXPECT_EQ(INCLUDED_FILENAME, lines[i]->GetLevelFilename());
+    }
+}
+
+TEST(CLevelParserTest, BinaryCorrupted)
+{
+    CLevelParserWrapper parser("levels/test.txt");
+    FillLevel(parser);
+    std::string packed = parser.SaveBinary();
+
+    EXPECT_THROW(CLevelParserWrapper("levels/test.txt").LoadBinary(""), CLevelParserException);
+    EXPECT_THROW(CLevelParserWrapper("levels/test.txt").LoadBinary(LEVEL_TEXT), CLevelParserException);
+
+    for (std::size_t size = 0; size < packed.size(); size++)
+    {
+        CLevelParserWrapper loaded("levels/test.txt");
+        EXPECT_THROW(loaded.LoadBinary(packed.substr(0, size)), CLevelParserException) << "size " << size;
+    }
+
+    // Truncated level data in a valid compressed container
+    std::string magic = packed.substr(0, 4);
+    std::string data;
+    ASSERT_TRUE(Compression::Unpack(packed, magic.data(), data));
+    for (std::size_t size = 0; size < data.size(); size++)
+    {
+        CLevelParserWrapper loaded("levels/test.txt");
+        EXPECT_THROW(loaded.LoadBinary(Compression::Pack(data.substr(0, size), magic.data())), CLevelParserException)
+            << "size " << size;
+    }
+
+    // Corrupted header fields: version, packing method and an impossible uncompressed size
+    for (std::size_t field : { 4, 5, 6 })
+    {
+        std::string corrupted = packed;
+        corrupted.replace(field, field == 6 ? 4 : 1, field == 6 ? 4 : 1, '\xFF');
+        CLevelParserWrapper loaded("levels/test.txt");
+        EXPECT_THROW(loaded.LoadBinary(corrupted), CLevelParserException) << "field " << field;
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "level/parser/parserlexer.h"
+#include "level/parser/parserexceptions.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+namespace
+{
+
+struct LexedLine
+{
+    int lineNumber;
+    std::string command;
+    std::vector<std::pair<std::string, std::string>> params;
+};
+
+std::vector<LexedLine> Lex(const std::string& data)
+{
+    std::string filename = "test.txt";
+    CLevelParserLexer lexer(data, filename);
+    std::vector<LexedLine> lines;
+    std::string command, name, value;
+    while (lexer.NextLine(command))
+    {
+        LexedLine line{lexer.GetLineNumber(), command, {}};
+        while (lexer.NextParam(name, value))
+            line.params.push_back(std::make_pair(name, value));
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+} // anonymous namespace
+
+TEST(CLevelParserLexerTest, Params)
+{
+    auto lines = Lex("Title.E text=\"Hello world\"\r\n"
+                     "\n"
+                     "  CreateObject\ttype=Me pos=1.5;-2\tdir =  0.5 cmdline=1 2 3\n"
+                     "Flag");
+
+    ASSERT_EQ(3u, lines.size());
+
+    EXPECT_EQ(1, lines[0].lineNumber);
+    EXPECT_EQ("Title.E", lines[0].command);
+    ASSERT_EQ(1u, lines[0].params.size());
+    EXPECT_EQ("text", lines[0].params[0].first);
+    EXPECT_EQ("\"Hello world\"", lines[0].params[0].second);
+
+    EXPECT_EQ(3, lines[1].lineNumber);
+    EXPECT_EQ("CreateObject", lines[1].command);
+    ASSERT_EQ(4u, lines[1].params.size());
+    EXPECT_EQ("pos", lines[1].params[1].first);
+    EXPECT_EQ("1.5;-2", lines[1].params[1].second);
+    EXPECT_EQ("dir", lines[1].params[2].first);
+    EXPECT_EQ("0.5", lines[1].params[2].second);
+    EXPECT_EQ("cmdline", lines[1].params[3].first);
+    EXPECT_EQ("1 2 3", lines[1].params[3].second);
+
+    EXPECT_EQ(4, lines[2].lineNumber);
+    EXPECT_EQ("Flag", lines[2].command);
+    EXPECT_TRUE(lines[2].params.empty());
+}
+
+TEST(CLevelParserLexerTest, Comments)
+{
+    auto lines = Lex("// only a comment\n"
+                     "Title text=\"a // b\" name='c // d' // comment\n"
+                     "Audio file=x.ogg// comment \"with quote\n");
+
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ(2, lines[0].lineNumber);
+    ASSERT_EQ(2u, lines[0].params.size());
+    EXPECT_EQ("\"a // b\"", lines[0].params[0].second);
+    EXPECT_EQ("'c // d'", lines[0].params[1].second);
+    ASSERT_EQ(1u, lines[1].params.size());
+    EXPECT_EQ("x.ogg", lines[1].params[0].second);
+}
+
+TEST(CLevelParserLexerTest, UnclosedQuote)
+{
+    try
+    {
+        Lex("Title\n\nTitle text=\"abc\n");
+        FAIL();
+    }
+    catch (CLevelParserException& e)
+    {
+        EXPECT_EQ("Unclosed \" in test.txt:3", std::string(e.what()));
+    }
+}
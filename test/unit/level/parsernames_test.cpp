@@ -0,0 +1,103 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+
+#include "level/parser/parsernames.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+
+namespace
+{
+
+template<typename T>
+void TestRoundTrip(const CLevelParserNameTable<T>& names)
+{
+    EXPECT_FALSE(names.GetEntries().empty());
+    for (const auto& entry : names.GetEntries())
+    {
+        SCOPED_TRACE(entry.name);
+
+        T value;
+        ASSERT_TRUE(names.GetValue(entry.name, value));
+        EXPECT_EQ(entry.value, value);
+
+        const char* name = names.GetName(entry.value);
+        ASSERT_NE(nullptr, name);
+        EXPECT_EQ(std::string(entry.name), name);
+    }
+}
+
+template<typename T>
+void TestAllValues(const CLevelParserNameTable<T>& names, int first, int last)
+{
+    for (int i = first; i <= last; i++)
+    {
+        T value = static_cast<T>(i);
+        const char* name = names.GetName(value);
+        if (name == nullptr) continue;
+
+        SCOPED_TRACE(name);
+        T result;
+        ASSERT_TRUE(names.GetValue(name, result));
+        EXPECT_EQ(value, result);
+    }
+}
+
+} // anonymous namespace
+
+TEST(CLevelParserNamesTest, ObjectTypes)
+{
+    TestRoundTrip(GetObjectTypeNames());
+    TestAllValues(GetObjectTypeNames(), 0, OBJECT_MAX);
+
+    ObjectType type;
+    ASSERT_TRUE(GetObjectTypeNames().GetValue("PracticeBot", type));
+    EXPECT_EQ(OBJECT_MOBILEwt, type);
+    EXPECT_STREQ("WheeledTrainer", GetObjectTypeNames().GetName(type));
+    ASSERT_TRUE(GetObjectTypeNames().GetValue("Any", type));
+    EXPECT_EQ(OBJECT_NULL, type);
+    EXPECT_EQ(nullptr, GetObjectTypeNames().GetName(OBJECT_NULL));
+    EXPECT_FALSE(GetObjectTypeNames().GetValue("NoSuchObject", type));
+}
+
+TEST(CLevelParserNamesTest, Flags)
+{
+    TestRoundTrip(GetBuildFlagNames());
+    TestRoundTrip(GetResearchFlagNames());
+    for (int bit = 0; bit < 31; bit++)
+    {
+        TestAllValues(GetBuildFlagNames(), 1 << bit, 1 << bit);
+        TestAllValues(GetResearchFlagNames(), 1 << bit, 1 << bit);
+    }
+
+    int flag;
+    ASSERT_TRUE(GetBuildFlagNames().GetValue("FuelCellPlant", flag));
+    EXPECT_STREQ("NuclearPlant", GetBuildFlagNames().GetName(flag));
+}
+
+TEST(CLevelParserNamesTest, PyroAndCameraTypes)
+{
+    TestRoundTrip(GetPyroTypeNames());
+    TestAllValues(GetPyroTypeNames(), 0, Gfx::PT_SQUASH);
+    TestRoundTrip(GetCameraTypeNames());
+    TestAllValues(GetCameraTypeNames(), 0, Gfx::CAM_TYPE_PLANE);
+}
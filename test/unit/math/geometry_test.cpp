@@ -50,6 +50,30 @@ TEST(GeometryTest, RotateAngleTest)
     EXPECT_TRUE(Math::IsEqual(Math::RotateAngle(1.0f, -1.0f), 1.75f * Math::PI, TEST_TOLERANCE));
 }
 
+TEST(GeometryTest, IntersectRayTriangleTest)
+{
+    Math::Vector a(0.0f, 0.0f, 0.0f);
+    Math::Vector b(4.0f, 0.0f, 0.0f);
+    Math::Vector c(0.0f, 0.0f, 4.0f);
+    float t = 0.0f;
+
+    EXPECT_TRUE(Math::IntersectRayTriangle(Math::Vector(1.0f, 5.0f, 1.0f), Math::Vector(0.0f, -1.0f, 0.0f), a, b, c, t));
+    EXPECT_TRUE(Math::IsEqual(t, 5.0f, TEST_TOLERANCE));
+
+    // Back face is hit as well
+    EXPECT_TRUE(Math::IntersectRayTriangle(Math::Vector(1.0f, -2.0f, 1.0f), Math::Vector(0.0f, 1.0f, 0.0f), a, b, c, t));
+    EXPECT_TRUE(Math::IsEqual(t, 2.0f, TEST_TOLERANCE));
+
+    // Outside of the triangle
+    EXPECT_FALSE(Math::IntersectRayTriangle(Math::Vector(3.0f, 5.0f, 3.0f), Math::Vector(0.0f, -1.0f, 0.0f), a, b, c, t));
+
+    // Triangle behind the origin
+    EXPECT_FALSE(Math::IntersectRayTriangle(Math::Vector(1.0f, 5.0f, 1.0f), Math::Vector(0.0f, 1.0f, 0.0f), a, b, c, t));
+
+    // Parallel ray
+    EXPECT_FALSE(Math::IntersectRayTriangle(Math::Vector(-1.0f, 0.0f, 1.0f), Math::Vector(1.0f, 0.0f, 0.0f), a, b, c, t));
+}
+
 // Tests for other altered, complex or uncertain functions
 
 /*
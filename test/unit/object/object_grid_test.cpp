@@ -0,0 +1,173 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2020, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/object_grid.h"
+
+#include "object/object.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+namespace
+{
+
+//! Object with only a position and crash spheres
+class CFakeObject : public CObject
+{
+public:
+    CFakeObject(int id, ObjectType type, const Math::Vector& pos, float radius = 0.0f)
+        : CObject(id, type)
+    {
+        m_position = pos;
+        if (radius > 0.0f)
+            AddCrashSphere(CrashSphere(Math::Vector(0.0f, 0.0f, 0.0f), radius));
+    }
+
+    void Write(CLevelParserLine*) override {}
+    void Read(CLevelParserLine*) override {}
+    void SetTransparency(float) override {}
+    void SetPosition(const Math::Vector& pos) override { m_position = pos; }
+
+protected:
+    void TransformCrashSphere(Math::Sphere& crashSphere) override { crashSphere.pos += m_position; }
+    void TransformCameraCollisionSphere(Math::Sphere&) override {}
+};
+
+//! Grid which gives the number of entries in its cells
+class CObjectGridWrapper : public CObjectGrid
+{
+public:
+    int GetCellEntryCount()
+    {
+        int count = 0;
+        for (const auto& cell : m_cells)
+            count += cell.size();
+        return count;
+    }
+};
+
+} // anonymous namespace
+
+class CObjectGridTest : public testing::Test
+{
+protected:
+    CObject* AddObject(ObjectType type, const Math::Vector& pos, float radius = 0.0f)
+    {
+        m_objects.push_back(std::unique_ptr<CObject>(new CFakeObject(m_objects.size() + 1, type, pos, radius)));
+        return m_objects.back().get();
+    }
+
+    void UpdateGrid()
+    {
+        std::vector<CObject*> objects;
+        for (const auto& object : m_objects)
+            objects.push_back(object.get());
+        m_grid.Update(objects);
+
+        // An updated grid has the same cells as a new one
+        CObjectGridWrapper newGrid;
+        newGrid.Update(objects);
+        EXPECT_EQ(newGrid.GetCellEntryCount(), m_grid.GetCellEntryCount());
+    }
+
+    std::vector<CObject*> Find(const Math::Vector& a, const Math::Vector& b, unsigned int required = 0, unsigned int excluded = 0)
+    {
+        std::vector<CObject*> result;
+        m_grid.FindNearSegment(a, b, 0.0f, required, excluded, result);
+        return result;
+    }
+
+    std::vector<std::unique_ptr<CObject>> m_objects;
+    CObjectGridWrapper m_grid;
+};
+
+TEST_F(CObjectGridTest, WrappedCellsAreRejected)
+{
+    // The grid is 1024 units wide, so these objects share their cells
+    CObject* near = AddObject(OBJECT_STONE, Math::Vector(8.0f, 0.0f, 8.0f));
+    CObject* far = AddObject(OBJECT_STONE, Math::Vector(8.0f + 1024.0f, 0.0f, 8.0f - 2048.0f));
+    CObject* negative = AddObject(OBJECT_STONE, Math::Vector(-1000.0f, 0.0f, -5.0f));
+    UpdateGrid();
+
+    EXPECT_EQ(std::vector<CObject*>{ near }, Find(Math::Vector(6.0f, 0.0f, 6.0f), Math::Vector(10.0f, 0.0f, 10.0f)));
+    EXPECT_EQ(std::vector<CObject*>{ far }, Find(Math::Vector(1030.0f, 0.0f, -2040.0f), Math::Vector(1030.0f, 0.0f, -2040.0f)));
+    EXPECT_EQ(std::vector<CObject*>{ negative }, Find(Math::Vector(-1002.0f, 0.0f, -3.0f), Math::Vector(-1002.0f, 0.0f, -3.0f)));
+
+    // A segment longer than the grid visits each cell once
+    std::vector<CObject*> all = { near, far, negative };
+    EXPECT_EQ(all, Find(Math::Vector(-3000.0f, 0.0f, -3000.0f), Math::Vector(3000.0f, 0.0f, 3000.0f)));
+}
+
+TEST_F(CObjectGridTest, ObjectInSeveralCellsIsFoundOnce)
+{
+    CObject* small = AddObject(OBJECT_STONE, Math::Vector(100.0f, 0.0f, 100.0f));
+    CObject* large = AddObject(OBJECT_STONE, Math::Vector(0.0f, 0.0f, 0.0f), 50.0f);
+    UpdateGrid();
+
+    std::vector<CObject*> result = Find(Math::Vector(-60.0f, 0.0f, -60.0f), Math::Vector(120.0f, 0.0f, 120.0f));
+    EXPECT_EQ((std::vector<CObject*>{ small, large }), result);
+
+    // Found from a cell far from its center, but not outside of its sphere
+    EXPECT_EQ(std::vector<CObject*>{ large }, Find(Math::Vector(45.0f, 0.0f, 0.0f), Math::Vector(45.0f, 0.0f, 0.0f)));
+    EXPECT_TRUE(Find(Math::Vector(60.0f, 0.0f, 0.0f), Math::Vector(60.0f, 0.0f, 0.0f)).empty());
+}
+
+TEST_F(CObjectGridTest, FiltersByShielderFlag)
+{
+    CObject* shielder = AddObject(OBJECT_MOBILErs, Math::Vector(0.0f, 0.0f, 0.0f));
+    CObject* ant = AddObject(OBJECT_ANT, Math::Vector(2.0f, 0.0f, 0.0f));
+    CObject* toto = AddObject(OBJECT_TOTO, Math::Vector(-2.0f, 0.0f, 0.0f));
+    UpdateGrid();
+
+    Math::Vector a(-5.0f, 0.0f, -5.0f), b(5.0f, 0.0f, 5.0f);
+    EXPECT_EQ(std::vector<CObject*>{ shielder }, Find(a, b, OBJECT_GRID_SHIELDER));
+    EXPECT_EQ(std::vector<CObject*>{ ant }, Find(a, b, OBJECT_GRID_ALIEN, OBJECT_GRID_SHIELDER));
+    EXPECT_EQ((std::vector<CObject*>{ shielder, ant }), Find(a, b, 0, OBJECT_GRID_TOTO));
+    EXPECT_EQ((std::vector<CObject*>{ shielder, ant, toto }), Find(a, b));
+}
+
+TEST_F(CObjectGridTest, UpdateFollowsMovedAndDeletedObjects)
+{
+    CObject* moving = AddObject(OBJECT_STONE, Math::Vector(0.0f, 0.0f, 0.0f));
+    CObject* staying = AddObject(OBJECT_STONE, Math::Vector(1.0f, 0.0f, 0.0f));
+    AddObject(OBJECT_STONE, Math::Vector(300.0f, 0.0f, 0.0f));
+    UpdateGrid();
+
+    // Moved within its cells, then to other cells
+    moving->SetPosition(Math::Vector(2.0f, 0.0f, 0.0f));
+    UpdateGrid();
+    EXPECT_EQ((std::vector<CObject*>{ moving, staying }), Find(Math::Vector(-10.0f, 0.0f, -10.0f), Math::Vector(10.0f, 0.0f, 10.0f)));
+
+    moving->SetPosition(Math::Vector(200.0f, 0.0f, 0.0f));
+    UpdateGrid();
+    EXPECT_EQ(std::vector<CObject*>{ staying }, Find(Math::Vector(-10.0f, 0.0f, -10.0f), Math::Vector(10.0f, 0.0f, 10.0f)));
+    EXPECT_EQ(std::vector<CObject*>{ moving }, Find(Math::Vector(199.0f, 0.0f, 0.0f), Math::Vector(201.0f, 0.0f, 0.0f)));
+
+    // Objects not given to the update are removed, their entries are reused
+    m_objects.pop_back();
+    UpdateGrid();
+    EXPECT_TRUE(Find(Math::Vector(299.0f, 0.0f, 0.0f), Math::Vector(301.0f, 0.0f, 0.0f)).empty());
+
+    CObject* added = AddObject(OBJECT_STONE, Math::Vector(300.0f, 0.0f, 0.0f));
+    UpdateGrid();
+    EXPECT_EQ(std::vector<CObject*>{ added }, Find(Math::Vector(299.0f, 0.0f, 0.0f), Math::Vector(301.0f, 0.0f, 0.0f)));
+}